@@ -0,0 +1,565 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_attitude.c
+ * @brief     driver l3gd20h attitude source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_attitude.h"
+#include "driver_l3gd20h_vec.h"
+
+#if (L3GD20H_ATTITUDE_LANES != L3GD20H_VEC_LANES)
+#error "the bank needs one vector lane per sensor"
+#endif
+
+/**
+ * @brief l3gd20h attitude one definition, 1.0 in q30
+ */
+#define L3GD20H_ATTITUDE_ONE        ((int32_t)1 << 30)
+
+/**
+ * @brief l3gd20h attitude step tables, half of the turn of one lsb in one us
+ * @note  mdps/digit * pi / 180 / 2 * 1e-9 in rad, the fixed table is the same value in q56
+ */
+static const float gs_attitude_k[3] = {7.63581548e-11f, 1.52716310e-10f, 6.10865238e-10f};
+static const int64_t gs_attitude_k56[3] = {5502185, 11004370, 44017479};
+
+/**
+ * @brief      check the sample times of a batch
+ * @param[in]  prev time of the sample before the batch
+ * @param[in]  *us pointer to a timestamp buffer
+ * @param[in]  len batch length
+ * @param[out] *steady pointer to a steady flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 5 timestamps are not increasing
+ * @note       none
+ */
+static uint8_t a_l3gd20h_attitude_check(uint64_t prev, const uint64_t *us, uint16_t len, uint8_t *steady)
+{
+    uint64_t span;
+    uint64_t d;
+    uint64_t err;
+    uint16_t i;
+
+    if (us[len - 1] <= prev)
+    {
+        return 5;
+    }
+    span = us[len - 1] - prev;
+    *steady = 1;
+    for (i = 0; i < len; i++)
+    {
+        if (us[i] <= prev)
+        {
+            return 5;
+        }
+        d = (us[i] - prev) * len;
+        err = (d > span) ? (d - span) : (span - d);
+        if (err > (span >> L3GD20H_ATTITUDE_STEADY_SHIFT))
+        {
+            *steady = 0;
+        }
+        prev = us[i];
+    }
+
+    return 0;
+}
+
+/**
+ * @brief         turn a float quaternion by a half angle vector
+ * @param[in,out] *q pointer to a quaternion w, x, y, z
+ * @param[in]     hx x half angle in rad
+ * @param[in]     hy y half angle in rad
+ * @param[in]     hz z half angle in rad
+ * @note          cos and sin of the half angle are expanded to keep the step norm within 1e-12
+ */
+static inline void a_l3gd20h_attitude_step(float q[4], float hx, float hy, float hz)
+{
+    float h2;
+    float dw;
+    float s;
+    float w, x, y, z;
+
+    h2 = hx * hx + hy * hy + hz * hz;
+    dw = 1.0f - h2 * 0.5f + h2 * h2 * (1.0f / 24.0f);
+    s = 1.0f - h2 * (1.0f / 6.0f);
+    hx *= s;
+    hy *= s;
+    hz *= s;
+    w = q[0];
+    x = q[1];
+    y = q[2];
+    z = q[3];
+    q[0] = w * dw - x * hx - y * hy - z * hz;
+    q[1] = w * hx + x * dw + y * hz - z * hy;
+    q[2] = w * hy - x * hz + y * dw + z * hx;
+    q[3] = w * hz + x * hy - y * hx + z * dw;
+}
+
+/**
+ * @brief     multiply two q30 numbers
+ * @param[in] a first number
+ * @param[in] b second number
+ * @return    rounded product
+ * @note      none
+ */
+static inline int32_t a_l3gd20h_attitude_mul(int32_t a, int32_t b)
+{
+    return (int32_t)(((int64_t)a * b + ((int64_t)1 << 29)) >> 30);
+}
+
+/**
+ * @brief         turn a q30 quaternion by a half angle vector
+ * @param[in,out] *q pointer to a quaternion w, x, y, z
+ * @param[in]     hx x half angle in q30 rad
+ * @param[in]     hy y half angle in q30 rad
+ * @param[in]     hz z half angle in q30 rad
+ * @note          the same expansion as the float step with integer math only
+ */
+static inline void a_l3gd20h_attitude_step_fixed(int32_t q[4], int32_t hx, int32_t hy, int32_t hz)
+{
+    int32_t h2;
+    int32_t dw;
+    int32_t s;
+    int64_t w, x, y, z;
+
+    h2 = a_l3gd20h_attitude_mul(hx, hx) + a_l3gd20h_attitude_mul(hy, hy) + a_l3gd20h_attitude_mul(hz, hz);
+    dw = L3GD20H_ATTITUDE_ONE - h2 / 2 + a_l3gd20h_attitude_mul(h2, h2) / 24;
+    s = L3GD20H_ATTITUDE_ONE - h2 / 6;
+    hx = a_l3gd20h_attitude_mul(hx, s);
+    hy = a_l3gd20h_attitude_mul(hy, s);
+    hz = a_l3gd20h_attitude_mul(hz, s);
+    w = q[0];
+    x = q[1];
+    y = q[2];
+    z = q[3];
+    q[0] = (int32_t)((w * dw - x * hx - y * hy - z * hz + ((int64_t)1 << 29)) >> 30);
+    q[1] = (int32_t)((w * hx + x * dw + y * hz - z * hy + ((int64_t)1 << 29)) >> 30);
+    q[2] = (int32_t)((w * hy - x * hz + y * dw + z * hx + ((int64_t)1 << 29)) >> 30);
+    q[3] = (int32_t)((w * hz + x * hy - y * hx + z * dw + ((int64_t)1 << 29)) >> 30);
+}
+
+/**
+ * @brief     init an attitude structure
+ * @param[in] *att pointer to an attitude structure
+ * @param[in] type quaternion type
+ * @return    status code
+ *            - 0 success
+ *            - 2 att is NULL
+ *            - 4 type is invalid
+ * @note      the attitude starts at the identity on the first timestamp
+ */
+uint8_t l3gd20h_attitude_init(l3gd20h_attitude_t *att, l3gd20h_attitude_type_t type)
+{
+    if (att == NULL)
+    {
+        return 2;
+    }
+    if (type > L3GD20H_ATTITUDE_TYPE_FIXED)
+    {
+        return 4;
+    }
+
+    att->q[0] = 1.0f;
+    att->q[1] = 0.0f;
+    att->q[2] = 0.0f;
+    att->q[3] = 0.0f;
+    att->q30[0] = L3GD20H_ATTITUDE_ONE;
+    att->q30[1] = 0;
+    att->q30[2] = 0;
+    att->q30[3] = 0;
+    att->us = 0;
+    att->samples = 0;
+    att->unsteady = 0;
+    att->type = (uint8_t)type;
+    att->started = 0;
+
+    return 0;
+}
+
+/**
+ * @brief     integrate a timestamped batch
+ * @param[in] *att pointer to an attitude structure
+ * @param[in] scale full scale of the batch
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] *us pointer to a timestamp buffer
+ * @param[in] len batch length
+ * @return    status code
+ *            - 0 success
+ *            - 2 att is NULL
+ *            - 4 scale is invalid
+ *            - 5 timestamps are not increasing
+ * @note      the raw data and the times come from l3gd20h_read_timestamp, every sample turns the body
+ *            frame by its rate over the time since the previous sample, the quaternion is normalised
+ *            once per batch
+ */
+uint8_t l3gd20h_attitude_update(l3gd20h_attitude_t *att, l3gd20h_full_scale_t scale,
+                                const int16_t (*raw)[3], const uint64_t *us, uint16_t len)
+{
+    uint8_t res;
+    uint8_t steady;
+    uint16_t i;
+    uint64_t prev;
+    uint64_t span;
+
+    if (att == NULL)
+    {
+        return 2;
+    }
+    if (scale > L3GD20H_FULL_SCALE_2000_DPS)
+    {
+        return 4;
+    }
+    if (len == 0)
+    {
+        return 0;
+    }
+
+    /* the first sample only starts the time base */
+    if (att->started == 0)
+    {
+        att->us = us[0];
+        att->started = 1;
+        raw++;
+        us++;
+        len--;
+        if (len == 0)
+        {
+            return 0;
+        }
+    }
+    prev = att->us;
+    res = a_l3gd20h_attitude_check(prev, us, len, &steady);
+    if (res != 0)
+    {
+        return res;
+    }
+    span = us[len - 1] - prev;
+    att->unsteady += (steady == 0) ? 1 : 0;
+
+    if (att->type == L3GD20H_ATTITUDE_TYPE_FLOAT)
+    {
+        float k;
+        float n2;
+        float f;
+
+        /* one step size for a steady batch */
+        k = gs_attitude_k[scale] * (float)span / (float)len;
+        for (i = 0; i < len; i++)
+        {
+            if (steady == 0)
+            {
+                k = gs_attitude_k[scale] * (float)(us[i] - prev);
+                prev = us[i];
+            }
+            a_l3gd20h_attitude_step(att->q, k * (float)raw[i][0], k * (float)raw[i][1], k * (float)raw[i][2]);
+        }
+
+        /* one newton step of 1 / sqrt around 1 */
+        n2 = att->q[0] * att->q[0] + att->q[1] * att->q[1] + att->q[2] * att->q[2] + att->q[3] * att->q[3];
+        f = 1.5f - 0.5f * n2;
+        for (i = 0; i < 4; i++)
+        {
+            att->q[i] *= f;
+        }
+    }
+    else
+    {
+        int64_t k;
+        int32_t n2;
+        int32_t f;
+
+        /* the step size in q46 */
+        k = (gs_attitude_k56[scale] * (int64_t)span / len) >> 10;
+        for (i = 0; i < len; i++)
+        {
+            if (steady == 0)
+            {
+                k = (gs_attitude_k56[scale] * (int64_t)(us[i] - prev)) >> 10;
+                prev = us[i];
+            }
+            a_l3gd20h_attitude_step_fixed(att->q30, (int32_t)((raw[i][0] * k) >> 16),
+                                          (int32_t)((raw[i][1] * k) >> 16), (int32_t)((raw[i][2] * k) >> 16));
+        }
+
+        /* one newton step of 1 / sqrt around 1 */
+        n2 = 0;
+        for (i = 0; i < 4; i++)
+        {
+            n2 += a_l3gd20h_attitude_mul(att->q30[i], att->q30[i]);
+        }
+        f = (3 * (L3GD20H_ATTITUDE_ONE / 2)) - n2 / 2;
+        for (i = 0; i < 4; i++)
+        {
+            att->q30[i] = a_l3gd20h_attitude_mul(att->q30[i], f);
+        }
+    }
+    att->us = us[len - 1];
+    att->samples += len;
+
+    return 0;
+}
+
+/**
+ * @brief      get the attitude quaternion
+ * @param[in]  *att pointer to an attitude structure
+ * @param[out] *q pointer to a quaternion buffer w, x, y, z
+ * @return     status code
+ *             - 0 success
+ *             - 2 att is NULL
+ * @note       none
+ */
+uint8_t l3gd20h_attitude_get(l3gd20h_attitude_t *att, float q[4])
+{
+    uint8_t i;
+
+    if (att == NULL)
+    {
+        return 2;
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        q[i] = (att->type == L3GD20H_ATTITUDE_TYPE_FLOAT) ? att->q[i] :
+               (float)att->q30[i] / (float)L3GD20H_ATTITUDE_ONE;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     init an attitude bank
+ * @param[in] *bank pointer to an attitude bank structure
+ * @param[in] lanes number of sensors
+ * @return    status code
+ *            - 0 success
+ *            - 2 bank is NULL
+ *            - 4 lanes is invalid
+ * @note      1 <= lanes <= L3GD20H_ATTITUDE_LANES
+ */
+uint8_t l3gd20h_attitude_bank_init(l3gd20h_attitude_bank_t *bank, uint8_t lanes)
+{
+    uint8_t i;
+
+    if (bank == NULL)
+    {
+        return 2;
+    }
+    if ((lanes == 0) || (lanes > L3GD20H_ATTITUDE_LANES))
+    {
+        return 4;
+    }
+
+    for (i = 0; i < L3GD20H_ATTITUDE_LANES; i++)
+    {
+        bank->w[i] = 1.0f;
+        bank->x[i] = 0.0f;
+        bank->y[i] = 0.0f;
+        bank->z[i] = 0.0f;
+        bank->us[i] = 0;
+    }
+    bank->lanes = lanes;
+    bank->started = 0;
+
+    return 0;
+}
+
+/**
+ * @brief     integrate one batch of every sensor of a bank
+ * @param[in] *bank pointer to an attitude bank structure
+ * @param[in] *scale pointer to a full scale buffer with one entry per lane
+ * @param[in] **raw pointer to a buffer of raw data pointers with one entry per lane
+ * @param[in] **us pointer to a buffer of timestamp pointers with one entry per lane
+ * @param[in] len batch length of every lane
+ * @return    status code
+ *            - 0 success
+ *            - 2 bank is NULL
+ *            - 4 scale is invalid
+ *            - 5 timestamps are not increasing
+ * @note      every lane steps with the mean period of its batch, so the sensors should run at a steady
+ *            output data rate, sse or neon handles the lanes together when the compiler offers it
+ */
+uint8_t l3gd20h_attitude_bank_update(l3gd20h_attitude_bank_t *bank, const l3gd20h_full_scale_t *scale,
+                                     const int16_t (*const *raw)[3], const uint64_t *const *us, uint16_t len)
+{
+    float k[L3GD20H_ATTITUDE_LANES];
+    float r[3][L3GD20H_ATTITUDE_LANES];
+    l3gd20h_vec_t w, x, y, z;
+    l3gd20h_vec_t hx, hy, hz;
+    l3gd20h_vec_t h2, dw, s, n2, f;
+    l3gd20h_vec_t nw, nx, ny;
+    l3gd20h_vec_t one, half, sixth, twentyfourth, threehalves;
+    uint16_t first;
+    uint16_t i;
+    uint8_t j;
+    uint8_t a;
+
+    if (bank == NULL)
+    {
+        return 2;
+    }
+    for (j = 0; j < bank->lanes; j++)
+    {
+        if (scale[j] > L3GD20H_FULL_SCALE_2000_DPS)
+        {
+            return 4;
+        }
+    }
+    if (len == 0)
+    {
+        return 0;
+    }
+
+    /* the first sample only starts the time base */
+    first = 0;
+    if (bank->started == 0)
+    {
+        for (j = 0; j < bank->lanes; j++)
+        {
+            bank->us[j] = us[j][0];
+        }
+        bank->started = 1;
+        first = 1;
+        if (len == 1)
+        {
+            return 0;
+        }
+    }
+
+    /* one step size per lane and batch, unused lanes stand still */
+    for (j = 0; j < L3GD20H_ATTITUDE_LANES; j++)
+    {
+        k[j] = 0.0f;
+        r[0][j] = 0.0f;
+        r[1][j] = 0.0f;
+        r[2][j] = 0.0f;
+    }
+    for (j = 0; j < bank->lanes; j++)
+    {
+        if (us[j][len - 1] <= bank->us[j])
+        {
+            return 5;
+        }
+        k[j] = gs_attitude_k[scale[j]] * (float)(us[j][len - 1] - bank->us[j]) / (float)(len - first);
+    }
+
+    one = a_l3gd20h_vec_set(1.0f);
+    half = a_l3gd20h_vec_set(0.5f);
+    sixth = a_l3gd20h_vec_set(1.0f / 6.0f);
+    twentyfourth = a_l3gd20h_vec_set(1.0f / 24.0f);
+    threehalves = a_l3gd20h_vec_set(1.5f);
+    w = a_l3gd20h_vec_load(bank->w);
+    x = a_l3gd20h_vec_load(bank->x);
+    y = a_l3gd20h_vec_load(bank->y);
+    z = a_l3gd20h_vec_load(bank->z);
+    for (i = first; i < len; i++)
+    {
+        /* gather one sample of every lane */
+        for (j = 0; j < bank->lanes; j++)
+        {
+            for (a = 0; a < 3; a++)
+            {
+                r[a][j] = k[j] * (float)raw[j][i][a];
+            }
+        }
+        hx = a_l3gd20h_vec_load(r[0]);
+        hy = a_l3gd20h_vec_load(r[1]);
+        hz = a_l3gd20h_vec_load(r[2]);
+
+        /* the same expansion as the single sensor step */
+        h2 = a_l3gd20h_vec_add(a_l3gd20h_vec_add(a_l3gd20h_vec_mul(hx, hx), a_l3gd20h_vec_mul(hy, hy)),
+                               a_l3gd20h_vec_mul(hz, hz));
+        dw = a_l3gd20h_vec_add(a_l3gd20h_vec_sub(one, a_l3gd20h_vec_mul(h2, half)),
+                               a_l3gd20h_vec_mul(a_l3gd20h_vec_mul(h2, h2), twentyfourth));
+        s = a_l3gd20h_vec_sub(one, a_l3gd20h_vec_mul(h2, sixth));
+        hx = a_l3gd20h_vec_mul(hx, s);
+        hy = a_l3gd20h_vec_mul(hy, s);
+        hz = a_l3gd20h_vec_mul(hz, s);
+        nw = a_l3gd20h_vec_sub(a_l3gd20h_vec_sub(a_l3gd20h_vec_sub(a_l3gd20h_vec_mul(w, dw), a_l3gd20h_vec_mul(x, hx)),
+                                                 a_l3gd20h_vec_mul(y, hy)), a_l3gd20h_vec_mul(z, hz));
+        nx = a_l3gd20h_vec_sub(a_l3gd20h_vec_add(a_l3gd20h_vec_add(a_l3gd20h_vec_mul(w, hx), a_l3gd20h_vec_mul(x, dw)),
+                                                 a_l3gd20h_vec_mul(y, hz)), a_l3gd20h_vec_mul(z, hy));
+        ny = a_l3gd20h_vec_add(a_l3gd20h_vec_add(a_l3gd20h_vec_sub(a_l3gd20h_vec_mul(w, hy), a_l3gd20h_vec_mul(x, hz)),
+                                                 a_l3gd20h_vec_mul(y, dw)), a_l3gd20h_vec_mul(z, hx));
+        z = a_l3gd20h_vec_add(a_l3gd20h_vec_sub(a_l3gd20h_vec_add(a_l3gd20h_vec_mul(w, hz), a_l3gd20h_vec_mul(x, hy)),
+                                                a_l3gd20h_vec_mul(y, hx)), a_l3gd20h_vec_mul(z, dw));
+        w = nw;
+        x = nx;
+        y = ny;
+    }
+
+    /* one newton step of 1 / sqrt around 1 */
+    n2 = a_l3gd20h_vec_add(a_l3gd20h_vec_add(a_l3gd20h_vec_mul(w, w), a_l3gd20h_vec_mul(x, x)),
+                           a_l3gd20h_vec_add(a_l3gd20h_vec_mul(y, y), a_l3gd20h_vec_mul(z, z)));
+    f = a_l3gd20h_vec_sub(threehalves, a_l3gd20h_vec_mul(half, n2));
+    a_l3gd20h_vec_store(bank->w, a_l3gd20h_vec_mul(w, f));
+    a_l3gd20h_vec_store(bank->x, a_l3gd20h_vec_mul(x, f));
+    a_l3gd20h_vec_store(bank->y, a_l3gd20h_vec_mul(y, f));
+    a_l3gd20h_vec_store(bank->z, a_l3gd20h_vec_mul(z, f));
+    for (j = 0; j < bank->lanes; j++)
+    {
+        bank->us[j] = us[j][len - 1];
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      get the attitude quaternion of a lane
+ * @param[in]  *bank pointer to an attitude bank structure
+ * @param[in]  lane sensor lane
+ * @param[out] *q pointer to a quaternion buffer w, x, y, z
+ * @return     status code
+ *             - 0 success
+ *             - 2 bank is NULL
+ *             - 4 lane is invalid
+ * @note       none
+ */
+uint8_t l3gd20h_attitude_bank_get(l3gd20h_attitude_bank_t *bank, uint8_t lane, float q[4])
+{
+    if (bank == NULL)
+    {
+        return 2;
+    }
+    if (lane >= bank->lanes)
+    {
+        return 4;
+    }
+
+    q[0] = bank->w[lane];
+    q[1] = bank->x[lane];
+    q[2] = bank->y[lane];
+    q[3] = bank->z[lane];
+
+    return 0;
+}
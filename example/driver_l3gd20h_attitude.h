@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_attitude.h
+ * @brief     driver l3gd20h attitude header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_ATTITUDE_H
+#define DRIVER_L3GD20H_ATTITUDE_H
+
+#include "driver_l3gd20h_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h attitude definition
+ * @note  a batch is steady when every sample period stays within 1 / 2^L3GD20H_ATTITUDE_STEADY_SHIFT of
+ *        the batch mean, a steady batch uses one step size for all samples, a bank integrates up to
+ *        L3GD20H_ATTITUDE_LANES sensors side by side
+ */
+#define L3GD20H_ATTITUDE_STEADY_SHIFT    4        /**< period tolerance shift of a steady batch */
+#define L3GD20H_ATTITUDE_LANES           4        /**< sensors of a bank */
+
+/**
+ * @brief l3gd20h attitude type enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_ATTITUDE_TYPE_FLOAT = 0x00,        /**< float quaternion */
+    L3GD20H_ATTITUDE_TYPE_FIXED = 0x01,        /**< q30 quaternion with integer math per sample */
+} l3gd20h_attitude_type_t;
+
+/**
+ * @brief l3gd20h attitude structure definition
+ */
+typedef struct l3gd20h_attitude_s
+{
+    float q[4];              /**< float quaternion w, x, y, z */
+    int32_t q30[4];          /**< q30 quaternion w, x, y, z */
+    uint64_t us;             /**< time of the last integrated sample */
+    uint32_t samples;        /**< integrated samples */
+    uint32_t unsteady;       /**< batches with a per sample step */
+    uint8_t type;            /**< quaternion type */
+    uint8_t started;         /**< time base flag */
+} l3gd20h_attitude_t;
+
+/**
+ * @brief l3gd20h attitude bank structure definition
+ * @note  the quaternions are kept as one array per component so one vector operation serves every lane
+ */
+typedef struct l3gd20h_attitude_bank_s
+{
+    float w[L3GD20H_ATTITUDE_LANES];          /**< w components */
+    float x[L3GD20H_ATTITUDE_LANES];          /**< x components */
+    float y[L3GD20H_ATTITUDE_LANES];          /**< y components */
+    float z[L3GD20H_ATTITUDE_LANES];          /**< z components */
+    uint64_t us[L3GD20H_ATTITUDE_LANES];      /**< time of the last integrated sample per lane */
+    uint8_t lanes;                            /**< used lanes */
+    uint8_t started;                          /**< time base flag */
+} l3gd20h_attitude_bank_t;
+
+/**
+ * @brief     init an attitude structure
+ * @param[in] *att pointer to an attitude structure
+ * @param[in] type quaternion type
+ * @return    status code
+ *            - 0 success
+ *            - 2 att is NULL
+ *            - 4 type is invalid
+ * @note      the attitude starts at the identity on the first timestamp
+ */
+uint8_t l3gd20h_attitude_init(l3gd20h_attitude_t *att, l3gd20h_attitude_type_t type);
+
+/**
+ * @brief     integrate a timestamped batch
+ * @param[in] *att pointer to an attitude structure
+ * @param[in] scale full scale of the batch
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] *us pointer to a timestamp buffer
+ * @param[in] len batch length
+ * @return    status code
+ *            - 0 success
+ *            - 2 att is NULL
+ *            - 4 scale is invalid
+ *            - 5 timestamps are not increasing
+ * @note      the raw data and the times come from l3gd20h_read_timestamp, every sample turns the body
+ *            frame by its rate over the time since the previous sample, the quaternion is normalised
+ *            once per batch
+ */
+uint8_t l3gd20h_attitude_update(l3gd20h_attitude_t *att, l3gd20h_full_scale_t scale,
+                                const int16_t (*raw)[3], const uint64_t *us, uint16_t len);
+
+/**
+ * @brief      get the attitude quaternion
+ * @param[in]  *att pointer to an attitude structure
+ * @param[out] *q pointer to a quaternion buffer w, x, y, z
+ * @return     status code
+ *             - 0 success
+ *             - 2 att is NULL
+ * @note       none
+ */
+uint8_t l3gd20h_attitude_get(l3gd20h_attitude_t *att, float q[4]);
+
+/**
+ * @brief     init an attitude bank
+ * @param[in] *bank pointer to an attitude bank structure
+ * @param[in] lanes number of sensors
+ * @return    status code
+ *            - 0 success
+ *            - 2 bank is NULL
+ *            - 4 lanes is invalid
+ * @note      1 <= lanes <= L3GD20H_ATTITUDE_LANES
+ */
+uint8_t l3gd20h_attitude_bank_init(l3gd20h_attitude_bank_t *bank, uint8_t lanes);
+
+/**
+ * @brief     integrate one batch of every sensor of a bank
+ * @param[in] *bank pointer to an attitude bank structure
+ * @param[in] *scale pointer to a full scale buffer with one entry per lane
+ * @param[in] **raw pointer to a buffer of raw data pointers with one entry per lane
+ * @param[in] **us pointer to a buffer of timestamp pointers with one entry per lane
+ * @param[in] len batch length of every lane
+ * @return    status code
+ *            - 0 success
+ *            - 2 bank is NULL
+ *            - 4 scale is invalid
+ *            - 5 timestamps are not increasing
+ * @note      every lane steps with the mean period of its batch, so the sensors should run at a steady
+ *            output data rate, sse or neon handles the lanes together when the compiler offers it
+ */
+uint8_t l3gd20h_attitude_bank_update(l3gd20h_attitude_bank_t *bank, const l3gd20h_full_scale_t *scale,
+                                     const int16_t (*const *raw)[3], const uint64_t *const *us, uint16_t len);
+
+/**
+ * @brief      get the attitude quaternion of a lane
+ * @param[in]  *bank pointer to an attitude bank structure
+ * @param[in]  lane sensor lane
+ * @param[out] *q pointer to a quaternion buffer w, x, y, z
+ * @return     status code
+ *             - 0 success
+ *             - 2 bank is NULL
+ *             - 4 lane is invalid
+ * @note       none
+ */
+uint8_t l3gd20h_attitude_bank_get(l3gd20h_attitude_bank_t *bank, uint8_t lane, float q[4]);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
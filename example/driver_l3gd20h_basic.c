@@ -51,7 +51,9 @@ static l3gd20h_handle_t gs_handle;        /**< l3gd20h handle */
 uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr_pin)
 {
     uint8_t res;
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
     uint16_t threshold;
+#endif
 
     /* link interface function */
     DRIVER_L3GD20H_LINK_INIT(&gs_handle, l3gd20h_handle_t);
@@ -65,6 +67,7 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
     DRIVER_L3GD20H_LINK_SPI_WRITE(&gs_handle, l3gd20h_interface_spi_write);
     DRIVER_L3GD20H_LINK_DELAY_MS(&gs_handle, l3gd20h_interface_delay_ms);
     DRIVER_L3GD20H_LINK_DEBUG_PRINT(&gs_handle, l3gd20h_interface_debug_print);
+    DRIVER_L3GD20H_LINK_TIMESTAMP_US(&gs_handle, l3gd20h_interface_timestamp_us);
     DRIVER_L3GD20H_LINK_RECEIVE_CALLBACK(&gs_handle, l3gd20h_interface_receive_callback);
     
     /* set the interface */
@@ -234,6 +237,7 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
         return 1;
     }
     
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
     /* set interrupt selection */
     res = l3gd20h_set_interrupt_selection(&gs_handle, L3GD20H_BASIC_DEFAULT_INTERRUPT_SELECTION);
     if (res != 0)
@@ -243,6 +247,7 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
         
         return 1;
     }
+#endif
     
     /* set high pass filter reference */
     res = l3gd20h_set_high_pass_filter_reference(&gs_handle, L3GD20H_BASIC_DEFAULT_HIGH_PASS_FILTER_REFERENCE);
@@ -254,6 +259,7 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
         return 1;
     }
     
+#if (L3GD20H_FIFO_ENABLE == 1)
     /* set bypass fifo mode */
     res = l3gd20h_set_fifo_mode(&gs_handle, L3GD20H_FIFO_MODE_BYPASS);
     if (res != 0)
@@ -263,7 +269,9 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
         
         return 1;
     }
+#endif
     
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
     /* set interrupt 1*/
     res = l3gd20h_set_interrupt1(&gs_handle, L3GD20H_BASIC_DEFAULT_INTERRUPT1);
     if (res != 0)
@@ -273,6 +281,7 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
         
         return 1;
     }
+#endif
     
     /* set boot on interrupt 1*/
     res = l3gd20h_set_boot_on_interrupt1(&gs_handle, L3GD20H_BASIC_DEFAULT_BOOT_ON_INTERRUPT1);
@@ -314,6 +323,7 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
         return 1;
     }
     
+#if (L3GD20H_FIFO_ENABLE == 1)
     /* set fifo threshold on interrupt2 */
     res = l3gd20h_set_fifo_threshold_on_interrupt2(&gs_handle, L3GD20H_BASIC_DEFAULT_FIFO_THRESHOLD_ON_INTERRUPT2);
     if (res != 0)
@@ -343,7 +353,9 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
         
         return 1;
     }
+#endif
     
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
     /* set L3GD20H_INTERRUPT_EVENT_AND_OR_COMBINATION */
     res = l3gd20h_set_interrupt_event(&gs_handle, L3GD20H_INTERRUPT_EVENT_AND_OR_COMBINATION, 
                                       L3GD20H_BASIC_DEFAULT_INTERRUPT_EVENT_AND_OR_COMBINATION);
@@ -502,6 +514,7 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
         
         return 1;
     }
+#endif
     
     /* set data ready active level */
     res = l3gd20h_set_data_ready_active_level(&gs_handle, L3GD20H_BASIC_DEFAULT_DATA_READY_ACTIVE_LEVEL);
@@ -513,6 +526,7 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
         return 1;
     }
     
+#if (L3GD20H_FIFO_ENABLE == 1)
     /* disable fifo */
     res = l3gd20h_set_fifo(&gs_handle, L3GD20H_BOOL_FALSE);
     if (res != 0)
@@ -542,6 +556,7 @@ uint8_t l3gd20h_basic_init(l3gd20h_interface_t interface, l3gd20h_address_t addr
         
         return 1;
     }
+#endif
     
     /* set endian */
     res = l3gd20h_set_data_format(&gs_handle, L3GD20H_BASIC_DEFAULT_DATA_FORMAT);
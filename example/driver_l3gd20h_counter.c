@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_l3gd20h_counter.c
+ * @brief     driver l3gd20h counter source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_counter.h"
+
+#if (L3GD20H_COUNTER_ENABLE == 1)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @brief counter name tables
+ */
+static const char *const gs_dir_name[L3GD20H_COUNTER_DIR_MAX] = {"read", "write"};
+static const char *const gs_irq_name[L3GD20H_COUNTER_IRQ_MAX] =
+{
+    "int1", "int1_active", "int2", "data_ready", "status_overrun", "fifo_threshold", "fifo_overrun", "fifo_empty",
+};
+
+/**
+ * @brief     write the counters as text
+ * @param[in] *counter pointer to a counter snapshot
+ * @param[in] *f pointer to an output stream
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one "name{labels} value" line per counter in the prometheus text format,
+ *            registers without traffic are skipped and the histogram buckets are cumulative
+ */
+uint8_t l3gd20h_counter_write(const l3gd20h_counter_t *counter, FILE *f)
+{
+    uint32_t d;
+    uint32_t i;
+
+    if ((counter == NULL) || (f == NULL))
+    {
+        return 1;
+    }
+
+    /* bus traffic by register */
+    for (d = 0; d < L3GD20H_COUNTER_DIR_MAX; d++)
+    {
+        for (i = 0; i < L3GD20H_COUNTER_REG_NUM; i++)
+        {
+            if (counter->transactions[d][i] == 0)
+            {
+                continue;
+            }
+            fprintf(f, "l3gd20h_bus_transactions_total{dir=\"%s\",reg=\"0x%02X\"} %u\n",
+                    gs_dir_name[d], (unsigned int)i, (unsigned int)counter->transactions[d][i]);
+            fprintf(f, "l3gd20h_bus_bytes_total{dir=\"%s\",reg=\"0x%02X\"} %u\n",
+                    gs_dir_name[d], (unsigned int)i, (unsigned int)counter->bytes[d][i]);
+        }
+    }
+    fprintf(f, "l3gd20h_bus_errors_total %u\n", (unsigned int)counter->errors);
+    fprintf(f, "l3gd20h_bus_retries_total %u\n", (unsigned int)counter->retries);
+
+    /* interrupts and samples */
+    for (i = 0; i < L3GD20H_COUNTER_IRQ_MAX; i++)
+    {
+        fprintf(f, "l3gd20h_irq_total{source=\"%s\"} %u\n", gs_irq_name[i], (unsigned int)counter->irq[i]);
+    }
+    fprintf(f, "l3gd20h_samples_delivered_total %u\n", (unsigned int)counter->samples_delivered);
+    fprintf(f, "l3gd20h_fifo_overrun_total %u\n", (unsigned int)counter->fifo_overrun);
+    fprintf(f, "l3gd20h_status_overrun_total %u\n", (unsigned int)counter->status_overrun);
+
+    /* bus hook time histograms */
+    for (d = 0; d < L3GD20H_COUNTER_DIR_MAX; d++)
+    {
+        uint32_t sum = 0;
+
+        for (i = 0; i < L3GD20H_COUNTER_HIST_BINS - 1; i++)
+        {
+            sum += counter->hist[d][i];
+            fprintf(f, "l3gd20h_bus_us_bucket{dir=\"%s\",le=\"%u\"} %u\n",
+                    gs_dir_name[d], (i == 0) ? 0U : (1U << i) - 1U, (unsigned int)sum);
+        }
+        sum += counter->hist[d][L3GD20H_COUNTER_HIST_BINS - 1];
+        fprintf(f, "l3gd20h_bus_us_bucket{dir=\"%s\",le=\"+Inf\"} %u\n", gs_dir_name[d], (unsigned int)sum);
+        fprintf(f, "l3gd20h_bus_us_sum{dir=\"%s\"} %llu\n", gs_dir_name[d], (unsigned long long)counter->bus_us[d]);
+        fprintf(f, "l3gd20h_bus_us_count{dir=\"%s\"} %u\n", gs_dir_name[d], (unsigned int)sum);
+    }
+
+    return (ferror(f) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     dump the counters to a file or a unix socket
+ * @param[in] *counter pointer to a counter snapshot
+ * @param[in] *path pointer to a file path or "unix:<socket path>"
+ * @return    status code
+ *            - 0 success
+ *            - 1 dump failed
+ * @note      a file is written to "<path>.tmp" and renamed, so a scraper never reads half a dump
+ */
+uint8_t l3gd20h_counter_dump(const l3gd20h_counter_t *counter, const char *path)
+{
+    char tmp[256];
+    FILE *f;
+    uint8_t res;
+
+    if ((counter == NULL) || (path == NULL))
+    {
+        return 1;
+    }
+
+    /* stream the dump to a listening unix socket */
+    if (strncmp(path, "unix:", 5) == 0)
+    {
+        struct sockaddr_un addr;
+        int fd;
+
+        if (strlen(path + 5) >= sizeof(addr.sun_path))
+        {
+            return 1;
+        }
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strcpy(addr.sun_path, path + 5);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+        {
+            return 1;
+        }
+        if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+        {
+            (void)close(fd);
+
+            return 1;
+        }
+        f = fdopen(fd, "w");
+        if (f == NULL)
+        {
+            (void)close(fd);
+
+            return 1;
+        }
+        res = l3gd20h_counter_write(counter, f);
+        if (fclose(f) != 0)
+        {
+            res = 1;
+        }
+
+        return res;
+    }
+
+    /* replace the file in one step */
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp))
+    {
+        return 1;
+    }
+    f = fopen(tmp, "w");
+    if (f == NULL)
+    {
+        return 1;
+    }
+    res = l3gd20h_counter_write(counter, f);
+    if (fclose(f) != 0)
+    {
+        res = 1;
+    }
+    if ((res != 0) || (rename(tmp, path) != 0))
+    {
+        (void)remove(tmp);
+
+        return 1;
+    }
+
+    return 0;
+}
+#endif
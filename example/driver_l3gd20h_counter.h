@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_l3gd20h_counter.h
+ * @brief     driver l3gd20h counter header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_COUNTER_H
+#define DRIVER_L3GD20H_COUNTER_H
+
+#include "driver_l3gd20h_interface.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if (L3GD20H_COUNTER_ENABLE == 1)
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief     write the counters as text
+ * @param[in] *counter pointer to a counter snapshot
+ * @param[in] *f pointer to an output stream
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one "name{labels} value" line per counter in the prometheus text format,
+ *            registers without traffic are skipped and the histogram buckets are cumulative
+ */
+uint8_t l3gd20h_counter_write(const l3gd20h_counter_t *counter, FILE *f);
+
+/**
+ * @brief     dump the counters to a file or a unix socket
+ * @param[in] *counter pointer to a counter snapshot
+ * @param[in] *path pointer to a file path or "unix:<socket path>"
+ * @return    status code
+ *            - 0 success
+ *            - 1 dump failed
+ * @note      a file is written to "<path>.tmp" and renamed, so a scraper never reads half a dump
+ */
+uint8_t l3gd20h_counter_dump(const l3gd20h_counter_t *counter, const char *path);
+
+/**
+ * @}
+ */
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
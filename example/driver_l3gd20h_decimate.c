@@ -0,0 +1,270 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_decimate.c
+ * @brief     driver l3gd20h decimate source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_decimate.h"
+
+/**
+ * @brief     saturate a value to int16
+ * @param[in] v input value
+ * @return    saturated value
+ * @note      none
+ */
+static inline int16_t a_l3gd20h_decimate_saturate(int32_t v)
+{
+    if (v > 32767)
+    {
+        return 32767;
+    }
+    else if (v < -32768)
+    {
+        return -32768;
+    }
+    else
+    {
+        return (int16_t)v;
+    }
+}
+
+/**
+ * @brief     init a decimator
+ * @param[in] *dec pointer to a decimate structure
+ * @param[in] factor decimation factor
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ *            - 4 factor is invalid
+ * @note      2 <= factor <= L3GD20H_DECIMATE_FACTOR_MAX, the subscribers are dropped
+ */
+uint8_t l3gd20h_decimate_init(l3gd20h_decimate_t *dec, uint8_t factor)
+{
+    int64_t r;
+
+    if (dec == NULL)
+    {
+        return 2;
+    }
+    if ((factor < 2) || (factor > L3GD20H_DECIMATE_FACTOR_MAX))
+    {
+        return 4;
+    }
+
+    memset(dec, 0, sizeof(l3gd20h_decimate_t));
+    dec->factor = factor;
+
+    /* unity dc gain and a tap that lifts the droop of order * w^2 / 24 * (1 - 1 / r^2) */
+    r = factor;
+    dec->gain = (int32_t)((((int64_t)1 << 30) + r * r * r / 2) / (r * r * r));
+    dec->droop = (int32_t)(((int64_t)L3GD20H_DECIMATE_ORDER * (r * r - 1) * 32768 + 12 * r * r) / (24 * r * r));
+
+    return 0;
+}
+
+/**
+ * @brief     subscribe to one rate
+ * @param[in] *dec pointer to a decimate structure
+ * @param[in] rate subscribed rate
+ * @param[in] *callback pointer to a batch callback
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ *            - 4 rate or callback is invalid
+ *            - 5 subscribers are full
+ * @note      the callback gets raw data of the full scale of the input, scale it like a driver read
+ */
+uint8_t l3gd20h_decimate_subscribe(l3gd20h_decimate_t *dec, l3gd20h_decimate_rate_t rate,
+                                   void (*callback)(const int16_t (*raw)[3], const uint64_t *us, uint16_t len))
+{
+    if (dec == NULL)
+    {
+        return 2;
+    }
+    if ((rate > L3GD20H_DECIMATE_RATE_LOW) || (callback == NULL))
+    {
+        return 4;
+    }
+    if (dec->subscribers >= L3GD20H_DECIMATE_SUBSCRIBERS)
+    {
+        return 5;
+    }
+
+    dec->subscriber[dec->subscribers].rate = (uint8_t)rate;
+    dec->subscriber[dec->subscribers].callback = callback;
+    dec->subscribers++;
+
+    return 0;
+}
+
+/**
+ * @brief     pass a batch to the subscribers of one rate
+ * @param[in] *dec pointer to a decimate structure
+ * @param[in] rate subscribed rate
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] *us pointer to a timestamp buffer
+ * @param[in] len batch length
+ * @note      none
+ */
+static void a_l3gd20h_decimate_publish(l3gd20h_decimate_t *dec, uint8_t rate, const int16_t (*raw)[3],
+                                       const uint64_t *us, uint16_t len)
+{
+    uint8_t i;
+
+    if (len == 0)
+    {
+        return;
+    }
+    for (i = 0; i < dec->subscribers; i++)
+    {
+        if (dec->subscriber[i].rate == rate)
+        {
+            dec->subscriber[i].callback(raw, us, len);
+        }
+    }
+}
+
+/**
+ * @brief     feed a drained batch
+ * @param[in] *dec pointer to a decimate structure
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] *us pointer to a timestamp buffer, NULL without times
+ * @param[in] len batch length
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ * @note      the high rate subscribers get the batch as it is, the low rate ones get every output with the
+ *            time of its centre, the time of the input sample that completes it less the lag of the chain in
+ *            input periods measured since the previous output, the decimation only runs with a low rate subscriber
+ */
+uint8_t l3gd20h_decimate_feed(l3gd20h_decimate_t *dec, const int16_t (*raw)[3], const uint64_t *us, uint16_t len)
+{
+    int16_t out[L3GD20H_DECIMATE_BATCH][3];
+    uint64_t out_us[L3GD20H_DECIMATE_BATCH];
+    uint16_t n;
+    uint16_t i;
+    uint8_t low;
+    uint8_t k;
+    uint8_t a;
+
+    if (dec == NULL)
+    {
+        return 2;
+    }
+
+    a_l3gd20h_decimate_publish(dec, L3GD20H_DECIMATE_RATE_HIGH, raw, us, len);
+    low = 0;
+    for (k = 0; k < dec->subscribers; k++)
+    {
+        low |= (dec->subscriber[k].rate == L3GD20H_DECIMATE_RATE_LOW) ? 1 : 0;
+    }
+    if (low == 0)
+    {
+        return 0;
+    }
+
+    n = 0;
+    for (i = 0; i < len; i++)
+    {
+        for (a = 0; a < 3; a++)
+        {
+            dec->integrator[0][a] += (uint32_t)(int32_t)raw[i][a];
+            dec->integrator[1][a] += dec->integrator[0][a];
+            dec->integrator[2][a] += dec->integrator[1][a];
+        }
+        dec->phase++;
+        if ((us != NULL) && (dec->step == 0))
+        {
+            dec->base_us = us[i];
+            dec->step = (uint8_t)(dec->factor - dec->phase);
+        }
+        if (dec->phase < dec->factor)
+        {
+            continue;
+        }
+        dec->phase = 0;
+        for (a = 0; a < 3; a++)
+        {
+            uint32_t v = dec->integrator[2][a];
+            uint32_t d;
+            int32_t x;
+
+            /* the combs run at the low rate */
+            for (k = 0; k < L3GD20H_DECIMATE_ORDER; k++)
+            {
+                d = v - dec->comb[k][a];
+                dec->comb[k][a] = v;
+                v = d;
+            }
+
+            /* scale to q4 and compensate the droop */
+            x = (int32_t)(((int64_t)(int32_t)v * dec->gain + ((int64_t)1 << 25)) >> 26);
+            out[n][a] = a_l3gd20h_decimate_saturate((int32_t)((((int64_t)32768 + 2 * dec->droop) * dec->history[0][a] -
+                                                              (int64_t)dec->droop * (x + dec->history[1][a]) +
+                                                              ((int64_t)1 << 18)) >> 19));
+            dec->history[1][a] = dec->history[0][a];
+            dec->history[0][a] = x;
+        }
+        out_us[n] = 0;
+        if (us != NULL)
+        {
+            /* the centre lags by 3 * (factor - 1) / 2 + factor input periods, counted in half periods */
+            out_us[n] = us[i];
+            if (dec->step != 0)
+            {
+                uint64_t lag = 3 * ((uint64_t)dec->factor - 1) + 2 * (uint64_t)dec->factor;
+
+                out_us[n] -= ((us[i] - dec->base_us) * lag + dec->step) / (2 * (uint64_t)dec->step);
+            }
+            dec->base_us = us[i];
+            dec->step = dec->factor;
+        }
+        else
+        {
+            dec->step = 0;
+        }
+        n++;
+        if (n == L3GD20H_DECIMATE_BATCH)
+        {
+            a_l3gd20h_decimate_publish(dec, L3GD20H_DECIMATE_RATE_LOW, (const int16_t (*)[3])out,
+                                       (us != NULL) ? out_us : NULL, n);
+            dec->samples += n;
+            n = 0;
+        }
+    }
+    a_l3gd20h_decimate_publish(dec, L3GD20H_DECIMATE_RATE_LOW, (const int16_t (*)[3])out,
+                               (us != NULL) ? out_us : NULL, n);
+    dec->samples += n;
+
+    return 0;
+}
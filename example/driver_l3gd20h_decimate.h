@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_decimate.h
+ * @brief     driver l3gd20h decimate header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_DECIMATE_H
+#define DRIVER_L3GD20H_DECIMATE_H
+
+#include "driver_l3gd20h_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h decimate definition
+ * @note  a third order cic with a three tap droop compensator, the output lags the input by
+ *        3 * (factor - 1) / 2 + factor input periods
+ */
+#define L3GD20H_DECIMATE_ORDER          3         /**< cic order */
+#define L3GD20H_DECIMATE_FACTOR_MAX     16        /**< largest factor, the cic gain fits 28 bits */
+#define L3GD20H_DECIMATE_SUBSCRIBERS    4         /**< subscribers of a decimator */
+#define L3GD20H_DECIMATE_BATCH          32        /**< low rate samples per callback */
+
+/**
+ * @brief l3gd20h decimate rate enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_DECIMATE_RATE_HIGH = 0x00,        /**< every input sample */
+    L3GD20H_DECIMATE_RATE_LOW  = 0x01,        /**< one sample per factor input samples */
+} l3gd20h_decimate_rate_t;
+
+/**
+ * @brief l3gd20h decimate subscriber structure definition
+ */
+typedef struct l3gd20h_decimate_subscriber_s
+{
+    uint8_t rate;                                                                   /**< subscribed rate */
+    void (*callback)(const int16_t (*raw)[3], const uint64_t *us, uint16_t len);    /**< batch callback */
+} l3gd20h_decimate_subscriber_t;
+
+/**
+ * @brief l3gd20h decimate structure definition
+ * @note  the integrators and the combs wrap around in 32 bits, the differences stay exact
+ */
+typedef struct l3gd20h_decimate_s
+{
+    uint32_t integrator[L3GD20H_DECIMATE_ORDER][3];                                 /**< cic integrators */
+    uint32_t comb[L3GD20H_DECIMATE_ORDER][3];                                       /**< cic comb delays */
+    int32_t history[2][3];                                                          /**< compensator inputs in q4 */
+    int32_t gain;                                                                   /**< 1 / factor^order in q30 */
+    int32_t droop;                                                                  /**< compensator tap in q15 */
+    uint8_t factor;                                                                 /**< decimation factor */
+    uint8_t phase;                                                                  /**< input samples of the current output */
+    uint8_t step;                                                                   /**< input periods from base_us to the next output */
+    uint64_t base_us;                                                               /**< time of an earlier input sample */
+    l3gd20h_decimate_subscriber_t subscriber[L3GD20H_DECIMATE_SUBSCRIBERS];         /**< subscribers */
+    uint8_t subscribers;                                                            /**< used subscribers */
+    uint32_t samples;                                                               /**< low rate samples */
+} l3gd20h_decimate_t;
+
+/**
+ * @brief     init a decimator
+ * @param[in] *dec pointer to a decimate structure
+ * @param[in] factor decimation factor
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ *            - 4 factor is invalid
+ * @note      2 <= factor <= L3GD20H_DECIMATE_FACTOR_MAX, the subscribers are dropped
+ */
+uint8_t l3gd20h_decimate_init(l3gd20h_decimate_t *dec, uint8_t factor);
+
+/**
+ * @brief     subscribe to one rate
+ * @param[in] *dec pointer to a decimate structure
+ * @param[in] rate subscribed rate
+ * @param[in] *callback pointer to a batch callback
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ *            - 4 rate or callback is invalid
+ *            - 5 subscribers are full
+ * @note      the callback gets raw data of the full scale of the input, scale it like a driver read
+ */
+uint8_t l3gd20h_decimate_subscribe(l3gd20h_decimate_t *dec, l3gd20h_decimate_rate_t rate,
+                                   void (*callback)(const int16_t (*raw)[3], const uint64_t *us, uint16_t len));
+
+/**
+ * @brief     feed a drained batch
+ * @param[in] *dec pointer to a decimate structure
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] *us pointer to a timestamp buffer, NULL without times
+ * @param[in] len batch length
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ * @note      the high rate subscribers get the batch as it is, the low rate ones get every output with the
+ *            time of its centre, the time of the input sample that completes it less the lag of the chain in
+ *            input periods measured since the previous output, the decimation only runs with a low rate subscriber
+ */
+uint8_t l3gd20h_decimate_feed(l3gd20h_decimate_t *dec, const int16_t (*raw)[3], const uint64_t *us, uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
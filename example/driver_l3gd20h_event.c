@@ -0,0 +1,399 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_event.c
+ * @brief     driver l3gd20h event source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_event.h"
+#include <math.h>
+
+/**
+ * @brief l3gd20h event sensitivity table
+ * @note  dps per lsb of every full scale
+ */
+static const float gs_event_dps[3] = {0.00875f, 0.0175f, 0.07f};
+
+/**
+ * @brief     convert a threshold to raw units
+ * @param[in] v threshold in the rule units
+ * @param[in] unit rule units per lsb
+ * @param[in] square 1 for a squared threshold
+ * @return    raw threshold
+ * @note      none
+ */
+static uint32_t a_l3gd20h_event_raw(float v, float unit, uint8_t square)
+{
+    double r;
+
+    r = (double)v / (double)unit;
+    if (square != 0)
+    {
+        r = r * r;
+    }
+    if (r >= 4294967295.0)
+    {
+        return 0xFFFFFFFFU;
+    }
+
+    return (uint32_t)(r + 0.5);
+}
+
+/**
+ * @brief     convert one rule to raw units
+ * @param[in] *engine pointer to an event engine structure
+ * @param[in] i rule index
+ * @note      a rate of change is compared per sample, so its unit carries the output data rate
+ */
+static void a_l3gd20h_event_convert(l3gd20h_event_engine_t *engine, uint8_t i)
+{
+    const l3gd20h_event_rule_t *rule = &engine->rule[i];
+    float unit;
+    uint8_t square;
+    float n;
+
+    unit = gs_event_dps[engine->scale];
+    if (rule->type == L3GD20H_EVENT_TYPE_CHANGE)
+    {
+        unit *= engine->odr;
+    }
+    square = (rule->type == L3GD20H_EVENT_TYPE_MAGNITUDE) ? 1 : 0;
+    engine->enter[i] = a_l3gd20h_event_raw(rule->enter, unit, square);
+    engine->leave[i] = a_l3gd20h_event_raw(rule->leave, unit, square);
+    n = rule->duration_ms * engine->odr / 1000.0f;
+    engine->duration[i] = (uint32_t)n;
+    if ((float)engine->duration[i] < n)
+    {
+        engine->duration[i]++;
+    }
+    if (engine->duration[i] == 0)
+    {
+        engine->duration[i] = 1;
+    }
+}
+
+/**
+ * @brief     report an edge
+ * @param[in] *engine pointer to an event engine structure
+ * @param[in] i rule index
+ * @param[in] edge rule edge
+ * @param[in] sample sample index
+ * @param[in] us sample time
+ * @note      none
+ */
+static void a_l3gd20h_event_emit(l3gd20h_event_engine_t *engine, uint8_t i, uint8_t edge, uint32_t sample, uint64_t us)
+{
+    l3gd20h_event_t event;
+    float unit;
+
+    unit = gs_event_dps[engine->scale];
+    if (engine->rule[i].type == L3GD20H_EVENT_TYPE_CHANGE)
+    {
+        unit *= engine->odr;
+    }
+    event.rule = i;
+    event.edge = edge;
+    event.sample = sample;
+    event.us = us;
+    if (engine->rule[i].type == L3GD20H_EVENT_TYPE_MAGNITUDE)
+    {
+        event.peak = sqrtf((float)engine->peak[i]) * unit;
+    }
+    else
+    {
+        event.peak = (float)engine->peak[i] * unit;
+    }
+    event.samples = (edge == L3GD20H_EVENT_EDGE_END) ? engine->count[i] : 0;
+    engine->callback(&event);
+}
+
+/**
+ * @brief     init an event engine
+ * @param[in] *engine pointer to an event engine structure
+ * @param[in] scale full scale of the fed data
+ * @param[in] odr output data rate in Hz
+ * @param[in] *callback pointer to an event callback
+ * @return    status code
+ *            - 0 success
+ *            - 2 engine is NULL
+ *            - 4 param is invalid
+ * @note      none
+ */
+uint8_t l3gd20h_event_init(l3gd20h_event_engine_t *engine, l3gd20h_full_scale_t scale, float odr,
+                           void (*callback)(const l3gd20h_event_t *event))
+{
+    if (engine == NULL)
+    {
+        return 2;
+    }
+    if ((scale > L3GD20H_FULL_SCALE_2000_DPS) || !(odr > 0.0f) || (callback == NULL))
+    {
+        return 4;
+    }
+
+    memset(engine, 0, sizeof(l3gd20h_event_engine_t));
+    engine->scale = (uint8_t)scale;
+    engine->odr = odr;
+    engine->callback = callback;
+
+    return 0;
+}
+
+/**
+ * @brief      add a rule
+ * @param[in]  *engine pointer to an event engine structure
+ * @param[in]  *rule pointer to a rule structure
+ * @param[out] *index pointer to a rule index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 engine is NULL
+ *             - 4 rule is invalid
+ *             - 5 rules are full
+ * @note       the thresholds are converted to raw units here
+ */
+uint8_t l3gd20h_event_add_rule(l3gd20h_event_engine_t *engine, const l3gd20h_event_rule_t *rule, uint8_t *index)
+{
+    uint8_t i;
+
+    if (engine == NULL)
+    {
+        return 2;
+    }
+    if ((rule == NULL) || (rule->type > L3GD20H_EVENT_TYPE_CHANGE) || (rule->combine > L3GD20H_EVENT_COMBINE_AND) ||
+        (rule->axes == 0) || (rule->axes > 0x07) || !(rule->enter > 0.0f) || !(rule->leave >= 0.0f) ||
+        (rule->leave > rule->enter) || !(rule->duration_ms >= 0.0f))
+    {
+        return 4;
+    }
+    if (engine->rules >= L3GD20H_EVENT_RULES)
+    {
+        return 5;
+    }
+
+    i = engine->rules;
+    engine->rule[i] = *rule;
+    engine->count[i] = 0;
+    engine->active[i] = 0;
+    engine->peak[i] = 0;
+    a_l3gd20h_event_convert(engine, i);
+    engine->rules++;
+    if (index != NULL)
+    {
+        *index = i;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     change the full scale and the output data rate
+ * @param[in] *engine pointer to an event engine structure
+ * @param[in] scale full scale of the fed data
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 engine is NULL
+ *            - 4 param is invalid
+ * @note      every rule is converted again, the rule states are kept
+ */
+uint8_t l3gd20h_event_set_scale(l3gd20h_event_engine_t *engine, l3gd20h_full_scale_t scale, float odr)
+{
+    uint8_t i;
+
+    if (engine == NULL)
+    {
+        return 2;
+    }
+    if ((scale > L3GD20H_FULL_SCALE_2000_DPS) || !(odr > 0.0f))
+    {
+        return 4;
+    }
+
+    engine->scale = (uint8_t)scale;
+    engine->odr = odr;
+    for (i = 0; i < engine->rules; i++)
+    {
+        a_l3gd20h_event_convert(engine, i);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     feed a drained batch
+ * @param[in] *engine pointer to an event engine structure
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] *us pointer to a timestamp buffer, NULL without times
+ * @param[in] len batch length
+ * @return    status code
+ *            - 0 success
+ *            - 2 engine is NULL
+ * @note      the callback runs for every edge in sample order of each rule
+ */
+uint8_t l3gd20h_event_feed(l3gd20h_event_engine_t *engine, const int16_t (*raw)[3], const uint64_t *us, uint16_t len)
+{
+    uint32_t level[3][L3GD20H_EVENT_BATCH];
+    uint32_t change[3][L3GD20H_EVENT_BATCH];
+    uint32_t value[L3GD20H_EVENT_BATCH];
+    const uint32_t (*src)[L3GD20H_EVENT_BATCH];
+    uint16_t done;
+    uint16_t n;
+    uint16_t i;
+    uint8_t r;
+    uint8_t a;
+    uint8_t first;
+    int32_t d;
+
+    if (engine == NULL)
+    {
+        return 2;
+    }
+
+    for (done = 0; done < len; done += n)
+    {
+        n = ((len - done) > L3GD20H_EVENT_BATCH) ? L3GD20H_EVENT_BATCH : (uint16_t)(len - done);
+
+        /* the absolute rates and changes of the pass in one contiguous row per axis */
+        for (a = 0; a < 3; a++)
+        {
+            for (i = 0; i < n; i++)
+            {
+                d = raw[done + i][a];
+                level[a][i] = (uint32_t)((d < 0) ? -d : d);
+                d -= (i == 0) ? engine->last[a] : raw[done + i - 1][a];
+                change[a][i] = (uint32_t)((d < 0) ? -d : d);
+            }
+            engine->last[a] = raw[done + n - 1][a];
+        }
+        if ((engine->sample + done) == 0)
+        {
+            /* the first sample has no previous one */
+            change[0][0] = 0;
+            change[1][0] = 0;
+            change[2][0] = 0;
+        }
+
+        for (r = 0; r < engine->rules; r++)
+        {
+            /* one value per sample and rule */
+            if (engine->rule[r].type == L3GD20H_EVENT_TYPE_MAGNITUDE)
+            {
+                for (i = 0; i < n; i++)
+                {
+                    value[i] = 0;
+                }
+                for (a = 0; a < 3; a++)
+                {
+                    if ((engine->rule[r].axes & (1 << a)) != 0)
+                    {
+                        for (i = 0; i < n; i++)
+                        {
+                            value[i] += level[a][i] * level[a][i];
+                        }
+                    }
+                }
+            }
+            else
+            {
+                src = (engine->rule[r].type == L3GD20H_EVENT_TYPE_CHANGE) ? change : level;
+                first = 1;
+                for (a = 0; a < 3; a++)
+                {
+                    if ((engine->rule[r].axes & (1 << a)) == 0)
+                    {
+                        continue;
+                    }
+                    for (i = 0; i < n; i++)
+                    {
+                        if (first != 0)
+                        {
+                            value[i] = src[a][i];
+                        }
+                        else if (engine->rule[r].combine == L3GD20H_EVENT_COMBINE_OR)
+                        {
+                            value[i] = (src[a][i] > value[i]) ? src[a][i] : value[i];
+                        }
+                        else
+                        {
+                            value[i] = (src[a][i] < value[i]) ? src[a][i] : value[i];
+                        }
+                    }
+                    first = 0;
+                }
+            }
+
+            /* hysteresis and minimum duration */
+            for (i = 0; i < n; i++)
+            {
+                if (engine->active[r] == 0)
+                {
+                    if (value[i] <= engine->enter[r])
+                    {
+                        engine->count[r] = 0;
+
+                        continue;
+                    }
+                    if (engine->count[r] == 0)
+                    {
+                        engine->onset[r] = engine->sample + done + i;
+                        engine->onset_us[r] = (us != NULL) ? us[done + i] : 0;
+                        engine->peak[r] = 0;
+                    }
+                    engine->peak[r] = (value[i] > engine->peak[r]) ? value[i] : engine->peak[r];
+                    engine->count[r]++;
+                    if (engine->count[r] >= engine->duration[r])
+                    {
+                        engine->active[r] = 1;
+                        a_l3gd20h_event_emit(engine, r, L3GD20H_EVENT_EDGE_START, engine->onset[r], engine->onset_us[r]);
+                    }
+                }
+                else
+                {
+                    if (value[i] < engine->leave[r])
+                    {
+                        engine->active[r] = 0;
+                        a_l3gd20h_event_emit(engine, r, L3GD20H_EVENT_EDGE_END, engine->sample + done + i,
+                                             (us != NULL) ? us[done + i] : 0);
+                        engine->count[r] = 0;
+
+                        continue;
+                    }
+                    engine->peak[r] = (value[i] > engine->peak[r]) ? value[i] : engine->peak[r];
+                    engine->count[r]++;
+                }
+            }
+        }
+    }
+    engine->sample += len;
+
+    return 0;
+}
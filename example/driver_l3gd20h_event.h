@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_event.h
+ * @brief     driver l3gd20h event header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_EVENT_H
+#define DRIVER_L3GD20H_EVENT_H
+
+#include "driver_l3gd20h_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h event definition
+ */
+#define L3GD20H_EVENT_RULES    8         /**< rules of an engine */
+#define L3GD20H_EVENT_BATCH    32        /**< samples matched in one pass */
+
+/**
+ * @brief l3gd20h event type enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_EVENT_TYPE_AXIS      = 0x00,        /**< absolute rate of the selected axes in dps */
+    L3GD20H_EVENT_TYPE_MAGNITUDE = 0x01,        /**< vector magnitude of the selected axes in dps */
+    L3GD20H_EVENT_TYPE_CHANGE    = 0x02,        /**< absolute rate of change of the selected axes in dps/s */
+} l3gd20h_event_type_t;
+
+/**
+ * @brief l3gd20h event combine enumeration definition
+ * @note  the magnitude rule combines the axes itself
+ */
+typedef enum
+{
+    L3GD20H_EVENT_COMBINE_OR  = 0x00,        /**< any selected axis */
+    L3GD20H_EVENT_COMBINE_AND = 0x01,        /**< every selected axis */
+} l3gd20h_event_combine_t;
+
+/**
+ * @brief l3gd20h event axis enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_EVENT_AXIS_X = 0x01,        /**< x axis */
+    L3GD20H_EVENT_AXIS_Y = 0x02,        /**< y axis */
+    L3GD20H_EVENT_AXIS_Z = 0x04,        /**< z axis */
+} l3gd20h_event_axis_t;
+
+/**
+ * @brief l3gd20h event edge enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_EVENT_EDGE_START = 0x00,        /**< the rule became active */
+    L3GD20H_EVENT_EDGE_END   = 0x01,        /**< the rule became idle */
+} l3gd20h_event_edge_t;
+
+/**
+ * @brief l3gd20h event rule structure definition
+ * @note  a rule starts when its value stays above enter for duration_ms and ends on the first sample
+ *        below leave, leave <= enter gives the hysteresis
+ */
+typedef struct l3gd20h_event_rule_s
+{
+    l3gd20h_event_type_t type;              /**< rule type */
+    l3gd20h_event_combine_t combine;        /**< axis combination */
+    uint8_t axes;                           /**< mask of l3gd20h_event_axis_t */
+    float enter;                            /**< start threshold */
+    float leave;                            /**< end threshold */
+    float duration_ms;                      /**< minimum duration above enter in ms */
+} l3gd20h_event_rule_t;
+
+/**
+ * @brief l3gd20h event structure definition
+ * @note  a start carries the first sample above enter, an end the first sample below leave
+ */
+typedef struct l3gd20h_event_s
+{
+    uint8_t rule;               /**< rule index */
+    uint8_t edge;               /**< l3gd20h_event_edge_t */
+    uint32_t sample;            /**< sample index since the init */
+    uint64_t us;                /**< sample time, 0 without times */
+    float peak;                 /**< largest value of the active rule in the rule units */
+    uint32_t samples;           /**< samples of the active rule, 0 on a start */
+} l3gd20h_event_t;
+
+/**
+ * @brief l3gd20h event engine structure definition
+ * @note  the thresholds live in raw units in one array per field, so a pass is integer compares only
+ */
+typedef struct l3gd20h_event_engine_s
+{
+    l3gd20h_event_rule_t rule[L3GD20H_EVENT_RULES];        /**< rules in their units */
+    uint32_t enter[L3GD20H_EVENT_RULES];                   /**< raw start thresholds, squared for a magnitude */
+    uint32_t leave[L3GD20H_EVENT_RULES];                   /**< raw end thresholds, squared for a magnitude */
+    uint32_t duration[L3GD20H_EVENT_RULES];                /**< minimum duration in samples */
+    uint32_t count[L3GD20H_EVENT_RULES];                   /**< samples above enter or of the active rule */
+    uint32_t onset[L3GD20H_EVENT_RULES];                   /**< index of the first sample above enter */
+    uint64_t onset_us[L3GD20H_EVENT_RULES];                /**< time of the first sample above enter */
+    uint32_t peak[L3GD20H_EVENT_RULES];                    /**< largest raw value of the active rule */
+    uint8_t active[L3GD20H_EVENT_RULES];                   /**< active flags */
+    uint8_t rules;                                         /**< used rules */
+    uint8_t scale;                                         /**< full scale */
+    float odr;                                             /**< output data rate in Hz */
+    int16_t last[3];                                       /**< previous sample for the rate of change */
+    uint32_t sample;                                       /**< samples since the init */
+    void (*callback)(const l3gd20h_event_t *event);        /**< event callback */
+} l3gd20h_event_engine_t;
+
+/**
+ * @brief     init an event engine
+ * @param[in] *engine pointer to an event engine structure
+ * @param[in] scale full scale of the fed data
+ * @param[in] odr output data rate in Hz
+ * @param[in] *callback pointer to an event callback
+ * @return    status code
+ *            - 0 success
+ *            - 2 engine is NULL
+ *            - 4 param is invalid
+ * @note      none
+ */
+uint8_t l3gd20h_event_init(l3gd20h_event_engine_t *engine, l3gd20h_full_scale_t scale, float odr,
+                           void (*callback)(const l3gd20h_event_t *event));
+
+/**
+ * @brief      add a rule
+ * @param[in]  *engine pointer to an event engine structure
+ * @param[in]  *rule pointer to a rule structure
+ * @param[out] *index pointer to a rule index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 engine is NULL
+ *             - 4 rule is invalid
+ *             - 5 rules are full
+ * @note       the thresholds are converted to raw units here
+ */
+uint8_t l3gd20h_event_add_rule(l3gd20h_event_engine_t *engine, const l3gd20h_event_rule_t *rule, uint8_t *index);
+
+/**
+ * @brief     change the full scale and the output data rate
+ * @param[in] *engine pointer to an event engine structure
+ * @param[in] scale full scale of the fed data
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 engine is NULL
+ *            - 4 param is invalid
+ * @note      every rule is converted again, the rule states are kept
+ */
+uint8_t l3gd20h_event_set_scale(l3gd20h_event_engine_t *engine, l3gd20h_full_scale_t scale, float odr);
+
+/**
+ * @brief     feed a drained batch
+ * @param[in] *engine pointer to an event engine structure
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] *us pointer to a timestamp buffer, NULL without times
+ * @param[in] len batch length
+ * @return    status code
+ *            - 0 success
+ *            - 2 engine is NULL
+ * @note      the callback runs for every edge in sample order of each rule
+ */
+uint8_t l3gd20h_event_feed(l3gd20h_event_engine_t *engine, const int16_t (*raw)[3], const uint64_t *us, uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
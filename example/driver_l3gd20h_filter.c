@@ -0,0 +1,263 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_filter.c
+ * @brief     driver l3gd20h filter source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_filter.h"
+#include "driver_l3gd20h_vec.h"
+#include <math.h>
+
+#if (L3GD20H_FILTER_LANES != L3GD20H_VEC_LANES)
+#error "the filter needs one vector lane per sensor"
+#endif
+
+/**
+ * @brief     init a filter
+ * @param[in] *filter pointer to a filter structure
+ * @param[in] type filter type
+ * @param[in] stages number of biquads
+ * @param[in] lanes number of sensors
+ * @return    status code
+ *            - 0 success
+ *            - 2 filter is NULL
+ *            - 4 param is invalid
+ * @note      the filter order is twice the stages, the filter passes the data unchanged until
+ *            l3gd20h_filter_set_corner designs it
+ */
+uint8_t l3gd20h_filter_init(l3gd20h_filter_t *filter, l3gd20h_filter_type_t type, uint8_t stages, uint8_t lanes)
+{
+    uint8_t i;
+
+    if (filter == NULL)
+    {
+        return 2;
+    }
+    if ((type > L3GD20H_FILTER_TYPE_HIGH_PASS) ||
+        (stages == 0) || (stages > L3GD20H_FILTER_STAGES) ||
+        (lanes == 0) || (lanes > L3GD20H_FILTER_LANES))
+    {
+        return 4;
+    }
+
+    memset(filter, 0, sizeof(l3gd20h_filter_t));
+    for (i = 0; i < L3GD20H_FILTER_STAGES; i++)
+    {
+        filter->b0[i] = 1.0f;
+    }
+    filter->type = (uint8_t)type;
+    filter->stages = stages;
+    filter->lanes = lanes;
+
+    return 0;
+}
+
+/**
+ * @brief     design the filter for a corner frequency
+ * @param[in] *filter pointer to a filter structure
+ * @param[in] corner corner frequency in Hz
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 filter is NULL
+ *            - 4 corner is invalid
+ * @note      0 < corner < odr / 2, pass the estimate of l3gd20h_timestamp_get_odr so the corner follows the
+ *            real rate of the device, the state is kept so the filter can be tuned while it runs
+ */
+uint8_t l3gd20h_filter_set_corner(l3gd20h_filter_t *filter, float corner, float odr)
+{
+    double sw;
+    double cw;
+    double ct;
+    double alpha;
+    double a0;
+    double g;
+    uint8_t i;
+
+    if (filter == NULL)
+    {
+        return 2;
+    }
+    if (!(corner > 0.0f) || !(odr > 2.0f * corner))
+    {
+        return 4;
+    }
+
+    /* bilinear butterworth, the pole pair k sits at pi * (2k + 1) / (4n) from the imaginary axis */
+    sw = sin(2.0 * L3GD20H_VEC_PI * (double)corner / (double)odr);
+    cw = cos(2.0 * L3GD20H_VEC_PI * (double)corner / (double)odr);
+    for (i = 0; i < filter->stages; i++)
+    {
+        ct = cos(L3GD20H_VEC_PI * (double)(2 * i + 1) / (double)(4 * filter->stages));
+        alpha = sw * ct;
+        a0 = 1.0 + alpha;
+        g = (filter->type == L3GD20H_FILTER_TYPE_LOW_PASS) ? (1.0 - cw) / 2.0 : (1.0 + cw) / 2.0;
+        filter->b0[i] = (float)(g / a0);
+        filter->b1[i] = (float)(((filter->type == L3GD20H_FILTER_TYPE_LOW_PASS) ? 2.0 * g : -2.0 * g) / a0);
+        filter->b2[i] = (float)(g / a0);
+        filter->a1[i] = (float)(-2.0 * cw / a0);
+        filter->a2[i] = (float)((1.0 - alpha) / a0);
+    }
+    filter->corner = corner;
+    filter->odr = odr;
+
+    return 0;
+}
+
+/**
+ * @brief      copy the samples of one sensor into a batch
+ * @param[in]  *filter pointer to a filter structure
+ * @param[in]  lane sensor lane
+ * @param[in]  **dps pointer to an angular rate buffer
+ * @param[out] **batch pointer to a batch buffer
+ * @param[in]  len batch length
+ * @return     status code
+ *             - 0 success
+ *             - 2 filter is NULL
+ *             - 4 lane is invalid
+ * @note       the batch keeps one row of lanes per axis and sample
+ */
+uint8_t l3gd20h_filter_load(l3gd20h_filter_t *filter, uint8_t lane, const float (*dps)[3],
+                            float (*batch)[3][L3GD20H_FILTER_LANES], uint16_t len)
+{
+    uint16_t i;
+
+    if (filter == NULL)
+    {
+        return 2;
+    }
+    if (lane >= filter->lanes)
+    {
+        return 4;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        batch[i][0][lane] = dps[i][0];
+        batch[i][1][lane] = dps[i][1];
+        batch[i][2][lane] = dps[i][2];
+    }
+
+    return 0;
+}
+
+/**
+ * @brief         filter a batch in place
+ * @param[in]     *filter pointer to a filter structure
+ * @param[in,out] **batch pointer to a batch buffer
+ * @param[in]     len batch length
+ * @return        status code
+ *                - 0 success
+ *                - 2 filter is NULL
+ * @note          every stage runs over the whole batch before the next one, sse or neon filters the lanes
+ *                together when the compiler offers it, the rows of unused lanes are filtered as well so
+ *                keep them at 0
+ */
+uint8_t l3gd20h_filter_process(l3gd20h_filter_t *filter, float (*batch)[3][L3GD20H_FILTER_LANES], uint16_t len)
+{
+    l3gd20h_vec_t b0, b1, b2, a1, a2;
+    l3gd20h_vec_t z1, z2;
+    l3gd20h_vec_t x, y;
+    uint16_t i;
+    uint8_t s;
+    uint8_t a;
+
+    if (filter == NULL)
+    {
+        return 2;
+    }
+
+    for (s = 0; s < filter->stages; s++)
+    {
+        b0 = a_l3gd20h_vec_set(filter->b0[s]);
+        b1 = a_l3gd20h_vec_set(filter->b1[s]);
+        b2 = a_l3gd20h_vec_set(filter->b2[s]);
+        a1 = a_l3gd20h_vec_set(filter->a1[s]);
+        a2 = a_l3gd20h_vec_set(filter->a2[s]);
+        for (a = 0; a < 3; a++)
+        {
+            /* the state stays in registers for the whole batch */
+            z1 = a_l3gd20h_vec_load(filter->z1[s][a]);
+            z2 = a_l3gd20h_vec_load(filter->z2[s][a]);
+            for (i = 0; i < len; i++)
+            {
+                x = a_l3gd20h_vec_load(batch[i][a]);
+                y = a_l3gd20h_vec_add(a_l3gd20h_vec_mul(b0, x), z1);
+                z1 = a_l3gd20h_vec_add(a_l3gd20h_vec_sub(a_l3gd20h_vec_mul(b1, x), a_l3gd20h_vec_mul(a1, y)), z2);
+                z2 = a_l3gd20h_vec_sub(a_l3gd20h_vec_mul(b2, x), a_l3gd20h_vec_mul(a2, y));
+                a_l3gd20h_vec_store(batch[i][a], y);
+            }
+            a_l3gd20h_vec_store(filter->z1[s][a], z1);
+            a_l3gd20h_vec_store(filter->z2[s][a], z2);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      copy the samples of one sensor out of a batch
+ * @param[in]  *filter pointer to a filter structure
+ * @param[in]  lane sensor lane
+ * @param[in]  **batch pointer to a batch buffer
+ * @param[out] **dps pointer to an angular rate buffer
+ * @param[in]  len batch length
+ * @return     status code
+ *             - 0 success
+ *             - 2 filter is NULL
+ *             - 4 lane is invalid
+ * @note       none
+ */
+uint8_t l3gd20h_filter_store(l3gd20h_filter_t *filter, uint8_t lane, const float (*batch)[3][L3GD20H_FILTER_LANES],
+                             float (*dps)[3], uint16_t len)
+{
+    uint16_t i;
+
+    if (filter == NULL)
+    {
+        return 2;
+    }
+    if (lane >= filter->lanes)
+    {
+        return 4;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        dps[i][0] = batch[i][0][lane];
+        dps[i][1] = batch[i][1][lane];
+        dps[i][2] = batch[i][2][lane];
+    }
+
+    return 0;
+}
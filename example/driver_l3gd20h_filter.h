@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_filter.h
+ * @brief     driver l3gd20h filter header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_FILTER_H
+#define DRIVER_L3GD20H_FILTER_H
+
+#include "driver_l3gd20h_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h filter definition
+ * @note  a filter cascades up to L3GD20H_FILTER_STAGES biquads, one stage per second order, and runs up to
+ *        L3GD20H_FILTER_LANES sensors side by side
+ */
+#define L3GD20H_FILTER_STAGES    4        /**< biquads of a filter */
+#define L3GD20H_FILTER_LANES     4        /**< sensors of a filter */
+
+/**
+ * @brief l3gd20h filter type enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_FILTER_TYPE_LOW_PASS  = 0x00,        /**< butterworth low pass */
+    L3GD20H_FILTER_TYPE_HIGH_PASS = 0x01,        /**< butterworth high pass */
+} l3gd20h_filter_type_t;
+
+/**
+ * @brief l3gd20h filter structure definition
+ * @note  the state is kept per stage, axis and lane in direct form 2 transposed
+ */
+typedef struct l3gd20h_filter_s
+{
+    float b0[L3GD20H_FILTER_STAGES];                                   /**< feed forward coefficient 0 */
+    float b1[L3GD20H_FILTER_STAGES];                                   /**< feed forward coefficient 1 */
+    float b2[L3GD20H_FILTER_STAGES];                                   /**< feed forward coefficient 2 */
+    float a1[L3GD20H_FILTER_STAGES];                                   /**< feedback coefficient 1 */
+    float a2[L3GD20H_FILTER_STAGES];                                   /**< feedback coefficient 2 */
+    float z1[L3GD20H_FILTER_STAGES][3][L3GD20H_FILTER_LANES];          /**< first state */
+    float z2[L3GD20H_FILTER_STAGES][3][L3GD20H_FILTER_LANES];          /**< second state */
+    float corner;                                                      /**< corner frequency in Hz */
+    float odr;                                                         /**< output data rate in Hz */
+    uint8_t type;                                                      /**< filter type */
+    uint8_t stages;                                                    /**< used stages */
+    uint8_t lanes;                                                     /**< used lanes */
+} l3gd20h_filter_t;
+
+/**
+ * @brief     init a filter
+ * @param[in] *filter pointer to a filter structure
+ * @param[in] type filter type
+ * @param[in] stages number of biquads
+ * @param[in] lanes number of sensors
+ * @return    status code
+ *            - 0 success
+ *            - 2 filter is NULL
+ *            - 4 param is invalid
+ * @note      the filter order is twice the stages, the filter passes the data unchanged until
+ *            l3gd20h_filter_set_corner designs it
+ */
+uint8_t l3gd20h_filter_init(l3gd20h_filter_t *filter, l3gd20h_filter_type_t type, uint8_t stages, uint8_t lanes);
+
+/**
+ * @brief     design the filter for a corner frequency
+ * @param[in] *filter pointer to a filter structure
+ * @param[in] corner corner frequency in Hz
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 filter is NULL
+ *            - 4 corner is invalid
+ * @note      0 < corner < odr / 2, pass the estimate of l3gd20h_timestamp_get_odr so the corner follows the
+ *            real rate of the device, the state is kept so the filter can be tuned while it runs
+ */
+uint8_t l3gd20h_filter_set_corner(l3gd20h_filter_t *filter, float corner, float odr);
+
+/**
+ * @brief      copy the samples of one sensor into a batch
+ * @param[in]  *filter pointer to a filter structure
+ * @param[in]  lane sensor lane
+ * @param[in]  **dps pointer to an angular rate buffer
+ * @param[out] **batch pointer to a batch buffer
+ * @param[in]  len batch length
+ * @return     status code
+ *             - 0 success
+ *             - 2 filter is NULL
+ *             - 4 lane is invalid
+ * @note       the batch keeps one row of lanes per axis and sample
+ */
+uint8_t l3gd20h_filter_load(l3gd20h_filter_t *filter, uint8_t lane, const float (*dps)[3],
+                            float (*batch)[3][L3GD20H_FILTER_LANES], uint16_t len);
+
+/**
+ * @brief         filter a batch in place
+ * @param[in]     *filter pointer to a filter structure
+ * @param[in,out] **batch pointer to a batch buffer
+ * @param[in]     len batch length
+ * @return        status code
+ *                - 0 success
+ *                - 2 filter is NULL
+ * @note          every stage runs over the whole batch before the next one, sse or neon filters the lanes
+ *                together when the compiler offers it, the rows of unused lanes are filtered as well so
+ *                keep them at 0
+ */
+uint8_t l3gd20h_filter_process(l3gd20h_filter_t *filter, float (*batch)[3][L3GD20H_FILTER_LANES], uint16_t len);
+
+/**
+ * @brief      copy the samples of one sensor out of a batch
+ * @param[in]  *filter pointer to a filter structure
+ * @param[in]  lane sensor lane
+ * @param[in]  **batch pointer to a batch buffer
+ * @param[out] **dps pointer to an angular rate buffer
+ * @param[in]  len batch length
+ * @return     status code
+ *             - 0 success
+ *             - 2 filter is NULL
+ *             - 4 lane is invalid
+ * @note       none
+ */
+uint8_t l3gd20h_filter_store(l3gd20h_filter_t *filter, uint8_t lane, const float (*batch)[3][L3GD20H_FILTER_LANES],
+                             float (*dps)[3], uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,348 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_ig.c
+ * @brief     driver l3gd20h ig source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_ig.h"
+
+/**
+ * @brief l3gd20h ig cut off table
+ * @note  cut off frequency in mhz per cut off index and output data rate from 12.5hz to 800hz
+ */
+static const uint32_t gs_ig_cut_off_mhz[10][7] =
+{
+    {1000, 2000, 4000, 8000, 15000, 30000, 56000},
+    {500, 1000, 2000, 4000, 8000, 15000, 30000},
+    {200, 500, 1000, 2000, 4000, 8000, 15000},
+    {100, 200, 500, 1000, 2000, 4000, 8000},
+    {50, 100, 200, 500, 1000, 2000, 4000},
+    {20, 50, 100, 200, 500, 1000, 2000},
+    {10, 20, 50, 100, 200, 500, 1000},
+    {5, 10, 20, 50, 100, 200, 500},
+    {2, 5, 10, 20, 50, 100, 200},
+    {1, 2, 5, 10, 20, 50, 100},
+};
+
+/**
+ * @brief     run the interrupt generator on one sample
+ * @param[in] *ig pointer to an ig structure
+ * @param[in] *v pointer to the selected data
+ * @note      events compare the absolute value with the axis threshold and the duration counts samples,
+ *            the steps follow the datasheet timing of the duration, wait, counter mode and latch bits
+ */
+static void a_l3gd20h_ig_step(l3gd20h_ig_t *ig, const int32_t v[3])
+{
+    uint8_t flags;
+    uint8_t enable;
+    uint8_t hit;
+    uint8_t cond;
+    uint8_t active;
+    uint8_t i;
+
+    flags = 0;
+    for (i = 0; i < 3; i++)
+    {
+        int32_t mag;
+
+        mag = (v[i] < 0) ? -v[i] : v[i];
+        if (mag > (int32_t)ig->config.threshold[i])
+        {
+            flags |= (uint8_t)(1 << (2 * i + 1));
+        }
+        else
+        {
+            flags |= (uint8_t)(1 << (2 * i));
+        }
+    }
+
+    /* combine the enabled events */
+    enable = ig->config.event & 0x3F;
+    hit = flags & enable;
+    if (enable == 0)
+    {
+        cond = 0;
+    }
+    else if (ig->config.and_or == L3GD20H_BOOL_TRUE)
+    {
+        cond = (hit == enable) ? 1 : 0;
+    }
+    else
+    {
+        cond = (hit != 0) ? 1 : 0;
+    }
+
+    /* a latched source is kept until it is read */
+    active = ((ig->src & (1 << 6)) != 0) ? 1 : 0;
+    if ((active != 0) && (ig->config.latch == L3GD20H_BOOL_TRUE))
+    {
+        return;
+    }
+
+    if (cond != 0)
+    {
+        ig->off = 0;
+        if (ig->on < 0xFF)
+        {
+            ig->on++;
+        }
+        if (ig->on > ig->config.duration)
+        {
+            active = 1;
+        }
+    }
+    else
+    {
+        /* counter mode decrements or resets the duration counter */
+        if (ig->config.counter_mode == L3GD20H_COUNTER_MODE_DECREMENT)
+        {
+            if (ig->on != 0)
+            {
+                ig->on--;
+            }
+        }
+        else
+        {
+            ig->on = 0;
+        }
+
+        /* wait keeps the interrupt for the duration */
+        if ((active != 0) && (ig->config.wait == L3GD20H_BOOL_TRUE))
+        {
+            if (ig->off < 0xFF)
+            {
+                ig->off++;
+            }
+            if (ig->off > ig->config.duration)
+            {
+                active = 0;
+            }
+        }
+        else
+        {
+            active = 0;
+        }
+    }
+
+    /* the auto reset mode clears the high pass filter on the interrupt */
+    if ((active != 0) && ((ig->src & (1 << 6)) == 0) &&
+        (ig->config.mode == L3GD20H_HIGH_PASS_FILTER_MODE_AUTORESET_ON_INT))
+    {
+        ig->out[0] = 0;
+        ig->out[1] = 0;
+        ig->out[2] = 0;
+    }
+    ig->src = (active != 0) ? (uint8_t)((1 << 6) | hit) : hit;
+}
+
+uint8_t l3gd20h_ig_init(l3gd20h_ig_t *ig, const l3gd20h_ig_config_t *config, float odr)
+{
+    uint8_t col;
+    uint8_t i;
+    float w;
+
+    if ((ig == NULL) || (config == NULL))
+    {
+        return 2;
+    }
+    if (((config->event & 0xC0) != 0) || (config->duration > 0x7F) ||
+        (config->selection == L3GD20H_SELECTION_LPF1_HPF_LPF2) ||
+        (config->mode == L3GD20H_HIGH_PASS_FILTER_MODE_REFERENCE_SIGNAL) ||
+        (config->cut_off > L3GD20H_HIGH_PASS_FILTER_CUT_OFF_FREQUENCY_9))
+    {
+        return 4;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        if (config->threshold[i] > 0x7FFF)
+        {
+            return 4;
+        }
+    }
+    if (!(odr > 0.0f))
+    {
+        return 5;
+    }
+
+    memset(ig, 0, sizeof(l3gd20h_ig_t));
+    ig->config = *config;
+
+    /* the nearest column of the cut off table and a one pole high pass filter */
+    col = 0;
+    while ((col < 6) && (odr > 12.5f * (float)(1 << col) * 1.41421356f))
+    {
+        col++;
+    }
+    w = 2.0f * 3.14159265f * (float)gs_ig_cut_off_mhz[config->cut_off][col] / (1000.0f * odr);
+    ig->alpha = (int32_t)(32768.0f / (1.0f + w) + 0.5f);
+
+    return 0;
+}
+
+uint8_t l3gd20h_ig_feed(l3gd20h_ig_t *ig, const int16_t (*raw)[3], uint16_t len, uint8_t *int1)
+{
+    int32_t v[3];
+    uint16_t n;
+    uint8_t level;
+    uint8_t i;
+
+    if (ig == NULL)
+    {
+        return 2;
+    }
+
+    for (n = 0; n < len; n++)
+    {
+        if (ig->config.selection == L3GD20H_SELECTION_LPF1_HPF)
+        {
+            /* y[n] = alpha * (y[n - 1] + x[n] - x[n - 1]) with fraction bits in the state */
+            if (ig->started == 0)
+            {
+                ig->in[0] = raw[n][0];
+                ig->in[1] = raw[n][1];
+                ig->in[2] = raw[n][2];
+                ig->started = 1;
+            }
+            for (i = 0; i < 3; i++)
+            {
+                int64_t acc;
+
+                acc = (int64_t)ig->out[i] + (int64_t)((raw[n][i] - ig->in[i]) * (1 << L3GD20H_IG_HPF_SHIFT));
+                ig->out[i] = (int32_t)((acc * ig->alpha) / 32768);
+                ig->in[i] = raw[n][i];
+                v[i] = ig->out[i] / (1 << L3GD20H_IG_HPF_SHIFT);
+            }
+        }
+        else
+        {
+            v[0] = raw[n][0];
+            v[1] = raw[n][1];
+            v[2] = raw[n][2];
+        }
+
+        level = ((ig->src & (1 << 6)) != 0) ? 1 : 0;
+        a_l3gd20h_ig_step(ig, v);
+        if (((ig->src & (1 << 6)) != 0) != (level != 0))
+        {
+            ig->edges++;
+            ig->rises += (level == 0) ? 1 : 0;
+        }
+        if (int1 != NULL)
+        {
+            int1[n] = ((ig->src & (1 << 6)) != 0) ? 1 : 0;
+        }
+        ig->samples++;
+    }
+
+    return 0;
+}
+
+uint8_t l3gd20h_ig_get_source(l3gd20h_ig_t *ig, uint8_t *src)
+{
+    if ((ig == NULL) || (src == NULL))
+    {
+        return 2;
+    }
+
+    *src = ig->src;
+    if (ig->config.latch == L3GD20H_BOOL_TRUE)
+    {
+        /* the read releases the latch and restarts the duration */
+        ig->src = 0;
+        ig->on = 0;
+    }
+
+    return 0;
+}
+
+uint8_t l3gd20h_ig_read_config(l3gd20h_handle_t *handle, l3gd20h_ig_config_t *config)
+{
+    l3gd20h_bool_t enable;
+    uint8_t res;
+    uint8_t i;
+
+    if ((handle == NULL) || (config == NULL))
+    {
+        return 2;
+    }
+
+    res = l3gd20h_get_x_interrupt_threshold(handle, &config->threshold[0]);
+    res |= l3gd20h_get_y_interrupt_threshold(handle, &config->threshold[1]);
+    res |= l3gd20h_get_z_interrupt_threshold(handle, &config->threshold[2]);
+    config->event = 0;
+    for (i = 0; i < 6; i++)
+    {
+        res |= l3gd20h_get_interrupt_event(handle, (l3gd20h_interrupt_event_t)i, &enable);
+        config->event |= (enable == L3GD20H_BOOL_TRUE) ? (uint8_t)(1 << i) : 0;
+    }
+    res |= l3gd20h_get_interrupt_event(handle, L3GD20H_INTERRUPT_EVENT_AND_OR_COMBINATION, &config->and_or);
+    res |= l3gd20h_get_interrupt_event(handle, L3GD20H_INTERRUPT_EVENT_LATCH, &config->latch);
+    res |= l3gd20h_get_counter_mode(handle, &config->counter_mode);
+    res |= l3gd20h_get_wait(handle, &config->wait);
+    res |= l3gd20h_get_duration(handle, &config->duration);
+    res |= l3gd20h_get_interrupt_selection(handle, &config->selection);
+    res |= l3gd20h_get_high_pass_filter_mode(handle, &config->mode);
+    res |= l3gd20h_get_high_pass_filter_cut_off_frequency(handle, &config->cut_off);
+
+    return (res != 0) ? 1 : 0;
+}
+
+uint8_t l3gd20h_ig_write_config(l3gd20h_handle_t *handle, const l3gd20h_ig_config_t *config)
+{
+    uint8_t res;
+    uint8_t i;
+
+    if ((handle == NULL) || (config == NULL))
+    {
+        return 2;
+    }
+
+    res = l3gd20h_set_x_interrupt_threshold(handle, config->threshold[0]);
+    res |= l3gd20h_set_y_interrupt_threshold(handle, config->threshold[1]);
+    res |= l3gd20h_set_z_interrupt_threshold(handle, config->threshold[2]);
+    for (i = 0; i < 6; i++)
+    {
+        res |= l3gd20h_set_interrupt_event(handle, (l3gd20h_interrupt_event_t)i,
+                                           ((config->event & (1 << i)) != 0) ? L3GD20H_BOOL_TRUE : L3GD20H_BOOL_FALSE);
+    }
+    res |= l3gd20h_set_interrupt_event(handle, L3GD20H_INTERRUPT_EVENT_AND_OR_COMBINATION, config->and_or);
+    res |= l3gd20h_set_interrupt_event(handle, L3GD20H_INTERRUPT_EVENT_LATCH, config->latch);
+    res |= l3gd20h_set_counter_mode(handle, config->counter_mode);
+    res |= l3gd20h_set_wait(handle, config->wait);
+    res |= l3gd20h_set_duration(handle, config->duration);
+    res |= l3gd20h_set_interrupt_selection(handle, config->selection);
+    res |= l3gd20h_set_high_pass_filter_mode(handle, config->mode);
+    res |= l3gd20h_set_high_pass_filter_cut_off_frequency(handle, config->cut_off);
+
+    return (res != 0) ? 1 : 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_ig.h
+ * @brief     driver l3gd20h ig header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_IG_H
+#define DRIVER_L3GD20H_IG_H
+
+#include "driver_l3gd20h_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h ig definition
+ * @note  the high pass filter keeps L3GD20H_IG_HPF_SHIFT fraction bits between two samples
+ */
+#define L3GD20H_IG_HPF_SHIFT    8        /**< fraction bits of the high pass filter state */
+
+/**
+ * @brief l3gd20h ig config structure definition
+ * @note  the fields follow the interrupt generator registers, bit n of event enables the
+ *        l3gd20h_interrupt_event_t n
+ */
+typedef struct l3gd20h_ig_config_s
+{
+    uint16_t threshold[3];                                    /**< x, y and z thresholds in lsb */
+    uint8_t event;                                            /**< enabled low and high events */
+    l3gd20h_bool_t and_or;                                    /**< and combination of the events */
+    l3gd20h_bool_t latch;                                     /**< keep the source until it is read */
+    l3gd20h_counter_mode_t counter_mode;                      /**< duration counter mode */
+    l3gd20h_bool_t wait;                                      /**< keep the interrupt for the duration */
+    uint8_t duration;                                         /**< duration in samples */
+    l3gd20h_selection_t selection;                            /**< interrupt data path */
+    l3gd20h_high_pass_filter_mode_t mode;                     /**< high pass filter mode */
+    l3gd20h_high_pass_filter_cut_off_frequency_t cut_off;     /**< high pass filter cut off */
+} l3gd20h_ig_config_t;
+
+/**
+ * @brief l3gd20h ig structure definition
+ * @note  the state follows the interrupt source register and the two duration counters of the chip
+ */
+typedef struct l3gd20h_ig_s
+{
+    l3gd20h_ig_config_t config;        /**< config */
+    int32_t alpha;                     /**< q15 pole of the high pass filter */
+    int32_t in[3];                     /**< previous high pass filter input */
+    int32_t out[3];                    /**< high pass filter output with the fraction bits */
+    uint8_t src;                       /**< interrupt source register */
+    uint8_t on;                        /**< samples with the condition true */
+    uint8_t off;                       /**< samples with the condition false */
+    uint8_t started;                   /**< high pass filter input flag */
+    uint32_t samples;                  /**< fed samples */
+    uint32_t edges;                    /**< int1 level changes */
+    uint32_t rises;                    /**< int1 rising edges */
+} l3gd20h_ig_t;
+
+/**
+ * @brief     init an interrupt generator model
+ * @param[in] *ig pointer to an ig structure
+ * @param[in] *config pointer to a config structure
+ * @param[in] odr output data rate in hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 ig or config is NULL
+ *            - 4 config is invalid
+ *            - 5 odr is invalid
+ * @note      the model covers the lpf1 and the lpf1->hpf paths in the normal modes of the high pass
+ *            filter, the lpf2 corner depends on the bandwidth and the reference mode on the reference
+ *            register so both are rejected, the output data rate picks the column of the cut off table
+ */
+uint8_t l3gd20h_ig_init(l3gd20h_ig_t *ig, const l3gd20h_ig_config_t *config, float odr);
+
+/**
+ * @brief      run the interrupt generator model over a sample stream
+ * @param[in]  *ig pointer to an ig structure
+ * @param[in]  **raw pointer to a raw data buffer
+ * @param[in]  len sample number
+ * @param[out] *int1 pointer to an int1 level buffer with one entry per sample, NULL skips the levels
+ * @return     status code
+ *             - 0 success
+ *             - 2 ig is NULL
+ * @note       the raw data is the lpf1 output as read with the lpf1 out selection, every sample runs
+ *             the generator like the chip does on its data ready
+ */
+uint8_t l3gd20h_ig_feed(l3gd20h_ig_t *ig, const int16_t (*raw)[3], uint16_t len, uint8_t *int1);
+
+/**
+ * @brief      read the interrupt source of the model
+ * @param[in]  *ig pointer to an ig structure
+ * @param[out] *src pointer to a source buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ig is NULL
+ * @note       the read releases a latched interrupt like a read of the interrupt source register
+ */
+uint8_t l3gd20h_ig_get_source(l3gd20h_ig_t *ig, uint8_t *src);
+
+/**
+ * @brief      read the interrupt generator config of a chip
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *config pointer to a config structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle or config is NULL
+ * @note       none
+ */
+uint8_t l3gd20h_ig_read_config(l3gd20h_handle_t *handle, l3gd20h_ig_config_t *config);
+
+/**
+ * @brief     write an interrupt generator config to a chip
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle or config is NULL
+ * @note      the int1 pin routing is left to the caller
+ */
+uint8_t l3gd20h_ig_write_config(l3gd20h_handle_t *handle, const l3gd20h_ig_config_t *config);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
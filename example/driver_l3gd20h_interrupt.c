@@ -167,6 +167,7 @@ uint8_t l3gd20h_interrupt_init(l3gd20h_interface_t interface, l3gd20h_address_t
     DRIVER_L3GD20H_LINK_SPI_WRITE(&gs_handle, l3gd20h_interface_spi_write);
     DRIVER_L3GD20H_LINK_DELAY_MS(&gs_handle, l3gd20h_interface_delay_ms);
     DRIVER_L3GD20H_LINK_DEBUG_PRINT(&gs_handle, l3gd20h_interface_debug_print);
+    DRIVER_L3GD20H_LINK_TIMESTAMP_US(&gs_handle, l3gd20h_interface_timestamp_us);
     DRIVER_L3GD20H_LINK_RECEIVE_CALLBACK(&gs_handle, a_l3gd20h_interface_receive_callback);
     
     /* set the interface */
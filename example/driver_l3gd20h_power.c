@@ -0,0 +1,295 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_power.c
+ * @brief     driver l3gd20h power source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_power.h"
+
+/**
+ * @brief     enter the watch state
+ * @param[in] *power pointer to a power structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus failed
+ * @note      bypass flushes the fifo, the interrupt source is read before the stream to fifo mode so a
+ *            latch from the active state can not freeze the new history
+ */
+static uint8_t a_l3gd20h_power_watch(l3gd20h_power_t *power)
+{
+    uint8_t res;
+    uint8_t src;
+
+    res = l3gd20h_set_fifo_threshold_on_interrupt2(power->handle, L3GD20H_BOOL_FALSE);
+    res |= l3gd20h_set_fifo_mode(power->handle, L3GD20H_FIFO_MODE_BYPASS);
+    res |= l3gd20h_set_rate_bandwidth(power->handle, power->config.watch_rate);
+    res |= l3gd20h_get_interrupt_source(power->handle, &src);
+    res |= l3gd20h_set_fifo_mode(power->handle, L3GD20H_FIFO_MODE_STREAM_TO_FIFO);
+    res |= l3gd20h_set_interrupt1(power->handle, L3GD20H_BOOL_TRUE);
+    if (res != 0)
+    {
+        return 1;
+    }
+    power->state = L3GD20H_POWER_STATE_WATCH;
+    power->quiet = 0;
+
+    return 0;
+}
+
+/**
+ * @brief     enter the active state
+ * @param[in] *power pointer to a power structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus failed
+ * @note      the frozen fifo is drained before the call
+ */
+static uint8_t a_l3gd20h_power_active(l3gd20h_power_t *power)
+{
+    uint8_t res;
+
+    res = l3gd20h_set_interrupt1(power->handle, L3GD20H_BOOL_FALSE);
+    res |= l3gd20h_set_fifo_mode(power->handle, L3GD20H_FIFO_MODE_BYPASS);
+    res |= l3gd20h_set_rate_bandwidth(power->handle, power->config.active_rate);
+    res |= l3gd20h_set_fifo_mode(power->handle, L3GD20H_FIFO_MODE_STREAM);
+    res |= l3gd20h_set_fifo_threshold_on_interrupt2(power->handle, L3GD20H_BOOL_TRUE);
+    if (res != 0)
+    {
+        return 1;
+    }
+    power->state = L3GD20H_POWER_STATE_ACTIVE;
+    power->quiet = 0;
+
+    return 0;
+}
+
+/**
+ * @brief      drain the fifo into the callback
+ * @param[in]  *power pointer to a power structure
+ * @param[out] *len pointer to a drained sample number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_l3gd20h_power_drain(l3gd20h_power_t *power, uint16_t *len)
+{
+    *len = L3GD20H_POWER_BATCH;
+    if (l3gd20h_read(power->handle, power->raw, power->dps, len) != 0)
+    {
+        return 1;
+    }
+    if (*len != 0)
+    {
+        power->callback((l3gd20h_power_state_t)power->state, power->raw, power->dps, *len);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     init a power controller and enter the watch state
+ * @param[in] *power pointer to a power structure
+ * @param[in] *handle pointer to an initialized l3gd20h handle structure
+ * @param[in] *config pointer to a config structure
+ * @param[in] *callback pointer to a batch callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus failed
+ *            - 2 power, handle or config is NULL
+ *            - 4 config is invalid
+ * @note      the controller owns the rate, the fifo, the interrupt generator thresholds and events,
+ *            the int1 routing and the fifo threshold routing on int2, the full scale and the interrupt
+ *            data path are left to the caller, the watch state samples at watch_rate, usually the 12.5 Hz
+ *            low output data rate, instead of the chip sleep mode, because the sleep mode turns the axes
+ *            off and the interrupt generator has no sample to compare with the wake threshold
+ */
+uint8_t l3gd20h_power_init(l3gd20h_power_t *power, l3gd20h_handle_t *handle, const l3gd20h_power_config_t *config,
+                           void (*callback)(l3gd20h_power_state_t state, int16_t (*raw)[3], float (*dps)[3],
+                                            uint16_t len))
+{
+    uint8_t res;
+    uint8_t i;
+    uint16_t ths;
+
+    if ((power == NULL) || (handle == NULL) || (config == NULL))
+    {
+        return 2;
+    }
+    if (!(config->wake_dps > 0.0f) || !(config->quiet_dps >= 0.0f) || !(config->quiet_dps < config->wake_dps) ||
+        (config->wake_samples > 0x7F) || (config->quiet_samples == 0) ||
+        (config->watermark == 0) || (config->watermark > 31) || (callback == NULL))
+    {
+        return 4;
+    }
+    if (l3gd20h_interrupt_threshold_convert_to_register(handle, config->wake_dps, &ths) != 0)
+    {
+        return 1;
+    }
+    if (ths > 0x7FFF)
+    {
+        return 4;
+    }
+
+    memset(power, 0, sizeof(l3gd20h_power_t));
+    power->handle = handle;
+    power->config = *config;
+    power->callback = callback;
+
+    /* any axis above the wake threshold for wake_samples samples latches int1, the high events are or combined */
+    res = l3gd20h_set_x_interrupt_threshold(handle, ths);
+    res |= l3gd20h_set_y_interrupt_threshold(handle, ths);
+    res |= l3gd20h_set_z_interrupt_threshold(handle, ths);
+    for (i = 0; i < 6; i++)
+    {
+        res |= l3gd20h_set_interrupt_event(handle, (l3gd20h_interrupt_event_t)i,
+                                           ((i & 1) != 0) ? L3GD20H_BOOL_TRUE : L3GD20H_BOOL_FALSE);
+    }
+    res |= l3gd20h_set_interrupt_event(handle, L3GD20H_INTERRUPT_EVENT_AND_OR_COMBINATION, L3GD20H_BOOL_FALSE);
+    res |= l3gd20h_set_interrupt_event(handle, L3GD20H_INTERRUPT_EVENT_LATCH, L3GD20H_BOOL_TRUE);
+    res |= l3gd20h_set_counter_mode(handle, L3GD20H_COUNTER_MODE_RESET);
+    res |= l3gd20h_set_wait(handle, L3GD20H_BOOL_FALSE);
+    res |= l3gd20h_set_duration(handle, config->wake_samples);
+    res |= l3gd20h_set_fifo_threshold(handle, config->watermark);
+    res |= l3gd20h_set_fifo(handle, L3GD20H_BOOL_TRUE);
+    if (res != 0)
+    {
+        return 1;
+    }
+
+    return a_l3gd20h_power_watch(power);
+}
+
+/**
+ * @brief     power controller interrupt handler
+ * @param[in] *power pointer to a power structure
+ * @param[in] num interrupt pin, 1 or 2
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus failed
+ *            - 2 power is NULL
+ *            - 4 num is invalid
+ * @note      call it on an active int1 in the watch state and on an active int2 in the active state,
+ *            an int1 drains the frozen fifo with the history before the wake and ramps to the active
+ *            rate, an int2 drains the watermark and returns to the watch state after quiet_samples
+ *            samples below quiet_dps, a pin that does not belong to the state is ignored
+ */
+uint8_t l3gd20h_power_irq_handler(l3gd20h_power_t *power, uint8_t num)
+{
+    uint8_t src;
+    uint16_t len;
+    uint16_t i;
+    uint8_t j;
+    float peak;
+    float v;
+
+    if (power == NULL)
+    {
+        return 2;
+    }
+    if ((num != 1) && (num != 2))
+    {
+        return 4;
+    }
+
+    if ((num == 1) && (power->state == L3GD20H_POWER_STATE_WATCH))
+    {
+        /* the source read releases the latch, the fifo stays frozen until the mode changes */
+        if (l3gd20h_get_interrupt_source(power->handle, &src) != 0)
+        {
+            return 1;
+        }
+        if ((src & (1 << 6)) == 0)
+        {
+            return 0;
+        }
+        power->batches++;
+        if (a_l3gd20h_power_drain(power, &len) != 0)
+        {
+            return 1;
+        }
+        power->pretrigger += len;
+        power->wakes++;
+
+        return a_l3gd20h_power_active(power);
+    }
+    if ((num == 2) && (power->state == L3GD20H_POWER_STATE_ACTIVE))
+    {
+        power->batches++;
+        if (a_l3gd20h_power_drain(power, &len) != 0)
+        {
+            return 1;
+        }
+
+        /* a loud sample restarts the quiet hold */
+        for (i = 0; i < len; i++)
+        {
+            peak = 0.0f;
+            for (j = 0; j < 3; j++)
+            {
+                v = (power->dps[i][j] < 0.0f) ? -power->dps[i][j] : power->dps[i][j];
+                peak = (v > peak) ? v : peak;
+            }
+            power->quiet = (peak < power->config.quiet_dps) ? (power->quiet + 1) : 0;
+        }
+        if (power->quiet >= power->config.quiet_samples)
+        {
+            power->watches++;
+
+            return a_l3gd20h_power_watch(power);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      get the power state
+ * @param[in]  *power pointer to a power structure
+ * @param[out] *state pointer to a state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 power is NULL
+ * @note       none
+ */
+uint8_t l3gd20h_power_get_state(l3gd20h_power_t *power, l3gd20h_power_state_t *state)
+{
+    if (power == NULL)
+    {
+        return 2;
+    }
+
+    *state = (l3gd20h_power_state_t)power->state;
+
+    return 0;
+}
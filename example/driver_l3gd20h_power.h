@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_power.h
+ * @brief     driver l3gd20h power header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_POWER_H
+#define DRIVER_L3GD20H_POWER_H
+
+#include "driver_l3gd20h_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h power definition
+ */
+#define L3GD20H_POWER_BATCH    32        /**< samples drained in one read */
+
+/**
+ * @brief l3gd20h power state enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_POWER_STATE_WATCH  = 0x00,        /**< watch rate, stream to fifo and int1 wake */
+    L3GD20H_POWER_STATE_ACTIVE = 0x01,        /**< active rate, stream and int2 watermark */
+} l3gd20h_power_state_t;
+
+/**
+ * @brief l3gd20h power config structure definition
+ * @note  the wake threshold runs in the interrupt generator at the watch rate, the quiet threshold on
+ *        the drained batches at the active rate, quiet_dps < wake_dps gives the hysteresis
+ */
+typedef struct l3gd20h_power_config_s
+{
+    l3gd20h_lodr_odr_bw_t watch_rate;         /**< rate bandwidth of the watch state */
+    l3gd20h_lodr_odr_bw_t active_rate;        /**< rate bandwidth of the active state */
+    float wake_dps;                           /**< wake threshold of every axis in dps */
+    uint8_t wake_samples;                     /**< watch samples above wake_dps before a wake */
+    float quiet_dps;                          /**< quiet threshold of every axis in dps */
+    uint32_t quiet_samples;                   /**< active samples below quiet_dps before a watch */
+    uint8_t watermark;                        /**< fifo threshold of the active state */
+} l3gd20h_power_config_t;
+
+/**
+ * @brief l3gd20h power structure definition
+ * @note  the callback gets every drained batch with the state it was sampled in, the watch batch
+ *        is the frozen fifo and carries the samples before the wake
+ */
+typedef struct l3gd20h_power_s
+{
+    l3gd20h_handle_t *handle;                                 /**< driver handle */
+    l3gd20h_power_config_t config;                            /**< config */
+    void (*callback)(l3gd20h_power_state_t state,
+                     int16_t (*raw)[3], float (*dps)[3],
+                     uint16_t len);                           /**< batch callback */
+    int16_t raw[L3GD20H_POWER_BATCH][3];                      /**< raw data buffer */
+    float dps[L3GD20H_POWER_BATCH][3];                        /**< converted data buffer */
+    uint8_t state;                                            /**< l3gd20h_power_state_t */
+    uint32_t quiet;                                           /**< active samples below quiet_dps */
+    uint32_t wakes;                                           /**< watch to active switches */
+    uint32_t watches;                                         /**< active to watch switches */
+    uint32_t pretrigger;                                      /**< samples delivered by the wakes */
+    uint32_t batches;                                         /**< serviced interrupts */
+} l3gd20h_power_t;
+
+/**
+ * @brief     init a power controller and enter the watch state
+ * @param[in] *power pointer to a power structure
+ * @param[in] *handle pointer to an initialized l3gd20h handle structure
+ * @param[in] *config pointer to a config structure
+ * @param[in] *callback pointer to a batch callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus failed
+ *            - 2 power, handle or config is NULL
+ *            - 4 config is invalid
+ * @note      the controller owns the rate, the fifo, the interrupt generator thresholds and events,
+ *            the int1 routing and the fifo threshold routing on int2, the full scale and the interrupt
+ *            data path are left to the caller, the watch state samples at watch_rate, usually the 12.5 Hz
+ *            low output data rate, instead of the chip sleep mode, because the sleep mode turns the axes
+ *            off and the interrupt generator has no sample to compare with the wake threshold
+ */
+uint8_t l3gd20h_power_init(l3gd20h_power_t *power, l3gd20h_handle_t *handle, const l3gd20h_power_config_t *config,
+                           void (*callback)(l3gd20h_power_state_t state, int16_t (*raw)[3], float (*dps)[3],
+                                            uint16_t len));
+
+/**
+ * @brief     power controller interrupt handler
+ * @param[in] *power pointer to a power structure
+ * @param[in] num interrupt pin, 1 or 2
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus failed
+ *            - 2 power is NULL
+ *            - 4 num is invalid
+ * @note      call it on an active int1 in the watch state and on an active int2 in the active state,
+ *            an int1 drains the frozen fifo with the history before the wake and ramps to the active
+ *            rate, an int2 drains the watermark and returns to the watch state after quiet_samples
+ *            samples below quiet_dps, a pin that does not belong to the state is ignored
+ */
+uint8_t l3gd20h_power_irq_handler(l3gd20h_power_t *power, uint8_t num);
+
+/**
+ * @brief      get the power state
+ * @param[in]  *power pointer to a power structure
+ * @param[out] *state pointer to a state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 power is NULL
+ * @note       none
+ */
+uint8_t l3gd20h_power_get_state(l3gd20h_power_t *power, l3gd20h_power_state_t *state);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
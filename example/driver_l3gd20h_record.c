@@ -0,0 +1,602 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_l3gd20h_record.c
+ * @brief     driver l3gd20h record source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_record.h"
+#include <stdlib.h>
+
+/**
+ * @brief record header length definition
+ */
+#define L3GD20H_RECORD_HEADER_LEN        8        /**< magic, version and reserved bytes */
+
+static FILE *gs_record_file = NULL;                   /**< record file */
+static l3gd20h_record_bus_t gs_record_bus;            /**< real bus hooks */
+static uint64_t gs_record_last_us = 0;                /**< time of the previous transaction */
+static uint8_t *gs_replay_buf = NULL;                 /**< replay file content */
+static size_t gs_replay_len = 0;                      /**< replay file length */
+static size_t gs_replay_pos = 0;                      /**< next record offset */
+static uint64_t gs_replay_us = 0;                     /**< time of the last served record */
+static l3gd20h_replay_mode_t gs_replay_mode;          /**< replay mode */
+
+/**
+ * @brief     write an unsigned leb128 number
+ * @param[in] value number
+ * @note      none
+ */
+static void a_l3gd20h_record_varint(uint64_t value)
+{
+    uint8_t b[10];
+    uint8_t n = 0;
+
+    do
+    {
+        b[n] = (uint8_t)(value & 0x7F);
+        value >>= 7;
+        if (value != 0)
+        {
+            b[n] |= 0x80;
+        }
+        n++;
+    } while (value != 0);
+    (void)fwrite(b, 1, n, gs_record_file);
+}
+
+/**
+ * @brief     append one transaction
+ * @param[in] kind record kind
+ * @param[in] addr iic device write address
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @note      none
+ */
+static void a_l3gd20h_record_put(uint8_t kind, uint8_t addr, uint8_t reg, const uint8_t *buf, uint16_t len)
+{
+    uint64_t now;
+    uint64_t dt;
+
+    if (gs_record_file == NULL)
+    {
+        return;
+    }
+
+    /* time since the previous transaction */
+    now = (gs_record_bus.timestamp_us != NULL) ? gs_record_bus.timestamp_us() : 0;
+    dt = (now > gs_record_last_us) ? (now - gs_record_last_us) : 0;
+    gs_record_last_us = now;
+
+    (void)fputc(kind, gs_record_file);
+    if ((kind & L3GD20H_RECORD_KIND_SPI) == 0)
+    {
+        (void)fputc(addr, gs_record_file);
+    }
+    (void)fputc(reg, gs_record_file);
+    a_l3gd20h_record_varint(len);
+    a_l3gd20h_record_varint(dt);
+    if ((kind & L3GD20H_RECORD_KIND_ERROR) == 0)
+    {
+        (void)fwrite(buf, 1, len, gs_record_file);
+    }
+}
+
+/**
+ * @brief     record example init
+ * @param[in] *path pointer to a file path
+ * @param[in] *bus pointer to the real bus hooks
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      link the l3gd20h_record_* hooks to the handle instead of the real hooks
+ */
+uint8_t l3gd20h_record_init(const char *path, const l3gd20h_record_bus_t *bus)
+{
+    const uint8_t header[L3GD20H_RECORD_HEADER_LEN] = {'L', '3', 'G', 'R', L3GD20H_RECORD_VERSION, 0, 0, 0};
+
+    if ((path == NULL) || (bus == NULL) || (gs_record_file != NULL))
+    {
+        return 1;
+    }
+
+    /* open the file */
+    gs_record_file = fopen(path, "wb");
+    if (gs_record_file == NULL)
+    {
+        return 1;
+    }
+    (void)setvbuf(gs_record_file, NULL, _IOFBF, 64 * 1024);
+    if (fwrite(header, 1, L3GD20H_RECORD_HEADER_LEN, gs_record_file) != L3GD20H_RECORD_HEADER_LEN)
+    {
+        (void)fclose(gs_record_file);
+        gs_record_file = NULL;
+
+        return 1;
+    }
+
+    /* save the real hooks */
+    memcpy(&gs_record_bus, bus, sizeof(l3gd20h_record_bus_t));
+    gs_record_last_us = (gs_record_bus.timestamp_us != NULL) ? gs_record_bus.timestamp_us() : 0;
+
+    return 0;
+}
+
+/**
+ * @brief  record example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t l3gd20h_record_deinit(void)
+{
+    uint8_t res;
+
+    if (gs_record_file == NULL)
+    {
+        return 1;
+    }
+    res = (fclose(gs_record_file) != 0) ? 1 : 0;
+    gs_record_file = NULL;
+
+    return res;
+}
+
+/**
+ * @brief      record iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t l3gd20h_record_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+
+    if (gs_record_bus.iic_read == NULL)
+    {
+        return 1;
+    }
+    res = gs_record_bus.iic_read(addr, reg, buf, len);
+    a_l3gd20h_record_put((uint8_t)(L3GD20H_RECORD_KIND_READ | ((res != 0) ? L3GD20H_RECORD_KIND_ERROR : 0)),
+                         addr, reg, buf, len);
+
+    return res;
+}
+
+/**
+ * @brief     record iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t l3gd20h_record_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+
+    if (gs_record_bus.iic_write == NULL)
+    {
+        return 1;
+    }
+    res = gs_record_bus.iic_write(addr, reg, buf, len);
+    a_l3gd20h_record_put((uint8_t)((res != 0) ? L3GD20H_RECORD_KIND_ERROR : 0), addr, reg, buf, len);
+
+    return res;
+}
+
+/**
+ * @brief      record spi bus read
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t l3gd20h_record_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+
+    if (gs_record_bus.spi_read == NULL)
+    {
+        return 1;
+    }
+    res = gs_record_bus.spi_read(reg, buf, len);
+    a_l3gd20h_record_put((uint8_t)(L3GD20H_RECORD_KIND_READ | L3GD20H_RECORD_KIND_SPI |
+                                   ((res != 0) ? L3GD20H_RECORD_KIND_ERROR : 0)), 0x00, reg, buf, len);
+
+    return res;
+}
+
+/**
+ * @brief     record spi bus write
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t l3gd20h_record_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+
+    if (gs_record_bus.spi_write == NULL)
+    {
+        return 1;
+    }
+    res = gs_record_bus.spi_write(reg, buf, len);
+    a_l3gd20h_record_put((uint8_t)(L3GD20H_RECORD_KIND_SPI | ((res != 0) ? L3GD20H_RECORD_KIND_ERROR : 0)),
+                         0x00, reg, buf, len);
+
+    return res;
+}
+
+/**
+ * @brief      read an unsigned leb128 number
+ * @param[in]  *pos pointer to a file offset
+ * @param[out] *value pointer to a number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 truncated file
+ * @note       none
+ */
+static uint8_t a_l3gd20h_replay_varint(size_t *pos, uint64_t *value)
+{
+    uint8_t shift = 0;
+
+    *value = 0;
+    while (*pos < gs_replay_len)
+    {
+        uint8_t b;
+
+        b = gs_replay_buf[(*pos)++];
+        *value |= (uint64_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+        {
+            return 0;
+        }
+        shift += 7;
+        if (shift > 63)
+        {
+            return 1;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief      serve one transaction
+ * @param[in]  kind expected record kind without the error bit
+ * @param[in]  addr iic device write address
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no matching record or the recorded hook failed
+ * @note       reads copy the recorded payload, writes are compared with it
+ */
+static uint8_t a_l3gd20h_replay_get(uint8_t kind, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    size_t pos;
+
+    if (gs_replay_buf == NULL)
+    {
+        return 1;
+    }
+
+    pos = gs_replay_pos;
+    while (pos < gs_replay_len)
+    {
+        uint8_t rkind;
+        uint8_t raddr = 0x00;
+        uint8_t rreg;
+        uint64_t rlen;
+        uint64_t dt;
+        size_t payload;
+        uint8_t match;
+
+        /* parse the record */
+        rkind = gs_replay_buf[pos++];
+        if ((rkind & L3GD20H_RECORD_KIND_SPI) == 0)
+        {
+            if (pos >= gs_replay_len)
+            {
+                return 1;
+            }
+            raddr = gs_replay_buf[pos++];
+        }
+        if (pos >= gs_replay_len)
+        {
+            return 1;
+        }
+        rreg = gs_replay_buf[pos++];
+        if ((a_l3gd20h_replay_varint(&pos, &rlen) != 0) || (a_l3gd20h_replay_varint(&pos, &dt) != 0))
+        {
+            return 1;
+        }
+        payload = pos;
+        if ((rkind & L3GD20H_RECORD_KIND_ERROR) == 0)
+        {
+            if (rlen > gs_replay_len - pos)
+            {
+                return 1;
+            }
+            pos += (size_t)rlen;
+        }
+        gs_replay_us += dt;
+
+        /* check the record */
+        match = ((rkind & (uint8_t)~L3GD20H_RECORD_KIND_ERROR) == kind) && (raddr == addr) &&
+                (rreg == reg) && (rlen == len);
+        if ((match != 0) && ((kind & L3GD20H_RECORD_KIND_READ) == 0) &&
+            ((rkind & L3GD20H_RECORD_KIND_ERROR) == 0))
+        {
+            match = (memcmp(&gs_replay_buf[payload], buf, len) == 0) ? 1 : 0;
+        }
+        if (match != 0)
+        {
+            gs_replay_pos = pos;
+            if ((rkind & L3GD20H_RECORD_KIND_ERROR) != 0)
+            {
+                return 1;
+            }
+            if ((kind & L3GD20H_RECORD_KIND_READ) != 0)
+            {
+                memcpy(buf, &gs_replay_buf[payload], len);
+            }
+
+            return 0;
+        }
+
+        /* strict replay stops at the first mismatch, seek ignores an unmatched write */
+        if (gs_replay_mode == L3GD20H_REPLAY_MODE_STRICT)
+        {
+            return 1;
+        }
+        if ((kind & L3GD20H_RECORD_KIND_READ) == 0)
+        {
+            return 0;
+        }
+        gs_replay_pos = pos;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief     replay example init
+ * @param[in] *path pointer to a file path
+ * @param[in] mode replay mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the whole file is loaded into memory so the replay runs without file access
+ */
+uint8_t l3gd20h_replay_init(const char *path, l3gd20h_replay_mode_t mode)
+{
+    FILE *f;
+    long size;
+
+    if ((path == NULL) || (gs_replay_buf != NULL))
+    {
+        return 1;
+    }
+
+    /* load the file */
+    f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        return 1;
+    }
+    if ((fseek(f, 0, SEEK_END) != 0) || ((size = ftell(f)) < L3GD20H_RECORD_HEADER_LEN) ||
+        (fseek(f, 0, SEEK_SET) != 0))
+    {
+        (void)fclose(f);
+
+        return 1;
+    }
+    gs_replay_buf = (uint8_t *)malloc((size_t)size);
+    if (gs_replay_buf == NULL)
+    {
+        (void)fclose(f);
+
+        return 1;
+    }
+    if (fread(gs_replay_buf, 1, (size_t)size, f) != (size_t)size)
+    {
+        (void)fclose(f);
+        (void)l3gd20h_replay_deinit();
+
+        return 1;
+    }
+    (void)fclose(f);
+
+    /* check the header */
+    if ((memcmp(gs_replay_buf, L3GD20H_RECORD_MAGIC, 4) != 0) || (gs_replay_buf[4] != L3GD20H_RECORD_VERSION))
+    {
+        (void)l3gd20h_replay_deinit();
+
+        return 1;
+    }
+    gs_replay_len = (size_t)size;
+    gs_replay_mode = mode;
+
+    return l3gd20h_replay_rewind();
+}
+
+/**
+ * @brief  replay example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t l3gd20h_replay_deinit(void)
+{
+    if (gs_replay_buf == NULL)
+    {
+        return 1;
+    }
+    free(gs_replay_buf);
+    gs_replay_buf = NULL;
+    gs_replay_len = 0;
+    gs_replay_pos = 0;
+
+    return 0;
+}
+
+/**
+ * @brief  replay example rewind
+ * @return status code
+ *         - 0 success
+ *         - 1 rewind failed
+ * @note   none
+ */
+uint8_t l3gd20h_replay_rewind(void)
+{
+    if (gs_replay_buf == NULL)
+    {
+        return 1;
+    }
+    gs_replay_pos = L3GD20H_RECORD_HEADER_LEN;
+    gs_replay_us = 0;
+
+    return 0;
+}
+
+/**
+ * @brief  check if every record is served
+ * @return 1 if the replay is finished
+ * @note   none
+ */
+uint8_t l3gd20h_replay_finished(void)
+{
+    return (gs_replay_pos >= gs_replay_len) ? 1 : 0;
+}
+
+/**
+ * @brief  get the recorded time of the last served transaction
+ * @return time in us
+ * @note   none
+ */
+uint64_t l3gd20h_replay_timestamp_us(void)
+{
+    return gs_replay_us;
+}
+
+/**
+ * @brief      replay iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t l3gd20h_replay_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return a_l3gd20h_replay_get(L3GD20H_RECORD_KIND_READ, addr, reg, buf, len);
+}
+
+/**
+ * @brief     replay iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t l3gd20h_replay_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return a_l3gd20h_replay_get(0x00, addr, reg, buf, len);
+}
+
+/**
+ * @brief      replay spi bus read
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t l3gd20h_replay_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return a_l3gd20h_replay_get(L3GD20H_RECORD_KIND_READ | L3GD20H_RECORD_KIND_SPI, 0x00, reg, buf, len);
+}
+
+/**
+ * @brief     replay spi bus write
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t l3gd20h_replay_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return a_l3gd20h_replay_get(L3GD20H_RECORD_KIND_SPI, 0x00, reg, buf, len);
+}
+
+/**
+ * @brief     replay delay ms
+ * @param[in] ms time
+ * @note      the replay never waits
+ */
+void l3gd20h_replay_delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_l3gd20h_record.h
+ * @brief     driver l3gd20h record header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_RECORD_H
+#define DRIVER_L3GD20H_RECORD_H
+
+#include "driver_l3gd20h_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h record file definition
+ * @note  the file starts with the 4 byte magic, the version byte and 3 reserved bytes, every transaction is
+ *        stored as a kind byte, the iic address byte for iic, the register byte, the length and the time
+ *        since the previous transaction in us as unsigned leb128 and the payload of writes and successful reads
+ */
+#define L3GD20H_RECORD_MAGIC          "L3GR"        /**< file magic */
+#define L3GD20H_RECORD_VERSION        0x01          /**< file version */
+
+/**
+ * @brief l3gd20h record kind definition
+ */
+#define L3GD20H_RECORD_KIND_READ         (1 << 0)        /**< read transaction, else write */
+#define L3GD20H_RECORD_KIND_SPI          (1 << 1)        /**< spi transaction, else iic */
+#define L3GD20H_RECORD_KIND_ERROR        (1 << 2)        /**< the hook returned an error */
+
+/**
+ * @brief l3gd20h replay mode enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_REPLAY_MODE_STRICT = 0x00,        /**< every transaction must match the next record */
+    L3GD20H_REPLAY_MODE_SEEK   = 0x01,        /**< reads skip to the next matching record, unmatched writes are ignored */
+} l3gd20h_replay_mode_t;
+
+/**
+ * @brief l3gd20h record bus structure definition
+ */
+typedef struct l3gd20h_record_bus_s
+{
+    uint8_t (*iic_read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< point to an iic_read function address */
+    uint8_t (*iic_write)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< point to an iic_write function address */
+    uint8_t (*spi_read)(uint8_t reg, uint8_t *buf, uint16_t len);                       /**< point to a spi_read function address */
+    uint8_t (*spi_write)(uint8_t reg, uint8_t *buf, uint16_t len);                      /**< point to a spi_write function address */
+    uint64_t (*timestamp_us)(void);                                                     /**< point to a timestamp function address, NULL stores zero times */
+} l3gd20h_record_bus_t;
+
+/**
+ * @brief     record example init
+ * @param[in] *path pointer to a file path
+ * @param[in] *bus pointer to the real bus hooks
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      link the l3gd20h_record_* hooks to the handle instead of the real hooks
+ */
+uint8_t l3gd20h_record_init(const char *path, const l3gd20h_record_bus_t *bus);
+
+/**
+ * @brief  record example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t l3gd20h_record_deinit(void);
+
+/**
+ * @brief      record iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t l3gd20h_record_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     record iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t l3gd20h_record_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      record spi bus read
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t l3gd20h_record_spi_read(uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     record spi bus write
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t l3gd20h_record_spi_write(uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     replay example init
+ * @param[in] *path pointer to a file path
+ * @param[in] mode replay mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the whole file is loaded into memory so the replay runs without file access
+ */
+uint8_t l3gd20h_replay_init(const char *path, l3gd20h_replay_mode_t mode);
+
+/**
+ * @brief  replay example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t l3gd20h_replay_deinit(void);
+
+/**
+ * @brief  replay example rewind
+ * @return status code
+ *         - 0 success
+ *         - 1 rewind failed
+ * @note   none
+ */
+uint8_t l3gd20h_replay_rewind(void);
+
+/**
+ * @brief  check if every record is served
+ * @return 1 if the replay is finished
+ * @note   none
+ */
+uint8_t l3gd20h_replay_finished(void);
+
+/**
+ * @brief  get the recorded time of the last served transaction
+ * @return time in us
+ * @note   none
+ */
+uint64_t l3gd20h_replay_timestamp_us(void);
+
+/**
+ * @brief      replay iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t l3gd20h_replay_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     replay iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t l3gd20h_replay_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      replay spi bus read
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t l3gd20h_replay_spi_read(uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     replay spi bus write
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t l3gd20h_replay_spi_write(uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     replay delay ms
+ * @param[in] ms time
+ * @note      the replay never waits
+ */
+void l3gd20h_replay_delay_ms(uint32_t ms);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,276 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_rotate.c
+ * @brief     driver l3gd20h rotate source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_rotate.h"
+#include "driver_l3gd20h_vec.h"
+
+/**
+ * @brief         rotate one block of samples
+ * @param[in]     *rot pointer to a rotate structure
+ * @param[in,out] *x pointer to L3GD20H_VEC_LANES x samples
+ * @param[in,out] *y pointer to L3GD20H_VEC_LANES y samples
+ * @param[in,out] *z pointer to L3GD20H_VEC_LANES z samples
+ * @note          none
+ */
+static inline void a_l3gd20h_rotate_block(const l3gd20h_rotate_t *rot, float *x, float *y, float *z)
+{
+    l3gd20h_vec_t vx, vy, vz;
+    l3gd20h_vec_t out[3];
+    uint8_t i;
+
+    vx = a_l3gd20h_vec_load(x);
+    vy = a_l3gd20h_vec_load(y);
+    vz = a_l3gd20h_vec_load(z);
+    for (i = 0; i < 3; i++)
+    {
+        out[i] = a_l3gd20h_vec_add(a_l3gd20h_vec_add(a_l3gd20h_vec_mul(a_l3gd20h_vec_set(rot->m[i][0]), vx),
+                                                     a_l3gd20h_vec_mul(a_l3gd20h_vec_set(rot->m[i][1]), vy)),
+                                   a_l3gd20h_vec_mul(a_l3gd20h_vec_set(rot->m[i][2]), vz));
+    }
+    a_l3gd20h_vec_store(x, out[0]);
+    a_l3gd20h_vec_store(y, out[1]);
+    a_l3gd20h_vec_store(z, out[2]);
+}
+
+/**
+ * @brief     init a rotate structure
+ * @param[in] *rot pointer to a rotate structure
+ * @param[in] m mounting matrix that turns the sensor frame into the output frame
+ * @return    status code
+ *            - 0 success
+ *            - 2 rot is NULL
+ *            - 4 matrix is not a rotation
+ * @note      the matrix is folded when every row holds exactly one entry of 1 or -1 and zeros elsewhere
+ *            and L3GD20H_REMAP_ENABLE is set
+ */
+uint8_t l3gd20h_rotate_init(l3gd20h_rotate_t *rot, const float m[3][3])
+{
+    float dot;
+    float d;
+    uint8_t used;
+    uint8_t i;
+    uint8_t j;
+    uint8_t k;
+
+    if (rot == NULL)
+    {
+        return 2;
+    }
+    if (m == NULL)
+    {
+        return 4;
+    }
+
+    /* the rows have to be orthonormal */
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            dot = 0.0f;
+            for (k = 0; k < 3; k++)
+            {
+                dot += m[i][k] * m[j][k];
+            }
+            d = dot - ((i == j) ? 1.0f : 0.0f);
+            if ((d > L3GD20H_ROTATE_TOLERANCE) || (d < -L3GD20H_ROTATE_TOLERANCE))
+            {
+                return 4;
+            }
+        }
+    }
+
+    /* look for a signed permutation */
+    memset(rot, 0, sizeof(l3gd20h_rotate_t));
+    used = 0;
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            rot->m[i][j] = m[i][j];
+            if ((m[i][j] == 1.0f) || (m[i][j] == -1.0f))
+            {
+                rot->remap[i] = (l3gd20h_remap_t)(j | ((m[i][j] < 0.0f) ? 0x04 : 0x00));
+                used |= (uint8_t)(1 << j);
+            }
+            else if (m[i][j] != 0.0f)
+            {
+                used |= 0x80;
+            }
+            else
+            {
+                /* a zero entry keeps the permutation */
+            }
+        }
+    }
+#if (L3GD20H_REMAP_ENABLE == 1)
+    rot->folded = (used == 0x07) ? 1 : 0;
+#else
+    /* without the driver remap every matrix runs on the converted samples */
+    rot->folded = 0;
+#endif
+    if (rot->folded == 0)
+    {
+        rot->remap[0] = L3GD20H_REMAP_POSITIVE_X;
+        rot->remap[1] = L3GD20H_REMAP_POSITIVE_Y;
+        rot->remap[2] = L3GD20H_REMAP_POSITIVE_Z;
+    }
+
+    return 0;
+}
+
+#if (L3GD20H_REMAP_ENABLE == 1)
+/**
+ * @brief     set the rotation of a handle
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] *rot pointer to a rotate structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ *            - 2 rot is NULL
+ * @note      a folded matrix becomes the axis remap of the handle, any other matrix restores the
+ *            identity remap so the kernels see the sensor frame, call it once after l3gd20h_init
+ */
+uint8_t l3gd20h_rotate_apply(l3gd20h_handle_t *handle, const l3gd20h_rotate_t *rot)
+{
+    if (rot == NULL)
+    {
+        return 2;
+    }
+    if (l3gd20h_set_axis_remap(handle, rot->remap[0], rot->remap[1], rot->remap[2]) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+#endif
+
+/**
+ * @brief         rotate converted samples kept as one array per axis
+ * @param[in]     *rot pointer to a rotate structure
+ * @param[in,out] *x pointer to the x samples in dps
+ * @param[in,out] *y pointer to the y samples in dps
+ * @param[in,out] *z pointer to the z samples in dps
+ * @param[in]     len sample length
+ * @return        status code
+ *                - 0 success
+ *                - 2 rot is NULL
+ * @note          sse or neon rotates four samples per step when the compiler offers it, a folded matrix
+ *                leaves the samples as they are because the driver already remapped them
+ */
+uint8_t l3gd20h_rotate_soa(const l3gd20h_rotate_t *rot, float *x, float *y, float *z, uint16_t len)
+{
+    float v[3];
+    uint16_t i;
+    uint8_t k;
+
+    if (rot == NULL)
+    {
+        return 2;
+    }
+    if (rot->folded != 0)
+    {
+        return 0;
+    }
+
+    for (i = 0; (uint32_t)i + L3GD20H_VEC_LANES <= len; i += L3GD20H_VEC_LANES)
+    {
+        a_l3gd20h_rotate_block(rot, &x[i], &y[i], &z[i]);
+    }
+    for (; i < len; i++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            v[k] = rot->m[k][0] * x[i] + rot->m[k][1] * y[i] + rot->m[k][2] * z[i];
+        }
+        x[i] = v[0];
+        y[i] = v[1];
+        z[i] = v[2];
+    }
+
+    return 0;
+}
+
+/**
+ * @brief         rotate converted samples as read by l3gd20h_read
+ * @param[in]     *rot pointer to a rotate structure
+ * @param[in,out] **dps pointer to a converted data buffer
+ * @param[in]     len sample length
+ * @return        status code
+ *                - 0 success
+ *                - 2 rot is NULL
+ * @note          the samples are gathered into blocks of L3GD20H_VEC_LANES for the same kernel, a folded
+ *                matrix leaves the samples as they are
+ */
+uint8_t l3gd20h_rotate_batch(const l3gd20h_rotate_t *rot, float (*dps)[3], uint16_t len)
+{
+    float x[L3GD20H_VEC_LANES];
+    float y[L3GD20H_VEC_LANES];
+    float z[L3GD20H_VEC_LANES];
+    uint16_t i;
+    uint16_t n;
+    uint16_t j;
+
+    if (rot == NULL)
+    {
+        return 2;
+    }
+    if (rot->folded != 0)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < len; i += n)
+    {
+        /* a short tail is padded with zeros and not written back */
+        n = ((uint32_t)len - i < L3GD20H_VEC_LANES) ? (uint16_t)(len - i) : L3GD20H_VEC_LANES;
+        for (j = 0; j < L3GD20H_VEC_LANES; j++)
+        {
+            x[j] = (j < n) ? dps[i + j][0] : 0.0f;
+            y[j] = (j < n) ? dps[i + j][1] : 0.0f;
+            z[j] = (j < n) ? dps[i + j][2] : 0.0f;
+        }
+        a_l3gd20h_rotate_block(rot, x, y, z);
+        for (j = 0; j < n; j++)
+        {
+            dps[i + j][0] = x[j];
+            dps[i + j][1] = y[j];
+            dps[i + j][2] = z[j];
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_rotate.h
+ * @brief     driver l3gd20h rotate header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_ROTATE_H
+#define DRIVER_L3GD20H_ROTATE_H
+
+#include "driver_l3gd20h_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h rotate definition
+ * @note  a mounting matrix is accepted when every entry of m * m^T stays within L3GD20H_ROTATE_TOLERANCE
+ *        of the identity
+ */
+#define L3GD20H_ROTATE_TOLERANCE    1.0e-3f        /**< orthonormality tolerance */
+
+/**
+ * @brief l3gd20h rotate structure definition
+ * @note  a matrix that only permutes and flips the axes is folded into the decode of the driver,
+ *        any other matrix runs on the converted samples
+ */
+typedef struct l3gd20h_rotate_s
+{
+    float m[3][3];                 /**< mounting matrix, output = m * sensor */
+    l3gd20h_remap_t remap[3];      /**< driver remap of a folded matrix */
+    uint8_t folded;                /**< folded flag */
+} l3gd20h_rotate_t;
+
+/**
+ * @brief     init a rotate structure
+ * @param[in] *rot pointer to a rotate structure
+ * @param[in] m mounting matrix that turns the sensor frame into the output frame
+ * @return    status code
+ *            - 0 success
+ *            - 2 rot is NULL
+ *            - 4 matrix is not a rotation
+ * @note      the matrix is folded when every row holds exactly one entry of 1 or -1 and zeros elsewhere
+ *            and L3GD20H_REMAP_ENABLE is set
+ */
+uint8_t l3gd20h_rotate_init(l3gd20h_rotate_t *rot, const float m[3][3]);
+
+#if (L3GD20H_REMAP_ENABLE == 1)
+/**
+ * @brief     set the rotation of a handle
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] *rot pointer to a rotate structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ *            - 2 rot is NULL
+ * @note      a folded matrix becomes the axis remap of the handle, any other matrix restores the
+ *            identity remap so the kernels below see the sensor frame, call it once after l3gd20h_init
+ */
+uint8_t l3gd20h_rotate_apply(l3gd20h_handle_t *handle, const l3gd20h_rotate_t *rot);
+#endif
+
+/**
+ * @brief         rotate converted samples kept as one array per axis
+ * @param[in]     *rot pointer to a rotate structure
+ * @param[in,out] *x pointer to the x samples in dps
+ * @param[in,out] *y pointer to the y samples in dps
+ * @param[in,out] *z pointer to the z samples in dps
+ * @param[in]     len sample length
+ * @return        status code
+ *                - 0 success
+ *                - 2 rot is NULL
+ * @note          sse or neon rotates four samples per step when the compiler offers it, a folded matrix
+ *                leaves the samples as they are because the driver already remapped them
+ */
+uint8_t l3gd20h_rotate_soa(const l3gd20h_rotate_t *rot, float *x, float *y, float *z, uint16_t len);
+
+/**
+ * @brief         rotate converted samples as read by l3gd20h_read
+ * @param[in]     *rot pointer to a rotate structure
+ * @param[in,out] **dps pointer to a converted data buffer
+ * @param[in]     len sample length
+ * @return        status code
+ *                - 0 success
+ *                - 2 rot is NULL
+ * @note          the samples are gathered into blocks of L3GD20H_VEC_LANES for the same kernel, a folded
+ *                matrix leaves the samples as they are
+ */
+uint8_t l3gd20h_rotate_batch(const l3gd20h_rotate_t *rot, float (*dps)[3], uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
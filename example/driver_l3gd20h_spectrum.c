@@ -0,0 +1,435 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_spectrum.c
+ * @brief     driver l3gd20h spectrum source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_spectrum.h"
+#include "driver_l3gd20h_vec.h"
+#include <math.h>
+
+#if ((L3GD20H_SPECTRUM_SIZE < 16) || ((L3GD20H_SPECTRUM_SIZE & (L3GD20H_SPECTRUM_SIZE - 1)) != 0))
+#error "the spectrum size must be a power of 2 from 16 on"
+#endif
+
+/**
+ * @brief l3gd20h spectrum half size definition
+ * @note  the real fft runs as a complex fft of half the size
+ */
+#define L3GD20H_SPECTRUM_HALF        (L3GD20H_SPECTRUM_SIZE / 2)
+
+/**
+ * @brief         run a complex fft of half the size in place
+ * @param[in]     *spec pointer to a spectrum structure
+ * @param[in,out] *re pointer to the real parts in bit reversed order
+ * @param[in,out] *im pointer to the imaginary parts in bit reversed order
+ * @note          radix 2 decimation in time, the stages with 4 butterflies and more run on vectors
+ */
+static void a_l3gd20h_spectrum_fft(l3gd20h_spectrum_t *spec, float *re, float *im)
+{
+    l3gd20h_vec_t wr, wi, ur, ui, vr, vi, tr, ti;
+    const float *sr;
+    const float *si;
+    uint16_t h;
+    uint16_t base;
+    uint16_t j;
+    float xr;
+    float xi;
+
+    for (h = 1; h < L3GD20H_SPECTRUM_HALF; h *= 2)
+    {
+        sr = &spec->stage[0][h - 1];
+        si = &spec->stage[1][h - 1];
+        for (base = 0; base < L3GD20H_SPECTRUM_HALF; base += 2 * h)
+        {
+            if (h >= L3GD20H_VEC_LANES)
+            {
+                for (j = 0; j < h; j += L3GD20H_VEC_LANES)
+                {
+                    wr = a_l3gd20h_vec_load(&sr[j]);
+                    wi = a_l3gd20h_vec_load(&si[j]);
+                    ur = a_l3gd20h_vec_load(&re[base + j]);
+                    ui = a_l3gd20h_vec_load(&im[base + j]);
+                    vr = a_l3gd20h_vec_load(&re[base + j + h]);
+                    vi = a_l3gd20h_vec_load(&im[base + j + h]);
+                    tr = a_l3gd20h_vec_sub(a_l3gd20h_vec_mul(wr, vr), a_l3gd20h_vec_mul(wi, vi));
+                    ti = a_l3gd20h_vec_add(a_l3gd20h_vec_mul(wr, vi), a_l3gd20h_vec_mul(wi, vr));
+                    a_l3gd20h_vec_store(&re[base + j], a_l3gd20h_vec_add(ur, tr));
+                    a_l3gd20h_vec_store(&im[base + j], a_l3gd20h_vec_add(ui, ti));
+                    a_l3gd20h_vec_store(&re[base + j + h], a_l3gd20h_vec_sub(ur, tr));
+                    a_l3gd20h_vec_store(&im[base + j + h], a_l3gd20h_vec_sub(ui, ti));
+                }
+            }
+            else
+            {
+                for (j = 0; j < h; j++)
+                {
+                    xr = sr[j] * re[base + j + h] - si[j] * im[base + j + h];
+                    xi = sr[j] * im[base + j + h] + si[j] * re[base + j + h];
+                    re[base + j + h] = re[base + j] - xr;
+                    im[base + j + h] = im[base + j] - xi;
+                    re[base + j] += xr;
+                    im[base + j] += xi;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief     run the windows of one result through the fft
+ * @param[in] *spec pointer to a spectrum structure
+ * @note      the even samples go to the real parts and the odd ones to the imaginary parts, the split
+ *            step turns the half size spectrum into the real one
+ */
+static void a_l3gd20h_spectrum_window(l3gd20h_spectrum_t *spec)
+{
+    float re[L3GD20H_SPECTRUM_HALF];
+    float im[L3GD20H_SPECTRUM_HALF];
+    uint16_t start;
+    uint16_t n;
+    uint16_t k;
+    uint8_t a;
+    float er, ei, dr, di, xr, xi;
+
+    /* the oldest sample of the ring is the first one of the window */
+    start = spec->head;
+    for (a = 0; a < 3; a++)
+    {
+        for (n = 0; n < L3GD20H_SPECTRUM_HALF; n++)
+        {
+            uint16_t i0 = (uint16_t)((start + 2 * n) % L3GD20H_SPECTRUM_SIZE);
+            uint16_t i1 = (uint16_t)((start + 2 * n + 1) % L3GD20H_SPECTRUM_SIZE);
+
+            re[spec->reverse[n]] = spec->ring[a][i0] * spec->window[2 * n];
+            im[spec->reverse[n]] = spec->ring[a][i1] * spec->window[2 * n + 1];
+        }
+        a_l3gd20h_spectrum_fft(spec, re, im);
+
+        /* x[k] = (z[k] + z*[m - k]) / 2 + w^k (z[k] - z*[m - k]) / 2i */
+        spec->power[a][0] += (re[0] + im[0]) * (re[0] + im[0]) * spec->norm;
+        spec->power[a][L3GD20H_SPECTRUM_HALF] += (re[0] - im[0]) * (re[0] - im[0]) * spec->norm;
+        for (k = 1; k < L3GD20H_SPECTRUM_HALF; k++)
+        {
+            er = 0.5f * (re[k] + re[L3GD20H_SPECTRUM_HALF - k]);
+            ei = 0.5f * (im[k] - im[L3GD20H_SPECTRUM_HALF - k]);
+            dr = 0.5f * (im[k] + im[L3GD20H_SPECTRUM_HALF - k]);
+            di = -0.5f * (re[k] - re[L3GD20H_SPECTRUM_HALF - k]);
+            xr = er + spec->twiddle[0][k] * dr - spec->twiddle[1][k] * di;
+            xi = ei + spec->twiddle[0][k] * di + spec->twiddle[1][k] * dr;
+            spec->power[a][k] += 2.0f * (xr * xr + xi * xi) * spec->norm;
+        }
+    }
+    spec->windows++;
+}
+
+/**
+ * @brief     turn the summed windows into a result
+ * @param[in] *spec pointer to a spectrum structure
+ * @note      the peak frequency is interpolated with a parabola through the largest bin and its neighbours
+ */
+static void a_l3gd20h_spectrum_result(l3gd20h_spectrum_t *spec)
+{
+    l3gd20h_spectrum_result_t result;
+    float bin;
+    float p;
+    float l;
+    float c;
+    float r;
+    float d;
+    uint16_t k;
+    uint16_t m;
+    uint8_t a;
+    uint8_t b;
+
+    bin = spec->odr / (float)L3GD20H_SPECTRUM_SIZE;
+    memset(&result, 0, sizeof(l3gd20h_spectrum_result_t));
+    result.us = spec->us;
+    result.bands = spec->bands;
+    result.windows = spec->windows;
+    for (a = 0; a < 3; a++)
+    {
+        m = 1;
+        for (k = 0; k <= L3GD20H_SPECTRUM_HALF; k++)
+        {
+            p = spec->power[a][k] / (float)spec->windows;
+            spec->power[a][k] = p;
+            if ((k > 0) && (p > spec->power[a][m]))
+            {
+                m = k;
+            }
+            for (b = 0; b < spec->bands; b++)
+            {
+                if (((float)k * bin >= spec->edge[b]) && ((float)k * bin < spec->edge[b + 1]))
+                {
+                    result.band[a][b] += p;
+                }
+            }
+        }
+
+        /* a parabola through the magnitudes gives the frequency */
+        l = (m > 1) ? sqrtf(spec->power[a][m - 1]) : 0.0f;
+        c = sqrtf(spec->power[a][m]);
+        r = (m < L3GD20H_SPECTRUM_HALF) ? sqrtf(spec->power[a][m + 1]) : 0.0f;
+        d = 0.0f;
+        if ((l - 2.0f * c + r) < 0.0f)
+        {
+            d = 0.5f * (l - r) / (l - 2.0f * c + r);
+        }
+        result.peak_hz[a] = ((float)m + d) * bin;
+
+        /* the main lobe of the hann window spans 2 bins on each side, its energy is a^2 / 2 wherever the tone sits */
+        p = 0.0f;
+        for (k = (m > 2) ? (uint16_t)(m - 2) : 1; (k <= m + 2) && (k <= L3GD20H_SPECTRUM_HALF); k++)
+        {
+            p += spec->power[a][k];
+        }
+        result.peak_dps[a] = sqrtf(2.0f * p);
+    }
+    for (a = 0; a < 3; a++)
+    {
+        for (k = 0; k <= L3GD20H_SPECTRUM_HALF; k++)
+        {
+            spec->power[a][k] = 0.0f;
+        }
+    }
+    spec->windows = 0;
+    spec->callback(&result);
+}
+
+/**
+ * @brief     init a spectrum stage
+ * @param[in] *spec pointer to a spectrum structure
+ * @param[in] hop samples between two windows
+ * @param[in] average windows per result
+ * @param[in] *callback pointer to a result callback
+ * @return    status code
+ *            - 0 success
+ *            - 2 spec is NULL
+ *            - 4 param is invalid
+ * @note      1 <= hop <= L3GD20H_SPECTRUM_SIZE, a hop of half the size overlaps the windows by half, a result
+ *            goes out every hop * average samples
+ */
+uint8_t l3gd20h_spectrum_init(l3gd20h_spectrum_t *spec, uint16_t hop, uint16_t average,
+                              void (*callback)(const l3gd20h_spectrum_result_t *result))
+{
+    double c;
+    double square;
+    uint16_t h;
+    uint16_t j;
+    uint16_t n;
+    uint16_t r;
+    uint16_t bits;
+
+    if (spec == NULL)
+    {
+        return 2;
+    }
+    if ((hop == 0) || (hop > L3GD20H_SPECTRUM_SIZE) || (average == 0) || (callback == NULL))
+    {
+        return 4;
+    }
+
+    memset(spec, 0, sizeof(l3gd20h_spectrum_t));
+    spec->hop = hop;
+    spec->average = average;
+    spec->callback = callback;
+
+    /* periodic hann window and its power gain */
+    square = 0.0;
+    for (n = 0; n < L3GD20H_SPECTRUM_SIZE; n++)
+    {
+        c = cos(2.0 * L3GD20H_VEC_PI * (double)n / (double)L3GD20H_SPECTRUM_SIZE);
+        spec->window[n] = (float)(0.5 - 0.5 * c);
+        square += (0.5 - 0.5 * c) * (0.5 - 0.5 * c);
+    }
+    spec->norm = (float)(1.0 / ((double)L3GD20H_SPECTRUM_SIZE * square));
+
+    /* twiddles of the split step and of every stage */
+    for (n = 0; n < L3GD20H_SPECTRUM_HALF; n++)
+    {
+        spec->twiddle[0][n] = (float)cos(2.0 * L3GD20H_VEC_PI * (double)n / (double)L3GD20H_SPECTRUM_SIZE);
+        spec->twiddle[1][n] = (float)(-sin(2.0 * L3GD20H_VEC_PI * (double)n / (double)L3GD20H_SPECTRUM_SIZE));
+    }
+    for (h = 1; h < L3GD20H_SPECTRUM_HALF; h *= 2)
+    {
+        for (j = 0; j < h; j++)
+        {
+            spec->stage[0][h - 1 + j] = spec->twiddle[0][j * (L3GD20H_SPECTRUM_HALF / h)];
+            spec->stage[1][h - 1 + j] = spec->twiddle[1][j * (L3GD20H_SPECTRUM_HALF / h)];
+        }
+    }
+
+    /* bit reversed order of the half size */
+    for (bits = 0; ((uint16_t)1 << bits) < L3GD20H_SPECTRUM_HALF; bits++)
+    {
+    }
+    for (n = 0; n < L3GD20H_SPECTRUM_HALF; n++)
+    {
+        r = 0;
+        for (j = 0; j < bits; j++)
+        {
+            r = (uint16_t)((r << 1) | ((n >> j) & 1));
+        }
+        spec->reverse[n] = r;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     set the output data rate
+ * @param[in] *spec pointer to a spectrum structure
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 spec is NULL
+ *            - 4 odr is invalid
+ * @note      pass the estimate of l3gd20h_timestamp_get_odr so the bins follow the real rate of the device
+ */
+uint8_t l3gd20h_spectrum_set_odr(l3gd20h_spectrum_t *spec, float odr)
+{
+    if (spec == NULL)
+    {
+        return 2;
+    }
+    if (!(odr > 0.0f))
+    {
+        return 4;
+    }
+
+    spec->odr = odr;
+
+    return 0;
+}
+
+/**
+ * @brief     set the bands
+ * @param[in] *spec pointer to a spectrum structure
+ * @param[in] *edge pointer to a buffer of bands + 1 increasing edges in Hz
+ * @param[in] bands number of bands
+ * @return    status code
+ *            - 0 success
+ *            - 2 spec is NULL
+ *            - 4 bands or edges are invalid
+ * @note      a bin belongs to the band its center falls in, 0 bands only reports the peaks
+ */
+uint8_t l3gd20h_spectrum_set_bands(l3gd20h_spectrum_t *spec, const float *edge, uint8_t bands)
+{
+    uint8_t b;
+
+    if (spec == NULL)
+    {
+        return 2;
+    }
+    if ((bands > L3GD20H_SPECTRUM_BANDS) || ((bands != 0) && (edge == NULL)))
+    {
+        return 4;
+    }
+    for (b = 0; b < bands; b++)
+    {
+        if (!(edge[b + 1] > edge[b]))
+        {
+            return 4;
+        }
+    }
+
+    for (b = 0; b < bands + 1; b++)
+    {
+        spec->edge[b] = (bands != 0) ? edge[b] : 0.0f;
+    }
+    spec->bands = bands;
+
+    return 0;
+}
+
+/**
+ * @brief     feed a drained batch
+ * @param[in] *spec pointer to a spectrum structure
+ * @param[in] **dps pointer to an angular rate buffer
+ * @param[in] *us pointer to a timestamp buffer, NULL without times
+ * @param[in] len batch length
+ * @return    status code
+ *            - 0 success
+ *            - 2 spec is NULL
+ *            - 3 odr is not set
+ * @note      every hop samples a full window runs through one real fft per axis
+ */
+uint8_t l3gd20h_spectrum_feed(l3gd20h_spectrum_t *spec, const float (*dps)[3], const uint64_t *us, uint16_t len)
+{
+    uint16_t i;
+
+    if (spec == NULL)
+    {
+        return 2;
+    }
+    if (spec->odr == 0.0f)
+    {
+        return 3;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        spec->ring[0][spec->head] = dps[i][0];
+        spec->ring[1][spec->head] = dps[i][1];
+        spec->ring[2][spec->head] = dps[i][2];
+        spec->head = (uint16_t)((spec->head + 1) % L3GD20H_SPECTRUM_SIZE);
+        spec->us = (us != NULL) ? us[i] : 0;
+        if (spec->fill < L3GD20H_SPECTRUM_SIZE)
+        {
+            spec->fill++;
+            if (spec->fill < L3GD20H_SPECTRUM_SIZE)
+            {
+                continue;
+            }
+        }
+        else
+        {
+            spec->since++;
+            if (spec->since < spec->hop)
+            {
+                continue;
+            }
+        }
+
+        /* a full window every hop samples */
+        spec->since = 0;
+        a_l3gd20h_spectrum_window(spec);
+        if (spec->windows >= spec->average)
+        {
+            a_l3gd20h_spectrum_result(spec);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_spectrum.h
+ * @brief     driver l3gd20h spectrum header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_SPECTRUM_H
+#define DRIVER_L3GD20H_SPECTRUM_H
+
+#include "driver_l3gd20h_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h spectrum size definition
+ * @note  the window length, a power of 2 from 16 on
+ */
+#ifndef L3GD20H_SPECTRUM_SIZE
+    #define L3GD20H_SPECTRUM_SIZE 256        /**< samples of a window */
+#endif
+
+/**
+ * @brief l3gd20h spectrum bands definition
+ */
+#define L3GD20H_SPECTRUM_BANDS 8        /**< largest number of bands */
+
+/**
+ * @brief l3gd20h spectrum result structure definition
+ * @note  the band values are the mean square rate in the band, the peak skips the dc bin
+ */
+typedef struct l3gd20h_spectrum_result_s
+{
+    uint64_t us;                                       /**< time of the last sample of the last window */
+    float peak_hz[3];                                  /**< interpolated peak frequency in Hz */
+    float peak_dps[3];                                 /**< amplitude of the peak in dps */
+    float band[3][L3GD20H_SPECTRUM_BANDS];             /**< band energies in dps^2 */
+    uint8_t bands;                                     /**< used bands */
+    uint16_t windows;                                  /**< averaged windows */
+} l3gd20h_spectrum_result_t;
+
+/**
+ * @brief l3gd20h spectrum structure definition
+ */
+typedef struct l3gd20h_spectrum_s
+{
+    float ring[3][L3GD20H_SPECTRUM_SIZE];                         /**< latest samples */
+    float window[L3GD20H_SPECTRUM_SIZE];                          /**< hann window */
+    float twiddle[2][L3GD20H_SPECTRUM_SIZE / 2];                  /**< exp(-2 pi i k / size) */
+    float stage[2][L3GD20H_SPECTRUM_SIZE / 2];                    /**< twiddles of every butterfly stage in a row */
+    uint16_t reverse[L3GD20H_SPECTRUM_SIZE / 2];                  /**< bit reversed order */
+    float power[3][L3GD20H_SPECTRUM_SIZE / 2 + 1];                /**< mean square per bin summed over the windows */
+    float edge[L3GD20H_SPECTRUM_BANDS + 1];                       /**< band edges in Hz */
+    float odr;                                                    /**< output data rate in Hz */
+    float norm;                                                   /**< 1 / (size * sum of the squared window) */
+    uint16_t head;                                                /**< next ring position */
+    uint16_t fill;                                                /**< samples in the ring */
+    uint16_t hop;                                                 /**< samples between two windows */
+    uint16_t since;                                               /**< samples since the last window */
+    uint16_t average;                                             /**< windows per result */
+    uint16_t windows;                                             /**< windows of the current result */
+    uint64_t us;                                                  /**< time of the latest sample */
+    uint8_t bands;                                                /**< used bands */
+    void (*callback)(const l3gd20h_spectrum_result_t *result);    /**< result callback */
+} l3gd20h_spectrum_t;
+
+/**
+ * @brief     init a spectrum stage
+ * @param[in] *spec pointer to a spectrum structure
+ * @param[in] hop samples between two windows
+ * @param[in] average windows per result
+ * @param[in] *callback pointer to a result callback
+ * @return    status code
+ *            - 0 success
+ *            - 2 spec is NULL
+ *            - 4 param is invalid
+ * @note      1 <= hop <= L3GD20H_SPECTRUM_SIZE, a hop of half the size overlaps the windows by half, a result
+ *            goes out every hop * average samples
+ */
+uint8_t l3gd20h_spectrum_init(l3gd20h_spectrum_t *spec, uint16_t hop, uint16_t average,
+                              void (*callback)(const l3gd20h_spectrum_result_t *result));
+
+/**
+ * @brief     set the output data rate
+ * @param[in] *spec pointer to a spectrum structure
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 spec is NULL
+ *            - 4 odr is invalid
+ * @note      pass the estimate of l3gd20h_timestamp_get_odr so the bins follow the real rate of the device
+ */
+uint8_t l3gd20h_spectrum_set_odr(l3gd20h_spectrum_t *spec, float odr);
+
+/**
+ * @brief     set the bands
+ * @param[in] *spec pointer to a spectrum structure
+ * @param[in] *edge pointer to a buffer of bands + 1 increasing edges in Hz
+ * @param[in] bands number of bands
+ * @return    status code
+ *            - 0 success
+ *            - 2 spec is NULL
+ *            - 4 bands or edges are invalid
+ * @note      a bin belongs to the band its center falls in, 0 bands only reports the peaks
+ */
+uint8_t l3gd20h_spectrum_set_bands(l3gd20h_spectrum_t *spec, const float *edge, uint8_t bands);
+
+/**
+ * @brief     feed a drained batch
+ * @param[in] *spec pointer to a spectrum structure
+ * @param[in] **dps pointer to an angular rate buffer
+ * @param[in] *us pointer to a timestamp buffer, NULL without times
+ * @param[in] len batch length
+ * @return    status code
+ *            - 0 success
+ *            - 2 spec is NULL
+ *            - 3 odr is not set
+ * @note      every hop samples a full window runs through one real fft per axis
+ */
+uint8_t l3gd20h_spectrum_feed(l3gd20h_spectrum_t *spec, const float (*dps)[3], const uint64_t *us, uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_l3gd20h_trace.c
+ * @brief     driver l3gd20h trace source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_trace.h"
+
+#if (L3GD20H_TRACE_ENABLE == 1)
+static uint8_t gs_first = 1;        /**< first event flag */
+
+/**
+ * @brief     start a chrome trace json file
+ * @param[in] *f pointer to an output stream
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the file opens in chrome://tracing and in the perfetto ui
+ */
+uint8_t l3gd20h_trace_json_begin(FILE *f)
+{
+    if (f == NULL)
+    {
+        return 1;
+    }
+    gs_first = 1;
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    return (ferror(f) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     convert trace entries to chrome trace events
+ * @param[in] *f pointer to an output stream
+ * @param[in] pid process id of the events
+ * @param[in] *trace pointer to a trace buffer
+ * @param[in] len trace length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      begin and end entries become duration events, an interrupt entry becomes an instant event
+ */
+uint8_t l3gd20h_trace_json_write(FILE *f, uint32_t pid, const l3gd20h_trace_t *trace, uint16_t len)
+{
+    uint16_t i;
+
+    if ((f == NULL) || (trace == NULL))
+    {
+        return 1;
+    }
+    for (i = 0; i < len; i++)
+    {
+        const l3gd20h_trace_t *t = &trace[i];
+        const char *sep = (gs_first != 0) ? "" : ",\n";
+
+        gs_first = 0;
+        switch (t->type)
+        {
+            case L3GD20H_TRACE_TYPE_BUS_READ_BEGIN :
+            case L3GD20H_TRACE_TYPE_BUS_WRITE_BEGIN :
+            {
+                fprintf(f, "%s{\"name\":\"%s 0x%02X\",\"cat\":\"bus\",\"ph\":\"B\",\"ts\":%llu,\"pid\":%u,\"tid\":1}",
+                        sep, (t->type == L3GD20H_TRACE_TYPE_BUS_READ_BEGIN) ? "read" : "write", t->reg,
+                        (unsigned long long)t->us, (unsigned int)pid);
+
+                break;
+            }
+            case L3GD20H_TRACE_TYPE_BUS_READ_END :
+            case L3GD20H_TRACE_TYPE_BUS_WRITE_END :
+            case L3GD20H_TRACE_TYPE_READ_END :
+            {
+                fprintf(f, "%s{\"ph\":\"E\",\"ts\":%llu,\"pid\":%u,\"tid\":1,\"args\":{\"len\":%u,\"res\":%u}}",
+                        sep, (unsigned long long)t->us, (unsigned int)pid, t->len, t->res);
+
+                break;
+            }
+            case L3GD20H_TRACE_TYPE_READ_BEGIN :
+            {
+                fprintf(f, "%s{\"name\":\"l3gd20h_read\",\"cat\":\"api\",\"ph\":\"B\",\"ts\":%llu,\"pid\":%u,\"tid\":1}",
+                        sep, (unsigned long long)t->us, (unsigned int)pid);
+
+                break;
+            }
+            case L3GD20H_TRACE_TYPE_IRQ :
+            {
+                fprintf(f, "%s{\"name\":\"irq %u\",\"cat\":\"irq\",\"ph\":\"i\",\"s\":\"p\",\"ts\":%llu,\"pid\":%u,\"tid\":1}",
+                        sep, t->reg, (unsigned long long)t->us, (unsigned int)pid);
+
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    }
+
+    return (ferror(f) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     finish a chrome trace json file
+ * @param[in] *f pointer to an output stream
+ * @param[in] lost overwritten trace entries
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t l3gd20h_trace_json_end(FILE *f, uint32_t lost)
+{
+    if (f == NULL)
+    {
+        return 1;
+    }
+    fprintf(f, "\n],\"otherData\":{\"lost\":%u}}\n", (unsigned int)lost);
+
+    return (ferror(f) != 0) ? 1 : 0;
+}
+#endif
@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_vec.h
+ * @brief     driver l3gd20h vector header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_VEC_H
+#define DRIVER_L3GD20H_VEC_H
+
+#include <stdint.h>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/**
+ * @brief l3gd20h vector lanes definition
+ * @note  the example modules that work on several sensors at once keep one float per lane
+ */
+#define L3GD20H_VEC_LANES 4        /**< floats of one vector */
+
+/**
+ * @brief l3gd20h vector pi definition
+ */
+#define L3GD20H_VEC_PI 3.14159265358979323846        /**< pi in double */
+
+#if defined(__SSE__)
+/**
+ * @brief l3gd20h vector definition
+ * @note  the helpers below map one vector operation to sse
+ */
+typedef __m128 l3gd20h_vec_t;
+
+static inline l3gd20h_vec_t a_l3gd20h_vec_load(const float *p) { return _mm_loadu_ps(p); }
+static inline void a_l3gd20h_vec_store(float *p, l3gd20h_vec_t a) { _mm_storeu_ps(p, a); }
+static inline l3gd20h_vec_t a_l3gd20h_vec_set(float v) { return _mm_set1_ps(v); }
+static inline l3gd20h_vec_t a_l3gd20h_vec_add(l3gd20h_vec_t a, l3gd20h_vec_t b) { return _mm_add_ps(a, b); }
+static inline l3gd20h_vec_t a_l3gd20h_vec_sub(l3gd20h_vec_t a, l3gd20h_vec_t b) { return _mm_sub_ps(a, b); }
+static inline l3gd20h_vec_t a_l3gd20h_vec_mul(l3gd20h_vec_t a, l3gd20h_vec_t b) { return _mm_mul_ps(a, b); }
+#elif defined(__ARM_NEON)
+/**
+ * @brief l3gd20h vector definition
+ * @note  the helpers below map one vector operation to neon
+ */
+typedef float32x4_t l3gd20h_vec_t;
+
+static inline l3gd20h_vec_t a_l3gd20h_vec_load(const float *p) { return vld1q_f32(p); }
+static inline void a_l3gd20h_vec_store(float *p, l3gd20h_vec_t a) { vst1q_f32(p, a); }
+static inline l3gd20h_vec_t a_l3gd20h_vec_set(float v) { return vdupq_n_f32(v); }
+static inline l3gd20h_vec_t a_l3gd20h_vec_add(l3gd20h_vec_t a, l3gd20h_vec_t b) { return vaddq_f32(a, b); }
+static inline l3gd20h_vec_t a_l3gd20h_vec_sub(l3gd20h_vec_t a, l3gd20h_vec_t b) { return vsubq_f32(a, b); }
+static inline l3gd20h_vec_t a_l3gd20h_vec_mul(l3gd20h_vec_t a, l3gd20h_vec_t b) { return vmulq_f32(a, b); }
+#else
+/**
+ * @brief l3gd20h vector definition
+ * @note  the helpers below loop over the lanes, compilers may still vectorise them
+ */
+typedef struct l3gd20h_vec_s
+{
+    float v[L3GD20H_VEC_LANES];        /**< lanes */
+} l3gd20h_vec_t;
+
+static inline l3gd20h_vec_t a_l3gd20h_vec_load(const float *p)
+{
+    l3gd20h_vec_t r;
+    uint8_t i;
+
+    for (i = 0; i < L3GD20H_VEC_LANES; i++)
+    {
+        r.v[i] = p[i];
+    }
+
+    return r;
+}
+
+static inline void a_l3gd20h_vec_store(float *p, l3gd20h_vec_t a)
+{
+    uint8_t i;
+
+    for (i = 0; i < L3GD20H_VEC_LANES; i++)
+    {
+        p[i] = a.v[i];
+    }
+}
+
+static inline l3gd20h_vec_t a_l3gd20h_vec_set(float v)
+{
+    l3gd20h_vec_t r;
+    uint8_t i;
+
+    for (i = 0; i < L3GD20H_VEC_LANES; i++)
+    {
+        r.v[i] = v;
+    }
+
+    return r;
+}
+
+static inline l3gd20h_vec_t a_l3gd20h_vec_add(l3gd20h_vec_t a, l3gd20h_vec_t b)
+{
+    uint8_t i;
+
+    for (i = 0; i < L3GD20H_VEC_LANES; i++)
+    {
+        a.v[i] += b.v[i];
+    }
+
+    return a;
+}
+
+static inline l3gd20h_vec_t a_l3gd20h_vec_sub(l3gd20h_vec_t a, l3gd20h_vec_t b)
+{
+    uint8_t i;
+
+    for (i = 0; i < L3GD20H_VEC_LANES; i++)
+    {
+        a.v[i] -= b.v[i];
+    }
+
+    return a;
+}
+
+static inline l3gd20h_vec_t a_l3gd20h_vec_mul(l3gd20h_vec_t a, l3gd20h_vec_t b)
+{
+    uint8_t i;
+
+    for (i = 0; i < L3GD20H_VEC_LANES; i++)
+    {
+        a.v[i] *= b.v[i];
+    }
+
+    return a;
+}
+#endif
+
+#endif
@@ -0,0 +1,233 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_watermark.c
+ * @brief     driver l3gd20h watermark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_watermark.h"
+
+/**
+ * @brief l3gd20h watermark fifo depth definition
+ */
+#define L3GD20H_WATERMARK_DEPTH    32        /**< fifo samples */
+
+/**
+ * @brief     pick the fifo threshold
+ * @param[in] *wm pointer to a watermark structure
+ * @note      the oldest sample of a batch waits threshold - 1 periods for the interrupt and the service on
+ *            top, the service adds service / period samples to the fifo before the drain
+ */
+static void a_l3gd20h_watermark_pick(l3gd20h_watermark_t *wm)
+{
+    float period;
+    float budget;
+    uint32_t lat;
+    uint32_t irq;
+    uint32_t over;
+    uint32_t fill;
+    uint32_t n;
+
+    period = 1000000.0f / wm->odr;
+    budget = wm->config.latency_ms * 1000.0f - wm->service_us;
+    lat = (budget >= 0.0f) ? ((uint32_t)(budget / period) + 1) : 0;
+    irq = (uint32_t)(wm->odr / wm->config.irq_hz);
+    irq += ((float)irq * wm->config.irq_hz < wm->odr) ? 1 : 0;
+    fill = (uint32_t)(wm->service_us / period);
+    fill += ((float)fill * period < wm->service_us) ? 1 : 0;
+    over = (fill + L3GD20H_WATERMARK_MARGIN < L3GD20H_WATERMARK_DEPTH) ?
+           (L3GD20H_WATERMARK_DEPTH - L3GD20H_WATERMARK_MARGIN - fill) : 0;
+
+    /* the interrupt rate wins over the latency and the fifo depth over both */
+    n = (lat > irq) ? lat : irq;
+    wm->met = ((lat >= irq) && (n <= over)) ? 1 : 0;
+    n = (n < over) ? n : over;
+    n = (n < 1) ? 1 : n;
+    n = (n > L3GD20H_WATERMARK_DEPTH - 1) ? (L3GD20H_WATERMARK_DEPTH - 1) : n;
+    wm->threshold = (uint8_t)n;
+}
+
+/**
+ * @brief     init a watermark controller
+ * @param[in] *wm pointer to a watermark structure
+ * @param[in] *config pointer to a config structure
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 wm or config is NULL
+ *            - 4 param is invalid
+ * @note      the first threshold assumes an instant service, write it with l3gd20h_watermark_apply
+ */
+uint8_t l3gd20h_watermark_init(l3gd20h_watermark_t *wm, const l3gd20h_watermark_config_t *config, float odr)
+{
+    if ((wm == NULL) || (config == NULL))
+    {
+        return 2;
+    }
+    if (!(config->latency_ms > 0.0f) || !(config->irq_hz > 0.0f) || !(odr > 0.0f))
+    {
+        return 4;
+    }
+
+    memset(wm, 0, sizeof(l3gd20h_watermark_t));
+    wm->config = *config;
+    wm->odr = odr;
+    a_l3gd20h_watermark_pick(wm);
+
+    return 0;
+}
+
+/**
+ * @brief     change the output data rate
+ * @param[in] *wm pointer to a watermark structure
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 wm is NULL
+ *            - 4 odr is invalid
+ * @note      the new threshold is written by the next l3gd20h_watermark_update
+ */
+uint8_t l3gd20h_watermark_set_odr(l3gd20h_watermark_t *wm, float odr)
+{
+    if (wm == NULL)
+    {
+        return 2;
+    }
+    if (!(odr > 0.0f))
+    {
+        return 4;
+    }
+
+    wm->odr = odr;
+    a_l3gd20h_watermark_pick(wm);
+
+    return 0;
+}
+
+/**
+ * @brief     write the fifo threshold
+ * @param[in] *wm pointer to a watermark structure
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set fifo threshold failed
+ *            - 2 wm or handle is NULL
+ * @note      the write keeps the fifo mode and the stored samples
+ */
+uint8_t l3gd20h_watermark_apply(l3gd20h_watermark_t *wm, l3gd20h_handle_t *handle)
+{
+    if ((wm == NULL) || (handle == NULL))
+    {
+        return 2;
+    }
+
+    if (l3gd20h_set_fifo_threshold(handle, wm->threshold) != 0)
+    {
+        return 1;
+    }
+    wm->written = wm->threshold;
+
+    return 0;
+}
+
+/**
+ * @brief     feed a measured service latency and retune the fifo threshold
+ * @param[in] *wm pointer to a watermark structure
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] service_us time from the threshold interrupt to the end of the drain in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 set fifo threshold failed
+ *            - 2 wm or handle is NULL
+ * @note      call it right after a drain, the threshold write keeps the fifo mode and the stored samples
+ *            so nothing is lost, the threshold is the largest one that keeps the latency target, raised to
+ *            keep the interrupt rate and lowered so the samples of a service fit in the fifo, the
+ *            interrupt rate wins over the latency when both can not hold, a level already at the new
+ *            threshold keeps int2 active without a new edge so the caller should check the pin
+ */
+uint8_t l3gd20h_watermark_update(l3gd20h_watermark_t *wm, l3gd20h_handle_t *handle, float service_us)
+{
+    if ((wm == NULL) || (handle == NULL))
+    {
+        return 2;
+    }
+
+    /* a slow service counts at once, a fast one slowly */
+    service_us = (service_us > 0.0f) ? service_us : 0.0f;
+    if (service_us > wm->service_us)
+    {
+        wm->service_us = service_us;
+    }
+    else
+    {
+        wm->service_us -= (wm->service_us - service_us) / (float)L3GD20H_WATERMARK_RELEASE;
+    }
+    wm->batches++;
+
+    a_l3gd20h_watermark_pick(wm);
+    if (wm->threshold != wm->written)
+    {
+        if (l3gd20h_watermark_apply(wm, handle) != 0)
+        {
+            return 1;
+        }
+        wm->retunes++;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      get the fifo threshold
+ * @param[in]  *wm pointer to a watermark structure
+ * @param[out] *threshold pointer to a threshold buffer
+ * @param[out] *met pointer to a targets met flag buffer, NULL skips the flag
+ * @return     status code
+ *             - 0 success
+ *             - 2 wm is NULL
+ * @note       none
+ */
+uint8_t l3gd20h_watermark_get(l3gd20h_watermark_t *wm, uint8_t *threshold, uint8_t *met)
+{
+    if (wm == NULL)
+    {
+        return 2;
+    }
+
+    *threshold = wm->threshold;
+    if (met != NULL)
+    {
+        *met = wm->met;
+    }
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_l3gd20h_watermark.h
+ * @brief     driver l3gd20h watermark header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_L3GD20H_WATERMARK_H
+#define DRIVER_L3GD20H_WATERMARK_H
+
+#include "driver_l3gd20h_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup l3gd20h_example_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h watermark definition
+ * @note  the service latency envelope follows a longer service at once and a shorter one by
+ *        1 / L3GD20H_WATERMARK_RELEASE of the distance per batch, the fifo keeps L3GD20H_WATERMARK_MARGIN
+ *        free samples behind the samples that arrive during the service
+ */
+#define L3GD20H_WATERMARK_RELEASE    16        /**< release divider of the service envelope */
+#define L3GD20H_WATERMARK_MARGIN     1         /**< free fifo samples at the service */
+
+/**
+ * @brief l3gd20h watermark config structure definition
+ * @note  the latency runs from the capture of the oldest sample of a batch to the end of its service
+ */
+typedef struct l3gd20h_watermark_config_s
+{
+    float latency_ms;        /**< end to end latency target in ms */
+    float irq_hz;            /**< largest interrupt rate in Hz */
+} l3gd20h_watermark_config_t;
+
+/**
+ * @brief l3gd20h watermark structure definition
+ */
+typedef struct l3gd20h_watermark_s
+{
+    l3gd20h_watermark_config_t config;        /**< config */
+    float odr;                                /**< output data rate in Hz */
+    float service_us;                         /**< service latency envelope in us */
+    uint8_t threshold;                        /**< fifo threshold in samples */
+    uint8_t written;                          /**< threshold of the last write */
+    uint8_t met;                              /**< both targets hold at the envelope */
+    uint32_t batches;                         /**< measured services */
+    uint32_t retunes;                         /**< threshold writes of the updates */
+} l3gd20h_watermark_t;
+
+/**
+ * @brief     init a watermark controller
+ * @param[in] *wm pointer to a watermark structure
+ * @param[in] *config pointer to a config structure
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 wm or config is NULL
+ *            - 4 param is invalid
+ * @note      the first threshold assumes an instant service, write it with l3gd20h_watermark_apply
+ */
+uint8_t l3gd20h_watermark_init(l3gd20h_watermark_t *wm, const l3gd20h_watermark_config_t *config, float odr);
+
+/**
+ * @brief     change the output data rate
+ * @param[in] *wm pointer to a watermark structure
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 2 wm is NULL
+ *            - 4 odr is invalid
+ * @note      the new threshold is written by the next l3gd20h_watermark_update
+ */
+uint8_t l3gd20h_watermark_set_odr(l3gd20h_watermark_t *wm, float odr);
+
+/**
+ * @brief     write the fifo threshold
+ * @param[in] *wm pointer to a watermark structure
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set fifo threshold failed
+ *            - 2 wm or handle is NULL
+ * @note      the write keeps the fifo mode and the stored samples
+ */
+uint8_t l3gd20h_watermark_apply(l3gd20h_watermark_t *wm, l3gd20h_handle_t *handle);
+
+/**
+ * @brief     feed a measured service latency and retune the fifo threshold
+ * @param[in] *wm pointer to a watermark structure
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] service_us time from the threshold interrupt to the end of the drain in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 set fifo threshold failed
+ *            - 2 wm or handle is NULL
+ * @note      call it right after a drain, the threshold write keeps the fifo mode and the stored samples
+ *            so nothing is lost, the threshold is the largest one that keeps the latency target, raised to
+ *            keep the interrupt rate and lowered so the samples of a service fit in the fifo, the
+ *            interrupt rate wins over the latency when both can not hold, a level already at the new
+ *            threshold keeps int2 active without a new edge so the caller should check the pin
+ */
+uint8_t l3gd20h_watermark_update(l3gd20h_watermark_t *wm, l3gd20h_handle_t *handle, float service_us);
+
+/**
+ * @brief      get the fifo threshold
+ * @param[in]  *wm pointer to a watermark structure
+ * @param[out] *threshold pointer to a threshold buffer
+ * @param[out] *met pointer to a targets met flag buffer, NULL skips the flag
+ * @return     status code
+ *             - 0 success
+ *             - 2 wm is NULL
+ * @note       none
+ */
+uint8_t l3gd20h_watermark_get(l3gd20h_watermark_t *wm, uint8_t *threshold, uint8_t *met);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
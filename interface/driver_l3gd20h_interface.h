@@ -144,6 +144,13 @@ uint8_t l3gd20h_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len);
  */
 void l3gd20h_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief  interface timestamp us
+ * @return time in us
+ * @note   the clock must be monotonic
+ */
+uint64_t l3gd20h_interface_timestamp_us(void);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -157,6 +157,16 @@ void l3gd20h_interface_delay_ms(uint32_t ms)
     
 }
 
+/**
+ * @brief  interface timestamp us
+ * @return time in us
+ * @note   none
+ */
+uint64_t l3gd20h_interface_timestamp_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
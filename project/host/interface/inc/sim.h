@@ -0,0 +1,334 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      sim.h
+ * @brief     simulated l3gd20h device header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup sim sim function
+ * @brief    simulated l3gd20h device modules
+ * @{
+ */
+
+/**
+ * @brief sim fifo depth definition
+ */
+#define SIM_FIFO_DEPTH 32        /**< 32 samples */
+
+/**
+ * @brief sim reference weight definition
+ * @note  the datasheet gives no scale for the reference register, the model subtracts a fixed
+ *        rate per lsb of the signed register value from every axis in reference mode
+ */
+#define SIM_REFERENCE_DPS 0.035f        /**< subtracted rate per reference lsb */
+
+/**
+ * @brief sim pin enumeration definition
+ */
+typedef enum
+{
+    SIM_PIN_INT1 = 0x00,        /**< interrupt 1 pin */
+    SIM_PIN_INT2 = 0x01,        /**< interrupt 2 / data ready pin */
+} sim_pin_t;
+
+/**
+ * @brief sim statistics structure definition
+ */
+typedef struct sim_stats_s
+{
+    uint32_t transactions;        /**< bus transactions */
+    uint32_t read_bytes;          /**< data bytes read */
+    uint32_t write_bytes;         /**< data bytes written */
+    uint32_t samples;             /**< samples produced by the core */
+    uint32_t fifo_dropped;        /**< samples lost to a full fifo */
+    uint32_t int1_edges;          /**< int1 pin edges */
+    uint32_t int2_edges;          /**< int2 pin edges */
+} sim_stats_t;
+
+/**
+ * @brief  power up the simulated device
+ * @return status code
+ *         - 0 success
+ * @note   the first call resets the register file and the virtual clock, later calls keep the state
+ *         like a device that stays powered between two driver inits
+ */
+uint8_t sim_power_up(void);
+
+/**
+ * @brief  reset the simulated device to its power on state
+ * @return status code
+ *         - 0 success
+ * @note   the angular rate source, the temperature and the edge callback are kept
+ */
+uint8_t sim_reset(void);
+
+/**
+ * @brief     set the level of the sdo / sa0 strap
+ * @param[in] level strap level
+ * @note      the device only answers the iic address selected by the strap
+ */
+void sim_set_address_pin(uint8_t level);
+
+/**
+ * @brief     set the angular rate source
+ * @param[in] *source pointer to a source function, NULL restores the default profile
+ * @note      the source returns the angular rate in dps at the virtual time in us
+ */
+void sim_set_source(void (*source)(uint64_t us, float dps[3]));
+
+/**
+ * @brief     set the die temperature
+ * @param[in] degree temperature in degrees celsius
+ * @note      none
+ */
+void sim_set_temperature(float degree);
+
+/**
+ * @brief     set the oscillator error
+ * @param[in] ppm output data rate error in ppm, positive values slow the device down
+ * @note      the sample period is rounded to 1 us, the error takes effect on the next rate change
+ */
+void sim_set_odr_error(int32_t ppm);
+
+/**
+ * @brief     set the zero rate level
+ * @param[in] *dps pointer to a zero rate level buffer in dps, NULL clears the level
+ * @note      the level is added to the source on every axis
+ */
+void sim_set_zero_rate(const float dps[3]);
+
+/**
+ * @brief     set the zero rate level change with the temperature
+ * @param[in] *dps pointer to a drift buffer in dps per degree, NULL clears the drift
+ * @note      the level changes linearly around 25 degrees
+ */
+void sim_set_zero_rate_drift(const float dps[3]);
+
+/**
+ * @brief     set the rate noise
+ * @param[in] dps noise in dps rms, 0 disables the noise
+ * @note      the noise is white and uniform
+ */
+void sim_set_noise(float dps);
+
+/**
+ * @brief     set the pin edge callback
+ * @param[in] *callback pointer to an edge callback, NULL disables the callback
+ * @note      the callback runs on every level change of int1 or int2 and may access the bus
+ */
+void sim_set_edge_callback(void (*callback)(sim_pin_t pin, uint8_t level));
+
+/**
+ * @brief     get the current pin level
+ * @param[in] pin interrupt pin
+ * @return    pin level
+ * @note      none
+ */
+uint8_t sim_get_pin(sim_pin_t pin);
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] us time in us
+ * @note      samples are produced at every odr period that elapses
+ */
+void sim_advance_us(uint64_t us);
+
+/**
+ * @brief  get the virtual clock
+ * @return time in us
+ * @note   none
+ */
+uint64_t sim_get_time_us(void);
+
+/**
+ * @brief  get the time of the latest sample
+ * @return time in us
+ * @note   none
+ */
+uint64_t sim_get_sample_time_us(void);
+
+/**
+ * @brief  get the sample period
+ * @return period in us, 0 when no sample is produced
+ * @note   the period includes the oscillator error
+ */
+uint32_t sim_get_period_us(void);
+
+/**
+ * @brief      get the statistics
+ * @param[out] *stats pointer to a statistics structure
+ * @note       none
+ */
+void sim_get_stats(sim_stats_t *stats);
+
+/**
+ * @brief clear the statistics
+ * @note  none
+ */
+void sim_clear_stats(void);
+
+/**
+ * @brief      iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg register address, bit 7 enables the address increment
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t sim_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg register address, bit 7 enables the address increment
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t sim_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      spi bus read
+ * @param[in]  reg register address, bit 7 is the read bit and bit 6 enables the address increment
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t sim_spi_read(uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     spi bus write
+ * @param[in] reg register address, bit 6 enables the address increment
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t sim_spi_write(uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     refuse the next async starts
+ * @param[in] count number of starts to refuse
+ * @note      none
+ */
+void sim_set_async_fail(uint8_t count);
+
+/**
+ * @brief      complete the async transfer in flight
+ * @param[out] *res pointer to a transfer result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no transfer is in flight
+ * @note       the channel is free again before the caller runs the driver completion handler
+ */
+uint8_t sim_async_complete(uint8_t *res);
+
+/**
+ * @brief      iic bus async read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg register address, bit 7 enables the address increment
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 start failed
+ * @note       the data is moved at the start, sim_async_complete reports the bus result
+ */
+uint8_t sim_iic_read_async(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic bus async write
+ * @param[in] addr iic device write address
+ * @param[in] reg register address, bit 7 enables the address increment
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the data is moved at the start, sim_async_complete reports the bus result
+ */
+uint8_t sim_iic_write_async(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      spi bus async read
+ * @param[in]  reg register address, bit 7 is the read bit and bit 6 enables the address increment
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 start failed
+ * @note       the data is moved at the start, sim_async_complete reports the bus result
+ */
+uint8_t sim_spi_read_async(uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     spi bus async write
+ * @param[in] reg register address, bit 6 enables the address increment
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the data is moved at the start, sim_async_complete reports the bus result
+ */
+uint8_t sim_spi_write_async(uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
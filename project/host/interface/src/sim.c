@@ -0,0 +1,1409 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      sim.c
+ * @brief     simulated l3gd20h device source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sim.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief register address definition
+ */
+#define SIM_REG_WHO_AM_I           0x0F        /**< who am i register */
+#define SIM_REG_CTRL1              0x20        /**< control 1 register */
+#define SIM_REG_CTRL2              0x21        /**< control 2 register */
+#define SIM_REG_CTRL3              0x22        /**< control 3 register */
+#define SIM_REG_CTRL4              0x23        /**< control 4 register */
+#define SIM_REG_CTRL5              0x24        /**< control 5 register */
+#define SIM_REG_REFERENCE          0x25        /**< reference register */
+#define SIM_REG_OUT_TEMP           0x26        /**< output temperature register */
+#define SIM_REG_STATUS             0x27        /**< status register */
+#define SIM_REG_OUT_X_L            0x28        /**< out x low register */
+#define SIM_REG_OUT_Z_H            0x2D        /**< out z high register */
+#define SIM_REG_FIFO_CTRL          0x2E        /**< fifo control register */
+#define SIM_REG_FIFO_SRC           0x2F        /**< fifo source register */
+#define SIM_REG_IG_CFG             0x30        /**< interrupt configure register */
+#define SIM_REG_IG_SRC             0x31        /**< interrupt source register */
+#define SIM_REG_IG_THS_XH          0x32        /**< threshold x high register */
+#define SIM_REG_IG_DURATION        0x38        /**< interrupt duration register */
+#define SIM_REG_LOW_ODR            0x39        /**< low power output data rate register */
+
+/**
+ * @brief sim fifo mode definition
+ */
+#define SIM_FIFO_MODE_BYPASS                  0x00        /**< bypass mode */
+#define SIM_FIFO_MODE_FIFO                    0x01        /**< fifo mode */
+#define SIM_FIFO_MODE_STREAM                  0x02        /**< stream mode */
+#define SIM_FIFO_MODE_STREAM_TO_FIFO          0x03        /**< stream-to-fifo mode */
+#define SIM_FIFO_MODE_BYPASS_TO_STREAM        0x04        /**< bypass-to-stream mode */
+#define SIM_FIFO_MODE_DYNAMIC_STREAM          0x06        /**< dynamic stream mode */
+#define SIM_FIFO_MODE_BYPASS_TO_FIFO          0x07        /**< bypass-to-fifo mode */
+
+/**
+ * @brief sim fifo collect definition
+ */
+#define SIM_COLLECT_NONE          0x00        /**< fifo is not collecting */
+#define SIM_COLLECT_FIFO          0x01        /**< stop collecting when full */
+#define SIM_COLLECT_STREAM        0x02        /**< discard the oldest sample when full */
+
+/**
+ * @brief sim boot time definition
+ */
+#define SIM_BOOT_US        5000        /**< memory reboot takes 5ms */
+
+/**
+ * @brief sim pi definition
+ */
+#define SIM_PI 3.14159265358979323846        /**< pi */
+
+/**
+ * @brief sim edge queue depth definition
+ */
+#define SIM_EDGE_DEPTH        16        /**< 16 pending edges */
+
+/**
+ * @brief sim state structure definition
+ */
+typedef struct sim_s
+{
+    uint8_t powered;                                        /**< power flag */
+    uint8_t reg[0x80];                                      /**< register file */
+    uint64_t time_us;                                       /**< virtual clock */
+    uint32_t period_us;                                     /**< sample period, 0 when stopped */
+    uint64_t next_us;                                       /**< next sample time */
+    uint64_t sample_us;                                     /**< latest sample time */
+    uint64_t boot_us;                                       /**< boot end time, 0 when idle */
+    int16_t out[3];                                         /**< latest sample */
+    int16_t fifo[SIM_FIFO_DEPTH][3];                        /**< fifo samples */
+    uint8_t head;                                           /**< oldest fifo sample */
+    uint8_t count;                                          /**< stored fifo samples */
+    uint8_t triggered;                                      /**< trigger seen in a triggered fifo mode */
+    uint8_t popped;                                         /**< samples popped by the current burst */
+    uint8_t ig_src;                                         /**< interrupt generator source */
+    uint8_t ig_on;                                          /**< samples with the condition true */
+    uint8_t ig_off;                                         /**< samples with the condition false */
+    uint8_t level[2];                                       /**< pin levels */
+    uint8_t edge_pin[SIM_EDGE_DEPTH];                       /**< pending edge pins */
+    uint8_t edge_level[SIM_EDGE_DEPTH];                     /**< pending edge levels */
+    uint8_t edge_head;                                      /**< edge queue head */
+    uint8_t edge_count;                                     /**< edge queue count */
+    uint8_t busy;                                           /**< edge callback running */
+    uint8_t async_pending;                                  /**< async transfer in flight */
+    uint8_t async_res;                                      /**< result of the async transfer */
+    uint8_t async_fail;                                     /**< async starts left to refuse */
+    uint8_t address_pin;                                    /**< sdo / sa0 strap */
+    float temperature;                                      /**< die temperature */
+    int32_t odr_ppm;                                        /**< oscillator error in ppm */
+    float zero_rate[3];                                     /**< zero rate level in dps */
+    float zero_rate_drift[3];                               /**< zero rate level change in dps per degree */
+    float noise;                                            /**< rate noise in dps rms */
+    uint32_t seed;                                          /**< noise generator state */
+    void (*source)(uint64_t us, float dps[3]);              /**< angular rate source */
+    void (*edge)(sim_pin_t pin, uint8_t level);             /**< edge callback */
+    sim_stats_t stats;                                      /**< statistics */
+} sim_t;
+
+/**
+ * @brief sim state definition
+ */
+static sim_t gs_sim =
+{
+    .temperature = 25.0f,
+};
+
+/**
+ * @brief     default angular rate profile
+ * @param[in] us virtual time in us
+ * @param[in] *dps pointer to an angular rate buffer
+ * @note      0.5Hz 100dps sine on every axis with 120 degrees between the axes
+ */
+static void a_sim_default_source(uint64_t us, float dps[3])
+{
+    double w;
+
+    /* angular frequency */
+    w = 2.0 * SIM_PI * 0.5 * ((double)us / 1000000.0);
+    dps[0] = (float)(100.0 * sin(w));
+    dps[1] = (float)(100.0 * sin(w + 2.0 * SIM_PI / 3.0));
+    dps[2] = (float)(100.0 * sin(w + 4.0 * SIM_PI / 3.0));
+}
+
+/**
+ * @brief  draw one noise value
+ * @return uniform value with unit rms
+ * @note   xorshift32, the sequence is the same on every run
+ */
+static float a_sim_noise(void)
+{
+    uint32_t x;
+
+    x = (gs_sim.seed != 0) ? gs_sim.seed : 0x2545F491U;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    gs_sim.seed = x;
+
+    /* uniform in -sqrt(3) .. sqrt(3) */
+    return (float)(((double)x / 4294967295.0 * 2.0 - 1.0) * 1.7320508);
+}
+
+/**
+ * @brief  get the sample period of the current configuration
+ * @return period in us, 0 when no sample is produced
+ * @note   none
+ */
+static uint32_t a_sim_period(void)
+{
+    const uint32_t normal[4] = {10000, 5000, 2500, 1250};
+    const uint32_t low[4] = {80000, 40000, 20000, 20000};
+    uint8_t ctrl1;
+    uint32_t period;
+
+    /* power down or sleep */
+    ctrl1 = gs_sim.reg[SIM_REG_CTRL1];
+    if (((ctrl1 & (1 << 3)) == 0) || ((ctrl1 & 0x07) == 0))
+    {
+        return 0;
+    }
+
+    /* low odr selects the low rates */
+    if ((gs_sim.reg[SIM_REG_LOW_ODR] & (1 << 0)) != 0)
+    {
+        period = low[ctrl1 >> 6];
+    }
+    else
+    {
+        period = normal[ctrl1 >> 6];
+    }
+
+    /* a slow oscillator stretches the period, rounded to the virtual clock */
+    return (uint32_t)(((int64_t)period * (1000000 + gs_sim.odr_ppm) + 500000) / 1000000);
+}
+
+/**
+ * @brief restart the sample clock when the period changes
+ * @note  none
+ */
+static void a_sim_schedule(void)
+{
+    uint32_t period;
+
+    period = a_sim_period();
+    if (period != gs_sim.period_us)
+    {
+        gs_sim.period_us = period;
+        gs_sim.next_us = gs_sim.time_us + period;
+    }
+}
+
+/**
+ * @brief clear the fifo
+ * @note  none
+ */
+static void a_sim_fifo_flush(void)
+{
+    gs_sim.head = 0;
+    gs_sim.count = 0;
+    gs_sim.triggered = 0;
+}
+
+/**
+ * @brief  get the fifo collect state
+ * @return collect state
+ * @note   none
+ */
+static uint8_t a_sim_fifo_collect(void)
+{
+    /* fifo disabled */
+    if ((gs_sim.reg[SIM_REG_CTRL5] & (1 << 6)) == 0)
+    {
+        return SIM_COLLECT_NONE;
+    }
+
+    switch (gs_sim.reg[SIM_REG_FIFO_CTRL] >> 5)
+    {
+        case SIM_FIFO_MODE_FIFO :
+        {
+            return SIM_COLLECT_FIFO;
+        }
+        case SIM_FIFO_MODE_STREAM :
+        case SIM_FIFO_MODE_DYNAMIC_STREAM :
+        {
+            return SIM_COLLECT_STREAM;
+        }
+        case SIM_FIFO_MODE_STREAM_TO_FIFO :
+        {
+            return (gs_sim.triggered != 0) ? SIM_COLLECT_FIFO : SIM_COLLECT_STREAM;
+        }
+        case SIM_FIFO_MODE_BYPASS_TO_STREAM :
+        {
+            return (gs_sim.triggered != 0) ? SIM_COLLECT_STREAM : SIM_COLLECT_NONE;
+        }
+        case SIM_FIFO_MODE_BYPASS_TO_FIFO :
+        {
+            return (gs_sim.triggered != 0) ? SIM_COLLECT_FIFO : SIM_COLLECT_NONE;
+        }
+        default :
+        {
+            return SIM_COLLECT_NONE;
+        }
+    }
+}
+
+/**
+ * @brief  check if the output registers read from the fifo
+ * @return 1 if the fifo is read
+ * @note   none
+ */
+static uint8_t a_sim_fifo_read_mode(void)
+{
+    return (((gs_sim.reg[SIM_REG_CTRL5] & (1 << 6)) != 0) &&
+            ((gs_sim.reg[SIM_REG_FIFO_CTRL] >> 5) != SIM_FIFO_MODE_BYPASS)) ? 1 : 0;
+}
+
+/**
+ * @brief  get the fifo depth
+ * @return depth in samples
+ * @note   stop on fifo threshold limits the depth to the threshold
+ */
+static uint8_t a_sim_fifo_depth(void)
+{
+    uint8_t wtm;
+
+    wtm = gs_sim.reg[SIM_REG_FIFO_CTRL] & 0x1F;
+    if (((gs_sim.reg[SIM_REG_CTRL5] & (1 << 5)) != 0) && (wtm != 0))
+    {
+        return wtm;
+    }
+
+    return SIM_FIFO_DEPTH;
+}
+
+/**
+ * @brief  get the fifo source register
+ * @return fifo source register
+ * @note   none
+ */
+static uint8_t a_sim_fifo_src(void)
+{
+    uint8_t src;
+    uint8_t wtm;
+
+    /* no status without the fifo */
+    if ((gs_sim.reg[SIM_REG_CTRL5] & (1 << 6)) == 0)
+    {
+        return 0;
+    }
+
+    wtm = gs_sim.reg[SIM_REG_FIFO_CTRL] & 0x1F;
+    src = (gs_sim.count < 0x1F) ? gs_sim.count : 0x1F;
+    if (gs_sim.count >= wtm)
+    {
+        src |= 1 << 7;
+    }
+    if (gs_sim.count >= a_sim_fifo_depth())
+    {
+        src |= 1 << 6;
+    }
+    if (gs_sim.count == 0)
+    {
+        src |= 1 << 5;
+    }
+
+    return src;
+}
+
+/**
+ * @brief     store a sample in the fifo
+ * @param[in] *raw pointer to a sample
+ * @note      none
+ */
+static void a_sim_fifo_push(const int16_t raw[3])
+{
+    uint8_t collect;
+    uint8_t depth;
+
+    collect = a_sim_fifo_collect();
+    if (collect == SIM_COLLECT_NONE)
+    {
+        return;
+    }
+
+    depth = a_sim_fifo_depth();
+    if (gs_sim.count >= depth)
+    {
+        gs_sim.stats.fifo_dropped++;
+        if (collect == SIM_COLLECT_FIFO)
+        {
+            /* fifo mode stops when full */
+            return;
+        }
+
+        /* stream mode discards the oldest sample */
+        gs_sim.head = (uint8_t)((gs_sim.head + 1) % SIM_FIFO_DEPTH);
+        gs_sim.count--;
+    }
+    memcpy(gs_sim.fifo[(gs_sim.head + gs_sim.count) % SIM_FIFO_DEPTH], raw, sizeof(int16_t) * 3);
+    gs_sim.count++;
+}
+
+/**
+ * @brief     run the interrupt generator on a new sample
+ * @param[in] *raw pointer to a sample
+ * @note      events compare the absolute rate with the axis threshold, the duration counts samples
+ */
+static void a_sim_ig_update(const int16_t raw[3])
+{
+    uint8_t cfg;
+    uint8_t flags;
+    uint8_t enable;
+    uint8_t hit;
+    uint8_t cond;
+    uint8_t duration;
+    uint8_t active;
+    uint8_t i;
+
+    cfg = gs_sim.reg[SIM_REG_IG_CFG];
+    flags = 0;
+    for (i = 0; i < 3; i++)
+    {
+        uint16_t ths;
+        int32_t mag;
+
+        ths = (uint16_t)(((gs_sim.reg[SIM_REG_IG_THS_XH + 2 * i] & 0x7F) << 8) | gs_sim.reg[SIM_REG_IG_THS_XH + 2 * i + 1]);
+        mag = (raw[i] < 0) ? -(int32_t)raw[i] : (int32_t)raw[i];
+        if (mag > ths)
+        {
+            flags |= (uint8_t)(1 << (2 * i + 1));
+        }
+        else
+        {
+            flags |= (uint8_t)(1 << (2 * i));
+        }
+    }
+
+    /* combine the enabled events */
+    enable = cfg & 0x3F;
+    hit = flags & enable;
+    if (enable == 0)
+    {
+        cond = 0;
+    }
+    else if ((cfg & (1 << 7)) != 0)
+    {
+        cond = (hit == enable) ? 1 : 0;
+    }
+    else
+    {
+        cond = (hit != 0) ? 1 : 0;
+    }
+
+    /* latched source is kept until it is read */
+    active = (gs_sim.ig_src & (1 << 6)) != 0;
+    if (active && ((cfg & (1 << 6)) != 0))
+    {
+        return;
+    }
+
+    duration = gs_sim.reg[SIM_REG_IG_DURATION] & 0x7F;
+    if (cond != 0)
+    {
+        gs_sim.ig_off = 0;
+        if (gs_sim.ig_on < 0xFF)
+        {
+            gs_sim.ig_on++;
+        }
+        if (gs_sim.ig_on > duration)
+        {
+            active = 1;
+        }
+    }
+    else
+    {
+        /* counter mode decrements or resets the duration counter */
+        if ((gs_sim.reg[SIM_REG_IG_THS_XH] & (1 << 7)) != 0)
+        {
+            if (gs_sim.ig_on != 0)
+            {
+                gs_sim.ig_on--;
+            }
+        }
+        else
+        {
+            gs_sim.ig_on = 0;
+        }
+
+        /* wait keeps the interrupt for the duration */
+        if (active && ((gs_sim.reg[SIM_REG_IG_DURATION] & (1 << 7)) != 0))
+        {
+            if (gs_sim.ig_off < 0xFF)
+            {
+                gs_sim.ig_off++;
+            }
+            if (gs_sim.ig_off > duration)
+            {
+                active = 0;
+            }
+        }
+        else
+        {
+            active = 0;
+        }
+    }
+
+    if (active)
+    {
+        /* the interrupt triggers the triggered fifo modes */
+        gs_sim.triggered = 1;
+        gs_sim.ig_src = (uint8_t)((1 << 6) | hit);
+    }
+    else
+    {
+        gs_sim.ig_src = hit;
+    }
+}
+
+/**
+ * @brief produce one sample
+ * @note  none
+ */
+static void a_sim_sample(void)
+{
+    float dps[3];
+    float sensitivity;
+    uint8_t ctrl1;
+    uint8_t status;
+    uint8_t i;
+    const uint8_t axis_enable[3] = {1 << 1, 1 << 0, 1 << 2};
+
+    /* full scale */
+    switch ((gs_sim.reg[SIM_REG_CTRL4] >> 4) & 0x03)
+    {
+        case 0 :
+        {
+            sensitivity = 8.75f;
+
+            break;
+        }
+        case 1 :
+        {
+            sensitivity = 17.5f;
+
+            break;
+        }
+        default :
+        {
+            sensitivity = 70.0f;
+
+            break;
+        }
+    }
+
+    /* convert the angular rate */
+    if (gs_sim.source != NULL)
+    {
+        gs_sim.source(gs_sim.time_us, dps);
+    }
+    else
+    {
+        a_sim_default_source(gs_sim.time_us, dps);
+    }
+    for (i = 0; i < 3; i++)
+    {
+        dps[i] += gs_sim.zero_rate[i] + gs_sim.zero_rate_drift[i] * (gs_sim.temperature - 25.0f) +
+                  gs_sim.noise * a_sim_noise();
+    }
+
+    /* the high pass filter in reference mode subtracts the reference */
+    if (((gs_sim.reg[SIM_REG_CTRL5] & (1 << 4)) != 0) && ((gs_sim.reg[SIM_REG_CTRL5] & 0x03) != 0) &&
+        (((gs_sim.reg[SIM_REG_CTRL2] >> 4) & 0x03) == 0x01))
+    {
+        for (i = 0; i < 3; i++)
+        {
+            dps[i] -= (float)(int8_t)gs_sim.reg[SIM_REG_REFERENCE] * SIM_REFERENCE_DPS;
+        }
+    }
+    ctrl1 = gs_sim.reg[SIM_REG_CTRL1];
+    status = gs_sim.reg[SIM_REG_STATUS];
+    for (i = 0; i < 3; i++)
+    {
+        float v;
+
+        /* disabled axes keep the last value */
+        if ((ctrl1 & axis_enable[i]) == 0)
+        {
+            continue;
+        }
+        v = roundf(dps[i] * 1000.0f / sensitivity);
+        if (v > 32767.0f)
+        {
+            v = 32767.0f;
+        }
+        if (v < -32768.0f)
+        {
+            v = -32768.0f;
+        }
+        gs_sim.out[i] = (int16_t)v;
+
+        /* data ready and overrun per axis */
+        if ((status & (1 << i)) != 0)
+        {
+            status |= (uint8_t)(1 << (i + 4));
+        }
+        status |= (uint8_t)(1 << i);
+    }
+    if ((status & (1 << 3)) != 0)
+    {
+        status |= 1 << 7;
+    }
+    status |= 1 << 3;
+    gs_sim.reg[SIM_REG_STATUS] = status;
+    gs_sim.sample_us = gs_sim.time_us;
+    gs_sim.stats.samples++;
+
+    /* the interrupt runs first so the trigger sample enters the fifo */
+    a_sim_ig_update(gs_sim.out);
+    a_sim_fifo_push(gs_sim.out);
+}
+
+/**
+ * @brief update the interrupt pins and run the edge callback
+ * @note  edges raised inside the callback are queued and delivered after it returns
+ */
+static void a_sim_update_pins(void)
+{
+    uint8_t ctrl3;
+    uint8_t src;
+    uint8_t active[2];
+    uint8_t i;
+
+    ctrl3 = gs_sim.reg[SIM_REG_CTRL3];
+    src = a_sim_fifo_src();
+
+    /* int1 carries the interrupt generator and the boot status */
+    active[0] = ((((ctrl3 & (1 << 7)) != 0) && ((gs_sim.ig_src & (1 << 6)) != 0)) ||
+                 (((ctrl3 & (1 << 6)) != 0) && (gs_sim.boot_us != 0))) ? 1 : 0;
+
+    /* int2 carries data ready and the fifo flags */
+    active[1] = ((((ctrl3 & (1 << 3)) != 0) && ((gs_sim.reg[SIM_REG_STATUS] & (1 << 3)) != 0)) ||
+                 (((ctrl3 & (1 << 2)) != 0) && ((src & (1 << 7)) != 0)) ||
+                 (((ctrl3 & (1 << 1)) != 0) && ((src & (1 << 6)) != 0)) ||
+                 (((ctrl3 & (1 << 0)) != 0) && ((src & (1 << 5)) != 0))) ? 1 : 0;
+
+    /* active low inverts the level */
+    if ((ctrl3 & (1 << 5)) != 0)
+    {
+        active[0] = !active[0];
+    }
+    if ((gs_sim.reg[SIM_REG_LOW_ODR] & (1 << 5)) != 0)
+    {
+        active[1] = !active[1];
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        if (active[i] != gs_sim.level[i])
+        {
+            gs_sim.level[i] = active[i];
+            if (i == 0)
+            {
+                gs_sim.stats.int1_edges++;
+            }
+            else
+            {
+                gs_sim.stats.int2_edges++;
+            }
+            if (gs_sim.edge_count < SIM_EDGE_DEPTH)
+            {
+                uint8_t pos;
+
+                pos = (uint8_t)((gs_sim.edge_head + gs_sim.edge_count) % SIM_EDGE_DEPTH);
+                gs_sim.edge_pin[pos] = i;
+                gs_sim.edge_level[pos] = active[i];
+                gs_sim.edge_count++;
+            }
+        }
+    }
+
+    /* deliver from the outermost call only */
+    if (gs_sim.busy != 0)
+    {
+        return;
+    }
+    gs_sim.busy = 1;
+    while (gs_sim.edge_count != 0)
+    {
+        uint8_t pin;
+        uint8_t level;
+
+        pin = gs_sim.edge_pin[gs_sim.edge_head];
+        level = gs_sim.edge_level[gs_sim.edge_head];
+        gs_sim.edge_head = (uint8_t)((gs_sim.edge_head + 1) % SIM_EDGE_DEPTH);
+        gs_sim.edge_count--;
+        if (gs_sim.edge != NULL)
+        {
+            gs_sim.edge((sim_pin_t)pin, level);
+        }
+    }
+    gs_sim.busy = 0;
+}
+
+/**
+ * @brief reset the register file and the core state
+ * @note  none
+ */
+static void a_sim_reset_regs(void)
+{
+    memset(gs_sim.reg, 0, sizeof(gs_sim.reg));
+    gs_sim.reg[SIM_REG_WHO_AM_I] = 0xD7;
+    gs_sim.reg[SIM_REG_CTRL1] = 0x07;
+    memset(gs_sim.out, 0, sizeof(gs_sim.out));
+    a_sim_fifo_flush();
+    gs_sim.popped = 0;
+    gs_sim.ig_src = 0;
+    gs_sim.ig_on = 0;
+    gs_sim.ig_off = 0;
+    gs_sim.boot_us = 0;
+    a_sim_schedule();
+}
+
+/**
+ * @brief     read one register
+ * @param[in] addr register address
+ * @return    register value
+ * @note      reading the output, status and source registers has side effects
+ */
+static uint8_t a_sim_read_reg(uint8_t addr)
+{
+    switch (addr)
+    {
+        case SIM_REG_OUT_TEMP :
+        {
+            return (uint8_t)(int8_t)lroundf(25.0f - gs_sim.temperature);
+        }
+        case SIM_REG_FIFO_SRC :
+        {
+            return a_sim_fifo_src();
+        }
+        case SIM_REG_IG_SRC :
+        {
+            uint8_t src;
+
+            /* reading clears a latched interrupt */
+            src = gs_sim.ig_src;
+            if ((gs_sim.reg[SIM_REG_IG_CFG] & (1 << 6)) != 0)
+            {
+                gs_sim.ig_src = 0;
+                gs_sim.ig_on = 0;
+            }
+
+            return src;
+        }
+        default :
+        {
+            break;
+        }
+    }
+
+    if ((addr >= SIM_REG_OUT_X_L) && (addr <= SIM_REG_OUT_Z_H))
+    {
+        const int16_t *sample;
+        uint8_t index;
+        uint8_t axis;
+        uint16_t value;
+        uint8_t fifo;
+
+        /* fifo modes read the oldest stored sample */
+        fifo = (a_sim_fifo_read_mode() != 0) && (gs_sim.count != 0);
+        sample = (fifo != 0) ? gs_sim.fifo[gs_sim.head] : gs_sim.out;
+        index = addr - SIM_REG_OUT_X_L;
+        axis = index / 2;
+        value = (uint16_t)sample[axis];
+        if (((gs_sim.reg[SIM_REG_CTRL4] & (1 << 6)) != 0) == ((index & 0x01) == 0))
+        {
+            value >>= 8;
+        }
+
+        /* the high address of an axis clears its flags */
+        if ((index & 0x01) != 0)
+        {
+            gs_sim.reg[SIM_REG_STATUS] &= (uint8_t)~((1 << axis) | (1 << (axis + 4)));
+            if ((gs_sim.reg[SIM_REG_STATUS] & 0x07) == 0)
+            {
+                gs_sim.reg[SIM_REG_STATUS] &= (uint8_t)~((1 << 3) | (1 << 7));
+            }
+        }
+
+        /* the last address pops the sample */
+        if ((fifo != 0) && (addr == SIM_REG_OUT_Z_H))
+        {
+            gs_sim.head = (uint8_t)((gs_sim.head + 1) % SIM_FIFO_DEPTH);
+            gs_sim.count--;
+            gs_sim.popped++;
+        }
+
+        return (uint8_t)(value & 0xFF);
+    }
+
+    return gs_sim.reg[addr];
+}
+
+/**
+ * @brief     write one register
+ * @param[in] addr register address
+ * @param[in] value register value
+ * @note      read only and reserved bits are ignored
+ */
+static void a_sim_write_reg(uint8_t addr, uint8_t value)
+{
+    uint8_t mask;
+    uint8_t prev;
+
+    if ((addr >= SIM_REG_CTRL1) && (addr <= SIM_REG_REFERENCE))
+    {
+        mask = 0xFF;
+    }
+    else if ((addr == SIM_REG_FIFO_CTRL) || (addr == SIM_REG_IG_CFG) ||
+             ((addr >= SIM_REG_IG_THS_XH) && (addr <= SIM_REG_IG_DURATION)))
+    {
+        mask = 0xFF;
+    }
+    else if (addr == SIM_REG_LOW_ODR)
+    {
+        mask = 0x2D;
+    }
+    else
+    {
+        return;
+    }
+    prev = gs_sim.reg[addr];
+    gs_sim.reg[addr] = (uint8_t)((prev & ~mask) | (value & mask));
+
+    switch (addr)
+    {
+        case SIM_REG_CTRL1 :
+        {
+            a_sim_schedule();
+
+            break;
+        }
+        case SIM_REG_CTRL5 :
+        {
+            /* reboot the memory content */
+            if (((value & (1 << 7)) != 0) && (gs_sim.boot_us == 0))
+            {
+                gs_sim.boot_us = gs_sim.time_us + SIM_BOOT_US;
+            }
+
+            /* disabling the fifo clears it */
+            if ((value & (1 << 6)) == 0)
+            {
+                a_sim_fifo_flush();
+            }
+
+            break;
+        }
+        case SIM_REG_FIFO_CTRL :
+        {
+            /* bypass resets the fifo and a new mode rearms the trigger */
+            if ((value >> 5) == SIM_FIFO_MODE_BYPASS)
+            {
+                a_sim_fifo_flush();
+            }
+            else if ((value >> 5) != (prev >> 5))
+            {
+                gs_sim.triggered = 0;
+            }
+
+            break;
+        }
+        case SIM_REG_LOW_ODR :
+        {
+            /* software reset restores every register and clears itself */
+            if ((value & (1 << 2)) != 0)
+            {
+                a_sim_reset_regs();
+            }
+            else
+            {
+                a_sim_schedule();
+            }
+
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief      run a read transfer
+ * @param[in]  addr first register address
+ * @param[in]  inc address increment flag
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @note       with the fifo enabled the increment wraps from out z high to out x low
+ */
+static void a_sim_read(uint8_t addr, uint8_t inc, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+
+    gs_sim.popped = 0;
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = a_sim_read_reg(addr);
+        if (inc != 0)
+        {
+            if ((addr == SIM_REG_OUT_Z_H) && ((gs_sim.reg[SIM_REG_CTRL5] & (1 << 6)) != 0))
+            {
+                addr = SIM_REG_OUT_X_L;
+            }
+            else
+            {
+                addr = (uint8_t)((addr + 1) & 0x7F);
+            }
+        }
+    }
+
+    /* dynamic stream restarts from the next new sample after a burst */
+    if ((gs_sim.popped != 0) && ((gs_sim.reg[SIM_REG_FIFO_CTRL] >> 5) == SIM_FIFO_MODE_DYNAMIC_STREAM))
+    {
+        gs_sim.stats.fifo_dropped += gs_sim.count;
+        gs_sim.head = 0;
+        gs_sim.count = 0;
+    }
+    gs_sim.stats.transactions++;
+    gs_sim.stats.read_bytes += len;
+    a_sim_update_pins();
+}
+
+/**
+ * @brief     run a write transfer
+ * @param[in] addr first register address
+ * @param[in] inc address increment flag
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @note      none
+ */
+static void a_sim_write(uint8_t addr, uint8_t inc, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        a_sim_write_reg(addr, buf[i]);
+        if (inc != 0)
+        {
+            addr = (uint8_t)((addr + 1) & 0x7F);
+        }
+    }
+    gs_sim.stats.transactions++;
+    gs_sim.stats.write_bytes += len;
+    a_sim_update_pins();
+}
+
+/**
+ * @brief  power up the simulated device
+ * @return status code
+ *         - 0 success
+ * @note   the first call resets the register file and the virtual clock, later calls keep the state
+ *         like a device that stays powered between two driver inits
+ */
+uint8_t sim_power_up(void)
+{
+    if (gs_sim.powered == 0)
+    {
+        gs_sim.powered = 1;
+        gs_sim.time_us = 0;
+        gs_sim.period_us = 0;
+        memset(gs_sim.level, 0, sizeof(gs_sim.level));
+        memset(&gs_sim.stats, 0, sizeof(sim_stats_t));
+        a_sim_reset_regs();
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  reset the simulated device to its power on state
+ * @return status code
+ *         - 0 success
+ * @note   the angular rate source, the temperature and the edge callback are kept
+ */
+uint8_t sim_reset(void)
+{
+    gs_sim.powered = 1;
+    a_sim_reset_regs();
+    a_sim_update_pins();
+
+    return 0;
+}
+
+/**
+ * @brief     set the level of the sdo / sa0 strap
+ * @param[in] level strap level
+ * @note      the device only answers the iic address selected by the strap
+ */
+void sim_set_address_pin(uint8_t level)
+{
+    gs_sim.address_pin = (level != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     set the angular rate source
+ * @param[in] *source pointer to a source function, NULL restores the default profile
+ * @note      the source returns the angular rate in dps at the virtual time in us
+ */
+void sim_set_source(void (*source)(uint64_t us, float dps[3]))
+{
+    gs_sim.source = source;
+}
+
+/**
+ * @brief     set the die temperature
+ * @param[in] degree temperature in degrees celsius
+ * @note      none
+ */
+void sim_set_temperature(float degree)
+{
+    gs_sim.temperature = degree;
+}
+
+/**
+ * @brief     set the oscillator error
+ * @param[in] ppm output data rate error in ppm, positive values slow the device down
+ * @note      the sample period is rounded to 1 us, the error takes effect on the next rate change
+ */
+void sim_set_odr_error(int32_t ppm)
+{
+    gs_sim.odr_ppm = ppm;
+}
+
+/**
+ * @brief     set the zero rate level
+ * @param[in] *dps pointer to a zero rate level buffer in dps, NULL clears the level
+ * @note      the level is added to the source on every axis
+ */
+void sim_set_zero_rate(const float dps[3])
+{
+    uint8_t i;
+
+    for (i = 0; i < 3; i++)
+    {
+        gs_sim.zero_rate[i] = (dps != NULL) ? dps[i] : 0.0f;
+    }
+}
+
+/**
+ * @brief     set the zero rate level change with the temperature
+ * @param[in] *dps pointer to a drift buffer in dps per degree, NULL clears the drift
+ * @note      the level changes linearly around 25 degrees
+ */
+void sim_set_zero_rate_drift(const float dps[3])
+{
+    uint8_t i;
+
+    for (i = 0; i < 3; i++)
+    {
+        gs_sim.zero_rate_drift[i] = (dps != NULL) ? dps[i] : 0.0f;
+    }
+}
+
+/**
+ * @brief     set the rate noise
+ * @param[in] dps noise in dps rms, 0 disables the noise
+ * @note      the noise is white and uniform
+ */
+void sim_set_noise(float dps)
+{
+    gs_sim.noise = dps;
+}
+
+/**
+ * @brief     set the pin edge callback
+ * @param[in] *callback pointer to an edge callback, NULL disables the callback
+ * @note      the callback runs on every level change of int1 or int2 and may access the bus
+ */
+void sim_set_edge_callback(void (*callback)(sim_pin_t pin, uint8_t level))
+{
+    gs_sim.edge = callback;
+}
+
+/**
+ * @brief     get the current pin level
+ * @param[in] pin interrupt pin
+ * @return    pin level
+ * @note      none
+ */
+uint8_t sim_get_pin(sim_pin_t pin)
+{
+    return gs_sim.level[(pin == SIM_PIN_INT1) ? 0 : 1];
+}
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] us time in us
+ * @note      samples are produced at every odr period that elapses
+ */
+void sim_advance_us(uint64_t us)
+{
+    uint64_t target;
+
+    target = gs_sim.time_us + us;
+    while (1)
+    {
+        uint64_t t;
+
+        /* find the next event */
+        t = target + 1;
+        if ((gs_sim.period_us != 0) && (gs_sim.next_us < t))
+        {
+            t = gs_sim.next_us;
+        }
+        if ((gs_sim.boot_us != 0) && (gs_sim.boot_us < t))
+        {
+            t = gs_sim.boot_us;
+        }
+        if (t > target)
+        {
+            break;
+        }
+        gs_sim.time_us = t;
+
+        /* boot done */
+        if ((gs_sim.boot_us != 0) && (gs_sim.boot_us <= t))
+        {
+            gs_sim.boot_us = 0;
+            gs_sim.reg[SIM_REG_CTRL5] &= (uint8_t)~(1 << 7);
+        }
+
+        /* sample */
+        if ((gs_sim.period_us != 0) && (gs_sim.next_us <= t))
+        {
+            gs_sim.next_us += gs_sim.period_us;
+            a_sim_sample();
+        }
+        a_sim_update_pins();
+    }
+
+    /* a nested delay may already be past the target */
+    if (target > gs_sim.time_us)
+    {
+        gs_sim.time_us = target;
+    }
+}
+
+/**
+ * @brief  get the virtual clock
+ * @return time in us
+ * @note   none
+ */
+uint64_t sim_get_time_us(void)
+{
+    return gs_sim.time_us;
+}
+
+/**
+ * @brief  get the time of the latest sample
+ * @return time in us
+ * @note   none
+ */
+uint64_t sim_get_sample_time_us(void)
+{
+    return gs_sim.sample_us;
+}
+
+/**
+ * @brief  get the sample period
+ * @return period in us, 0 when no sample is produced
+ * @note   the period includes the oscillator error
+ */
+uint32_t sim_get_period_us(void)
+{
+    return gs_sim.period_us;
+}
+
+/**
+ * @brief      get the statistics
+ * @param[out] *stats pointer to a statistics structure
+ * @note       none
+ */
+void sim_get_stats(sim_stats_t *stats)
+{
+    memcpy(stats, &gs_sim.stats, sizeof(sim_stats_t));
+}
+
+/**
+ * @brief clear the statistics
+ * @note  none
+ */
+void sim_clear_stats(void)
+{
+    memset(&gs_sim.stats, 0, sizeof(sim_stats_t));
+}
+
+/**
+ * @brief      iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg register address, bit 7 enables the address increment
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t sim_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    /* nack a wrong address or a disabled iic */
+    if ((gs_sim.powered == 0) || (addr != (0xD4 | (gs_sim.address_pin << 1))) ||
+        ((gs_sim.reg[SIM_REG_LOW_ODR] & (1 << 3)) != 0))
+    {
+        return 1;
+    }
+    a_sim_read(reg & 0x7F, reg & 0x80, buf, len);
+
+    return 0;
+}
+
+/**
+ * @brief     iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg register address, bit 7 enables the address increment
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t sim_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    /* nack a wrong address or a disabled iic */
+    if ((gs_sim.powered == 0) || (addr != (0xD4 | (gs_sim.address_pin << 1))) ||
+        ((gs_sim.reg[SIM_REG_LOW_ODR] & (1 << 3)) != 0))
+    {
+        return 1;
+    }
+    a_sim_write(reg & 0x7F, reg & 0x80, buf, len);
+
+    return 0;
+}
+
+/**
+ * @brief      spi bus read
+ * @param[in]  reg register address, bit 7 is the read bit and bit 6 enables the address increment
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t sim_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    /* a read needs the read bit */
+    if ((gs_sim.powered == 0) || ((reg & 0x80) == 0))
+    {
+        return 1;
+    }
+    a_sim_read(reg & 0x3F, reg & 0x40, buf, len);
+
+    return 0;
+}
+
+/**
+ * @brief     spi bus write
+ * @param[in] reg register address, bit 6 enables the address increment
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t sim_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    /* a write must not carry the read bit */
+    if ((gs_sim.powered == 0) || ((reg & 0x80) != 0))
+    {
+        return 1;
+    }
+    a_sim_write(reg & 0x3F, reg & 0x40, buf, len);
+
+    return 0;
+}
+
+/**
+ * @brief  take the async channel
+ * @return status code
+ *         - 0 success
+ *         - 1 start refused
+ * @note   one transfer is in flight at a time like a single dma channel
+ */
+static uint8_t a_sim_async_start(void)
+{
+    if (gs_sim.async_pending != 0)
+    {
+        return 1;
+    }
+    if (gs_sim.async_fail != 0)
+    {
+        gs_sim.async_fail--;
+
+        return 1;
+    }
+    gs_sim.async_pending = 1;
+
+    return 0;
+}
+
+/**
+ * @brief     refuse the next async starts
+ * @param[in] count number of starts to refuse
+ * @note      none
+ */
+void sim_set_async_fail(uint8_t count)
+{
+    gs_sim.async_fail = count;
+}
+
+/**
+ * @brief      complete the async transfer in flight
+ * @param[out] *res pointer to a transfer result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no transfer is in flight
+ * @note       the channel is free again before the caller runs the driver completion handler
+ */
+uint8_t sim_async_complete(uint8_t *res)
+{
+    if (gs_sim.async_pending == 0)
+    {
+        return 1;
+    }
+    gs_sim.async_pending = 0;
+    *res = gs_sim.async_res;
+
+    return 0;
+}
+
+/**
+ * @brief      iic bus async read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg register address, bit 7 enables the address increment
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 start failed
+ * @note       the data is moved at the start, sim_async_complete reports the bus result
+ */
+uint8_t sim_iic_read_async(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (a_sim_async_start() != 0)
+    {
+        return 1;
+    }
+    gs_sim.async_res = sim_iic_read(addr, reg, buf, len);
+
+    return 0;
+}
+
+/**
+ * @brief     iic bus async write
+ * @param[in] addr iic device write address
+ * @param[in] reg register address, bit 7 enables the address increment
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the data is moved at the start, sim_async_complete reports the bus result
+ */
+uint8_t sim_iic_write_async(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (a_sim_async_start() != 0)
+    {
+        return 1;
+    }
+    gs_sim.async_res = sim_iic_write(addr, reg, buf, len);
+
+    return 0;
+}
+
+/**
+ * @brief      spi bus async read
+ * @param[in]  reg register address, bit 7 is the read bit and bit 6 enables the address increment
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 start failed
+ * @note       the data is moved at the start, sim_async_complete reports the bus result
+ */
+uint8_t sim_spi_read_async(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (a_sim_async_start() != 0)
+    {
+        return 1;
+    }
+    gs_sim.async_res = sim_spi_read(reg, buf, len);
+
+    return 0;
+}
+
+/**
+ * @brief     spi bus async write
+ * @param[in] reg register address, bit 6 enables the address increment
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the data is moved at the start, sim_async_complete reports the bus result
+ */
+uint8_t sim_spi_write_async(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (a_sim_async_start() != 0)
+    {
+        return 1;
+    }
+    gs_sim.async_res = sim_spi_write(reg, buf, len);
+
+    return 0;
+}
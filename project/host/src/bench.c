@@ -0,0 +1,3812 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      bench.c
+ * @brief     bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_interface.h"
+#include "driver_l3gd20h_attitude.h"
+#include "driver_l3gd20h_counter.h"
+#include "driver_l3gd20h_decimate.h"
+#include "driver_l3gd20h_event.h"
+#include "driver_l3gd20h_filter.h"
+#include "driver_l3gd20h_ig.h"
+#include "driver_l3gd20h_power.h"
+#include "driver_l3gd20h_record.h"
+#include "driver_l3gd20h_rotate.h"
+#include "driver_l3gd20h_spectrum.h"
+#include "driver_l3gd20h_trace.h"
+#include "driver_l3gd20h_watermark.h"
+#include "sim.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief bench batch definition
+ */
+#define BENCH_BATCH        16        /**< fifo threshold and stream poll interval in samples */
+
+/**
+ * @brief bench reference register definition
+ */
+#define BENCH_REG_REFERENCE 0x25        /**< register written by the async queue check */
+
+/**
+ * @brief bench reference period definition
+ */
+#define BENCH_REFERENCE_PERIOD 1024        /**< samples between two reference calibrations */
+
+/**
+ * @brief bench timestamp limit definition
+ * @note  a polled sample lies anywhere in the period before the stamp, so a good track stays below half a
+ *        period on average, the largest single error is bounded by the relock distance of the driver
+ */
+#define BENCH_TIMESTAMP_MEAN 0.5        /**< largest mean sample time error in periods */
+
+/**
+ * @brief bench odr estimate definition
+ * @note  a read adds at most 32 samples past the drift step, so the window is full after these samples
+ */
+#define BENCH_ODR_SAMPLES (L3GD20H_TIMESTAMP_WINDOW * (L3GD20H_TIMESTAMP_STEP + 32))        /**< samples that fill the drift window */
+
+/**
+ * @brief bench bias limit definition
+ * @note  a still window of 0.1dps noise leaves a few mdps on the mean, the tracking gain smooths it further
+ */
+#define BENCH_BIAS_TOLERANCE 0.05        /**< largest tracked bias error in dps */
+
+/**
+ * @brief bench temperature definition
+ * @note  the source runs a 0 to 50 degrees triangle of 600 seconds
+ */
+#define BENCH_TEMP_SLOPE (50.0 / 300.0)        /**< temperature slope in degrees per second */
+
+/**
+ * @brief bench attitude rate definition
+ * @note  whole multiples of the 245dps lsb, so the simulated samples carry no rounding
+ */
+static const double gs_attitude_dps[3] = {35.0, -17.5, 43.75};
+
+/**
+ * @brief bench attitude limit definitions
+ * @note  the rates carry no rounding, what is left is the rounding of every integration step which adds up
+ *        with the samples, about 0.7e-6 degrees per float step at 800Hz
+ */
+#define BENCH_ATTITUDE_TOLERANCE 0.002       /**< attitude error in degrees allowed at the start */
+#define BENCH_ATTITUDE_STEP      1.0e-6      /**< attitude error in degrees allowed per integrated sample */
+
+/**
+ * @brief bench mounting tables
+ * @note  the remap turns the sensor x, y, z into -y, z, -x and is folded into the decode, the general
+ *        mount turns the output by 30 degrees about z and 20 degrees about x
+ */
+static const float gs_remap_matrix[3][3] = {{0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {-1.0f, 0.0f, 0.0f}};
+static const double gs_mount_deg[2] = {30.0, 20.0};
+
+/**
+ * @brief bench range tables
+ * @note  a rest, an impact beyond 500dps, a swing that needs 2000dps and a slow turn per 2s period, every
+ *        level and axis factor gives whole multiples of the 2000dps lsb, so every full scale decodes exactly,
+ *        the first BENCH_RANGE_SPLIT samples of a fifo read are read alone so a switch leaves samples queued
+ */
+static const double gs_range_dps[4] = {7.0, 1400.0, 420.0, 140.0};
+static const double gs_range_axis[3] = {1.0, -0.5, 0.25};
+#define BENCH_RANGE_SPLIT 5        /**< samples of the first part of a fifo read */
+
+/**
+ * @brief bench power definition
+ * @note  one half sine motion of BENCH_POWER_DPS per BENCH_POWER_PERIOD_US starts BENCH_POWER_ONSET_US into
+ *        the period and lasts BENCH_POWER_MOTION_US, the rest of the period is still
+ */
+#define BENCH_POWER_PERIOD_US 8000000ULL        /**< motion period in us */
+#define BENCH_POWER_ONSET_US  3000000ULL        /**< motion start in the period in us */
+#define BENCH_POWER_MOTION_US 1000000ULL        /**< motion length in us */
+#define BENCH_POWER_DPS       120.0             /**< motion peak in dps */
+
+/**
+ * @brief bench watermark definition
+ * @note  the host serves a threshold interrupt after a load that changes every second, the virtual clock
+ *        runs in BENCH_WATERMARK_STEP_US steps so a service lands at most one step late
+ */
+static const uint32_t gs_watermark_load_us[4] = {250, 2000, 6000, 1000};
+#define BENCH_WATERMARK_IRQ_HZ  100.0f        /**< largest interrupt rate in Hz */
+#define BENCH_WATERMARK_STEP_US 250           /**< virtual clock step in us */
+
+/**
+ * @brief bench spectrum tone tables
+ * @note  one tone per axis at a fraction of the output data rate, so every rate sees the same bins
+ */
+static const double gs_spectrum_ratio[3] = {0.1, 0.23, 0.31};
+static const double gs_spectrum_dps[3] = {20.0, 10.0, 5.0};
+
+/**
+ * @brief bench spectrum limit definition
+ * @note  the stage runs on the nominal rate, so a slower or faster device also moves the peak by the highest tone
+ *        times the rate error
+ */
+#define BENCH_SPECTRUM_TOLERANCE 0.1        /**< largest peak frequency error in bins */
+
+/**
+ * @brief bench filter stages definition
+ */
+#define BENCH_FILTER_STAGES 2        /**< fourth order butterworth */
+
+/**
+ * @brief bench filter limit definitions
+ * @note  the float coefficients and states of a biquad lose precision as the corner moves below the rate, with the
+ *        1dps noise the lanes leave the double biquads by about 1.5e-8dps times the rate over corner to the power 1.5
+ */
+#define BENCH_FILTER_TOLERANCE   1.0e-5        /**< filter error in dps allowed at any corner */
+#define BENCH_FILTER_SENSITIVITY 3.0e-8        /**< filter error in dps allowed per rate over corner to the power 1.5 */
+
+/**
+ * @brief bench settle definition
+ * @note  the odr to cut off ratios of the high pass cut off frequencies 0 and 1, the check reconfigures the chip
+ *        BENCH_SETTLE_STEPS times: wake, rate, output path, high pass on, high pass mode, high pass cut off,
+ *        high pass off and output path back
+ */
+static const double gs_settle_hpf_ratio[2] = {12.5, 25.0};
+#define BENCH_SETTLE_STEPS  8        /**< reconfigurations of the check */
+#define BENCH_SETTLE_QUEUED 4        /**< stream samples left in the fifo before a reconfiguration after the wake */
+
+/**
+ * @brief bench mode enumeration definition
+ */
+typedef enum
+{
+    BENCH_MODE_BYPASS = 0x00,        /**< bypass polling */
+    BENCH_MODE_DRDY   = 0x01,        /**< data ready interrupt */
+    BENCH_MODE_FIFO   = 0x02,        /**< fifo threshold interrupt */
+    BENCH_MODE_STREAM = 0x03,        /**< stream polling */
+    BENCH_MODE_MAX    = 0x04,        /**< mode number */
+} bench_mode_t;
+
+/**
+ * @brief bench backend enumeration definition
+ */
+typedef enum
+{
+    BENCH_BACKEND_SIM    = 0x00,        /**< simulated device */
+    BENCH_BACKEND_RECORD = 0x01,        /**< simulated device behind the recorder */
+    BENCH_BACKEND_REPLAY = 0x02,        /**< recorded bus trace */
+} bench_backend_t;
+
+/**
+ * @brief bench rate structure definition
+ */
+typedef struct bench_rate_s
+{
+    l3gd20h_lodr_odr_bw_t rate;           /**< rate bandwidth */
+    float odr;                            /**< output data rate in Hz */
+    uint32_t period_us;                   /**< sample period in us */
+    float bandwidth;                      /**< low pass bandwidth in Hz, 0 when not given */
+} bench_rate_t;
+
+/**
+ * @brief bench result structure definition
+ */
+typedef struct bench_result_s
+{
+    uint32_t produced;                    /**< samples produced by the device */
+    uint32_t delivered;                   /**< samples delivered by the driver */
+    uint32_t lost;                        /**< samples never delivered */
+    double transactions;                  /**< bus transactions per sample */
+    double bytes;                         /**< bus bytes per sample */
+    double ns;                            /**< wall time per sample in ns */
+    double cycles;                        /**< cpu cycles per sample */
+    double irq_ns;                        /**< interrupt edge to data in ns */
+    double age_us;                        /**< mean sample age at delivery in us */
+    double recorded_s;                    /**< recorded time of a replayed run in s */
+    double ts_us;                         /**< mean timestamp error in us */
+    double ts_max_us;                     /**< largest timestamp error in us */
+    double odr;                           /**< estimated output data rate in Hz, 0 without an estimate */
+    double odr_bound;                     /**< confidence bound of the estimate in Hz */
+    double bias;                          /**< largest bias estimate error in dps */
+    uint32_t bias_windows;                /**< still windows behind the bias */
+    int8_t reference;                     /**< reference register value */
+    double reference_error;               /**< common zero rate level left by the reference in dps */
+    uint32_t reference_runs;              /**< finished reference calibrations */
+    double attitude;                      /**< float attitude error in degrees */
+    double attitude_fixed;                /**< q30 attitude error in degrees */
+    double attitude_bank;                 /**< largest bank lane attitude error in degrees */
+    double attitude_ns;                   /**< float integration wall time per sample in ns */
+    double filter_corner;                 /**< corner frequency of the run in Hz */
+    double filter_error;                  /**< largest distance of the filter from a double reference in dps */
+    double filter_in;                     /**< rms of the filter input in dps */
+    double filter_out;                    /**< rms of the filter output in dps */
+    double filter_ns;                     /**< filter wall time per sample in ns */
+    uint32_t decimate_high;               /**< samples passed to the high rate subscriber */
+    uint32_t decimate_low;                /**< samples passed to the low rate subscriber */
+    double decimate_error;                /**< largest distance of the low rate from a double reference in lsb */
+    double decimate_in;                   /**< rms of the high rate in dps */
+    double decimate_out;                  /**< rms of the low rate in dps */
+    double decimate_ns;                   /**< decimation wall time per input sample in ns */
+    double decimate_time;                 /**< largest distance of the low rate times from the window centres in us */
+    uint32_t spectrum_results;            /**< spectrum results */
+    double spectrum_peak;                 /**< largest peak frequency error in Hz */
+    double spectrum_amplitude;            /**< largest peak amplitude error in dps */
+    double spectrum_band;                 /**< largest relative band energy error */
+    double spectrum_ns;                   /**< spectrum wall time per sample in ns */
+    uint32_t event_starts;                /**< starts of the magnitude rule */
+    uint32_t event_expected;              /**< threshold crossings of the source */
+    double event_delay_us;                /**< largest distance of a start from its crossing in us */
+    uint32_t event_change_starts;         /**< starts of the rate of change rule */
+    double event_ns;                      /**< engine wall time per sample in ns */
+    uint32_t ig_edges;                    /**< int1 edges of the simulated device */
+    uint32_t ig_model_edges;              /**< int1 edges of the model */
+    uint32_t ig_rises;                    /**< rising int1 edges of the model */
+    double ig_ns;                         /**< model wall time per sample in ns */
+    double remap_error;                   /**< largest distance of the remapped output from the truth in dps */
+    double rotate_error;                  /**< largest distance of the rotated output from a double reference in dps */
+    double rotate_ns;                     /**< rotation wall time per sample in ns */
+    uint32_t range_switches;              /**< full scale switches */
+    uint32_t range_queued;                /**< samples decoded with the full scale before a switch */
+    uint32_t range_clipped;               /**< samples at the end of the full scale */
+    double range_error;                   /**< largest distance of an unclipped sample from the source in dps */
+    uint32_t power_wakes;                 /**< watch to active switches */
+    uint32_t power_onsets;                /**< wakes whose history covers the motion start */
+    uint32_t power_expected;              /**< motion starts with a full history before and a quiet hold after them */
+    uint32_t power_pretrigger;            /**< samples delivered by the wakes */
+    double power_active;                  /**< fraction of the run in the active state */
+    double power_irqs;                    /**< serviced interrupts per second */
+    double power_bytes;                   /**< bus bytes per second */
+    uint8_t watermark_min;                /**< smallest fifo threshold */
+    uint8_t watermark_max;                /**< largest fifo threshold */
+    uint32_t watermark_retunes;           /**< fifo threshold writes of the controller updates */
+    double watermark_latency;             /**< mean latency of the oldest sample of a batch in ms */
+    double watermark_latency_max;         /**< largest latency of the oldest sample of a batch in ms */
+    uint32_t watermark_over;              /**< batches above the latency target */
+    double watermark_irqs;                /**< served interrupts per second */
+    uint32_t async_requests;              /**< completed async requests */
+    uint32_t settle_samples;              /**< settling samples dropped or tagged by the check */
+} bench_result_t;
+
+/**
+ * @brief bench state structure definition
+ */
+typedef struct bench_s
+{
+    l3gd20h_handle_t handle;              /**< l3gd20h handle */
+    uint32_t period_us;                   /**< sample period in us */
+    uint32_t delivered;                   /**< samples delivered */
+    uint64_t ns;                          /**< wall time in the driver */
+    uint64_t cycles;                      /**< cpu cycles in the driver */
+    uint64_t irq_ns;                      /**< wall time from the edges to the data */
+    uint32_t irqs;                        /**< served interrupts */
+    double age_us;                        /**< sum of the sample ages */
+    uint8_t error;                        /**< read error flag */
+    bench_backend_t backend;              /**< bus backend */
+    const char *counters;                 /**< counter dump path */
+    FILE *trace;                          /**< trace json file */
+    uint32_t trace_pid;                   /**< trace process id of the run */
+    uint32_t trace_lost;                  /**< overwritten trace entries */
+    uint8_t timestamp;                    /**< timestamp check flag */
+    l3gd20h_timestamp_t ts;               /**< sample time track */
+    double ts_us;                         /**< sum of the timestamp errors */
+    double ts_max_us;                     /**< largest timestamp error */
+    uint8_t bias;                         /**< bias tracking flag */
+    float zero_rate[3];                   /**< simulated zero rate level in dps */
+    uint8_t drift;                        /**< temperature model flag */
+    float zero_rate_drift[3];             /**< simulated zero rate drift in dps per degree */
+    uint8_t reference;                    /**< reference calibration flag */
+    uint8_t attitude;                     /**< attitude integration flag */
+    l3gd20h_attitude_t att;               /**< float attitude */
+    l3gd20h_attitude_t att_fixed;         /**< q30 attitude */
+    l3gd20h_attitude_bank_t att_bank;     /**< attitude bank fed with one stream per lane */
+    uint64_t att_us;                      /**< time of the first integrated sample */
+    uint64_t att_ns;                      /**< wall time in the float integration */
+    uint8_t filter;                       /**< filter flag */
+    float filter_corner;                  /**< requested corner frequency in Hz */
+    float filter_odr;                     /**< output data rate of the filter design in Hz */
+    l3gd20h_filter_t filt;                /**< filter fed with one stream per lane */
+    double filter_b[BENCH_FILTER_STAGES][5];       /**< double reference coefficients */
+    double filter_z[BENCH_FILTER_STAGES][3][2];    /**< double reference state */
+    double filter_error;                  /**< largest distance from the double reference */
+    double filter_in;                     /**< sum of the squared inputs */
+    double filter_out;                    /**< sum of the squared outputs */
+    uint32_t filter_n;                    /**< filtered samples */
+    uint64_t filter_ns;                   /**< wall time in the filter */
+    uint8_t decimate;                     /**< decimation factor, 0 without decimation */
+    l3gd20h_decimate_t dec;               /**< decimator */
+    double dec_sum[3][3];                 /**< double reference boxcar sums */
+    double dec_hist[3][3][L3GD20H_DECIMATE_FACTOR_MAX];      /**< double reference boxcar inputs */
+    double dec_fir[2][3];                 /**< double reference compensator inputs */
+    double dec_ref[64][3];                /**< double reference outputs not yet compared */
+    double dec_ref_us[64];                /**< window centres of the reference outputs, -1 when unknown */
+    uint64_t dec_us[64];                  /**< last input times */
+    uint32_t dec_inputs;                  /**< input times */
+    uint8_t dec_ref_head;                 /**< oldest reference output */
+    uint8_t dec_ref_count;                /**< reference outputs not yet compared */
+    uint8_t dec_pos;                      /**< boxcar position */
+    uint8_t dec_phase;                    /**< reference input samples of the current output */
+    uint32_t dec_high;                    /**< samples of the high rate subscriber */
+    uint32_t dec_low;                     /**< samples of the low rate subscriber */
+    double dec_error;                     /**< largest distance from the double reference */
+    double dec_time;                      /**< largest distance from the window centres in us */
+    double dec_in;                        /**< sum of the squared high rate samples */
+    double dec_out;                       /**< sum of the squared low rate samples */
+    uint64_t dec_ns;                      /**< wall time in the decimator */
+    uint8_t spectrum;                     /**< spectrum flag */
+    double spectrum_odr;                  /**< output data rate of the run in Hz */
+    l3gd20h_spectrum_t spec;              /**< spectrum stage */
+    uint32_t spec_results;                /**< spectrum results */
+    double spec_peak;                     /**< largest peak frequency error */
+    double spec_amplitude;                /**< largest peak amplitude error */
+    double spec_band;                     /**< largest relative band energy error */
+    uint32_t spec_n;                      /**< samples fed to the spectrum */
+    uint64_t spec_ns;                     /**< wall time in the spectrum */
+    uint8_t event;                        /**< event engine flag */
+    l3gd20h_event_engine_t engine;        /**< event engine */
+    uint32_t event_starts;                /**< starts of the magnitude rule */
+    uint32_t event_change_starts;         /**< starts of the rate of change rule */
+    double event_delay_us;                /**< largest distance of a start from its crossing */
+    uint64_t event_first_us;              /**< time of the first fed sample */
+    uint64_t event_last_us;               /**< time of the last fed sample */
+    uint32_t event_n;                     /**< samples fed to the engine */
+    uint64_t event_ns;                    /**< wall time in the engine */
+    uint8_t ig;                           /**< interrupt generator model flag */
+    l3gd20h_ig_t ig_model;                /**< interrupt generator model */
+    uint64_t ig_ns;                       /**< wall time in the model */
+    uint8_t remap;                        /**< axis remap flag */
+    l3gd20h_rotate_t rot_remap;           /**< rotation folded into the decode */
+    l3gd20h_rotate_t rot_mount;           /**< general rotation of the converted samples */
+    double mount[3][3];                   /**< double reference of the general rotation */
+    double remap_error;                   /**< largest distance from the remapped truth */
+    double rotate_error;                  /**< largest distance from the double reference */
+    uint32_t remap_n;                     /**< rotated samples */
+    uint64_t remap_ns;                    /**< wall time in the rotation */
+    uint8_t range;                        /**< auto ranging flag */
+    uint8_t range_rest;                   /**< second part of a split read flag */
+    uint8_t range_last;                   /**< full scale of the previous read, 0xFF before the first read */
+    uint32_t range_switches;              /**< full scale switches */
+    uint32_t range_queued;                /**< samples decoded with the full scale before a switch */
+    uint32_t range_clipped;               /**< samples at the end of the full scale */
+    double range_error;                   /**< largest distance from the source */
+    uint8_t power;                        /**< power controller flag */
+    l3gd20h_power_t pwr;                  /**< power controller */
+    uint32_t power_onsets;                /**< wakes whose history covers the motion start */
+    uint64_t power_start_us;              /**< start of the run */
+    uint64_t power_since_us;              /**< start of the active state */
+    uint64_t power_active_us;             /**< time in the active state */
+    uint8_t watermark;                    /**< watermark controller flag */
+    float watermark_ms;                   /**< latency target in ms */
+    l3gd20h_watermark_t wm;               /**< watermark controller */
+    uint8_t wm_pending;                   /**< threshold interrupt waiting for the host */
+    uint64_t wm_irq_us;                   /**< time of the waiting interrupt */
+    uint8_t wm_min;                       /**< smallest fifo threshold */
+    uint8_t wm_max;                       /**< largest fifo threshold */
+    uint32_t wm_batches;                  /**< served batches */
+    uint32_t wm_over;                     /**< batches above the latency target */
+    double wm_latency;                    /**< sum of the batch latencies in us */
+    double wm_latency_max;                /**< largest batch latency in us */
+    uint8_t async;                        /**< async read flag */
+    uint8_t async_fifo;                   /**< drain requests instead of single reads */
+    uint8_t async_chain;                  /**< queue check request left to push */
+    uint32_t async_done;                  /**< completed requests */
+    uint32_t async_errors;                /**< requests finished with an error */
+    uint16_t async_len;                   /**< length of the last completed request */
+    uint8_t settle;                       /**< settling sample handling, 0 when off */
+    uint32_t settle_samples;              /**< settling samples of the check */
+} bench_t;
+
+/**
+ * @brief bench rate table
+ * @note  one entry per output data rate of l3gd20h_lodr_odr_bw_t, the bandwidth does not change the bus traffic
+ */
+static const bench_rate_t gs_rate[] =
+{
+    {L3GD20H_LOW_ODR_1_ODR_12P5HZ_BW_0_NA, 12.5f, 80000, 0.0f},
+    {L3GD20H_LOW_ODR_1_ODR_25HZ_BW_0_NA, 25.0f, 40000, 0.0f},
+    {L3GD20H_LOW_ODR_1_ODR_50HZ_BW_0_16P6HZ, 50.0f, 20000, 16.6f},
+    {L3GD20H_LOW_ODR_0_ODR_100HZ_BW_0_12P5HZ, 100.0f, 10000, 12.5f},
+    {L3GD20H_LOW_ODR_0_ODR_200HZ_BW_0_12P5HZ, 200.0f, 5000, 12.5f},
+    {L3GD20H_LOW_ODR_0_ODR_400HZ_BW_0_20HZ, 400.0f, 2500, 20.0f},
+    {L3GD20H_LOW_ODR_0_ODR_800HZ_BW_0_30HZ, 800.0f, 1250, 30.0f},
+};
+
+/**
+ * @brief bench mode name table
+ */
+static const char *const gs_mode_name[BENCH_MODE_MAX] = {"bypass", "drdy", "fifo", "stream"};
+
+/**
+ * @brief bench state definition
+ */
+static bench_t gs_bench;
+
+/**
+ * @brief  get the host monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_bench_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  get the host monotonic time in us
+ * @return time in us
+ * @note   the driver counters time the bus hooks with it
+ */
+static uint64_t a_bench_us(void)
+{
+    return a_bench_ns() / 1000;
+}
+
+/**
+ * @brief  get the cpu cycle counter
+ * @return cycles
+ * @note   x86 reads the time stamp counter, aarch64 the virtual counter and others fall back to ns
+ */
+static inline uint64_t a_bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t v;
+
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+
+    return v;
+#else
+    return a_bench_ns();
+#endif
+}
+
+/**
+ * @brief     still and moving angular rate profile
+ * @param[in] us virtual time in us
+ * @param[in] *dps pointer to an angular rate buffer
+ * @note      two seconds of two 1Hz 50dps sine periods follow two still seconds
+ */
+static void a_bench_bias_source(uint64_t us, float dps[3])
+{
+    double t;
+    double w;
+
+    t = (double)(us % 4000000ULL) / 1000000.0;
+    w = (t < 2.0) ? 50.0 * sin(2.0 * M_PI * t) : 0.0;
+    dps[0] = (float)w;
+    dps[1] = (float)(-w);
+    dps[2] = (float)(w / 2.0);
+}
+
+/**
+ * @brief     impact angular rate profile
+ * @param[in] us virtual time in us
+ * @param[in] *dps pointer to an angular rate buffer
+ * @note      0.5s of rest, 0.25s of impact, 0.25s of swing and 1s of turn per 2s period
+ */
+static void a_bench_range_source(uint64_t us, float dps[3])
+{
+    uint64_t t;
+    uint8_t i;
+    uint8_t k;
+
+    t = us % 2000000ULL;
+    k = (t < 500000ULL) ? 0 : ((t < 750000ULL) ? 1 : ((t < 1000000ULL) ? 2 : 3));
+    for (i = 0; i < 3; i++)
+    {
+        dps[i] = (float)(gs_range_dps[k] * gs_range_axis[i]);
+    }
+}
+
+/**
+ * @brief     mostly still angular rate profile
+ * @param[in] us virtual time in us
+ * @param[in] *dps pointer to an angular rate buffer
+ * @note      one half sine motion per BENCH_POWER_PERIOD_US
+ */
+static void a_bench_power_source(uint64_t us, float dps[3])
+{
+    uint64_t t;
+    double w;
+
+    t = us % BENCH_POWER_PERIOD_US;
+    w = 0.0;
+    if ((t >= BENCH_POWER_ONSET_US) && (t < BENCH_POWER_ONSET_US + BENCH_POWER_MOTION_US))
+    {
+        w = BENCH_POWER_DPS * sin(M_PI * (double)(t - BENCH_POWER_ONSET_US) / (double)BENCH_POWER_MOTION_US);
+    }
+    dps[0] = (float)w;
+    dps[1] = (float)(-w / 2.0);
+    dps[2] = (float)(w / 4.0);
+}
+
+/**
+ * @brief     constant angular rate profile
+ * @param[in] us virtual time in us
+ * @param[in] *dps pointer to an angular rate buffer
+ * @note      the body turns about one fixed axis
+ */
+static void a_bench_attitude_source(uint64_t us, float dps[3])
+{
+    (void)us;
+    dps[0] = (float)gs_attitude_dps[0];
+    dps[1] = (float)gs_attitude_dps[1];
+    dps[2] = (float)gs_attitude_dps[2];
+}
+
+/**
+ * @brief     still angular rate profile
+ * @param[in] us virtual time in us
+ * @param[in] *dps pointer to an angular rate buffer
+ * @note      only the noise of the simulated device moves the samples
+ */
+static void a_bench_still_source(uint64_t us, float dps[3])
+{
+    (void)us;
+    dps[0] = 0.0f;
+    dps[1] = 0.0f;
+    dps[2] = 0.0f;
+}
+
+/**
+ * @brief     vibration angular rate profile
+ * @param[in] us virtual time in us
+ * @param[in] *dps pointer to an angular rate buffer
+ * @note      one sine per axis at a fraction of the rate of the run
+ */
+static void a_bench_spectrum_source(uint64_t us, float dps[3])
+{
+    double t;
+    uint32_t k;
+
+    t = (double)us / 1000000.0;
+    for (k = 0; k < 3; k++)
+    {
+        dps[k] = (float)(gs_spectrum_dps[k] * sin(2.0 * M_PI * gs_spectrum_ratio[k] * gs_bench.spectrum_odr * t));
+    }
+}
+
+/**
+ * @brief     temperature profile
+ * @param[in] us virtual time in us
+ * @return    temperature in degrees
+ * @note      a 0 to 50 degrees triangle with a period of 600 seconds
+ */
+static float a_bench_temperature(uint64_t us)
+{
+    double t;
+
+    t = (double)(us % 600000000ULL) / 1000000.0;
+
+    return (float)(((t < 300.0) ? t : (600.0 - t)) * BENCH_TEMP_SLOPE);
+}
+
+/**
+ * @brief     fit the bias temperature model from a logged calibration
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 fit failed
+ * @note      the log holds the still bias of the simulated device at five temperatures
+ */
+static uint8_t a_bench_temp_fit(l3gd20h_handle_t *handle)
+{
+    float temp[5];
+    float dps[5][3];
+    uint32_t i;
+    uint32_t k;
+
+    for (i = 0; i < 5; i++)
+    {
+        temp[i] = 12.5f * (float)i;
+        for (k = 0; k < 3; k++)
+        {
+            dps[i][k] = gs_bench.zero_rate[k] + gs_bench.zero_rate_drift[k] * (temp[i] - 25.0f);
+        }
+    }
+
+    return l3gd20h_bias_temp_fit(handle, temp, (const float (*)[3])dps, 5, 1);
+}
+
+/**
+ * @brief     drop a driver message
+ * @param[in] *fmt pointer to a format string
+ * @note      a replayed run ends on the first read the trace does not hold, so its message is expected
+ */
+static void a_bench_quiet(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     drop an interrupt source
+ * @param[in] type irq type
+ * @note      the bench only runs the interrupt handler to trace its entry
+ */
+static void a_bench_receive(uint8_t type)
+{
+    (void)type;
+}
+
+/**
+ * @brief move the trace ring of the driver to the trace file
+ * @note  none
+ */
+static void a_bench_trace(void)
+{
+    l3gd20h_trace_t trace[L3GD20H_TRACE_DEPTH];
+    uint16_t len;
+    uint32_t lost;
+
+    if (gs_bench.trace == NULL)
+    {
+        return;
+    }
+    do
+    {
+        len = L3GD20H_TRACE_DEPTH;
+        if (l3gd20h_trace_read(&gs_bench.handle, trace, &len, &lost) != 0)
+        {
+            return;
+        }
+        gs_bench.trace_lost += lost;
+        (void)l3gd20h_trace_json_write(gs_bench.trace, gs_bench.trace_pid, trace, len);
+    } while (len != 0);
+}
+
+/**
+ * @brief     compare the assigned sample times with the simulated ones
+ * @param[in] *us pointer to the assigned times
+ * @param[in] len sample number
+ * @note      the read drained the fifo, so the last sample is the latest one of the device
+ */
+static void a_bench_timestamp(const uint64_t *us, uint16_t len)
+{
+    uint64_t t;
+    double err;
+    uint16_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        t = sim_get_sample_time_us() - (uint64_t)(len - 1 - i) * gs_bench.period_us;
+        err = fabs((double)us[i] - (double)t);
+        gs_bench.ts_us += err;
+        gs_bench.ts_max_us = (err > gs_bench.ts_max_us) ? err : gs_bench.ts_max_us;
+    }
+}
+
+/**
+ * @brief     integrate the attitude of a read
+ * @param[in] **raw pointer to the raw data
+ * @param[in] *us pointer to the assigned times
+ * @param[in] len sample number
+ * @note      every lane of the bank gets the same stream, so every lane must end on the float result
+ */
+static void a_bench_attitude(const int16_t (*raw)[3], const uint64_t *us, uint16_t len)
+{
+    const int16_t (*lane_raw[L3GD20H_ATTITUDE_LANES])[3];
+    const uint64_t *lane_us[L3GD20H_ATTITUDE_LANES];
+    l3gd20h_full_scale_t scale[L3GD20H_ATTITUDE_LANES];
+    uint64_t ns;
+    uint8_t res;
+    uint8_t j;
+
+    if (len == 0)
+    {
+        return;
+    }
+    if (gs_bench.att.started == 0)
+    {
+        gs_bench.att_us = us[0];
+    }
+    for (j = 0; j < L3GD20H_ATTITUDE_LANES; j++)
+    {
+        lane_raw[j] = raw;
+        lane_us[j] = us;
+        scale[j] = L3GD20H_FULL_SCALE_245_DPS;
+    }
+    ns = a_bench_ns();
+    res = l3gd20h_attitude_update(&gs_bench.att, L3GD20H_FULL_SCALE_245_DPS, raw, us, len);
+    gs_bench.att_ns += a_bench_ns() - ns;
+    res |= l3gd20h_attitude_update(&gs_bench.att_fixed, L3GD20H_FULL_SCALE_245_DPS, raw, us, len);
+    res |= l3gd20h_attitude_bank_update(&gs_bench.att_bank, scale, lane_raw, lane_us, len);
+    if (res != 0)
+    {
+        gs_bench.error = 1;
+    }
+}
+
+/**
+ * @brief     get the angle between an attitude and the constant rate truth
+ * @param[in] *q pointer to a quaternion w, x, y, z
+ * @return    angle in degrees
+ * @note      the body turned by the rate over the integrated time
+ */
+static double a_bench_attitude_error(const float q[4])
+{
+    double t;
+    double n;
+    double a;
+    double v[3];
+    double e[4];
+
+    /* the truth turns by the rate over the integrated time */
+    t = (double)(gs_bench.att.us - gs_bench.att_us) / 1000000.0;
+    n = sqrt(gs_attitude_dps[0] * gs_attitude_dps[0] + gs_attitude_dps[1] * gs_attitude_dps[1] +
+             gs_attitude_dps[2] * gs_attitude_dps[2]);
+    a = n * t * M_PI / 360.0;
+    v[0] = sin(a) * gs_attitude_dps[0] / n;
+    v[1] = sin(a) * gs_attitude_dps[1] / n;
+    v[2] = sin(a) * gs_attitude_dps[2] / n;
+
+    /* conjugate truth times the attitude, its vector part keeps the precision of small angles */
+    e[0] = cos(a) * q[0] + v[0] * q[1] + v[1] * q[2] + v[2] * q[3];
+    e[1] = cos(a) * q[1] - q[0] * v[0] - (v[1] * q[3] - v[2] * q[2]);
+    e[2] = cos(a) * q[2] - q[0] * v[1] - (v[2] * q[1] - v[0] * q[3]);
+    e[3] = cos(a) * q[3] - q[0] * v[2] - (v[0] * q[2] - v[1] * q[1]);
+
+    return 2.0 * atan2(sqrt(e[1] * e[1] + e[2] * e[2] + e[3] * e[3]), fabs(e[0])) * 180.0 / M_PI;
+}
+
+/**
+ * @brief     design the filter and its double reference
+ * @param[in] odr output data rate in Hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 design failed
+ * @note      the corner is held below a quarter of the rate, so every rate of the bench can run it
+ */
+static uint8_t a_bench_filter_design(float odr)
+{
+    double corner;
+    double w;
+    double alpha;
+    double a0;
+    uint32_t i;
+
+    corner = (gs_bench.filter_corner < odr / 4.0f) ? gs_bench.filter_corner : odr / 4.0f;
+    if (l3gd20h_filter_set_corner(&gs_bench.filt, (float)corner, odr) != 0)
+    {
+        return 1;
+    }
+    gs_bench.filter_odr = odr;
+
+    /* the textbook biquads with the math library */
+    w = 2.0 * M_PI * corner / (double)odr;
+    for (i = 0; i < BENCH_FILTER_STAGES; i++)
+    {
+        alpha = sin(w) * cos(M_PI * (double)(2 * i + 1) / (double)(4 * BENCH_FILTER_STAGES));
+        a0 = 1.0 + alpha;
+        gs_bench.filter_b[i][0] = (1.0 - cos(w)) / 2.0 / a0;
+        gs_bench.filter_b[i][1] = (1.0 - cos(w)) / a0;
+        gs_bench.filter_b[i][2] = (1.0 - cos(w)) / 2.0 / a0;
+        gs_bench.filter_b[i][3] = -2.0 * cos(w) / a0;
+        gs_bench.filter_b[i][4] = (1.0 - alpha) / a0;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     filter a read and compare it with the double reference
+ * @param[in] **dps pointer to the angular rate
+ * @param[in] len sample number
+ * @note      every lane gets the same stream, the design follows the rate estimate once it is there
+ */
+static void a_bench_filter(const float (*dps)[3], uint16_t len)
+{
+    float batch[32][3][L3GD20H_FILTER_LANES];
+    float odr;
+    float odr_bound;
+    double x;
+    double y;
+    double err;
+    uint64_t ns;
+    uint16_t i;
+    uint32_t s;
+    uint8_t j;
+    uint8_t a;
+
+    if ((l3gd20h_timestamp_get_odr(&gs_bench.ts, &odr, &odr_bound) == 0) && (odr != gs_bench.filter_odr))
+    {
+        if (a_bench_filter_design(odr) != 0)
+        {
+            gs_bench.error = 1;
+
+            return;
+        }
+    }
+    ns = a_bench_ns();
+    for (j = 0; j < L3GD20H_FILTER_LANES; j++)
+    {
+        (void)l3gd20h_filter_load(&gs_bench.filt, j, dps, batch, len);
+    }
+    (void)l3gd20h_filter_process(&gs_bench.filt, batch, len);
+    gs_bench.filter_ns += a_bench_ns() - ns;
+
+    /* direct form 2 transposed in double */
+    for (i = 0; i < len; i++)
+    {
+        for (a = 0; a < 3; a++)
+        {
+            x = (double)dps[i][a];
+            gs_bench.filter_in += x * x;
+            for (s = 0; s < BENCH_FILTER_STAGES; s++)
+            {
+                double *b = gs_bench.filter_b[s];
+                double *z = gs_bench.filter_z[s][a];
+
+                y = b[0] * x + z[0];
+                z[0] = b[1] * x - b[3] * y + z[1];
+                z[1] = b[2] * x - b[4] * y;
+                x = y;
+            }
+            gs_bench.filter_out += x * x;
+            for (j = 0; j < L3GD20H_FILTER_LANES; j++)
+            {
+                err = fabs((double)batch[i][a][j] - x);
+                gs_bench.filter_error = (err > gs_bench.filter_error) ? err : gs_bench.filter_error;
+            }
+        }
+    }
+    gs_bench.filter_n += len;
+}
+
+/**
+ * @brief     high rate subscriber
+ * @param[in] **raw pointer to the raw data
+ * @param[in] *us pointer to the sample times
+ * @param[in] len sample number
+ * @note      none
+ */
+static void a_bench_decimate_high(const int16_t (*raw)[3], const uint64_t *us, uint16_t len)
+{
+    uint16_t i;
+    uint8_t a;
+
+    (void)us;
+    for (i = 0; i < len; i++)
+    {
+        for (a = 0; a < 3; a++)
+        {
+            gs_bench.dec_in += (double)raw[i][a] * (double)raw[i][a];
+        }
+    }
+    gs_bench.dec_high += len;
+}
+
+/**
+ * @brief     low rate subscriber
+ * @param[in] **raw pointer to the raw data
+ * @param[in] *us pointer to the sample times
+ * @param[in] len sample number
+ * @note      every sample and its time are compared with the oldest reference output
+ */
+static void a_bench_decimate_low(const int16_t (*raw)[3], const uint64_t *us, uint16_t len)
+{
+    double err;
+    uint16_t i;
+    uint8_t a;
+
+    for (i = 0; i < len; i++)
+    {
+        if (gs_bench.dec_ref_count == 0)
+        {
+            gs_bench.error = 1;
+
+            return;
+        }
+        if ((us != NULL) && (gs_bench.dec_ref_us[gs_bench.dec_ref_head] >= 0.0))
+        {
+            err = fabs((double)us[i] - gs_bench.dec_ref_us[gs_bench.dec_ref_head]);
+            gs_bench.dec_time = (err > gs_bench.dec_time) ? err : gs_bench.dec_time;
+        }
+        for (a = 0; a < 3; a++)
+        {
+            gs_bench.dec_out += (double)raw[i][a] * (double)raw[i][a];
+            err = fabs((double)raw[i][a] - gs_bench.dec_ref[gs_bench.dec_ref_head][a]);
+            gs_bench.dec_error = (err > gs_bench.dec_error) ? err : gs_bench.dec_error;
+        }
+        gs_bench.dec_ref_head = (uint8_t)((gs_bench.dec_ref_head + 1) % 64);
+        gs_bench.dec_ref_count--;
+    }
+    gs_bench.dec_low += len;
+}
+
+/**
+ * @brief     decimate a read and run the double reference next to it
+ * @param[in] **raw pointer to the raw data
+ * @param[in] *us pointer to the sample times, NULL without times
+ * @param[in] len sample number
+ * @note      the reference is three boxcars of factor samples, every factor-th output divided by
+ *            factor^3 and the three tap compensator, its time is the middle of the input times
+ *            3 * (factor - 1) / 2 + factor periods back
+ */
+static void a_bench_decimate(const int16_t (*raw)[3], const uint64_t *us, uint16_t len)
+{
+    double r = (double)gs_bench.decimate;
+    double droop = 3.0 * (r * r - 1.0) / (24.0 * r * r);
+    double x[3];
+    uint64_t ns;
+    uint32_t lag = 3 * ((uint32_t)gs_bench.decimate - 1) + 2 * (uint32_t)gs_bench.decimate;
+    uint16_t i;
+    uint8_t s;
+    uint8_t a;
+    uint8_t tail;
+
+    for (i = 0; i < len; i++)
+    {
+        for (a = 0; a < 3; a++)
+        {
+            x[a] = (double)raw[i][a];
+            for (s = 0; s < 3; s++)
+            {
+                gs_bench.dec_sum[s][a] += x[a] - gs_bench.dec_hist[s][a][gs_bench.dec_pos];
+                gs_bench.dec_hist[s][a][gs_bench.dec_pos] = x[a];
+                x[a] = gs_bench.dec_sum[s][a];
+            }
+        }
+        gs_bench.dec_pos = (uint8_t)((gs_bench.dec_pos + 1) % gs_bench.decimate);
+        if (us != NULL)
+        {
+            gs_bench.dec_us[gs_bench.dec_inputs % 64] = us[i];
+            gs_bench.dec_inputs++;
+        }
+        gs_bench.dec_phase++;
+        if (gs_bench.dec_phase < gs_bench.decimate)
+        {
+            continue;
+        }
+        gs_bench.dec_phase = 0;
+        tail = (uint8_t)((gs_bench.dec_ref_head + gs_bench.dec_ref_count) % 64);
+        gs_bench.dec_ref_us[tail] = -1.0;
+        if ((us != NULL) && (gs_bench.dec_inputs > lag / 2 + 1))
+        {
+            gs_bench.dec_ref_us[tail] = ((double)gs_bench.dec_us[(gs_bench.dec_inputs - 1 - lag / 2) % 64] +
+                                         (double)gs_bench.dec_us[(gs_bench.dec_inputs - 1 - (lag + 1) / 2) % 64]) / 2.0;
+        }
+        for (a = 0; a < 3; a++)
+        {
+            x[a] /= r * r * r;
+            gs_bench.dec_ref[tail][a] = (1.0 + 2.0 * droop) * gs_bench.dec_fir[0][a] -
+                                        droop * (x[a] + gs_bench.dec_fir[1][a]);
+            gs_bench.dec_fir[1][a] = gs_bench.dec_fir[0][a];
+            gs_bench.dec_fir[0][a] = x[a];
+        }
+        gs_bench.dec_ref_count++;
+    }
+    ns = a_bench_ns();
+    if (l3gd20h_decimate_feed(&gs_bench.dec, raw, us, len) != 0)
+    {
+        gs_bench.error = 1;
+    }
+    gs_bench.dec_ns += a_bench_ns() - ns;
+}
+
+/**
+ * @brief     spectrum result callback
+ * @param[in] *result pointer to a spectrum result
+ * @note      the tone of an axis falls in band k of the four even bands, its mean square is a^2 / 2
+ */
+static void a_bench_spectrum_result(const l3gd20h_spectrum_result_t *result)
+{
+    double err;
+    double ms;
+    uint32_t k;
+    uint32_t b;
+
+    for (k = 0; k < 3; k++)
+    {
+        err = fabs((double)result->peak_hz[k] - gs_spectrum_ratio[k] * gs_bench.spectrum_odr);
+        gs_bench.spec_peak = (err > gs_bench.spec_peak) ? err : gs_bench.spec_peak;
+        err = fabs((double)result->peak_dps[k] - gs_spectrum_dps[k]);
+        gs_bench.spec_amplitude = (err > gs_bench.spec_amplitude) ? err : gs_bench.spec_amplitude;
+        b = (uint32_t)(gs_spectrum_ratio[k] * 8.0);
+        ms = gs_spectrum_dps[k] * gs_spectrum_dps[k] / 2.0;
+        err = fabs((double)result->band[k][b] - ms) / ms;
+        gs_bench.spec_band = (err > gs_bench.spec_band) ? err : gs_bench.spec_band;
+    }
+    gs_bench.spec_results++;
+}
+
+/**
+ * @brief     feed a read to the spectrum stage
+ * @param[in] **dps pointer to the angular rate
+ * @param[in] *us pointer to the sample times, NULL without times
+ * @param[in] len sample number
+ * @note      none
+ */
+static void a_bench_spectrum(const float (*dps)[3], const uint64_t *us, uint16_t len)
+{
+    uint64_t ns;
+
+    ns = a_bench_ns();
+    if (l3gd20h_spectrum_feed(&gs_bench.spec, dps, us, len) != 0)
+    {
+        gs_bench.error = 1;
+    }
+    gs_bench.spec_ns += a_bench_ns() - ns;
+    gs_bench.spec_n += len;
+}
+
+/**
+ * @brief     get the latest upward magnitude crossing of the bias source
+ * @param[in] us virtual time in us
+ * @return    crossing time in us
+ * @note      the magnitude is 1.5 * 50dps * |sin(2 pi t)| in the moving seconds, so it crosses 30dps
+ *            every half second at asin(0.4) / (2 pi) past the zero
+ */
+static double a_bench_event_crossing(double us)
+{
+    double c;
+    double t;
+    double k;
+
+    c = asin(0.4) / (2.0 * M_PI) * 1000000.0;
+    t = fmod(us, 4000000.0);
+    k = floor((t - c) / 500000.0);
+    k = (k > 3.0) ? 3.0 : k;
+
+    return us - t + c + k * 500000.0;
+}
+
+/**
+ * @brief bench interrupt generator config
+ * @note  x or y above 20dps for more than 4 samples, held for 4 samples after the drop
+ */
+static const l3gd20h_ig_config_t gs_ig_config =
+{
+    {2286, 2286, 2286},
+    (1 << L3GD20H_INTERRUPT_EVENT_X_HIGH_EVENT) | (1 << L3GD20H_INTERRUPT_EVENT_Y_HIGH_EVENT),
+    L3GD20H_BOOL_FALSE,
+    L3GD20H_BOOL_FALSE,
+    L3GD20H_COUNTER_MODE_DECREMENT,
+    L3GD20H_BOOL_TRUE,
+    4,
+    L3GD20H_SELECTION_LPF1,
+    L3GD20H_HIGH_PASS_FILTER_MODE_NORMAL,
+    L3GD20H_HIGH_PASS_FILTER_CUT_OFF_FREQUENCY_0,
+};
+
+/**
+ * @brief bench interrupt generator sequence structure definition
+ * @note  x high event over a threshold of 100lsb, h is a sample of 200lsb and l one of 0lsb, the int1 levels
+ *        are worked by hand from the interrupt generator timing of the datasheet: the interrupt rises when the
+ *        event lasts for more than the duration, the reset counter mode clears the duration counter on a
+ *        sample without the event and the decrement mode takes one off it, wait holds the interrupt until
+ *        the event is gone for more than the duration and latch holds it until the source is read
+ */
+typedef struct bench_ig_sequence_s
+{
+    const char *name;                        /**< sequence name */
+    l3gd20h_counter_mode_t counter_mode;     /**< duration counter mode */
+    l3gd20h_bool_t wait;                     /**< wait flag */
+    l3gd20h_bool_t latch;                    /**< latch flag */
+    uint8_t duration;                        /**< duration in samples */
+    const char *in;                          /**< x samples */
+    const char *int1;                        /**< expected int1 levels */
+    uint8_t read;                            /**< samples before the source read, 0 for none */
+    uint8_t src;                             /**< expected source of the read */
+} bench_ig_sequence_t;
+
+/**
+ * @brief bench interrupt generator sequence table
+ */
+static const bench_ig_sequence_t gs_ig_sequence[] =
+{
+    {"reset", L3GD20H_COUNTER_MODE_RESET, L3GD20H_BOOL_FALSE, L3GD20H_BOOL_FALSE, 2,
+     "hhlhhhhllh", "0000011000", 0, 0x00},
+    {"dcrm", L3GD20H_COUNTER_MODE_DECREMENT, L3GD20H_BOOL_FALSE, L3GD20H_BOOL_FALSE, 2,
+     "hhlhhhllhh", "0000110011", 0, 0x00},
+    {"wait", L3GD20H_COUNTER_MODE_RESET, L3GD20H_BOOL_TRUE, L3GD20H_BOOL_FALSE, 2,
+     "hhhlhlllhl", "0011111000", 0, 0x00},
+    {"latch", L3GD20H_COUNTER_MODE_RESET, L3GD20H_BOOL_FALSE, L3GD20H_BOOL_TRUE, 0,
+     "lhlllhhl", "01110111", 4, 0x42},
+};
+
+/**
+ * @brief  check the interrupt generator model on the hand worked sequences
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   the edge count of a run only shows the model and the simulated device agree, they share one
+ *         reading of the datasheet, the sequences check that reading against the datasheet timing
+ */
+static uint8_t a_bench_ig_check(void)
+{
+    l3gd20h_ig_config_t config;
+    l3gd20h_ig_t ig;
+    int16_t raw[1][3];
+    uint8_t int1;
+    uint8_t src;
+    uint32_t i;
+    uint32_t n;
+
+    for (i = 0; i < sizeof(gs_ig_sequence) / sizeof(gs_ig_sequence[0]); i++)
+    {
+        const bench_ig_sequence_t *seq = &gs_ig_sequence[i];
+
+        memset(&config, 0, sizeof(l3gd20h_ig_config_t));
+        config.threshold[0] = 100;
+        config.threshold[1] = 100;
+        config.threshold[2] = 100;
+        config.event = 1 << L3GD20H_INTERRUPT_EVENT_X_HIGH_EVENT;
+        config.and_or = L3GD20H_BOOL_FALSE;
+        config.latch = seq->latch;
+        config.counter_mode = seq->counter_mode;
+        config.wait = seq->wait;
+        config.duration = seq->duration;
+        config.selection = L3GD20H_SELECTION_LPF1;
+        config.mode = L3GD20H_HIGH_PASS_FILTER_MODE_NORMAL;
+        config.cut_off = L3GD20H_HIGH_PASS_FILTER_CUT_OFF_FREQUENCY_0;
+        if (l3gd20h_ig_init(&ig, &config, 100.0f) != 0)
+        {
+            return 1;
+        }
+        for (n = 0; seq->in[n] != '\0'; n++)
+        {
+            if ((seq->read != 0) && (n == seq->read))
+            {
+                (void)l3gd20h_ig_get_source(&ig, &src);
+                if (src != seq->src)
+                {
+                    l3gd20h_interface_debug_print("l3gd20h: ig %s source 0x%02X, expected 0x%02X.\n",
+                                                  seq->name, src, seq->src);
+
+                    return 1;
+                }
+            }
+            raw[0][0] = (seq->in[n] == 'h') ? 200 : 0;
+            raw[0][1] = 0;
+            raw[0][2] = 0;
+            (void)l3gd20h_ig_feed(&ig, (const int16_t (*)[3])raw, 1, &int1);
+            if (int1 != (uint8_t)(seq->int1[n] - '0'))
+            {
+                l3gd20h_interface_debug_print("l3gd20h: ig %s sample %u int1 %u, expected %c.\n",
+                                              seq->name, n, int1, seq->int1[n]);
+
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     event callback
+ * @param[in] *event pointer to an event
+ * @note      rule 0 is the magnitude rule and rule 1 the rate of change rule
+ */
+static void a_bench_event_edge(const l3gd20h_event_t *event)
+{
+    double c;
+    double d;
+
+    if (event->edge != L3GD20H_EVENT_EDGE_START)
+    {
+        return;
+    }
+    if (event->rule == 0)
+    {
+        /* a run that starts above the threshold has no crossing of its own */
+        c = a_bench_event_crossing((double)event->us);
+        if (c < (double)gs_bench.event_first_us)
+        {
+            return;
+        }
+        d = fabs((double)event->us - c);
+        gs_bench.event_delay_us = (d > gs_bench.event_delay_us) ? d : gs_bench.event_delay_us;
+        gs_bench.event_starts++;
+    }
+    else
+    {
+        gs_bench.event_change_starts++;
+    }
+}
+
+/**
+ * @brief     feed a read to the event engine
+ * @param[in] **raw pointer to the raw data
+ * @param[in] *us pointer to the sample times
+ * @param[in] len sample number
+ * @note      none
+ */
+static void a_bench_event(const int16_t (*raw)[3], const uint64_t *us, uint16_t len)
+{
+    uint64_t ns;
+
+    if (len == 0)
+    {
+        return;
+    }
+    if (gs_bench.event_n == 0)
+    {
+        gs_bench.event_first_us = us[0];
+    }
+    gs_bench.event_last_us = us[len - 1];
+    ns = a_bench_ns();
+    if (l3gd20h_event_feed(&gs_bench.engine, raw, us, len) != 0)
+    {
+        gs_bench.error = 1;
+    }
+    gs_bench.event_ns += a_bench_ns() - ns;
+    gs_bench.event_n += len;
+}
+
+/**
+ * @brief     check the remapped samples of a read and rotate them
+ * @param[in] **raw pointer to the raw data
+ * @param[in] **dps pointer to the converted data
+ * @param[in] len sample number
+ * @note      the raw data has to match the remapped source to the lsb
+ */
+static void a_bench_remap(const int16_t (*raw)[3], const float (*dps)[3], uint16_t len)
+{
+    float out[32][3];
+    double truth[3];
+    double ref;
+    double err;
+    uint64_t ns;
+    uint16_t i;
+    uint8_t j;
+    uint8_t k;
+
+    /* the remapped source in lsb and in dps */
+    for (j = 0; j < 3; j++)
+    {
+        truth[j] = 0.0;
+        for (k = 0; k < 3; k++)
+        {
+            truth[j] += (double)gs_remap_matrix[j][k] * gs_attitude_dps[k];
+        }
+    }
+    for (i = 0; i < len; i++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            if ((double)raw[i][j] != floor(truth[j] / 0.00875 + 0.5))
+            {
+                gs_bench.error = 1;
+            }
+            err = fabs((double)dps[i][j] - truth[j]);
+            gs_bench.remap_error = (err > gs_bench.remap_error) ? err : gs_bench.remap_error;
+        }
+    }
+
+    /* the general mount on top of the folded one */
+    memcpy(out, dps, sizeof(float) * 3 * len);
+    ns = a_bench_ns();
+    if (l3gd20h_rotate_batch(&gs_bench.rot_mount, out, len) != 0)
+    {
+        gs_bench.error = 1;
+    }
+    gs_bench.remap_ns += a_bench_ns() - ns;
+    gs_bench.remap_n += len;
+    for (i = 0; i < len; i++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            ref = 0.0;
+            for (k = 0; k < 3; k++)
+            {
+                ref += gs_bench.mount[j][k] * (double)dps[i][k];
+            }
+            err = fabs((double)out[i][j] - ref);
+            gs_bench.rotate_error = (err > gs_bench.rotate_error) ? err : gs_bench.rotate_error;
+        }
+    }
+}
+
+/**
+ * @brief     check the full scale of a read
+ * @param[in] **raw pointer to the raw data
+ * @param[in] **dps pointer to the converted data
+ * @param[in] len sample number
+ * @note      every sample has to sit on one level of the source unless it is clipped
+ */
+static void a_bench_range(const int16_t (*raw)[3], const float (*dps)[3], uint16_t len)
+{
+    l3gd20h_full_scale_t head;
+    l3gd20h_full_scale_t tail;
+    uint16_t split;
+    uint16_t i;
+    uint8_t j;
+    uint8_t k;
+    uint8_t clipped;
+    double err;
+    double best;
+    double d;
+
+    if (l3gd20h_get_range_tag(&gs_bench.handle, &split, &head, &tail) != 0)
+    {
+        gs_bench.error = 1;
+
+        return;
+    }
+    if ((gs_bench.range_last != 0xFF) && (len != 0) && (((split != 0) ? head : tail) != gs_bench.range_last))
+    {
+        gs_bench.range_switches++;
+    }
+    if ((split != 0) && (head != tail))
+    {
+        gs_bench.range_switches++;
+    }
+    if (len != 0)
+    {
+        gs_bench.range_last = tail;
+    }
+    gs_bench.range_queued += split;
+    for (i = 0; i < len; i++)
+    {
+        clipped = 0;
+        for (j = 0; j < 3; j++)
+        {
+            clipped |= ((raw[i][j] >= 32767) || (raw[i][j] <= -32768)) ? 1 : 0;
+        }
+        if (clipped != 0)
+        {
+            gs_bench.range_clipped++;
+
+            continue;
+        }
+        best = 1.0e9;
+        for (k = 0; k < 4; k++)
+        {
+            err = 0.0;
+            for (j = 0; j < 3; j++)
+            {
+                d = fabs((double)dps[i][j] - gs_range_dps[k] * gs_range_axis[j]);
+                err = (d > err) ? d : err;
+            }
+            best = (err < best) ? err : best;
+        }
+        gs_bench.range_error = (best > gs_bench.range_error) ? best : gs_bench.range_error;
+    }
+}
+
+/**
+ * @brief     account a finished async request
+ * @param[in] type request type
+ * @param[in] res request result
+ * @param[in] len delivered sample length
+ * @note      none
+ */
+static void a_bench_async_done(uint8_t type, uint8_t res, uint16_t len)
+{
+    (void)type;
+    gs_bench.async_done++;
+    gs_bench.async_errors += (res != 0) ? 1 : 0;
+    gs_bench.async_len = len;
+}
+
+/**
+ * @brief     account a finished async request and queue one more behind a refused start
+ * @param[in] type request type
+ * @param[in] res request result
+ * @param[in] len delivered sample length
+ * @note      the older request queued behind the idle bus takes the refused start
+ */
+static void a_bench_async_chain(uint8_t type, uint8_t res, uint16_t len)
+{
+    a_bench_async_done(type, res, len);
+    if (gs_bench.async_chain != 0)
+    {
+        gs_bench.async_chain = 0;
+        sim_set_async_fail(1);
+        if (l3gd20h_async_apply_config(&gs_bench.handle, BENCH_REG_REFERENCE, 0xFF, 0x00, a_bench_async_done) != 0)
+        {
+            gs_bench.error = 1;
+        }
+    }
+}
+
+/**
+ * @brief run the completion interrupts until the bus is idle
+ * @note  none
+ */
+static void a_bench_async_pump(void)
+{
+    uint8_t res;
+
+    while (sim_async_complete(&res) == 0)
+    {
+        if (l3gd20h_async_irq_handler(&gs_bench.handle, res) != 0)
+        {
+            gs_bench.error = 1;
+        }
+    }
+}
+
+/**
+ * @brief  check the async queue around a refused start
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   a config, a read and a config pushed by the first callback must all finish,
+ *         the read with the refused start and the rest without an error
+ */
+static uint8_t a_bench_async_check(void)
+{
+    int16_t raw[1][3];
+    float dps[1][3];
+    uint8_t pending;
+    uint8_t value;
+
+    gs_bench.async_done = 0;
+    gs_bench.async_errors = 0;
+    gs_bench.async_chain = 1;
+    DRIVER_L3GD20H_LINK_DEBUG_PRINT(&gs_bench.handle, a_bench_quiet);
+    if ((l3gd20h_async_apply_config(&gs_bench.handle, BENCH_REG_REFERENCE, 0xFF, 0x5A, a_bench_async_chain) != 0) ||
+        (l3gd20h_async_read(&gs_bench.handle, raw, dps, a_bench_async_done) != 0))
+    {
+        DRIVER_L3GD20H_LINK_DEBUG_PRINT(&gs_bench.handle, l3gd20h_interface_debug_print);
+
+        return 1;
+    }
+    a_bench_async_pump();
+    DRIVER_L3GD20H_LINK_DEBUG_PRINT(&gs_bench.handle, l3gd20h_interface_debug_print);
+    if ((l3gd20h_async_get_pending(&gs_bench.handle, &pending) != 0) ||
+        (l3gd20h_get_high_pass_filter_reference(&gs_bench.handle, &value) != 0))
+    {
+        return 1;
+    }
+    if ((gs_bench.error != 0) || (gs_bench.async_done != 3) || (gs_bench.async_errors != 1) ||
+        (pending != 0) || (value != 0))
+    {
+        return 1;
+    }
+    gs_bench.async_done = 0;
+    gs_bench.async_errors = 0;
+
+    return 0;
+}
+
+/**
+ * @brief      read the available samples through the async queue
+ * @param[out] **raw pointer to a raw data buffer
+ * @param[out] **dps pointer to a converted data buffer
+ * @param[in, out] *len pointer to a length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the completion interrupts run right after the start
+ */
+static uint8_t a_bench_async_read(int16_t (*raw)[3], float (*dps)[3], uint16_t *len)
+{
+    uint32_t done;
+    uint8_t res;
+
+    done = gs_bench.async_done;
+    if (gs_bench.async_fifo != 0)
+    {
+        res = l3gd20h_async_drain(&gs_bench.handle, raw, dps, *len, a_bench_async_done);
+    }
+    else
+    {
+        res = l3gd20h_async_read(&gs_bench.handle, raw, dps, a_bench_async_done);
+    }
+    if (res != 0)
+    {
+        return 1;
+    }
+    a_bench_async_pump();
+    if ((gs_bench.async_done != done + 1) || (gs_bench.async_errors != 0))
+    {
+        return 1;
+    }
+    *len = gs_bench.async_len;
+
+    return 0;
+}
+
+/**
+ * @brief     get the settling samples a reconfiguration must open
+ * @param[in] *rate pointer to a rate
+ * @param[in] turn_on 1 for a wake from power down
+ * @param[in] hpf high pass cut off frequency in the output path, -1 when the high pass is out
+ * @return    settling samples
+ * @note      three time constants of the low pass and of the high pass from the datasheet figures
+ */
+static uint32_t a_bench_settle_expect(const bench_rate_t *rate, uint8_t turn_on, int8_t hpf)
+{
+    double s;
+    uint32_t samples;
+    uint32_t high;
+
+    s = (rate->bandwidth > 0.0f) ? 3.0 / (2.0 * M_PI * (double)rate->bandwidth) : 0.0;
+    s += (turn_on != 0) ? (double)L3GD20H_SETTLE_TURN_ON_MS / 1000.0 : 0.0;
+    samples = (uint32_t)ceil(s * (double)rate->odr);
+    samples = (samples < L3GD20H_SETTLE_MIN_SAMPLES) ? L3GD20H_SETTLE_MIN_SAMPLES : samples;
+    if (hpf >= 0)
+    {
+        high = (uint32_t)ceil(3.0 * gs_settle_hpf_ratio[hpf] / (2.0 * M_PI));
+        samples = (high > samples) ? high : samples;
+    }
+
+    return samples;
+}
+
+/**
+ * @brief      run one reconfiguration of the settle check
+ * @param[in]  *rate pointer to a rate
+ * @param[in]  step check step
+ * @param[out] *expect pointer to a settling samples buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 reconfiguration failed
+ * @note       none
+ */
+static uint8_t a_bench_settle_step(const bench_rate_t *rate, uint8_t step, uint32_t *expect)
+{
+    l3gd20h_handle_t *handle = &gs_bench.handle;
+    uint8_t res;
+
+    switch (step)
+    {
+        case 0 :
+        {
+            res = l3gd20h_set_mode(handle, L3GD20H_MODE_POWER_DOWN);
+            res |= l3gd20h_set_mode(handle, L3GD20H_MODE_NORMAL);
+            *expect = a_bench_settle_expect(rate, 1, -1);
+
+            break;
+        }
+        case 1 :
+        {
+            res = l3gd20h_set_rate_bandwidth(handle, rate->rate);
+            *expect = a_bench_settle_expect(rate, 0, -1);
+
+            break;
+        }
+        case 2 :
+        {
+            res = l3gd20h_set_out_selection(handle, L3GD20H_SELECTION_LPF1_HPF);
+            *expect = a_bench_settle_expect(rate, 0, -1);
+
+            break;
+        }
+        case 3 :
+        {
+            res = l3gd20h_set_high_pass_filter(handle, L3GD20H_BOOL_TRUE);
+            *expect = a_bench_settle_expect(rate, 0, 0);
+
+            break;
+        }
+        case 4 :
+        {
+            res = l3gd20h_set_high_pass_filter_mode(handle, L3GD20H_HIGH_PASS_FILTER_MODE_NORMAL);
+            *expect = a_bench_settle_expect(rate, 0, 0);
+
+            break;
+        }
+        case 5 :
+        {
+            res = l3gd20h_set_high_pass_filter_cut_off_frequency(handle, L3GD20H_HIGH_PASS_FILTER_CUT_OFF_FREQUENCY_1);
+            *expect = a_bench_settle_expect(rate, 0, 1);
+
+            break;
+        }
+        case 6 :
+        {
+            res = l3gd20h_set_high_pass_filter(handle, L3GD20H_BOOL_FALSE);
+            *expect = a_bench_settle_expect(rate, 0, -1);
+
+            break;
+        }
+        default :
+        {
+            res = l3gd20h_set_out_selection(handle, L3GD20H_SELECTION_LPF1);
+            *expect = a_bench_settle_expect(rate, 0, -1);
+
+            break;
+        }
+    }
+
+    return res;
+}
+
+/**
+ * @brief     check the settling windows of every reconfiguration
+ * @param[in] *rate pointer to a rate
+ * @param[in] mode bench mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      every step starts from a drained fifo, the stream steps after the wake leave BENCH_SETTLE_QUEUED
+ *            samples in it, those must come out first with the last one counted to the window, drop mode must
+ *            deliver the samples after the window with the sample times of the device, tag mode must deliver
+ *            and count them, the check polls every BENCH_BATCH periods in the middle of the sample periods,
+ *            so a bypass window must end on the time and not on the reads
+ */
+static uint8_t a_bench_settle_check(const bench_rate_t *rate, bench_mode_t mode)
+{
+    int16_t raw[32][3];
+    float dps[32][3];
+    uint64_t us[32];
+    l3gd20h_timestamp_t ts;
+    sim_stats_t stats;
+    uint64_t first_us;
+    uint64_t expect_us;
+    uint64_t got_us;
+    uint32_t period;
+    uint32_t expect;
+    uint32_t window;
+    uint32_t queued;
+    uint32_t old;
+    uint32_t remaining;
+    uint32_t start;
+    uint32_t produced;
+    uint32_t delivered;
+    uint32_t delivered_expect;
+    uint32_t tagged_sum;
+    uint32_t tagged_expect;
+    uint16_t tagged;
+    uint16_t len;
+    uint8_t step;
+
+    /* close the turn on window of the init */
+    if ((l3gd20h_set_settle(&gs_bench.handle, (l3gd20h_settle_t)gs_bench.settle) != 0) ||
+        (l3gd20h_timestamp_init(&ts, rate->rate) != 0))
+    {
+        return 1;
+    }
+    gs_bench.settle_samples = 0;
+    sim_advance_us(sim_get_period_us() / 2);
+    for (step = 0; step < BENCH_SETTLE_STEPS; step++)
+    {
+        len = 32;
+        if (l3gd20h_read_timestamp(&gs_bench.handle, &ts, raw, dps, us, &len) != 0)
+        {
+            return 1;
+        }
+
+        /* the samples from before the change come first and the last one may follow the write */
+        queued = ((mode == BENCH_MODE_STREAM) && (step != 0)) ? BENCH_SETTLE_QUEUED : 0;
+        sim_advance_us(queued * sim_get_period_us());
+        old = (queued != 0) ? queued - 1 : 0;
+        sim_get_stats(&stats);
+        start = stats.samples;
+        if ((a_bench_settle_step(rate, step, &expect) != 0) ||
+            (l3gd20h_get_settling(&gs_bench.handle, &remaining, &tagged) != 0))
+        {
+            return 1;
+        }
+        window = expect + ((queued != 0) ? 1 : 0);
+        if (remaining != window)
+        {
+            l3gd20h_interface_debug_print("l3gd20h: settle step %d opens %u samples, expected %u.\n", step, remaining, window);
+
+            return 1;
+        }
+
+        /* the wake restarts the sample clock */
+        period = sim_get_period_us();
+        if (step == 0)
+        {
+            sim_advance_us(period / 2);
+        }
+        first_us = 0;
+        got_us = 0;
+        expect_us = 0;
+        produced = 0;
+        delivered = 0;
+        delivered_expect = old;
+        tagged_sum = 0;
+        tagged_expect = 0;
+        while (produced < expect + BENCH_BATCH)
+        {
+            sim_advance_us(period);
+            sim_get_stats(&stats);
+            produced = stats.samples - start;
+            if (produced == 1)
+            {
+                first_us = sim_get_sample_time_us();
+            }
+            if (((produced % BENCH_BATCH) != 0) && (produced < expect + BENCH_BATCH))
+            {
+                continue;
+            }
+            len = 32;
+            if ((l3gd20h_read_timestamp(&gs_bench.handle, &ts, raw, dps, us, &len) != 0) ||
+                (l3gd20h_get_settling(&gs_bench.handle, &remaining, &tagged) != 0))
+            {
+                return 1;
+            }
+            if ((delivered <= old) && (delivered + len > old))
+            {
+                got_us = us[old - delivered];
+            }
+            delivered += len;
+            tagged_sum += tagged;
+
+            /* bypass returns the newest sample */
+            if ((mode == BENCH_MODE_BYPASS) && ((gs_bench.settle == L3GD20H_SETTLE_TAG) || (produced > expect)))
+            {
+                delivered_expect++;
+                tagged_expect += (produced <= expect) ? 1 : 0;
+                expect_us = (expect_us == 0) ? first_us + (uint64_t)(produced - 1) * period : expect_us;
+            }
+        }
+
+        /* drop mode moves the first sample past the window */
+        if (mode != BENCH_MODE_BYPASS)
+        {
+            delivered_expect = (gs_bench.settle == L3GD20H_SETTLE_DROP) ? old + BENCH_BATCH : queued + expect + BENCH_BATCH;
+            tagged_expect = (gs_bench.settle == L3GD20H_SETTLE_DROP) ? 0 : window;
+            expect_us = (gs_bench.settle == L3GD20H_SETTLE_DROP) ? first_us + (uint64_t)expect * period :
+                                                                   first_us - ((queued != 0) ? period : 0);
+        }
+        if ((remaining != 0) || (delivered != delivered_expect) || (tagged_sum != tagged_expect) ||
+            (fabs((double)got_us - (double)expect_us) > (double)period / 4.0))
+        {
+            l3gd20h_interface_debug_print("l3gd20h: settle step %d delivered %u tagged %u first %0.0f us, "
+                                          "expected %u tagged %u first %0.0f us.\n", step, delivered, tagged_sum,
+                                          (double)got_us, delivered_expect, tagged_expect, (double)expect_us);
+
+            return 1;
+        }
+        gs_bench.settle_samples += window;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     read the available samples and account the cost
+ * @param[in] irq_us interrupt time in us, 0 for a polled read
+ * @note      an interrupt read anchors the newest sample at the interrupt time,
+ *            a polled read lets the driver stamp the fifo level
+ */
+static void a_bench_read(uint64_t irq_us)
+{
+    int16_t raw[32][3];
+    float dps[32][3];
+    uint64_t us[32];
+    uint16_t len;
+    uint64_t ns;
+    uint64_t cycles;
+    uint64_t age;
+    uint32_t writes;
+    sim_stats_t stats;
+    uint8_t res;
+
+    len = ((gs_bench.range != 0) && (gs_bench.range_rest == 0)) ? BENCH_RANGE_SPLIT : 32;
+    sim_get_stats(&stats);
+    writes = stats.write_bytes;
+    ns = a_bench_ns();
+    cycles = a_bench_cycles();
+    if ((gs_bench.timestamp != 0) && (irq_us == 0))
+    {
+        res = l3gd20h_read_timestamp(&gs_bench.handle, &gs_bench.ts, raw, dps, us, &len);
+    }
+    else if (gs_bench.async != 0)
+    {
+        res = a_bench_async_read(raw, dps, &len);
+    }
+    else
+    {
+        res = l3gd20h_read(&gs_bench.handle, raw, dps, &len);
+    }
+    if ((res == 0) && (gs_bench.timestamp != 0) && (irq_us != 0) && (len != 0))
+    {
+        res = l3gd20h_timestamp_assign(&gs_bench.ts, irq_us, (uint16_t)(len - 1), len, us);
+    }
+    if (res != 0)
+    {
+        gs_bench.error = 1;
+        a_bench_trace();
+
+        return;
+    }
+    gs_bench.cycles += a_bench_cycles() - cycles;
+    gs_bench.ns += a_bench_ns() - ns;
+    gs_bench.delivered += len;
+    a_bench_trace();
+    if (gs_bench.timestamp != 0)
+    {
+        a_bench_timestamp(us, len);
+    }
+    if (gs_bench.attitude != 0)
+    {
+        a_bench_attitude((const int16_t (*)[3])raw, us, len);
+    }
+    if (gs_bench.filter != 0)
+    {
+        a_bench_filter((const float (*)[3])dps, len);
+    }
+    if (gs_bench.decimate != 0)
+    {
+        a_bench_decimate((const int16_t (*)[3])raw, (gs_bench.timestamp != 0) ? us : NULL, len);
+    }
+    if (gs_bench.spectrum != 0)
+    {
+        a_bench_spectrum((const float (*)[3])dps, (gs_bench.timestamp != 0) ? us : NULL, len);
+    }
+    if (gs_bench.event != 0)
+    {
+        a_bench_event((const int16_t (*)[3])raw, us, len);
+    }
+    if (gs_bench.ig != 0)
+    {
+        uint64_t ns = a_bench_ns();
+
+        (void)l3gd20h_ig_feed(&gs_bench.ig_model, (const int16_t (*)[3])raw, len, NULL);
+        gs_bench.ig_ns += a_bench_ns() - ns;
+    }
+    if (gs_bench.remap != 0)
+    {
+        a_bench_remap((const int16_t (*)[3])raw, (const float (*)[3])dps, len);
+    }
+    if (gs_bench.range != 0)
+    {
+        a_bench_range((const int16_t (*)[3])raw, (const float (*)[3])dps, len);
+    }
+
+    /* the newest sample is the youngest, the others are one period apart */
+    if ((len != 0) && (gs_bench.backend != BENCH_BACKEND_REPLAY))
+    {
+        age = sim_get_time_us() - sim_get_sample_time_us();
+        gs_bench.age_us += (double)len * ((double)age + (double)gs_bench.period_us * (double)(len - 1) / 2.0);
+    }
+
+    /* the rest of a split read sees the samples queued at a switch, a register read that switched is
+     * repeated before the next sample, so the sample of the previous full scale comes back once more */
+    sim_get_stats(&stats);
+    if ((gs_bench.range != 0) && (gs_bench.range_rest == 0) &&
+        ((len == BENCH_RANGE_SPLIT) || ((len == 1) && (stats.write_bytes != writes))))
+    {
+        gs_bench.range_rest = 1;
+        a_bench_read(0);
+        gs_bench.range_rest = 0;
+    }
+}
+
+/**
+ * @brief     host load of a threshold interrupt
+ * @param[in] us interrupt time in us
+ * @return    load in us
+ * @note      none
+ */
+static uint32_t a_bench_watermark_load(uint64_t us)
+{
+    return gs_watermark_load_us[(us / 1000000ULL) % 4];
+}
+
+/**
+ * @brief  serve a waiting threshold interrupt
+ * @note   the latency runs from the capture of the oldest drained sample to the service, the service
+ *         time is fed back to the controller and a level that stays at the new threshold is served again
+ */
+static void a_bench_watermark_serve(void)
+{
+    uint64_t now;
+    uint64_t irq;
+    uint64_t oldest;
+    uint32_t len;
+    double latency;
+
+    now = sim_get_time_us();
+    irq = gs_bench.wm_irq_us;
+    gs_bench.wm_pending = 0;
+    len = gs_bench.delivered;
+    a_bench_read(irq);
+    len = gs_bench.delivered - len;
+    gs_bench.irq_ns += (now - irq) * 1000ULL;
+    gs_bench.irqs++;
+    if (len != 0)
+    {
+        oldest = sim_get_sample_time_us() - (uint64_t)gs_bench.period_us * (uint64_t)(len - 1);
+        latency = (double)(now - oldest);
+        gs_bench.wm_batches++;
+        gs_bench.wm_latency += latency;
+        gs_bench.wm_latency_max = (latency > gs_bench.wm_latency_max) ? latency : gs_bench.wm_latency_max;
+        gs_bench.wm_over += (latency > (double)gs_bench.watermark_ms * 1000.0) ? 1 : 0;
+    }
+    if (l3gd20h_watermark_update(&gs_bench.wm, &gs_bench.handle, (float)(now - irq)) != 0)
+    {
+        gs_bench.error = 1;
+
+        return;
+    }
+    gs_bench.wm_min = (gs_bench.wm.threshold < gs_bench.wm_min) ? gs_bench.wm.threshold : gs_bench.wm_min;
+    gs_bench.wm_max = (gs_bench.wm.threshold > gs_bench.wm_max) ? gs_bench.wm.threshold : gs_bench.wm_max;
+    if (sim_get_pin(SIM_PIN_INT2) == 0)
+    {
+        gs_bench.wm_pending = 1;
+        gs_bench.wm_irq_us = now;
+    }
+}
+
+/**
+ * @brief     advance the virtual clock and serve the host
+ * @param[in] us time in us
+ * @note      none
+ */
+static void a_bench_watermark_advance(uint32_t us)
+{
+    uint32_t step;
+
+    while ((us != 0) && (gs_bench.error == 0))
+    {
+        step = (us < BENCH_WATERMARK_STEP_US) ? us : BENCH_WATERMARK_STEP_US;
+        sim_advance_us(step);
+        us -= step;
+        if ((gs_bench.wm_pending != 0) &&
+            (sim_get_time_us() >= gs_bench.wm_irq_us + a_bench_watermark_load(gs_bench.wm_irq_us)))
+        {
+            a_bench_watermark_serve();
+        }
+    }
+}
+
+/**
+ * @brief     power controller batch callback
+ * @param[in] state state the batch was sampled in
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] **dps pointer to a converted data buffer
+ * @param[in] len batch length
+ * @note      a watch batch is the frozen history of a wake, it covers the onset when its oldest sample is
+ *            not younger than the motion start of the period of its newest sample
+ */
+static void a_bench_power_batch(l3gd20h_power_state_t state, int16_t (*raw)[3], float (*dps)[3], uint16_t len)
+{
+    uint64_t newest;
+    uint64_t span;
+    uint64_t onset;
+    uint32_t period;
+
+    (void)raw;
+    (void)dps;
+    newest = sim_get_sample_time_us();
+    period = sim_get_period_us();
+    gs_bench.delivered += len;
+    gs_bench.age_us += (double)len * ((double)(sim_get_time_us() - newest) + (double)period * (double)(len - 1) / 2.0);
+    if (state == L3GD20H_POWER_STATE_WATCH)
+    {
+        span = (uint64_t)period * (uint64_t)(len - 1);
+        onset = newest - newest % BENCH_POWER_PERIOD_US + BENCH_POWER_ONSET_US;
+        if ((newest >= onset) && (newest - onset <= span))
+        {
+            gs_bench.power_onsets++;
+        }
+    }
+}
+
+/**
+ * @brief     power controller edge callback
+ * @param[in] pin simulated interrupt pin
+ * @param[in] level new pin level
+ * @note      the int1 line is active high and the int2 line active low, every served edge is a host wakeup
+ */
+static void a_bench_power_edge(sim_pin_t pin, uint8_t level)
+{
+    l3gd20h_power_state_t prev;
+    l3gd20h_power_state_t state;
+    uint64_t ns;
+    uint64_t cycles;
+    uint8_t num;
+
+    if ((pin == SIM_PIN_INT1) && (level == 1))
+    {
+        num = 1;
+    }
+    else if ((pin == SIM_PIN_INT2) && (level == 0))
+    {
+        num = 2;
+    }
+    else
+    {
+        return;
+    }
+    (void)l3gd20h_power_get_state(&gs_bench.pwr, &prev);
+    ns = a_bench_ns();
+    cycles = a_bench_cycles();
+    if (l3gd20h_power_irq_handler(&gs_bench.pwr, num) != 0)
+    {
+        gs_bench.error = 1;
+    }
+    gs_bench.cycles += a_bench_cycles() - cycles;
+    ns = a_bench_ns() - ns;
+    gs_bench.ns += ns;
+    gs_bench.irq_ns += ns;
+    gs_bench.irqs++;
+    a_bench_trace();
+
+    /* account the time spent at the active rate */
+    (void)l3gd20h_power_get_state(&gs_bench.pwr, &state);
+    if ((prev == L3GD20H_POWER_STATE_WATCH) && (state == L3GD20H_POWER_STATE_ACTIVE))
+    {
+        gs_bench.power_since_us = sim_get_time_us();
+    }
+    else if ((prev == L3GD20H_POWER_STATE_ACTIVE) && (state == L3GD20H_POWER_STATE_WATCH))
+    {
+        gs_bench.power_active_us += sim_get_time_us() - gs_bench.power_since_us;
+    }
+    else
+    {
+        /* no switch */
+    }
+}
+
+/**
+ * @brief     int2 edge callback
+ * @param[in] pin simulated interrupt pin
+ * @param[in] level new pin level
+ * @note      the int2 line is active low, the power controller serves both lines itself and the watermark
+ *            run defers the service to the host load
+ */
+static void a_bench_edge(sim_pin_t pin, uint8_t level)
+{
+    uint64_t ns;
+
+    if (gs_bench.power != 0)
+    {
+        a_bench_power_edge(pin, level);
+
+        return;
+    }
+    if (gs_bench.watermark != 0)
+    {
+        /* the host serves the interrupt after its load */
+        if ((pin == SIM_PIN_INT2) && (level == 0) && (gs_bench.wm_pending == 0))
+        {
+            gs_bench.wm_pending = 1;
+            gs_bench.wm_irq_us = sim_get_time_us();
+        }
+
+        return;
+    }
+    if ((pin == SIM_PIN_INT2) && (level == 0))
+    {
+        ns = a_bench_ns();
+        if (gs_bench.trace != NULL)
+        {
+            (void)l3gd20h_irq_handler(&gs_bench.handle, 2);
+        }
+        a_bench_read(sim_get_time_us());
+        gs_bench.irq_ns += a_bench_ns() - ns;
+        gs_bench.irqs++;
+    }
+}
+
+/**
+ * @brief     init the chip for a bench run
+ * @param[in] interface chip interface
+ * @param[in] *rate pointer to a rate
+ * @param[in] mode bench mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+static uint8_t a_bench_init(l3gd20h_interface_t interface, const bench_rate_t *rate, bench_mode_t mode)
+{
+    l3gd20h_handle_t *handle = &gs_bench.handle;
+    uint8_t res;
+
+    /* link interface function */
+    DRIVER_L3GD20H_LINK_INIT(handle, l3gd20h_handle_t);
+    DRIVER_L3GD20H_LINK_IIC_INIT(handle, l3gd20h_interface_iic_init);
+    DRIVER_L3GD20H_LINK_IIC_DEINIT(handle, l3gd20h_interface_iic_deinit);
+    DRIVER_L3GD20H_LINK_IIC_READ(handle, l3gd20h_interface_iic_read);
+    DRIVER_L3GD20H_LINK_IIC_WRITE(handle, l3gd20h_interface_iic_write);
+    DRIVER_L3GD20H_LINK_SPI_INIT(handle, l3gd20h_interface_spi_init);
+    DRIVER_L3GD20H_LINK_SPI_DEINIT(handle, l3gd20h_interface_spi_deinit);
+    DRIVER_L3GD20H_LINK_SPI_READ(handle, l3gd20h_interface_spi_read);
+    DRIVER_L3GD20H_LINK_SPI_WRITE(handle, l3gd20h_interface_spi_write);
+    DRIVER_L3GD20H_LINK_IIC_READ_ASYNC(handle, sim_iic_read_async);
+    DRIVER_L3GD20H_LINK_IIC_WRITE_ASYNC(handle, sim_iic_write_async);
+    DRIVER_L3GD20H_LINK_SPI_READ_ASYNC(handle, sim_spi_read_async);
+    DRIVER_L3GD20H_LINK_SPI_WRITE_ASYNC(handle, sim_spi_write_async);
+    DRIVER_L3GD20H_LINK_DELAY_MS(handle, l3gd20h_interface_delay_ms);
+    DRIVER_L3GD20H_LINK_DEBUG_PRINT(handle, l3gd20h_interface_debug_print);
+    DRIVER_L3GD20H_LINK_RECEIVE_CALLBACK(handle, a_bench_receive);
+    if ((gs_bench.counters != NULL) || (gs_bench.trace != NULL))
+    {
+        /* the clock is only read when the timing is wanted */
+        DRIVER_L3GD20H_LINK_TIMESTAMP_US(handle, a_bench_us);
+    }
+    else if ((gs_bench.timestamp != 0) || (gs_bench.settle != 0))
+    {
+        /* the sample times follow the virtual clock of the simulated device */
+        DRIVER_L3GD20H_LINK_TIMESTAMP_US(handle, l3gd20h_interface_timestamp_us);
+    }
+    gs_bench.trace_pid++;
+    if (gs_bench.backend == BENCH_BACKEND_RECORD)
+    {
+        DRIVER_L3GD20H_LINK_IIC_READ(handle, l3gd20h_record_iic_read);
+        DRIVER_L3GD20H_LINK_IIC_WRITE(handle, l3gd20h_record_iic_write);
+        DRIVER_L3GD20H_LINK_SPI_READ(handle, l3gd20h_record_spi_read);
+        DRIVER_L3GD20H_LINK_SPI_WRITE(handle, l3gd20h_record_spi_write);
+    }
+    else if (gs_bench.backend == BENCH_BACKEND_REPLAY)
+    {
+        DRIVER_L3GD20H_LINK_IIC_READ(handle, l3gd20h_replay_iic_read);
+        DRIVER_L3GD20H_LINK_IIC_WRITE(handle, l3gd20h_replay_iic_write);
+        DRIVER_L3GD20H_LINK_SPI_READ(handle, l3gd20h_replay_spi_read);
+        DRIVER_L3GD20H_LINK_SPI_WRITE(handle, l3gd20h_replay_spi_write);
+        DRIVER_L3GD20H_LINK_DELAY_MS(handle, l3gd20h_replay_delay_ms);
+        DRIVER_L3GD20H_LINK_DEBUG_PRINT(handle, a_bench_quiet);
+    }
+    else
+    {
+        /* the simulated device is linked by default */
+    }
+
+    /* init the chip */
+    res = l3gd20h_set_interface(handle, interface);
+    res |= l3gd20h_set_addr_pin(handle, L3GD20H_ADDRESS_SDO_0);
+    res |= l3gd20h_init(handle);
+    if (res != 0)
+    {
+        return 1;
+    }
+
+    /* set the rate and the active low int2 */
+    res = l3gd20h_set_rate_bandwidth(handle, rate->rate);
+    res |= l3gd20h_set_full_scale(handle, L3GD20H_FULL_SCALE_245_DPS);
+    res |= l3gd20h_set_data_ready_active_level(handle, L3GD20H_INTERRUPT_ACTIVE_LEVEL_LOW);
+    switch (mode)
+    {
+        case BENCH_MODE_DRDY :
+        {
+            res |= l3gd20h_set_data_ready_on_interrupt2(handle, L3GD20H_BOOL_TRUE);
+
+            break;
+        }
+        case BENCH_MODE_FIFO :
+        {
+            res |= l3gd20h_set_fifo_threshold(handle, BENCH_BATCH);
+            res |= l3gd20h_set_fifo_mode(handle, L3GD20H_FIFO_MODE_FIFO);
+            res |= l3gd20h_set_fifo_threshold_on_interrupt2(handle, L3GD20H_BOOL_TRUE);
+            res |= l3gd20h_set_fifo(handle, L3GD20H_BOOL_TRUE);
+
+            break;
+        }
+        case BENCH_MODE_STREAM :
+        {
+            res |= l3gd20h_set_fifo_mode(handle, L3GD20H_FIFO_MODE_STREAM);
+            res |= l3gd20h_set_fifo(handle, L3GD20H_BOOL_TRUE);
+
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+    if (gs_bench.ig != 0)
+    {
+        /* the generator sees every sample from the first one on */
+        res |= l3gd20h_ig_write_config(handle, &gs_ig_config);
+        res |= l3gd20h_set_interrupt1(handle, L3GD20H_BOOL_TRUE);
+    }
+    if (gs_bench.remap != 0)
+    {
+        /* the mounting is set once per handle */
+        res |= l3gd20h_rotate_apply(handle, &gs_bench.rot_remap);
+    }
+    if (gs_bench.range != 0)
+    {
+        res |= l3gd20h_set_auto_range(handle, L3GD20H_BOOL_TRUE);
+    }
+    if (gs_bench.settle != 0)
+    {
+        /* the wake opens the first window */
+        res |= l3gd20h_set_settle(handle, (l3gd20h_settle_t)gs_bench.settle);
+    }
+    res |= l3gd20h_set_mode(handle, L3GD20H_MODE_NORMAL);
+    if (gs_bench.power != 0)
+    {
+        /* watch at 12.5Hz, run at the bench rate and fall back after half a second of rest */
+        l3gd20h_power_config_t config;
+
+        config.watch_rate = L3GD20H_LOW_ODR_1_ODR_12P5HZ_BW_0_NA;
+        config.active_rate = rate->rate;
+        config.wake_dps = 20.0f;
+        config.wake_samples = 1;
+        config.quiet_dps = 5.0f;
+        config.quiet_samples = (uint32_t)(rate->odr / 2.0f);
+        config.watermark = BENCH_BATCH;
+        res |= l3gd20h_power_init(&gs_bench.pwr, handle, &config, a_bench_power_batch);
+    }
+    if (gs_bench.watermark != 0)
+    {
+        /* the first threshold assumes an instant service */
+        l3gd20h_watermark_config_t config;
+
+        config.latency_ms = gs_bench.watermark_ms;
+        config.irq_hz = BENCH_WATERMARK_IRQ_HZ;
+        if (l3gd20h_watermark_init(&gs_bench.wm, &config, rate->odr) != 0)
+        {
+            res |= 1;
+        }
+        else
+        {
+            res |= l3gd20h_watermark_apply(&gs_bench.wm, handle);
+        }
+    }
+    if (gs_bench.bias != 0)
+    {
+        res |= l3gd20h_bias_set_mode(handle, L3GD20H_BIAS_TRACK);
+    }
+    else if (gs_bench.drift != 0)
+    {
+        res |= l3gd20h_bias_set_mode(handle, L3GD20H_BIAS_HOLD);
+    }
+    if (gs_bench.drift != 0)
+    {
+        res |= a_bench_temp_fit(handle);
+    }
+    if (gs_bench.reference != 0)
+    {
+        res |= l3gd20h_reference_calibrate(handle, BENCH_REFERENCE_PERIOD);
+    }
+    if (res != 0)
+    {
+        (void)l3gd20h_deinit(handle);
+
+        return 1;
+    }
+    a_bench_trace();
+
+    return 0;
+}
+
+/**
+ * @brief  dump the driver counters of a run
+ * @return status code
+ *         - 0 success
+ *         - 1 dump failed
+ * @note   every run replaces the dump of the previous run
+ */
+static uint8_t a_bench_counters(void)
+{
+    l3gd20h_counter_t counter;
+
+    if (gs_bench.counters == NULL)
+    {
+        return 0;
+    }
+    if (l3gd20h_counter_snapshot(&gs_bench.handle, &counter) != 0)
+    {
+        return 1;
+    }
+    if (l3gd20h_counter_dump(&counter, gs_bench.counters) != 0)
+    {
+        l3gd20h_interface_debug_print("l3gd20h: dump %s failed.\n", gs_bench.counters);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      run one bench
+ * @param[in]  interface chip interface
+ * @param[in]  *rate pointer to a rate
+ * @param[in]  mode bench mode
+ * @param[in]  samples sample number
+ * @param[out] *result pointer to a result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_bench_run(l3gd20h_interface_t interface, const bench_rate_t *rate, bench_mode_t mode,
+                           uint32_t samples, bench_result_t *result)
+{
+    uint32_t i;
+    sim_stats_t stats;
+    double n;
+    float odr;
+    float odr_bound;
+    uint8_t converged;
+    double limit;
+
+    if (a_bench_init(interface, rate, mode) != 0)
+    {
+        return 1;
+    }
+
+    /* start from clean counters, the device period includes the oscillator error */
+    gs_bench.period_us = sim_get_period_us();
+    gs_bench.delivered = 0;
+    gs_bench.ns = 0;
+    gs_bench.cycles = 0;
+    gs_bench.irq_ns = 0;
+    gs_bench.irqs = 0;
+    gs_bench.age_us = 0.0;
+    gs_bench.error = 0;
+    gs_bench.ts_us = 0.0;
+    gs_bench.ts_max_us = 0.0;
+    (void)l3gd20h_timestamp_init(&gs_bench.ts, rate->rate);
+    (void)l3gd20h_attitude_init(&gs_bench.att, L3GD20H_ATTITUDE_TYPE_FLOAT);
+    (void)l3gd20h_attitude_init(&gs_bench.att_fixed, L3GD20H_ATTITUDE_TYPE_FIXED);
+    (void)l3gd20h_attitude_bank_init(&gs_bench.att_bank, L3GD20H_ATTITUDE_LANES);
+    gs_bench.att_us = 0;
+    gs_bench.att_ns = 0;
+    (void)l3gd20h_filter_init(&gs_bench.filt, L3GD20H_FILTER_TYPE_LOW_PASS, BENCH_FILTER_STAGES, L3GD20H_FILTER_LANES);
+    memset(gs_bench.filter_z, 0, sizeof(gs_bench.filter_z));
+    gs_bench.filter_error = 0.0;
+    gs_bench.filter_in = 0.0;
+    gs_bench.filter_out = 0.0;
+    gs_bench.filter_n = 0;
+    gs_bench.filter_ns = 0;
+    if ((gs_bench.filter != 0) && (a_bench_filter_design(rate->odr) != 0))
+    {
+        (void)l3gd20h_deinit(&gs_bench.handle);
+
+        return 1;
+    }
+    memset(gs_bench.dec_sum, 0, sizeof(gs_bench.dec_sum));
+    memset(gs_bench.dec_hist, 0, sizeof(gs_bench.dec_hist));
+    memset(gs_bench.dec_fir, 0, sizeof(gs_bench.dec_fir));
+    gs_bench.dec_ref_head = 0;
+    gs_bench.dec_ref_count = 0;
+    gs_bench.dec_pos = 0;
+    gs_bench.dec_phase = 0;
+    gs_bench.dec_high = 0;
+    gs_bench.dec_low = 0;
+    gs_bench.dec_error = 0.0;
+    gs_bench.dec_time = 0.0;
+    gs_bench.dec_inputs = 0;
+    gs_bench.dec_in = 0.0;
+    gs_bench.dec_out = 0.0;
+    gs_bench.dec_ns = 0;
+    if ((gs_bench.decimate != 0) &&
+        ((l3gd20h_decimate_init(&gs_bench.dec, gs_bench.decimate) != 0) ||
+         (l3gd20h_decimate_subscribe(&gs_bench.dec, L3GD20H_DECIMATE_RATE_HIGH, a_bench_decimate_high) != 0) ||
+         (l3gd20h_decimate_subscribe(&gs_bench.dec, L3GD20H_DECIMATE_RATE_LOW, a_bench_decimate_low) != 0)))
+    {
+        (void)l3gd20h_deinit(&gs_bench.handle);
+
+        return 1;
+    }
+    gs_bench.spectrum_odr = rate->odr;
+    gs_bench.spec_results = 0;
+    gs_bench.spec_peak = 0.0;
+    gs_bench.spec_amplitude = 0.0;
+    gs_bench.spec_band = 0.0;
+    gs_bench.spec_n = 0;
+    gs_bench.spec_ns = 0;
+    if (gs_bench.spectrum != 0)
+    {
+        float edge[5];
+        uint32_t k;
+
+        /* half overlapping windows, four per result and four even bands */
+        for (k = 0; k < 5; k++)
+        {
+            edge[k] = rate->odr * (float)k / 8.0f;
+        }
+        if ((l3gd20h_spectrum_init(&gs_bench.spec, L3GD20H_SPECTRUM_SIZE / 2, 4, a_bench_spectrum_result) != 0) ||
+            (l3gd20h_spectrum_set_odr(&gs_bench.spec, rate->odr) != 0) ||
+            (l3gd20h_spectrum_set_bands(&gs_bench.spec, edge, 4) != 0))
+        {
+            (void)l3gd20h_deinit(&gs_bench.handle);
+
+            return 1;
+        }
+    }
+    gs_bench.event_starts = 0;
+    gs_bench.event_change_starts = 0;
+    gs_bench.event_delay_us = 0.0;
+    gs_bench.event_first_us = 0;
+    gs_bench.event_last_us = 0;
+    gs_bench.event_n = 0;
+    gs_bench.event_ns = 0;
+    if (gs_bench.event != 0)
+    {
+        const l3gd20h_event_rule_t magnitude = {L3GD20H_EVENT_TYPE_MAGNITUDE, L3GD20H_EVENT_COMBINE_OR, 0x07,
+                                                30.0f, 20.0f, 50.0f};
+        const l3gd20h_event_rule_t change = {L3GD20H_EVENT_TYPE_CHANGE, L3GD20H_EVENT_COMBINE_OR,
+                                             L3GD20H_EVENT_AXIS_X, 250.0f, 150.0f, 0.0f};
+
+        if ((l3gd20h_event_init(&gs_bench.engine, L3GD20H_FULL_SCALE_245_DPS, rate->odr, a_bench_event_edge) != 0) ||
+            (l3gd20h_event_add_rule(&gs_bench.engine, &magnitude, NULL) != 0) ||
+            (l3gd20h_event_add_rule(&gs_bench.engine, &change, NULL) != 0))
+        {
+            (void)l3gd20h_deinit(&gs_bench.handle);
+
+            return 1;
+        }
+    }
+    gs_bench.ig_ns = 0;
+    if ((gs_bench.ig != 0) && ((a_bench_ig_check() != 0) ||
+        (l3gd20h_ig_init(&gs_bench.ig_model, &gs_ig_config, rate->odr) != 0)))
+    {
+        (void)l3gd20h_deinit(&gs_bench.handle);
+
+        return 1;
+    }
+    gs_bench.remap_error = 0.0;
+    gs_bench.rotate_error = 0.0;
+    gs_bench.remap_n = 0;
+    gs_bench.remap_ns = 0;
+    gs_bench.range_rest = 0;
+    gs_bench.range_last = 0xFF;
+    gs_bench.range_switches = 0;
+    gs_bench.range_queued = 0;
+    gs_bench.range_clipped = 0;
+    gs_bench.range_error = 0.0;
+    gs_bench.power_onsets = 0;
+    gs_bench.power_start_us = sim_get_time_us();
+    gs_bench.power_since_us = gs_bench.power_start_us;
+    gs_bench.power_active_us = 0;
+    gs_bench.wm_pending = 0;
+    gs_bench.wm_irq_us = 0;
+    gs_bench.wm_min = gs_bench.wm.threshold;
+    gs_bench.wm_max = gs_bench.wm.threshold;
+    gs_bench.wm_batches = 0;
+    gs_bench.wm_over = 0;
+    gs_bench.wm_latency = 0.0;
+    gs_bench.wm_latency_max = 0.0;
+    gs_bench.async_fifo = ((mode == BENCH_MODE_FIFO) || (mode == BENCH_MODE_STREAM)) ? 1 : 0;
+    gs_bench.async_done = 0;
+    gs_bench.async_errors = 0;
+    if ((gs_bench.async != 0) && (a_bench_async_check() != 0))
+    {
+        (void)l3gd20h_deinit(&gs_bench.handle);
+
+        return 1;
+    }
+    gs_bench.settle_samples = 0;
+    if ((gs_bench.settle != 0) && (a_bench_settle_check(rate, mode) != 0))
+    {
+        (void)l3gd20h_deinit(&gs_bench.handle);
+
+        return 1;
+    }
+    sim_clear_stats();
+    if ((mode == BENCH_MODE_DRDY) || (mode == BENCH_MODE_FIFO))
+    {
+        sim_set_edge_callback(a_bench_edge);
+    }
+    else if (gs_bench.timestamp != 0)
+    {
+        /* a poller is not aligned to the sample clock, poll in the middle of the periods */
+        sim_advance_us(rate->period_us / 2);
+    }
+
+    /* run the virtual clock one period at a time */
+    for (i = 0; (i < samples) && (gs_bench.error == 0); i++)
+    {
+        if (gs_bench.drift != 0)
+        {
+            sim_set_temperature(a_bench_temperature(sim_get_time_us()));
+        }
+        if (gs_bench.watermark != 0)
+        {
+            a_bench_watermark_advance(rate->period_us);
+        }
+        else
+        {
+            sim_advance_us(rate->period_us);
+        }
+        if (mode == BENCH_MODE_BYPASS)
+        {
+            a_bench_read(0);
+        }
+        else if ((mode == BENCH_MODE_STREAM) && (((i + 1) % BENCH_BATCH) == 0))
+        {
+            a_bench_read(0);
+        }
+        else
+        {
+            /* interrupt modes read in the edge callback */
+        }
+    }
+    sim_set_edge_callback(NULL);
+
+    /* drain what is left in the fifo, the watch history of the power controller is never read */
+    if ((gs_bench.error == 0) && ((mode == BENCH_MODE_FIFO) || (mode == BENCH_MODE_STREAM)) && (gs_bench.power == 0))
+    {
+        a_bench_read(0);
+    }
+    sim_get_stats(&stats);
+    if (a_bench_counters() != 0)
+    {
+        gs_bench.error = 1;
+    }
+    result->bias = 0.0;
+    result->bias_windows = 0;
+    result->reference = 0;
+    result->reference_error = 0.0;
+    result->reference_runs = 0;
+    if (gs_bench.reference != 0)
+    {
+        float residual[3];
+        double level = 0.0;
+        uint32_t k;
+
+        /* the hardware removes the reference from the common level only */
+        if (l3gd20h_reference_get(&gs_bench.handle, &result->reference, residual, &result->reference_runs) != 0)
+        {
+            gs_bench.error = 1;
+        }
+        for (k = 0; k < 3; k++)
+        {
+            level += (double)gs_bench.zero_rate[k] / 3.0;
+        }
+        result->reference_error = fabs(level - (double)result->reference * SIM_REFERENCE_DPS);
+    }
+    result->attitude = 0.0;
+    result->attitude_fixed = 0.0;
+    result->attitude_bank = 0.0;
+    result->attitude_ns = 0.0;
+    if (gs_bench.attitude != 0)
+    {
+        float q[4];
+        double err;
+        uint8_t j;
+
+        (void)l3gd20h_attitude_get(&gs_bench.att, q);
+        result->attitude = a_bench_attitude_error(q);
+        (void)l3gd20h_attitude_get(&gs_bench.att_fixed, q);
+        result->attitude_fixed = a_bench_attitude_error(q);
+        for (j = 0; j < L3GD20H_ATTITUDE_LANES; j++)
+        {
+            (void)l3gd20h_attitude_bank_get(&gs_bench.att_bank, j, q);
+            err = a_bench_attitude_error(q);
+            result->attitude_bank = (err > result->attitude_bank) ? err : result->attitude_bank;
+        }
+        result->attitude_ns = (gs_bench.att.samples != 0) ? (double)gs_bench.att_ns / (double)gs_bench.att.samples : 0.0;
+    }
+    result->filter_corner = 0.0;
+    result->filter_error = 0.0;
+    result->filter_in = 0.0;
+    result->filter_out = 0.0;
+    result->filter_ns = 0.0;
+    if ((gs_bench.filter != 0) && (gs_bench.filter_n != 0))
+    {
+        result->filter_corner = gs_bench.filt.corner;
+        result->filter_error = gs_bench.filter_error;
+        result->filter_in = sqrt(gs_bench.filter_in / (3.0 * (double)gs_bench.filter_n));
+        result->filter_out = sqrt(gs_bench.filter_out / (3.0 * (double)gs_bench.filter_n));
+        result->filter_ns = (double)gs_bench.filter_ns / (double)gs_bench.filter_n;
+    }
+    result->decimate_high = gs_bench.dec_high;
+    result->decimate_low = gs_bench.dec_low;
+    result->decimate_error = gs_bench.dec_error;
+    result->decimate_time = gs_bench.dec_time;
+    result->decimate_in = 0.0;
+    result->decimate_out = 0.0;
+    result->decimate_ns = 0.0;
+    if (gs_bench.dec_high != 0)
+    {
+        result->decimate_in = sqrt(gs_bench.dec_in / (3.0 * (double)gs_bench.dec_high)) * 0.00875;
+        result->decimate_ns = (double)gs_bench.dec_ns / (double)gs_bench.dec_high;
+    }
+    if (gs_bench.dec_low != 0)
+    {
+        result->decimate_out = sqrt(gs_bench.dec_out / (3.0 * (double)gs_bench.dec_low)) * 0.00875;
+    }
+    result->spectrum_results = gs_bench.spec_results;
+    result->spectrum_peak = gs_bench.spec_peak;
+    result->spectrum_amplitude = gs_bench.spec_amplitude;
+    result->spectrum_band = gs_bench.spec_band;
+    result->spectrum_ns = (gs_bench.spec_n != 0) ? (double)gs_bench.spec_ns / (double)gs_bench.spec_n : 0.0;
+    result->ig_edges = stats.int1_edges;
+    result->ig_model_edges = gs_bench.ig_model.edges;
+    result->ig_rises = gs_bench.ig_model.rises;
+    result->ig_ns = (gs_bench.ig_model.samples != 0) ? (double)gs_bench.ig_ns / (double)gs_bench.ig_model.samples : 0.0;
+    result->remap_error = gs_bench.remap_error;
+    result->rotate_error = gs_bench.rotate_error;
+    result->rotate_ns = (gs_bench.remap_n != 0) ? (double)gs_bench.remap_ns / (double)gs_bench.remap_n : 0.0;
+    result->range_switches = gs_bench.range_switches;
+    result->range_queued = gs_bench.range_queued;
+    result->range_clipped = gs_bench.range_clipped;
+    result->range_error = gs_bench.range_error;
+    if ((gs_bench.range != 0) && (result->range_error > 0.001))
+    {
+        /* a sample decoded with the wrong full scale misses every level */
+        gs_bench.error = 1;
+    }
+    result->power_wakes = 0;
+    result->power_onsets = 0;
+    result->power_expected = 0;
+    result->power_pretrigger = 0;
+    result->power_active = 0.0;
+    result->power_irqs = 0.0;
+    result->power_bytes = 0.0;
+    if (gs_bench.power != 0)
+    {
+        uint64_t end;
+        uint64_t onset;
+        double run;
+
+        end = sim_get_time_us();
+        if (gs_bench.pwr.state == L3GD20H_POWER_STATE_ACTIVE)
+        {
+            gs_bench.power_active_us += end - gs_bench.power_since_us;
+        }
+        run = (double)(end - gs_bench.power_start_us);
+        result->power_wakes = gs_bench.pwr.wakes;
+        result->power_onsets = gs_bench.power_onsets;
+        result->power_pretrigger = gs_bench.pwr.pretrigger;
+        result->power_active = (double)gs_bench.power_active_us / run;
+        result->power_irqs = (double)gs_bench.irqs * 1000000.0 / run;
+        result->power_bytes = (double)(stats.read_bytes + stats.write_bytes) * 1000000.0 / run;
+
+        /* motions with a full watch fifo before them and the quiet hold after them */
+        onset = gs_bench.power_start_us - gs_bench.power_start_us % BENCH_POWER_PERIOD_US + BENCH_POWER_ONSET_US;
+        for (; onset + BENCH_POWER_MOTION_US + 1000000ULL <= end; onset += BENCH_POWER_PERIOD_US)
+        {
+            result->power_expected += (onset >= gs_bench.power_start_us + 32ULL * 80000ULL) ? 1 : 0;
+        }
+        if (result->power_onsets < result->power_expected)
+        {
+            /* a wake has to bring the samples before the motion start along */
+            gs_bench.error = 1;
+        }
+    }
+    result->watermark_min = gs_bench.wm_min;
+    result->watermark_max = gs_bench.wm_max;
+    result->watermark_retunes = gs_bench.wm.retunes;
+    result->watermark_latency = (gs_bench.wm_batches != 0) ? gs_bench.wm_latency / (double)gs_bench.wm_batches / 1000.0 : 0.0;
+    result->watermark_latency_max = gs_bench.wm_latency_max / 1000.0;
+    result->watermark_over = gs_bench.wm_over;
+    result->watermark_irqs = (double)gs_bench.irqs * 1000000.0 / ((double)samples * (double)rate->period_us);
+    if ((gs_bench.watermark != 0) && (stats.fifo_dropped != 0))
+    {
+        /* a retune or a slow service must not overrun the fifo */
+        gs_bench.error = 1;
+    }
+    result->async_requests = gs_bench.async_done;
+    result->settle_samples = gs_bench.settle_samples;
+    if ((gs_bench.async != 0) && (gs_bench.async_done == 0))
+    {
+        /* every read of the run goes through the queue */
+        gs_bench.error = 1;
+    }
+    if ((gs_bench.ig != 0) && (result->ig_edges != result->ig_model_edges))
+    {
+        /* the model has to follow the chip edge by edge */
+        gs_bench.error = 1;
+    }
+    result->event_starts = gs_bench.event_starts;
+    result->event_expected = 0;
+    result->event_delay_us = gs_bench.event_delay_us;
+    result->event_change_starts = gs_bench.event_change_starts;
+    result->event_ns = (gs_bench.event_n != 0) ? (double)gs_bench.event_ns / (double)gs_bench.event_n : 0.0;
+    if (gs_bench.event_n != 0)
+    {
+        double t;
+        uint32_t k;
+
+        /* four crossings per profile period that are held for the minimum duration before the last sample */
+        t = floor((double)gs_bench.event_first_us / 4000000.0) * 4000000.0 + asin(0.4) / (2.0 * M_PI) * 1000000.0;
+        for (k = 0; t + 50000.0 + (double)gs_bench.period_us <= (double)gs_bench.event_last_us; k++)
+        {
+            result->event_expected += (t >= (double)gs_bench.event_first_us) ? 1 : 0;
+            t += ((k % 4) == 3) ? 2500000.0 : 500000.0;
+        }
+    }
+    if ((gs_bench.bias != 0) || (gs_bench.drift != 0))
+    {
+        float bias[3];
+        float term[3] = {0.0f, 0.0f, 0.0f};
+        float degree;
+        float t;
+        uint32_t k;
+
+        /* the driver applies the stored bias plus the temperature term */
+        if (l3gd20h_bias_get(&gs_bench.handle, bias, &result->bias_windows) != 0)
+        {
+            gs_bench.error = 1;
+        }
+        if ((gs_bench.drift != 0) && (l3gd20h_bias_temp_get(&gs_bench.handle, &degree, term) != 0))
+        {
+            gs_bench.error = 1;
+        }
+        t = a_bench_temperature(sim_get_time_us());
+        for (k = 0; k < 3; k++)
+        {
+            double truth = (double)gs_bench.zero_rate[k] + (double)gs_bench.zero_rate_drift[k] * ((double)t - 25.0) -
+                           (double)result->reference * SIM_REFERENCE_DPS;
+            double err = fabs((double)bias[k] + (double)term[k] - truth);
+
+            result->bias = (err > result->bias) ? err : result->bias;
+        }
+    }
+    (void)l3gd20h_deinit(&gs_bench.handle);
+    if (gs_bench.error != 0)
+    {
+        return 1;
+    }
+
+    /* per sample figures */
+    n = (gs_bench.delivered != 0) ? (double)gs_bench.delivered : 1.0;
+    result->produced = stats.samples;
+    result->delivered = gs_bench.delivered;
+    result->lost = (stats.samples > gs_bench.delivered) ? (stats.samples - gs_bench.delivered) : 0;
+    result->transactions = (double)stats.transactions / n;
+    result->bytes = (double)(stats.read_bytes + stats.write_bytes) / n;
+    result->ns = (double)gs_bench.ns / n;
+    result->cycles = (double)gs_bench.cycles / n;
+    result->irq_ns = (gs_bench.irqs != 0) ? (double)gs_bench.irq_ns / (double)gs_bench.irqs : 0.0;
+    result->age_us = gs_bench.age_us / n;
+    result->ts_us = gs_bench.ts_us / n;
+    result->ts_max_us = gs_bench.ts_max_us;
+    result->odr = 0.0;
+    result->odr_bound = 0.0;
+    converged = 0;
+    if (l3gd20h_timestamp_get_odr(&gs_bench.ts, &odr, &odr_bound) == 0)
+    {
+        result->odr = odr;
+        result->odr_bound = odr_bound;
+        converged = 1;
+    }
+    if ((gs_bench.timestamp != 0) && ((result->ts_us > (double)gs_bench.period_us * BENCH_TIMESTAMP_MEAN) ||
+        (result->ts_max_us > (double)gs_bench.period_us * (double)L3GD20H_TIMESTAMP_RELOCK)))
+    {
+        /* a sample further away than the relock distance means the track was lost */
+        l3gd20h_interface_debug_print("l3gd20h: timestamp error %0.1f us max %0.1f us is too large.\n",
+                                      result->ts_us, result->ts_max_us);
+        gs_bench.error = 1;
+
+        return 1;
+    }
+    if ((gs_bench.timestamp != 0) && (mode != BENCH_MODE_BYPASS) &&
+        (((converged != 0) && (fabs(result->odr - 1000000.0 / (double)gs_bench.period_us) > result->odr_bound)) ||
+        ((converged == 0) && (gs_bench.ts.samples >= BENCH_ODR_SAMPLES))))
+    {
+        /* bypass polls cannot see the drift, the other modes have to converge on the real rate */
+        l3gd20h_interface_debug_print("l3gd20h: odr estimate %0.4f hz bound %0.4f hz misses %0.4f hz.\n",
+                                      result->odr, result->odr_bound, 1000000.0 / (double)gs_bench.period_us);
+        gs_bench.error = 1;
+
+        return 1;
+    }
+    if ((gs_bench.reference != 0) && (gs_bench.drift == 0) &&
+        ((result->reference_runs == 0) || (result->reference_error > (double)SIM_REFERENCE_DPS)))
+    {
+        /* a run ends within half a reference lsb of its measured level, the window noise adds the other half,
+           the temperature moves the level between two runs */
+        l3gd20h_interface_debug_print("l3gd20h: reference error %0.4f dps after %u runs is too large.\n",
+                                      result->reference_error, result->reference_runs);
+        gs_bench.error = 1;
+
+        return 1;
+    }
+    limit = BENCH_ATTITUDE_TOLERANCE + BENCH_ATTITUDE_STEP * (double)gs_bench.att.samples;
+    if ((gs_bench.attitude != 0) && ((result->attitude > limit) ||
+        (result->attitude_fixed > limit) || (result->attitude_bank > limit)))
+    {
+        l3gd20h_interface_debug_print("l3gd20h: attitude error %0.5f fixed %0.5f bank %0.5f exceeds %0.5f degrees.\n",
+                                      result->attitude, result->attitude_fixed, result->attitude_bank, limit);
+        gs_bench.error = 1;
+
+        return 1;
+    }
+    limit = (result->filter_corner > 0.0) ? (double)rate->odr / result->filter_corner : 0.0;
+    limit = BENCH_FILTER_TOLERANCE + BENCH_FILTER_SENSITIVITY * limit * sqrt(limit);
+    if ((gs_bench.filter != 0) && (result->filter_error > limit))
+    {
+        l3gd20h_interface_debug_print("l3gd20h: filter error %0.6f dps exceeds %0.6f dps.\n", result->filter_error, limit);
+        gs_bench.error = 1;
+
+        return 1;
+    }
+    /* both subscribers start at the first delivered sample, the low rate takes every factor-th */
+    if ((gs_bench.decimate != 0) && ((result->decimate_high != result->delivered) ||
+        (result->decimate_low != result->delivered / gs_bench.decimate)))
+    {
+        l3gd20h_interface_debug_print("l3gd20h: decimate delivered %u high %u low %u samples is wrong.\n",
+                                      result->delivered, result->decimate_high, result->decimate_low);
+        gs_bench.error = 1;
+
+        return 1;
+    }
+    /* the low rate times are the window centres up to the rounding of the lag to 1us, the rate estimate of
+     * a slower or faster device moves the input times, so only the lag over evenly spaced times is checked */
+    if ((gs_bench.decimate != 0) && (gs_bench.period_us == rate->period_us) && (result->decimate_time > 1.0))
+    {
+        l3gd20h_interface_debug_print("l3gd20h: decimate time error %0.1f us exceeds 1.0 us.\n", result->decimate_time);
+        gs_bench.error = 1;
+
+        return 1;
+    }
+    limit = (double)rate->odr * (BENCH_SPECTRUM_TOLERANCE / (double)L3GD20H_SPECTRUM_SIZE + gs_spectrum_ratio[2] *
+            fabs((double)gs_bench.period_us - (double)rate->period_us) / (double)rate->period_us);
+    if ((gs_bench.spectrum != 0) && ((result->spectrum_results == 0) || (result->spectrum_peak > limit)))
+    {
+        l3gd20h_interface_debug_print("l3gd20h: spectrum peak error %0.4f Hz after %u results exceeds %0.4f Hz.\n",
+                                      result->spectrum_peak, result->spectrum_results, limit);
+        gs_bench.error = 1;
+
+        return 1;
+    }
+    /* a crossing held across either end of the run may count or not, a slower or faster device moves the reads
+     * and bypass polls repeat or lose its samples */
+    limit = 1.0 + (double)result->event_expected * fabs((double)gs_bench.period_us - (double)rate->period_us) /
+            (double)rate->period_us;
+    if ((gs_bench.event != 0) && ((mode != BENCH_MODE_BYPASS) || (gs_bench.period_us == rate->period_us)) &&
+        (fabs((double)result->event_starts - (double)result->event_expected) > limit))
+    {
+        l3gd20h_interface_debug_print("l3gd20h: event starts %u expected %u are too far apart.\n",
+                                      result->event_starts, result->event_expected);
+        gs_bench.error = 1;
+
+        return 1;
+    }
+    limit = BENCH_BIAS_TOLERANCE;
+    if (gs_bench.drift != 0)
+    {
+        /* the term lags by the slope over one read interval and the whole degree of OUT_TEMP */
+        limit += (double)fmaxf(fabsf(gs_bench.zero_rate_drift[0]), fmaxf(fabsf(gs_bench.zero_rate_drift[1]),
+                 fabsf(gs_bench.zero_rate_drift[2]))) * (1.0 + BENCH_TEMP_SLOPE * (double)L3GD20H_BIAS_TEMP_INTERVAL *
+                 (double)gs_bench.period_us / 1000000.0);
+    }
+    if (((gs_bench.bias != 0) || (gs_bench.drift != 0)) &&
+        ((result->bias > limit) || ((gs_bench.bias != 0) && (result->bias_windows == 0))))
+    {
+        /* every rate holds still windows in the two still seconds of the source */
+        l3gd20h_interface_debug_print("l3gd20h: bias error %0.4f dps after %u windows exceeds %0.4f dps.\n",
+                                      result->bias, result->bias_windows, limit);
+        gs_bench.error = 1;
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     print one result
+ * @param[in] json 1 for json lines and 0 for csv
+ * @param[in] interface chip interface
+ * @param[in] *rate pointer to a rate
+ * @param[in] mode bench mode
+ * @param[in] *result pointer to a result structure
+ * @note      none
+ */
+static void a_bench_print(uint8_t json, l3gd20h_interface_t interface, const bench_rate_t *rate,
+                          bench_mode_t mode, const bench_result_t *result)
+{
+    const char *name = (interface == L3GD20H_INTERFACE_IIC) ? "iic" : "spi";
+
+    if (gs_bench.backend == BENCH_BACKEND_REPLAY)
+    {
+        if (json != 0)
+        {
+            l3gd20h_interface_debug_print("{\"interface\":\"%s\",\"mode\":\"%s\",\"odr_hz\":%0.1f,"
+                                          "\"delivered\":%u,\"recorded_s\":%0.3f,"
+                                          "\"ns_per_sample\":%0.1f,\"cycles_per_sample\":%0.1f}\n",
+                                          name, gs_mode_name[mode], rate->odr, result->delivered,
+                                          result->recorded_s, result->ns, result->cycles);
+        }
+        else
+        {
+            l3gd20h_interface_debug_print("%s,%s,%0.1f,%u,%0.3f,%0.1f,%0.1f\n",
+                                          name, gs_mode_name[mode], rate->odr, result->delivered,
+                                          result->recorded_s, result->ns, result->cycles);
+        }
+    }
+    else if (json != 0)
+    {
+        l3gd20h_interface_debug_print("{\"interface\":\"%s\",\"mode\":\"%s\",\"odr_hz\":%0.1f,"
+                                      "\"produced\":%u,\"delivered\":%u,\"lost\":%u,"
+                                      "\"transactions_per_sample\":%0.3f,\"bytes_per_sample\":%0.3f,"
+                                      "\"ns_per_sample\":%0.1f,\"cycles_per_sample\":%0.1f,"
+                                      "\"irq_to_data_ns\":%0.1f,\"sample_age_us\":%0.1f",
+                                      name, gs_mode_name[mode], rate->odr,
+                                      result->produced, result->delivered, result->lost,
+                                      result->transactions, result->bytes, result->ns, result->cycles,
+                                      result->irq_ns, result->age_us);
+        if (gs_bench.timestamp != 0)
+        {
+            l3gd20h_interface_debug_print(",\"timestamp_error_us\":%0.1f,\"timestamp_max_us\":%0.1f,"
+                                          "\"odr_estimate_hz\":%0.4f,\"odr_bound_hz\":%0.4f",
+                                          result->ts_us, result->ts_max_us, result->odr, result->odr_bound);
+        }
+        if ((gs_bench.bias != 0) || (gs_bench.drift != 0))
+        {
+            l3gd20h_interface_debug_print(",\"bias_error_dps\":%0.4f,\"bias_windows\":%u",
+                                          result->bias, result->bias_windows);
+        }
+        if (gs_bench.reference != 0)
+        {
+            l3gd20h_interface_debug_print(",\"reference\":%d,\"reference_error_dps\":%0.4f,\"reference_runs\":%u",
+                                          result->reference, result->reference_error, result->reference_runs);
+        }
+        if (gs_bench.attitude != 0)
+        {
+            l3gd20h_interface_debug_print(",\"attitude_error_deg\":%0.5f,\"attitude_fixed_error_deg\":%0.5f,"
+                                          "\"attitude_bank_error_deg\":%0.5f,\"attitude_ns_per_sample\":%0.1f",
+                                          result->attitude, result->attitude_fixed, result->attitude_bank,
+                                          result->attitude_ns);
+        }
+        if (gs_bench.filter != 0)
+        {
+            l3gd20h_interface_debug_print(",\"filter_corner_hz\":%0.3f,\"filter_error_dps\":%0.6f,"
+                                          "\"filter_in_dps\":%0.4f,\"filter_out_dps\":%0.4f,\"filter_ns_per_sample\":%0.1f",
+                                          result->filter_corner, result->filter_error, result->filter_in,
+                                          result->filter_out, result->filter_ns);
+        }
+        if (gs_bench.decimate != 0)
+        {
+            l3gd20h_interface_debug_print(",\"decimate_high\":%u,\"decimate_low\":%u,\"decimate_error_lsb\":%0.3f,"
+                                          "\"decimate_in_dps\":%0.4f,\"decimate_out_dps\":%0.4f,"
+                                          "\"decimate_ns_per_sample\":%0.1f,\"decimate_time_error_us\":%0.1f",
+                                          result->decimate_high, result->decimate_low, result->decimate_error,
+                                          result->decimate_in, result->decimate_out, result->decimate_ns,
+                                          result->decimate_time);
+        }
+        if (gs_bench.spectrum != 0)
+        {
+            l3gd20h_interface_debug_print(",\"spectrum_results\":%u,\"spectrum_peak_error_hz\":%0.4f,"
+                                          "\"spectrum_amplitude_error_dps\":%0.4f,\"spectrum_band_error\":%0.4f,"
+                                          "\"spectrum_ns_per_sample\":%0.1f",
+                                          result->spectrum_results, result->spectrum_peak, result->spectrum_amplitude,
+                                          result->spectrum_band, result->spectrum_ns);
+        }
+        if (gs_bench.event != 0)
+        {
+            l3gd20h_interface_debug_print(",\"event_starts\":%u,\"event_expected\":%u,\"event_delay_us\":%0.1f,"
+                                          "\"event_change_starts\":%u,\"event_ns_per_sample\":%0.1f",
+                                          result->event_starts, result->event_expected, result->event_delay_us,
+                                          result->event_change_starts, result->event_ns);
+        }
+        if (gs_bench.ig != 0)
+        {
+            l3gd20h_interface_debug_print(",\"ig_edges\":%u,\"ig_model_edges\":%u,\"ig_rises\":%u,\"ig_ns_per_sample\":%0.1f",
+                                          result->ig_edges, result->ig_model_edges, result->ig_rises, result->ig_ns);
+        }
+        if (gs_bench.remap != 0)
+        {
+            l3gd20h_interface_debug_print(",\"remap_error_dps\":%0.6f,\"rotate_error_dps\":%0.6f,\"rotate_ns_per_sample\":%0.1f",
+                                          result->remap_error, result->rotate_error, result->rotate_ns);
+        }
+        if (gs_bench.range != 0)
+        {
+            l3gd20h_interface_debug_print(",\"range_switches\":%u,\"range_queued\":%u,\"range_clipped\":%u,\"range_error_dps\":%0.6f",
+                                          result->range_switches, result->range_queued, result->range_clipped,
+                                          result->range_error);
+        }
+        if (gs_bench.power != 0)
+        {
+            l3gd20h_interface_debug_print(",\"power_wakes\":%u,\"power_onsets\":%u,\"power_expected\":%u,\"power_pretrigger\":%u,"
+                                          "\"power_active\":%0.4f,\"power_irqs_per_s\":%0.2f,\"power_bytes_per_s\":%0.1f",
+                                          result->power_wakes, result->power_onsets, result->power_expected,
+                                          result->power_pretrigger, result->power_active, result->power_irqs,
+                                          result->power_bytes);
+        }
+        if (gs_bench.watermark != 0)
+        {
+            l3gd20h_interface_debug_print(",\"watermark_min\":%u,\"watermark_max\":%u,\"watermark_retunes\":%u,"
+                                          "\"latency_ms\":%0.3f,\"latency_max_ms\":%0.3f,\"latency_over\":%u,"
+                                          "\"irqs_per_s\":%0.2f",
+                                          result->watermark_min, result->watermark_max, result->watermark_retunes,
+                                          result->watermark_latency, result->watermark_latency_max,
+                                          result->watermark_over, result->watermark_irqs);
+        }
+        if (gs_bench.async != 0)
+        {
+            l3gd20h_interface_debug_print(",\"async_requests\":%u", result->async_requests);
+        }
+        if (gs_bench.settle != 0)
+        {
+            l3gd20h_interface_debug_print(",\"settle_samples\":%u", result->settle_samples);
+        }
+        l3gd20h_interface_debug_print("}\n");
+    }
+    else
+    {
+        l3gd20h_interface_debug_print("%s,%s,%0.1f,%u,%u,%u,%0.3f,%0.3f,%0.1f,%0.1f,%0.1f,%0.1f",
+                                      name, gs_mode_name[mode], rate->odr,
+                                      result->produced, result->delivered, result->lost,
+                                      result->transactions, result->bytes, result->ns, result->cycles,
+                                      result->irq_ns, result->age_us);
+        if (gs_bench.timestamp != 0)
+        {
+            l3gd20h_interface_debug_print(",%0.1f,%0.1f,%0.4f,%0.4f", result->ts_us, result->ts_max_us,
+                                          result->odr, result->odr_bound);
+        }
+        if ((gs_bench.bias != 0) || (gs_bench.drift != 0))
+        {
+            l3gd20h_interface_debug_print(",%0.4f,%u", result->bias, result->bias_windows);
+        }
+        if (gs_bench.reference != 0)
+        {
+            l3gd20h_interface_debug_print(",%d,%0.4f,%u", result->reference, result->reference_error,
+                                          result->reference_runs);
+        }
+        if (gs_bench.attitude != 0)
+        {
+            l3gd20h_interface_debug_print(",%0.5f,%0.5f,%0.5f,%0.1f", result->attitude, result->attitude_fixed,
+                                          result->attitude_bank, result->attitude_ns);
+        }
+        if (gs_bench.filter != 0)
+        {
+            l3gd20h_interface_debug_print(",%0.3f,%0.6f,%0.4f,%0.4f,%0.1f", result->filter_corner, result->filter_error,
+                                          result->filter_in, result->filter_out, result->filter_ns);
+        }
+        if (gs_bench.decimate != 0)
+        {
+            l3gd20h_interface_debug_print(",%u,%u,%0.3f,%0.4f,%0.4f,%0.1f,%0.1f", result->decimate_high,
+                                          result->decimate_low, result->decimate_error, result->decimate_in,
+                                          result->decimate_out, result->decimate_ns, result->decimate_time);
+        }
+        if (gs_bench.spectrum != 0)
+        {
+            l3gd20h_interface_debug_print(",%u,%0.4f,%0.4f,%0.4f,%0.1f", result->spectrum_results, result->spectrum_peak,
+                                          result->spectrum_amplitude, result->spectrum_band, result->spectrum_ns);
+        }
+        if (gs_bench.event != 0)
+        {
+            l3gd20h_interface_debug_print(",%u,%u,%0.1f,%u,%0.1f", result->event_starts, result->event_expected,
+                                          result->event_delay_us, result->event_change_starts, result->event_ns);
+        }
+        if (gs_bench.ig != 0)
+        {
+            l3gd20h_interface_debug_print(",%u,%u,%u,%0.1f", result->ig_edges, result->ig_model_edges,
+                                          result->ig_rises, result->ig_ns);
+        }
+        if (gs_bench.remap != 0)
+        {
+            l3gd20h_interface_debug_print(",%0.6f,%0.6f,%0.1f", result->remap_error, result->rotate_error,
+                                          result->rotate_ns);
+        }
+        if (gs_bench.range != 0)
+        {
+            l3gd20h_interface_debug_print(",%u,%u,%u,%0.6f", result->range_switches, result->range_queued,
+                                          result->range_clipped, result->range_error);
+        }
+        if (gs_bench.power != 0)
+        {
+            l3gd20h_interface_debug_print(",%u,%u,%u,%u,%0.4f,%0.2f,%0.1f", result->power_wakes, result->power_onsets,
+                                          result->power_expected, result->power_pretrigger, result->power_active,
+                                          result->power_irqs, result->power_bytes);
+        }
+        if (gs_bench.watermark != 0)
+        {
+            l3gd20h_interface_debug_print(",%u,%u,%u,%0.3f,%0.3f,%u,%0.2f", result->watermark_min, result->watermark_max,
+                                          result->watermark_retunes, result->watermark_latency,
+                                          result->watermark_latency_max, result->watermark_over, result->watermark_irqs);
+        }
+        if (gs_bench.async != 0)
+        {
+            l3gd20h_interface_debug_print(",%u", result->async_requests);
+        }
+        if (gs_bench.settle != 0)
+        {
+            l3gd20h_interface_debug_print(",%u", result->settle_samples);
+        }
+        l3gd20h_interface_debug_print("\n");
+    }
+}
+
+/**
+ * @brief      replay one bench from the recorded bus trace
+ * @param[in]  interface chip interface
+ * @param[in]  *rate pointer to a rate
+ * @param[in]  mode bench mode
+ * @param[out] *result pointer to a result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the init and the reads issue the recorded transactions again, the reads run back to back
+ *             until the trace reaches the deinit of the recorded run
+ */
+static uint8_t a_bench_replay_run(l3gd20h_interface_t interface, const bench_rate_t *rate, bench_mode_t mode,
+                                  bench_result_t *result)
+{
+    uint64_t start_us;
+    double n;
+
+    start_us = l3gd20h_replay_timestamp_us();
+    if (a_bench_init(interface, rate, mode) != 0)
+    {
+        return 1;
+    }
+    gs_bench.period_us = rate->period_us;
+    gs_bench.delivered = 0;
+    gs_bench.ns = 0;
+    gs_bench.cycles = 0;
+    gs_bench.error = 0;
+    while (gs_bench.error == 0)
+    {
+        a_bench_read(0);
+    }
+    if ((a_bench_counters() != 0) || (l3gd20h_deinit(&gs_bench.handle) != 0))
+    {
+        return 1;
+    }
+
+    /* per sample figures */
+    n = (gs_bench.delivered != 0) ? (double)gs_bench.delivered : 1.0;
+    memset(result, 0, sizeof(bench_result_t));
+    result->produced = gs_bench.delivered;
+    result->delivered = gs_bench.delivered;
+    result->ns = (double)gs_bench.ns / n;
+    result->cycles = (double)gs_bench.cycles / n;
+    result->recorded_s = (double)(l3gd20h_replay_timestamp_us() - start_us) / 1000000.0;
+
+    return 0;
+}
+
+/**
+ * @brief  close the trace file and the record or replay backend
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   none
+ */
+static uint8_t a_bench_close(void)
+{
+    uint8_t res = 0;
+
+    if (gs_bench.trace != NULL)
+    {
+        res |= l3gd20h_trace_json_end(gs_bench.trace, gs_bench.trace_lost);
+        res |= (fclose(gs_bench.trace) != 0) ? 1 : 0;
+        gs_bench.trace = NULL;
+    }
+    if (gs_bench.backend == BENCH_BACKEND_RECORD)
+    {
+        res |= l3gd20h_record_deinit();
+    }
+    else if (gs_bench.backend == BENCH_BACKEND_REPLAY)
+    {
+        res |= l3gd20h_replay_deinit();
+    }
+    else
+    {
+        /* nothing to close */
+    }
+    gs_bench.backend = BENCH_BACKEND_SIM;
+
+    return res;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"samples", required_argument, NULL, 1},
+        {"interface", required_argument, NULL, 2},
+        {"mode", required_argument, NULL, 3},
+        {"format", required_argument, NULL, 4},
+        {"record", required_argument, NULL, 5},
+        {"replay", required_argument, NULL, 6},
+        {"counters", required_argument, NULL, 7},
+        {"trace", required_argument, NULL, 8},
+        {"timestamp", no_argument, NULL, 9},
+        {"odr-error", required_argument, NULL, 10},
+        {"bias", required_argument, NULL, 11},
+        {"temp-drift", required_argument, NULL, 12},
+        {"reference", no_argument, NULL, 13},
+        {"attitude", no_argument, NULL, 14},
+        {"filter", required_argument, NULL, 15},
+        {"decimate", required_argument, NULL, 16},
+        {"spectrum", no_argument, NULL, 17},
+        {"event", no_argument, NULL, 18},
+        {"ig", no_argument, NULL, 19},
+        {"remap", no_argument, NULL, 20},
+        {"range", no_argument, NULL, 21},
+        {"power", no_argument, NULL, 22},
+        {"watermark", required_argument, NULL, 23},
+        {"async", no_argument, NULL, 24},
+        {"settle", required_argument, NULL, 25},
+        {NULL, 0, NULL, 0},
+    };
+    const char *record = NULL;
+    const char *replay = NULL;
+    const char *trace = NULL;
+    uint32_t samples = 1024;
+    uint8_t interface_mask = 0x03;
+    uint8_t mode_mask = 0x0F;
+    uint8_t json = 0;
+    uint8_t res;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+
+    /* parse */
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                l3gd20h_interface_debug_print("Usage:\n");
+                l3gd20h_interface_debug_print("  l3gd20h_bench [--samples=<num>] [--interface=<iic | spi | all>] "
+                                              "[--mode=<bypass | drdy | fifo | stream | all>] [--format=<csv | json>] "
+                                              "[--record=<file>] [--counters=<file | unix:socket>] [--trace=<file> | --timestamp] ");
+                l3gd20h_interface_debug_print("[--odr-error=<ppm>] [--bias=<dps>] [--temp-drift=<dps>] [--reference] [--attitude] "
+                                              "[--filter=<hz>] [--decimate=<factor>] [--spectrum] [--event] [--ig] [--remap] [--range] [--power] ");
+                l3gd20h_interface_debug_print("[--watermark=<ms>] [--async] [--settle=<drop | tag>]\n");
+                l3gd20h_interface_debug_print("  l3gd20h_bench --replay=<file> [--interface=<iic | spi | all>] "
+                                              "[--mode=<bypass | drdy | fifo | stream | all>] [--format=<csv | json>]\n");
+
+                return 0;
+            }
+            case 1 :
+            {
+                samples = (uint32_t)atol(optarg);
+                if (samples == 0)
+                {
+                    return 5;
+                }
+
+                break;
+            }
+            case 2 :
+            {
+                if (strcmp("iic", optarg) == 0)
+                {
+                    interface_mask = 0x01;
+                }
+                else if (strcmp("spi", optarg) == 0)
+                {
+                    interface_mask = 0x02;
+                }
+                else if (strcmp("all", optarg) == 0)
+                {
+                    interface_mask = 0x03;
+                }
+                else
+                {
+                    return 5;
+                }
+
+                break;
+            }
+            case 3 :
+            {
+                mode_mask = 0;
+                for (k = 0; k < BENCH_MODE_MAX; k++)
+                {
+                    if (strcmp(gs_mode_name[k], optarg) == 0)
+                    {
+                        mode_mask = (uint8_t)(1 << k);
+                    }
+                }
+                if (strcmp("all", optarg) == 0)
+                {
+                    mode_mask = 0x0F;
+                }
+                if (mode_mask == 0)
+                {
+                    return 5;
+                }
+
+                break;
+            }
+            case 4 :
+            {
+                if (strcmp("json", optarg) == 0)
+                {
+                    json = 1;
+                }
+                else if (strcmp("csv", optarg) == 0)
+                {
+                    json = 0;
+                }
+                else
+                {
+                    return 5;
+                }
+
+                break;
+            }
+            case 5 :
+            {
+                record = optarg;
+
+                break;
+            }
+            case 6 :
+            {
+                replay = optarg;
+
+                break;
+            }
+            case 7 :
+            {
+                gs_bench.counters = optarg;
+
+                break;
+            }
+            case 8 :
+            {
+                trace = optarg;
+
+                break;
+            }
+            case 9 :
+            {
+                gs_bench.timestamp = 1;
+
+                break;
+            }
+            case 10 :
+            {
+                sim_set_odr_error((int32_t)atol(optarg));
+
+                break;
+            }
+            case 11 :
+            {
+                float dps = (float)atof(optarg);
+
+                /* a different level per axis, the bias source moves every axis */
+                gs_bench.bias = 1;
+                gs_bench.zero_rate[0] = dps;
+                gs_bench.zero_rate[1] = -dps;
+                gs_bench.zero_rate[2] = dps / 2.0f;
+                sim_set_zero_rate(gs_bench.zero_rate);
+                sim_set_noise(0.1f);
+                sim_set_source(a_bench_bias_source);
+
+                break;
+            }
+            case 12 :
+            {
+                float dps = (float)atof(optarg);
+
+                /* dps per degree, the temperature follows a slow triangle */
+                gs_bench.drift = 1;
+                gs_bench.zero_rate_drift[0] = dps;
+                gs_bench.zero_rate_drift[1] = -dps;
+                gs_bench.zero_rate_drift[2] = dps / 2.0f;
+                sim_set_zero_rate_drift(gs_bench.zero_rate_drift);
+
+                break;
+            }
+            case 13 :
+            {
+                gs_bench.reference = 1;
+
+                break;
+            }
+            case 14 :
+            {
+                /* the integration needs the sample times */
+                gs_bench.attitude = 1;
+                gs_bench.timestamp = 1;
+                sim_set_source(a_bench_attitude_source);
+
+                break;
+            }
+            case 15 :
+            {
+                /* the design follows the estimated rate */
+                gs_bench.filter = 1;
+                gs_bench.filter_corner = (float)atof(optarg);
+                gs_bench.timestamp = 1;
+                if (!(gs_bench.filter_corner > 0.0f))
+                {
+                    return 5;
+                }
+                sim_set_noise(1.0f);
+                sim_set_source(a_bench_still_source);
+
+                break;
+            }
+            case 16 :
+            {
+                long factor = atol(optarg);
+
+                /* the noise of a still device shows the bandwidth cut */
+                if ((factor < 2) || (factor > L3GD20H_DECIMATE_FACTOR_MAX))
+                {
+                    return 5;
+                }
+                gs_bench.decimate = (uint8_t)factor;
+                sim_set_noise(1.0f);
+                sim_set_source(a_bench_still_source);
+
+                break;
+            }
+            case 17 :
+            {
+                gs_bench.spectrum = 1;
+                sim_set_source(a_bench_spectrum_source);
+
+                break;
+            }
+            case 18 :
+            {
+                /* the moving seconds of the bias profile without a level or noise */
+                gs_bench.event = 1;
+                gs_bench.timestamp = 1;
+                sim_set_source(a_bench_bias_source);
+
+                break;
+            }
+            case 19 :
+            {
+                /* the moving seconds of the bias profile with noise around the threshold */
+                gs_bench.ig = 1;
+                sim_set_noise(1.0f);
+                sim_set_source(a_bench_bias_source);
+
+                break;
+            }
+            case 20 :
+            {
+                double c[2];
+                double sn[2];
+                float m[3][3];
+                uint8_t j;
+                uint8_t n;
+
+                /* the constant rate source seen through a remap and a general mount */
+                for (j = 0; j < 2; j++)
+                {
+                    c[j] = cos(gs_mount_deg[j] * M_PI / 180.0);
+                    sn[j] = sin(gs_mount_deg[j] * M_PI / 180.0);
+                }
+                gs_bench.mount[0][0] = c[0];
+                gs_bench.mount[0][1] = -sn[0];
+                gs_bench.mount[0][2] = 0.0;
+                gs_bench.mount[1][0] = c[1] * sn[0];
+                gs_bench.mount[1][1] = c[1] * c[0];
+                gs_bench.mount[1][2] = -sn[1];
+                gs_bench.mount[2][0] = sn[1] * sn[0];
+                gs_bench.mount[2][1] = sn[1] * c[0];
+                gs_bench.mount[2][2] = c[1];
+                for (j = 0; j < 3; j++)
+                {
+                    for (n = 0; n < 3; n++)
+                    {
+                        m[j][n] = (float)gs_bench.mount[j][n];
+                    }
+                }
+                if ((l3gd20h_rotate_init(&gs_bench.rot_remap, gs_remap_matrix) != 0) ||
+                    (l3gd20h_rotate_init(&gs_bench.rot_mount, (const float (*)[3])m) != 0))
+                {
+                    return 1;
+                }
+                gs_bench.remap = 1;
+                sim_set_source(a_bench_attitude_source);
+
+                break;
+            }
+            case 21 :
+            {
+                /* rest, impact, swing and turn levels that need every full scale */
+                gs_bench.range = 1;
+                sim_set_source(a_bench_range_source);
+
+                break;
+            }
+            case 22 :
+            {
+                /* short motions between long rests */
+                gs_bench.power = 1;
+                sim_set_source(a_bench_power_source);
+
+                break;
+            }
+            case 23 :
+            {
+                /* the latency target of the oldest sample of a batch */
+                gs_bench.watermark = 1;
+                gs_bench.watermark_ms = (float)atof(optarg);
+                if (!(gs_bench.watermark_ms > 0.0f))
+                {
+                    return 5;
+                }
+
+                break;
+            }
+            case 24 :
+            {
+                /* every read goes through the async queue of the simulated dma */
+                gs_bench.async = 1;
+
+                break;
+            }
+            case 25 :
+            {
+                /* check the windows of every reconfiguration before the run */
+                if (strcmp("drop", optarg) == 0)
+                {
+                    gs_bench.settle = L3GD20H_SETTLE_DROP;
+                }
+                else if (strcmp("tag", optarg) == 0)
+                {
+                    gs_bench.settle = L3GD20H_SETTLE_TAG;
+                }
+                else
+                {
+                    return 5;
+                }
+
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+
+    /* the sample times need the virtual clock, the counters and the trace the host clock */
+    if ((gs_bench.timestamp != 0) && ((replay != NULL) || (gs_bench.counters != NULL) || (trace != NULL)))
+    {
+        return 5;
+    }
+
+    /* the zero rate level lives in the simulated device */
+    if (((gs_bench.bias != 0) || (gs_bench.drift != 0)) && (replay != NULL))
+    {
+        return 5;
+    }
+
+    /* the reference calibration removes the level set by the bias option */
+    if ((gs_bench.reference != 0) && (gs_bench.bias == 0))
+    {
+        return 5;
+    }
+
+    /* the attitude truth needs the constant rate source and the filter the still one */
+    if (((gs_bench.attitude != 0) || (gs_bench.filter != 0)) && ((gs_bench.bias != 0) || (gs_bench.drift != 0)))
+    {
+        return 5;
+    }
+    if ((gs_bench.decimate != 0) && ((gs_bench.bias != 0) || (gs_bench.drift != 0) || (gs_bench.attitude != 0)))
+    {
+        return 5;
+    }
+    if ((gs_bench.attitude != 0) && (gs_bench.filter != 0))
+    {
+        return 5;
+    }
+
+    /* one source per run */
+    if ((gs_bench.spectrum != 0) && ((gs_bench.bias != 0) || (gs_bench.drift != 0) || (gs_bench.attitude != 0) ||
+                                     (gs_bench.filter != 0) || (gs_bench.decimate != 0)))
+    {
+        return 5;
+    }
+    if ((gs_bench.event != 0) && ((gs_bench.bias != 0) || (gs_bench.drift != 0) || (gs_bench.attitude != 0) ||
+                                  (gs_bench.filter != 0) || (gs_bench.decimate != 0) || (gs_bench.spectrum != 0)))
+    {
+        return 5;
+    }
+    if ((gs_bench.ig != 0) && ((gs_bench.bias != 0) || (gs_bench.drift != 0) || (gs_bench.attitude != 0) ||
+                               (gs_bench.filter != 0) || (gs_bench.decimate != 0) || (gs_bench.spectrum != 0) ||
+                               (gs_bench.event != 0) || (replay != NULL)))
+    {
+        return 5;
+    }
+    if ((gs_bench.remap != 0) && ((gs_bench.bias != 0) || (gs_bench.drift != 0) || (gs_bench.attitude != 0) ||
+                                  (gs_bench.filter != 0) || (gs_bench.decimate != 0) || (gs_bench.spectrum != 0) ||
+                                  (gs_bench.event != 0) || (gs_bench.ig != 0) || (replay != NULL)))
+    {
+        return 5;
+    }
+
+    /* the split reads do not anchor the interrupt timestamps */
+    if ((gs_bench.range != 0) && ((gs_bench.bias != 0) || (gs_bench.drift != 0) || (gs_bench.attitude != 0) ||
+                                  (gs_bench.filter != 0) || (gs_bench.decimate != 0) || (gs_bench.spectrum != 0) ||
+                                  (gs_bench.event != 0) || (gs_bench.ig != 0) || (gs_bench.remap != 0) ||
+                                  (gs_bench.timestamp != 0) || (replay != NULL)))
+    {
+        return 5;
+    }
+
+    /* the controller owns the fifo and both interrupt pins and picks the rate itself */
+    if ((gs_bench.power != 0) && ((gs_bench.bias != 0) || (gs_bench.drift != 0) || (gs_bench.attitude != 0) ||
+                                  (gs_bench.filter != 0) || (gs_bench.decimate != 0) || (gs_bench.spectrum != 0) ||
+                                  (gs_bench.event != 0) || (gs_bench.ig != 0) || (gs_bench.remap != 0) ||
+                                  (gs_bench.range != 0) || (gs_bench.timestamp != 0) || (replay != NULL) ||
+                                  (mode_mask != (1 << BENCH_MODE_FIFO))))
+    {
+        return 5;
+    }
+
+    /* the host load runs on the virtual clock of the threshold interrupts */
+    if ((gs_bench.watermark != 0) && ((gs_bench.power != 0) || (gs_bench.range != 0) || (gs_bench.timestamp != 0) ||
+                                      (replay != NULL) || (mode_mask != (1 << BENCH_MODE_FIFO))))
+    {
+        return 5;
+    }
+
+    /* the async transfers bypass the recorder and do not stamp the samples or split the reads */
+    if ((gs_bench.async != 0) && ((gs_bench.timestamp != 0) || (gs_bench.range != 0) || (gs_bench.power != 0) ||
+                                  (gs_bench.watermark != 0) || (replay != NULL) || (record != NULL)))
+    {
+        return 5;
+    }
+
+    /* the check polls the bypass registers or drains the stream fifo of the simulated device through the sync bus */
+    if ((gs_bench.settle != 0) && ((gs_bench.async != 0) || (replay != NULL) || (record != NULL) ||
+                                   ((mode_mask & ~((1 << BENCH_MODE_BYPASS) | (1 << BENCH_MODE_STREAM))) != 0)))
+    {
+        return 5;
+    }
+
+    /* write the driver trace of every run as one chrome trace */
+    if (trace != NULL)
+    {
+        gs_bench.trace = fopen(trace, "w");
+        if ((gs_bench.trace == NULL) || (l3gd20h_trace_json_begin(gs_bench.trace) != 0))
+        {
+            l3gd20h_interface_debug_print("l3gd20h: open %s failed.\n", trace);
+
+            return 1;
+        }
+    }
+
+    /* replay a recorded trace with the options of the recorded run */
+    if (replay != NULL)
+    {
+        if (l3gd20h_replay_init(replay, L3GD20H_REPLAY_MODE_STRICT) != 0)
+        {
+            l3gd20h_interface_debug_print("l3gd20h: open %s failed.\n", replay);
+            (void)a_bench_close();
+
+            return 1;
+        }
+        gs_bench.backend = BENCH_BACKEND_REPLAY;
+    }
+
+    /* record the bus traffic of the whole run */
+    else if (record != NULL)
+    {
+        l3gd20h_record_bus_t bus;
+
+        bus.iic_read = l3gd20h_interface_iic_read;
+        bus.iic_write = l3gd20h_interface_iic_write;
+        bus.spi_read = l3gd20h_interface_spi_read;
+        bus.spi_write = l3gd20h_interface_spi_write;
+        bus.timestamp_us = sim_get_time_us;
+        if (l3gd20h_record_init(record, &bus) != 0)
+        {
+            l3gd20h_interface_debug_print("l3gd20h: open %s failed.\n", record);
+            (void)a_bench_close();
+
+            return 1;
+        }
+        gs_bench.backend = BENCH_BACKEND_RECORD;
+    }
+
+    /* run every interface, mode and rate */
+    if ((json == 0) && (gs_bench.backend == BENCH_BACKEND_REPLAY))
+    {
+        l3gd20h_interface_debug_print("interface,mode,odr_hz,delivered,recorded_s,ns_per_sample,cycles_per_sample\n");
+    }
+    else if (json == 0)
+    {
+        /* one print per column group, the debug print holds 255 characters */
+        l3gd20h_interface_debug_print("interface,mode,odr_hz,produced,delivered,lost,transactions_per_sample,"
+                                      "bytes_per_sample,ns_per_sample,cycles_per_sample,irq_to_data_ns,sample_age_us%s%s%s",
+                                      (gs_bench.timestamp != 0) ? ",timestamp_error_us,timestamp_max_us,odr_estimate_hz,odr_bound_hz" : "",
+                                      ((gs_bench.bias != 0) || (gs_bench.drift != 0)) ? ",bias_error_dps,bias_windows" : "",
+                                      (gs_bench.reference != 0) ? ",reference,reference_error_dps,reference_runs" : "");
+        l3gd20h_interface_debug_print("%s%s", (gs_bench.attitude != 0) ? ",attitude_error_deg,attitude_fixed_error_deg,"
+                                      "attitude_bank_error_deg,attitude_ns_per_sample" : "",
+                                      (gs_bench.filter != 0) ? ",filter_corner_hz,filter_error_dps,filter_in_dps,"
+                                      "filter_out_dps,filter_ns_per_sample" : "");
+        l3gd20h_interface_debug_print("%s%s", (gs_bench.decimate != 0) ? ",decimate_high,decimate_low,decimate_error_lsb,"
+                                      "decimate_in_dps,decimate_out_dps,decimate_ns_per_sample,decimate_time_error_us" : "",
+                                      (gs_bench.spectrum != 0) ? ",spectrum_results,spectrum_peak_error_hz,"
+                                      "spectrum_amplitude_error_dps,spectrum_band_error,spectrum_ns_per_sample" : "");
+        l3gd20h_interface_debug_print("%s%s", (gs_bench.event != 0) ? ",event_starts,event_expected,event_delay_us,"
+                                      "event_change_starts,event_ns_per_sample" : "",
+                                      (gs_bench.ig != 0) ? ",ig_edges,ig_model_edges,ig_rises,ig_ns_per_sample" : "");
+        l3gd20h_interface_debug_print("%s%s", (gs_bench.remap != 0) ? ",remap_error_dps,rotate_error_dps,"
+                                      "rotate_ns_per_sample" : "",
+                                      (gs_bench.range != 0) ? ",range_switches,range_queued,range_clipped,range_error_dps" : "");
+        l3gd20h_interface_debug_print("%s%s%s%s\n", (gs_bench.power != 0) ? ",power_wakes,power_onsets,power_expected,"
+                                      "power_pretrigger,power_active,power_irqs_per_s,power_bytes_per_s" : "",
+                                      (gs_bench.watermark != 0) ? ",watermark_min,watermark_max,watermark_retunes,"
+                                      "latency_ms,latency_max_ms,latency_over,irqs_per_s" : "",
+                                      (gs_bench.async != 0) ? ",async_requests" : "",
+                                      (gs_bench.settle != 0) ? ",settle_samples" : "");
+    }
+    for (i = 0; i < 2; i++)
+    {
+        l3gd20h_interface_t interface = (i == 0) ? L3GD20H_INTERFACE_IIC : L3GD20H_INTERFACE_SPI;
+
+        if ((interface_mask & (1 << i)) == 0)
+        {
+            continue;
+        }
+        for (k = 0; k < BENCH_MODE_MAX; k++)
+        {
+            if ((mode_mask & (1 << k)) == 0)
+            {
+                continue;
+            }
+            for (j = 0; j < sizeof(gs_rate) / sizeof(gs_rate[0]); j++)
+            {
+                bench_result_t result;
+
+                if (gs_bench.backend == BENCH_BACKEND_REPLAY)
+                {
+                    res = a_bench_replay_run(interface, &gs_rate[j], (bench_mode_t)k, &result);
+                }
+                else
+                {
+                    res = a_bench_run(interface, &gs_rate[j], (bench_mode_t)k, samples, &result);
+                }
+                if (res != 0)
+                {
+                    l3gd20h_interface_debug_print("l3gd20h: bench %s failed.\n", gs_mode_name[k]);
+                    (void)a_bench_close();
+
+                    return 1;
+                }
+                a_bench_print(json, interface, &gs_rate[j], (bench_mode_t)k, &result);
+            }
+        }
+    }
+    if (gs_bench.backend == BENCH_BACKEND_REPLAY)
+    {
+        if (l3gd20h_replay_finished() == 0)
+        {
+            l3gd20h_interface_debug_print("l3gd20h: replay does not match the recorded options.\n");
+            (void)a_bench_close();
+
+            return 1;
+        }
+    }
+    if (a_bench_close() != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
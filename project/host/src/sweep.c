@@ -0,0 +1,701 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      sweep.c
+ * @brief     sweep source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_l3gd20h_ig.h"
+#include <getopt.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief sweep definition
+ * @note  the grid crosses every threshold, duration, counter mode, wait, combination and data path, a
+ *        rise up to SWEEP_TOLERANCE_S after a labelled segment still counts for that segment
+ */
+#define SWEEP_THREADS        64          /**< most worker threads */
+#define SWEEP_CHUNK          4096        /**< samples per model call */
+#define SWEEP_TOLERANCE_S    0.25        /**< late rise tolerance in s */
+#define SWEEP_DPS            0.00875     /**< 245dps sensitivity in dps per lsb */
+
+/**
+ * @brief sweep grid tables
+ */
+static const double gs_sweep_threshold_dps[] = {5.0, 10.0, 15.0, 20.0, 25.0, 30.0, 40.0, 50.0};
+static const uint8_t gs_sweep_duration[] = {0, 1, 2, 4, 8, 16};
+static const l3gd20h_counter_mode_t gs_sweep_counter[] = {L3GD20H_COUNTER_MODE_RESET, L3GD20H_COUNTER_MODE_DECREMENT};
+static const l3gd20h_bool_t gs_sweep_bool[] = {L3GD20H_BOOL_FALSE, L3GD20H_BOOL_TRUE};
+static const int8_t gs_sweep_path[] = {-1, 4, 7};
+
+/**
+ * @brief sweep grid size definition
+ */
+#define SWEEP_N(a) (sizeof(a) / sizeof((a)[0]))
+
+/**
+ * @brief sweep result structure definition
+ */
+typedef struct sweep_result_s
+{
+    l3gd20h_ig_config_t config;        /**< interrupt generator config */
+    uint32_t hits;                     /**< labelled segments with a rise */
+    uint32_t false_positives;          /**< rises outside the labelled segments */
+    double latency_ms;                 /**< mean time from a segment start to its first rise */
+} sweep_result_t;
+
+/**
+ * @brief sweep structure definition
+ */
+typedef struct sweep_s
+{
+    int16_t (*raw)[3];                 /**< sample stream */
+    int32_t *segment;                  /**< labelled segment covering every sample, -1 for none */
+    uint32_t *start;                   /**< first sample of every segment */
+    uint32_t samples;                  /**< stream length */
+    uint32_t segments;                 /**< labelled segments */
+    float odr;                         /**< output data rate in hz */
+    sweep_result_t *result;            /**< one result per config */
+    uint32_t configs;                  /**< grid size */
+    uint32_t threads;                  /**< worker threads */
+} sweep_t;
+
+/**
+ * @brief sweep worker structure definition
+ */
+typedef struct sweep_worker_s
+{
+    sweep_t *sweep;                    /**< shared sweep */
+    uint32_t index;                    /**< worker index */
+    uint8_t error;                     /**< error flag */
+} sweep_worker_t;
+
+static sweep_t gs_sweep;               /**< sweep */
+
+/**
+ * @brief     get a uniform random number
+ * @param[in] *state pointer to a generator state
+ * @return    number in [-1, 1)
+ * @note      xorshift32, so every run draws the same stream
+ */
+static double a_sweep_random(uint32_t *state)
+{
+    uint32_t x;
+
+    x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return (double)x / 2147483648.0 - 1.0;
+}
+
+/**
+ * @brief      add a sample to the stream
+ * @param[in]  *dps pointer to an angular rate buffer
+ * @param[in]  truth label of the sample
+ * @param[in]  n sample index
+ * @param[out] *truth_buf pointer to a label buffer
+ * @note       none
+ */
+static void a_sweep_store(const double dps[3], uint8_t truth, uint32_t n, uint8_t *truth_buf)
+{
+    uint8_t i;
+
+    for (i = 0; i < 3; i++)
+    {
+        double v = round(dps[i] / SWEEP_DPS);
+
+        v = (v > 32767.0) ? 32767.0 : ((v < -32768.0) ? -32768.0 : v);
+        gs_sweep.raw[n][i] = (int16_t)v;
+    }
+    truth_buf[n] = truth;
+}
+
+/**
+ * @brief      synthesise a labelled stream
+ * @param[in]  seconds stream length in s
+ * @param[out] **truth pointer to a label buffer pointer
+ * @return     status code
+ *             - 0 success
+ *             - 1 out of memory
+ * @note       half sine motions of 15dps to 60dps on a random axis are labelled, single sample shocks,
+ *             2dps of noise and an 8dps bias wander are not
+ */
+static uint8_t a_sweep_synthesise(double seconds, uint8_t **truth)
+{
+    uint32_t state = 0x2545F491U;
+    uint32_t next_motion;
+    uint32_t next_shock;
+    uint32_t n;
+
+    gs_sweep.samples = (uint32_t)(seconds * (double)gs_sweep.odr);
+    gs_sweep.raw = malloc(sizeof(int16_t) * 3 * gs_sweep.samples);
+    *truth = malloc(gs_sweep.samples);
+    if ((gs_sweep.raw == NULL) || (*truth == NULL))
+    {
+        return 1;
+    }
+
+    next_motion = (uint32_t)(1.0 * gs_sweep.odr);
+    next_shock = (uint32_t)(2.5 * gs_sweep.odr);
+    for (n = 0; n < gs_sweep.samples; )
+    {
+        double t = (double)n / (double)gs_sweep.odr;
+        double dps[3];
+        uint8_t i;
+
+        for (i = 0; i < 3; i++)
+        {
+            dps[i] = 8.0 * sin(2.0 * M_PI * (t / 40.0 + (double)i / 3.0)) + 2.0 * sqrt(3.0) * a_sweep_random(&state);
+        }
+        if (n == next_motion)
+        {
+            uint32_t len = (uint32_t)((0.75 + 0.45 * a_sweep_random(&state)) * gs_sweep.odr);
+            double amp = 37.5 + 22.5 * a_sweep_random(&state);
+            uint8_t axis = (uint8_t)((a_sweep_random(&state) + 1.0) * 1.5);
+            uint32_t k;
+
+            /* one labelled motion */
+            len = (len < 2) ? 2 : len;
+            for (k = 0; (k < len) && (n < gs_sweep.samples); k++, n++)
+            {
+                t = (double)n / (double)gs_sweep.odr;
+                for (i = 0; i < 3; i++)
+                {
+                    dps[i] = 8.0 * sin(2.0 * M_PI * (t / 40.0 + (double)i / 3.0)) + 2.0 * sqrt(3.0) * a_sweep_random(&state);
+                }
+                dps[axis] += amp * sin(M_PI * (double)(k + 1) / (double)(len + 1));
+                a_sweep_store(dps, 1, n, *truth);
+            }
+            next_motion = n + (uint32_t)((3.0 + 1.5 * a_sweep_random(&state)) * gs_sweep.odr);
+            next_shock = (next_shock < n) ? n + (uint32_t)(0.5 * gs_sweep.odr) : next_shock;
+
+            continue;
+        }
+        if (n == next_shock)
+        {
+            /* one unlabelled shock */
+            dps[(n / 7) % 3] += 60.0 + 20.0 * a_sweep_random(&state);
+            next_shock = n + (uint32_t)((3.0 + 1.0 * a_sweep_random(&state)) * gs_sweep.odr);
+        }
+        a_sweep_store(dps, 0, n, *truth);
+        n++;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      load a labelled stream
+ * @param[in]  *path pointer to a file path
+ * @param[out] **truth pointer to a label buffer pointer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ * @note       one sample per line as x,y,z or x,y,z,label in lsb, lines starting with # are skipped
+ */
+static uint8_t a_sweep_load(const char *path, uint8_t **truth)
+{
+    FILE *f;
+    char line[128];
+    uint32_t cap = 0;
+
+    f = fopen(path, "r");
+    if (f == NULL)
+    {
+        return 1;
+    }
+    gs_sweep.samples = 0;
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        int x;
+        int y;
+        int z;
+        int label = 0;
+        int fields;
+
+        if (line[0] == '#')
+        {
+            continue;
+        }
+        fields = sscanf(line, "%d,%d,%d,%d", &x, &y, &z, &label);
+        if (fields < 3)
+        {
+            continue;
+        }
+        if (gs_sweep.samples == cap)
+        {
+            int16_t (*raw)[3];
+            uint8_t *t;
+
+            cap = (cap == 0) ? 4096 : cap * 2;
+            raw = realloc(gs_sweep.raw, sizeof(int16_t) * 3 * cap);
+            t = realloc(*truth, cap);
+            if (raw != NULL)
+            {
+                gs_sweep.raw = raw;
+            }
+            if (t != NULL)
+            {
+                *truth = t;
+            }
+            if ((raw == NULL) || (t == NULL))
+            {
+                (void)fclose(f);
+
+                return 1;
+            }
+        }
+        gs_sweep.raw[gs_sweep.samples][0] = (int16_t)x;
+        gs_sweep.raw[gs_sweep.samples][1] = (int16_t)y;
+        gs_sweep.raw[gs_sweep.samples][2] = (int16_t)z;
+        (*truth)[gs_sweep.samples] = (label != 0) ? 1 : 0;
+        gs_sweep.samples++;
+    }
+    (void)fclose(f);
+
+    return (gs_sweep.samples != 0) ? 0 : 1;
+}
+
+/**
+ * @brief     cover every sample with its labelled segment
+ * @param[in] *truth pointer to a label buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 out of memory
+ * @note      a segment covers its labelled run and the tolerance after it
+ */
+static uint8_t a_sweep_segment(const uint8_t *truth)
+{
+    uint32_t tol;
+    uint32_t n;
+    uint32_t k;
+
+    gs_sweep.segment = malloc(sizeof(int32_t) * gs_sweep.samples);
+    gs_sweep.start = malloc(sizeof(uint32_t) * (gs_sweep.samples / 2 + 1));
+    if ((gs_sweep.segment == NULL) || (gs_sweep.start == NULL))
+    {
+        return 1;
+    }
+    tol = (uint32_t)(SWEEP_TOLERANCE_S * (double)gs_sweep.odr);
+    gs_sweep.segments = 0;
+    for (n = 0; n < gs_sweep.samples; n++)
+    {
+        gs_sweep.segment[n] = -1;
+    }
+    for (n = 0; n < gs_sweep.samples; n++)
+    {
+        if ((truth[n] == 0) || ((n != 0) && (truth[n - 1] != 0)))
+        {
+            continue;
+        }
+        gs_sweep.start[gs_sweep.segments] = n;
+        for (k = n; (k < gs_sweep.samples) && (truth[k] != 0); k++)
+        {
+            gs_sweep.segment[k] = (int32_t)gs_sweep.segments;
+        }
+        for (; (k < gs_sweep.samples) && (k < n + tol) && (truth[k] == 0); k++)
+        {
+            gs_sweep.segment[k] = (int32_t)gs_sweep.segments;
+        }
+        gs_sweep.segments++;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      build the config of a grid index
+ * @param[in]  index grid index
+ * @param[out] *config pointer to a config structure
+ * @note       the high events of every axis are enabled
+ */
+static void a_sweep_config(uint32_t index, l3gd20h_ig_config_t *config)
+{
+    uint16_t ths;
+    int8_t path;
+
+    ths = (uint16_t)(gs_sweep_threshold_dps[index % SWEEP_N(gs_sweep_threshold_dps)] / SWEEP_DPS + 0.5);
+    index /= SWEEP_N(gs_sweep_threshold_dps);
+    config->threshold[0] = ths;
+    config->threshold[1] = ths;
+    config->threshold[2] = ths;
+    config->event = (1 << L3GD20H_INTERRUPT_EVENT_X_HIGH_EVENT) | (1 << L3GD20H_INTERRUPT_EVENT_Y_HIGH_EVENT) |
+                    (1 << L3GD20H_INTERRUPT_EVENT_Z_HIGH_EVENT);
+    config->latch = L3GD20H_BOOL_FALSE;
+    config->duration = gs_sweep_duration[index % SWEEP_N(gs_sweep_duration)];
+    index /= SWEEP_N(gs_sweep_duration);
+    config->counter_mode = gs_sweep_counter[index % SWEEP_N(gs_sweep_counter)];
+    index /= SWEEP_N(gs_sweep_counter);
+    config->wait = gs_sweep_bool[index % SWEEP_N(gs_sweep_bool)];
+    index /= SWEEP_N(gs_sweep_bool);
+    config->and_or = gs_sweep_bool[index % SWEEP_N(gs_sweep_bool)];
+    index /= SWEEP_N(gs_sweep_bool);
+    path = gs_sweep_path[index % SWEEP_N(gs_sweep_path)];
+    config->selection = (path < 0) ? L3GD20H_SELECTION_LPF1 : L3GD20H_SELECTION_LPF1_HPF;
+    config->mode = L3GD20H_HIGH_PASS_FILTER_MODE_NORMAL;
+    config->cut_off = (path < 0) ? L3GD20H_HIGH_PASS_FILTER_CUT_OFF_FREQUENCY_0 :
+                      (l3gd20h_high_pass_filter_cut_off_frequency_t)path;
+}
+
+/**
+ * @brief     run one config over the stream
+ * @param[in] *result pointer to a result structure with the config set
+ * @param[in] *hit pointer to a segment hit buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_sweep_score(sweep_result_t *result, uint8_t *hit)
+{
+    l3gd20h_ig_t ig;
+    uint8_t int1[SWEEP_CHUNK];
+    uint8_t level = 0;
+    double latency = 0.0;
+    uint32_t n;
+    uint32_t k;
+
+    if (l3gd20h_ig_init(&ig, &result->config, gs_sweep.odr) != 0)
+    {
+        return 1;
+    }
+    memset(hit, 0, gs_sweep.segments);
+    result->hits = 0;
+    result->false_positives = 0;
+    for (n = 0; n < gs_sweep.samples; n += SWEEP_CHUNK)
+    {
+        uint32_t len = ((gs_sweep.samples - n) > SWEEP_CHUNK) ? SWEEP_CHUNK : (gs_sweep.samples - n);
+
+        (void)l3gd20h_ig_feed(&ig, (const int16_t (*)[3])&gs_sweep.raw[n], (uint16_t)len, int1);
+        for (k = 0; k < len; k++)
+        {
+            int32_t s;
+
+            if ((int1[k] == 0) || (level != 0))
+            {
+                level = int1[k];
+
+                continue;
+            }
+            level = 1;
+
+            /* a rise belongs to the segment around it */
+            s = gs_sweep.segment[n + k];
+            if (s < 0)
+            {
+                result->false_positives++;
+            }
+            else if (hit[s] == 0)
+            {
+                hit[s] = 1;
+                result->hits++;
+                latency += (double)(n + k - gs_sweep.start[s]) * 1000.0 / (double)gs_sweep.odr;
+            }
+            else
+            {
+                /* a second rise in a hit segment is neither */
+            }
+        }
+    }
+    result->latency_ms = (result->hits != 0) ? latency / (double)result->hits : 0.0;
+
+    return 0;
+}
+
+/**
+ * @brief     sweep worker
+ * @param[in] *arg pointer to a worker structure
+ * @return    NULL
+ * @note      worker i runs the configs i, i + threads, i + 2 * threads and so on
+ */
+static void *a_sweep_worker(void *arg)
+{
+    sweep_worker_t *worker = (sweep_worker_t *)arg;
+    sweep_t *sweep = worker->sweep;
+    uint8_t *hit;
+    uint32_t i;
+
+    hit = malloc(sweep->segments + 1);
+    if (hit == NULL)
+    {
+        worker->error = 1;
+
+        return NULL;
+    }
+    for (i = worker->index; i < sweep->configs; i += sweep->threads)
+    {
+        a_sweep_config(i, &sweep->result[i].config);
+        if (a_sweep_score(&sweep->result[i], hit) != 0)
+        {
+            worker->error = 1;
+        }
+    }
+    free(hit);
+
+    return NULL;
+}
+
+/**
+ * @brief     compare two results
+ * @param[in] *a pointer to a result
+ * @param[in] *b pointer to a result
+ * @return    order
+ * @note      most hits first, then fewest false positives, then the shortest latency
+ */
+static int a_sweep_compare(const void *a, const void *b)
+{
+    const sweep_result_t *ra = (const sweep_result_t *)a;
+    const sweep_result_t *rb = (const sweep_result_t *)b;
+
+    if (ra->hits != rb->hits)
+    {
+        return (ra->hits > rb->hits) ? -1 : 1;
+    }
+    if (ra->false_positives != rb->false_positives)
+    {
+        return (ra->false_positives < rb->false_positives) ? -1 : 1;
+    }
+    if (ra->latency_ms != rb->latency_ms)
+    {
+        return (ra->latency_ms < rb->latency_ms) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 5 param is invalid
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"stream", required_argument, NULL, 1},
+        {"odr", required_argument, NULL, 2},
+        {"seconds", required_argument, NULL, 3},
+        {"threads", required_argument, NULL, 4},
+        {"top", required_argument, NULL, 5},
+        {NULL, 0, NULL, 0},
+    };
+    pthread_t thread[SWEEP_THREADS];
+    sweep_worker_t worker[SWEEP_THREADS];
+    const char *stream = NULL;
+    uint8_t *truth = NULL;
+    double seconds = 120.0;
+    uint32_t top = 10;
+    struct timespec t0;
+    struct timespec t1;
+    long cores;
+    uint8_t res = 0;
+    uint32_t i;
+
+    gs_sweep.odr = 100.0f;
+    cores = sysconf(_SC_NPROCESSORS_ONLN);
+    gs_sweep.threads = (cores < 1) ? 1 : ((cores > SWEEP_THREADS) ? SWEEP_THREADS : (uint32_t)cores);
+
+    /* parse */
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  l3gd20h_sweep [--stream=<file> | --seconds=<s>] [--odr=<hz>] [--threads=<num>] [--top=<num>]\n");
+
+                return 0;
+            }
+            case 1 :
+            {
+                stream = optarg;
+
+                break;
+            }
+            case 2 :
+            {
+                gs_sweep.odr = (float)atof(optarg);
+                if (!(gs_sweep.odr > 0.0f))
+                {
+                    return 5;
+                }
+
+                break;
+            }
+            case 3 :
+            {
+                seconds = atof(optarg);
+                if (!(seconds > 0.0))
+                {
+                    return 5;
+                }
+
+                break;
+            }
+            case 4 :
+            {
+                long n = atol(optarg);
+
+                if ((n < 1) || (n > SWEEP_THREADS))
+                {
+                    return 5;
+                }
+                gs_sweep.threads = (uint32_t)n;
+
+                break;
+            }
+            case 5 :
+            {
+                top = (uint32_t)atol(optarg);
+
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+
+    /* a recorded stream or a synthetic one */
+    if (stream != NULL)
+    {
+        if (a_sweep_load(stream, &truth) != 0)
+        {
+            fprintf(stderr, "l3gd20h: load %s failed.\n", stream);
+            res = 1;
+        }
+    }
+    else if (a_sweep_synthesise(seconds, &truth) != 0)
+    {
+        res = 1;
+    }
+    if ((res == 0) && (a_sweep_segment(truth) != 0))
+    {
+        res = 1;
+    }
+    gs_sweep.configs = (uint32_t)(SWEEP_N(gs_sweep_threshold_dps) * SWEEP_N(gs_sweep_duration) * SWEEP_N(gs_sweep_counter) *
+                                  SWEEP_N(gs_sweep_bool) * SWEEP_N(gs_sweep_bool) * SWEEP_N(gs_sweep_path));
+    gs_sweep.result = calloc(gs_sweep.configs, sizeof(sweep_result_t));
+    if (gs_sweep.result == NULL)
+    {
+        res = 1;
+    }
+
+    /* one worker per core over the grid */
+    if (res == 0)
+    {
+        (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (i = 0; i < gs_sweep.threads; i++)
+        {
+            worker[i].sweep = &gs_sweep;
+            worker[i].index = i;
+            worker[i].error = 0;
+            if (pthread_create(&thread[i], NULL, a_sweep_worker, &worker[i]) != 0)
+            {
+                /* run the share of a missing thread here */
+                (void)a_sweep_worker(&worker[i]);
+                worker[i].index = SWEEP_THREADS;
+            }
+        }
+        for (i = 0; i < gs_sweep.threads; i++)
+        {
+            if (worker[i].index != SWEEP_THREADS)
+            {
+                (void)pthread_join(thread[i], NULL);
+            }
+            res |= worker[i].error;
+        }
+        (void)clock_gettime(CLOCK_MONOTONIC, &t1);
+    }
+
+    /* the best configs */
+    if (res == 0)
+    {
+        qsort(gs_sweep.result, gs_sweep.configs, sizeof(sweep_result_t), a_sweep_compare);
+        fprintf(stderr, "l3gd20h: %u configs over %u samples and %u segments on %u threads in %0.3fs.\n",
+                gs_sweep.configs, gs_sweep.samples, gs_sweep.segments, gs_sweep.threads,
+                (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1000000000.0);
+        printf("threshold_dps,duration,counter_mode,wait,and_or,path,hits,segments,hit_rate,false_positives,latency_ms\n");
+        for (i = 0; (i < top) && (i < gs_sweep.configs); i++)
+        {
+            const sweep_result_t *r = &gs_sweep.result[i];
+            char path[8];
+
+            if (r->config.selection == L3GD20H_SELECTION_LPF1)
+            {
+                (void)snprintf(path, sizeof(path), "lpf1");
+            }
+            else
+            {
+                (void)snprintf(path, sizeof(path), "hpf%u", r->config.cut_off);
+            }
+            printf("%0.1f,%u,%s,%u,%u,%s,%u,%u,%0.3f,%u,%0.1f\n",
+                   (double)r->config.threshold[0] * SWEEP_DPS, r->config.duration,
+                   (r->config.counter_mode == L3GD20H_COUNTER_MODE_DECREMENT) ? "decrement" : "reset",
+                   r->config.wait, r->config.and_or, path, r->hits, gs_sweep.segments,
+                   (gs_sweep.segments != 0) ? (double)r->hits / (double)gs_sweep.segments : 0.0,
+                   r->false_positives, r->latency_ms);
+        }
+    }
+    free(gs_sweep.raw);
+    free(gs_sweep.segment);
+    free(gs_sweep.start);
+    free(gs_sweep.result);
+    free(truth);
+
+    return res;
+}
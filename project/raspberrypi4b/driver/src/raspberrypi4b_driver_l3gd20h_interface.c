@@ -39,6 +39,7 @@
 #include "iic.h"
 #include "spi.h"
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -180,6 +181,20 @@ void l3gd20h_interface_delay_ms(uint32_t ms)
     usleep(1000 * ms);
 }
 
+/**
+ * @brief  interface timestamp us
+ * @return time in us
+ * @note   none
+ */
+uint64_t l3gd20h_interface_timestamp_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      stm32f407_driver_l3gd20h_bus.h
+ * @brief     stm32f407 driver l3gd20h static bus header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef STM32F407_DRIVER_L3GD20H_BUS_H
+#define STM32F407_DRIVER_L3GD20H_BUS_H
+
+#include "iic.h"
+#include "spi.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief      static bus read bytes
+ * @param[in]  addr iic device write address
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       L3GD20H_STATIC_BUS selects the bus
+ */
+static inline uint8_t l3gd20h_static_bus_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+#if (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_IIC)
+    return iic_read(addr, reg, buf, len);
+#else
+    (void)addr;
+    
+    return spi_read(reg, buf, len);
+#endif
+}
+
+/**
+ * @brief     static bus write bytes
+ * @param[in] addr iic device write address
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      L3GD20H_STATIC_BUS selects the bus
+ */
+static inline uint8_t l3gd20h_static_bus_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+#if (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_IIC)
+    return iic_write(addr, reg, buf, len);
+#else
+    (void)addr;
+    
+    return spi_write(reg, buf, len);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -42,6 +42,9 @@
 #include "uart.h"
 #include <stdarg.h>
 
+static uint32_t gs_tick_last = 0;        /**< last extended tick */
+static uint32_t gs_tick_high = 0;        /**< tick wraps */
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -162,6 +165,42 @@ void l3gd20h_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief  interface timestamp us
+ * @return time in us
+ * @note   the systick counts down from the reload value once per ms, a reload whose interrupt is still pending
+ *         is counted through PENDSTSET, so a caller that masks or outranks the systick still sees increasing
+ *         times, the 32 bit tick is extended to 64 bit and must be read at least once every 49.7 days
+ */
+uint64_t l3gd20h_interface_timestamp_us(void)
+{
+    uint32_t primask;
+    uint32_t tick;
+    uint32_t val;
+    uint32_t high;
+    
+    primask = __get_PRIMASK();
+    __disable_irq();
+    tick = HAL_GetTick();
+    val = SysTick->VAL;
+    
+    /* the counter reloaded but the tick interrupt has not run yet */
+    if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0)
+    {
+        tick++;
+        val = SysTick->VAL;
+    }
+    if (tick < gs_tick_last)
+    {
+        gs_tick_high++;
+    }
+    gs_tick_last = tick;
+    high = gs_tick_high;
+    __set_PRIMASK(primask);
+    
+    return ((((uint64_t)high << 32) | tick) * 1000) + (SysTick->LOAD - val) / (SystemCoreClock / 1000000);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -81,7 +81,259 @@
 #define L3GD20H_REG_LOW_ODR            0x39        /**< low power output data rate register */
 
 /**
- * @brief      iic or spi interface read bytes
+ * @brief debug message definition
+ */
+#if (L3GD20H_DEBUG_STRING_ENABLE == 1)
+    #define L3GD20H_PRINT(HANDLE, ...) (HANDLE)->debug_print(__VA_ARGS__)        /**< print the message */
+#else
+    #define L3GD20H_PRINT(HANDLE, ...)                                           /**< messages are compiled out */
+#endif
+
+/**
+ * @brief counter definition
+ */
+#if (L3GD20H_COUNTER_ENABLE == 1)
+    #define L3GD20H_COUNT(HANDLE, FIELD, N) ((HANDLE)->counter.FIELD += (N))        /**< add to a counter */
+#else
+    #define L3GD20H_COUNT(HANDLE, FIELD, N)                                          /**< counters are compiled out */
+#endif
+
+/**
+ * @brief trace definition
+ */
+#if (L3GD20H_TRACE_ENABLE == 1)
+    #define L3GD20H_TRACE(HANDLE, TYPE, REG, LEN, RES) a_l3gd20h_trace_put(HANDLE, TYPE, REG, LEN, RES)        /**< add a trace entry */
+#else
+    #define L3GD20H_TRACE(HANDLE, TYPE, REG, LEN, RES)                                                          /**< trace is compiled out */
+#endif
+
+/**
+ * @brief axis remap definition
+ */
+#if (L3GD20H_REMAP_ENABLE == 1)
+    #define L3GD20H_REMAP(HANDLE) ((HANDLE)->remap)        /**< remap of the handle */
+#else
+    #define L3GD20H_REMAP(HANDLE) (NULL)                   /**< sensor frame */
+#endif
+
+/**
+ * @brief auto ranging definition
+ */
+#if (L3GD20H_RANGE_ENABLE == 1)
+    #define L3GD20H_RANGE_SPLIT(HANDLE) ((HANDLE)->range_split)        /**< samples of the old range in the last read */
+#else
+    #define L3GD20H_RANGE_SPLIT(HANDLE) (0)                            /**< one full scale */
+#endif
+
+/**
+ * @brief interface selection definition
+ */
+#if ((L3GD20H_IIC_ENABLE == 1) && (L3GD20H_SPI_ENABLE == 1))
+    #define L3GD20H_BUS_IS_IIC(HANDLE) ((HANDLE)->iic_spi == L3GD20H_INTERFACE_IIC)        /**< runtime selection */
+#elif (L3GD20H_IIC_ENABLE == 1)
+    #define L3GD20H_BUS_IS_IIC(HANDLE) (1)                                                 /**< iic only */
+#else
+    #define L3GD20H_BUS_IS_IIC(HANDLE) (0)                                                 /**< spi only */
+#endif
+
+/**
+ * @brief l3gd20h register field structure definition
+ */
+typedef struct l3gd20h_field_s
+{
+    uint8_t reg;          /**< register address */
+    uint8_t shift;        /**< first bit of the field */
+    uint8_t width;        /**< bit width of the field */
+    uint8_t reset;        /**< field value after reset */
+} l3gd20h_field_t;
+
+/**
+ * @brief l3gd20h register field enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_FIELD_AXIS_Y                             = 0x00,        /**< axis y enable */
+    L3GD20H_FIELD_AXIS_X                             = 0x01,        /**< axis x enable */
+    L3GD20H_FIELD_AXIS_Z                             = 0x02,        /**< axis z enable */
+    L3GD20H_FIELD_EDGE_TRIGGER                       = 0x03,        /**< edge trigger */
+    L3GD20H_FIELD_LEVEL_TRIGGER                      = 0x04,        /**< level trigger */
+    L3GD20H_FIELD_HIGH_PASS_FILTER_MODE              = 0x05,        /**< high pass filter mode */
+    L3GD20H_FIELD_HIGH_PASS_FILTER_CUT_OFF_FREQUENCY = 0x06,        /**< high pass filter cut off frequency */
+    L3GD20H_FIELD_INTERRUPT1                         = 0x07,        /**< interrupt 1 */
+    L3GD20H_FIELD_BOOT_ON_INTERRUPT1                 = 0x08,        /**< boot on interrupt 1 */
+    L3GD20H_FIELD_INTERRUPT_ACTIVE_LEVEL             = 0x09,        /**< interrupt active level */
+    L3GD20H_FIELD_INTERRUPT_PIN_TYPE                 = 0x0A,        /**< interrupt pin type */
+    L3GD20H_FIELD_DATA_READY_ON_INTERRUPT2           = 0x0B,        /**< data ready on interrupt 2 */
+    L3GD20H_FIELD_FIFO_THRESHOLD_ON_INTERRUPT2       = 0x0C,        /**< fifo threshold on interrupt 2 */
+    L3GD20H_FIELD_FIFO_OVERRUN_ON_INTERRUPT2         = 0x0D,        /**< fifo overrun on interrupt 2 */
+    L3GD20H_FIELD_FIFO_EMPTY_ON_INTERRUPT2           = 0x0E,        /**< fifo empty on interrupt 2 */
+    L3GD20H_FIELD_BLOCK_DATA_UPDATE                  = 0x0F,        /**< block data update */
+    L3GD20H_FIELD_DATA_FORMAT                        = 0x10,        /**< data format */
+    L3GD20H_FIELD_FULL_SCALE                         = 0x11,        /**< full scale */
+    L3GD20H_FIELD_LEVEL_SENSITIVE_LATCHED            = 0x12,        /**< level sensitive latched */
+    L3GD20H_FIELD_SELF_TEST                          = 0x13,        /**< self test */
+    L3GD20H_FIELD_SPI_WIRE                           = 0x14,        /**< spi wire */
+    L3GD20H_FIELD_BOOT                               = 0x15,        /**< boot */
+    L3GD20H_FIELD_FIFO                               = 0x16,        /**< fifo enable */
+    L3GD20H_FIELD_STOP_ON_FIFO_THRESHOLD             = 0x17,        /**< stop on fifo threshold */
+    L3GD20H_FIELD_HIGH_PASS_FILTER                   = 0x18,        /**< high pass filter */
+    L3GD20H_FIELD_INTERRUPT_SELECTION                = 0x19,        /**< interrupt selection */
+    L3GD20H_FIELD_OUT_SELECTION                      = 0x1A,        /**< out selection */
+    L3GD20H_FIELD_FIFO_MODE                          = 0x1B,        /**< fifo mode */
+    L3GD20H_FIELD_FIFO_THRESHOLD                     = 0x1C,        /**< fifo threshold */
+    L3GD20H_FIELD_FIFO_LEVEL                         = 0x1D,        /**< fifo level */
+    L3GD20H_FIELD_IG_X_LOW_EVENT                     = 0x1E,        /**< x low event */
+    L3GD20H_FIELD_IG_X_HIGH_EVENT                    = 0x1F,        /**< x high event */
+    L3GD20H_FIELD_IG_Y_LOW_EVENT                     = 0x20,        /**< y low event */
+    L3GD20H_FIELD_IG_Y_HIGH_EVENT                    = 0x21,        /**< y high event */
+    L3GD20H_FIELD_IG_Z_LOW_EVENT                     = 0x22,        /**< z low event */
+    L3GD20H_FIELD_IG_Z_HIGH_EVENT                    = 0x23,        /**< z high event */
+    L3GD20H_FIELD_IG_LATCH                           = 0x24,        /**< latch */
+    L3GD20H_FIELD_IG_AND_OR_COMBINATION              = 0x25,        /**< and or combination */
+    L3GD20H_FIELD_COUNTER_MODE                       = 0x26,        /**< counter mode */
+    L3GD20H_FIELD_WAIT                               = 0x27,        /**< wait */
+    L3GD20H_FIELD_DURATION                           = 0x28,        /**< duration */
+    L3GD20H_FIELD_DATA_READY_ACTIVE_LEVEL            = 0x29,        /**< data ready active level */
+    L3GD20H_FIELD_IIC                                = 0x2A,        /**< iic disable */
+    L3GD20H_FIELD_MAX                                = 0x2B,        /**< field number */
+} l3gd20h_field_index_t;
+
+/**
+ * @brief register field table
+ * @note  indexed by l3gd20h_field_index_t, the axis and event fields follow the bit order of
+ *        l3gd20h_axis_t and l3gd20h_interrupt_event_t
+ */
+static const l3gd20h_field_t gs_l3gd20h_field[L3GD20H_FIELD_MAX] =
+{
+    {L3GD20H_REG_CTRL1, 0, 1, 1},              /* axis y enable */
+    {L3GD20H_REG_CTRL1, 1, 1, 1},              /* axis x enable */
+    {L3GD20H_REG_CTRL1, 2, 1, 1},              /* axis z enable */
+    {L3GD20H_REG_CTRL2, 7, 1, 0},              /* edge trigger */
+    {L3GD20H_REG_CTRL2, 6, 1, 0},              /* level trigger */
+    {L3GD20H_REG_CTRL2, 4, 2, 0},              /* high pass filter mode */
+    {L3GD20H_REG_CTRL2, 0, 4, 0},              /* high pass filter cut off frequency */
+    {L3GD20H_REG_CTRL3, 7, 1, 0},              /* interrupt 1 */
+    {L3GD20H_REG_CTRL3, 6, 1, 0},              /* boot on interrupt 1 */
+    {L3GD20H_REG_CTRL3, 5, 1, 0},              /* interrupt active level */
+    {L3GD20H_REG_CTRL3, 4, 1, 0},              /* interrupt pin type */
+    {L3GD20H_REG_CTRL3, 3, 1, 0},              /* data ready on interrupt 2 */
+    {L3GD20H_REG_CTRL3, 2, 1, 0},              /* fifo threshold on interrupt 2 */
+    {L3GD20H_REG_CTRL3, 1, 1, 0},              /* fifo overrun on interrupt 2 */
+    {L3GD20H_REG_CTRL3, 0, 1, 0},              /* fifo empty on interrupt 2 */
+    {L3GD20H_REG_CTRL4, 7, 1, 0},              /* block data update */
+    {L3GD20H_REG_CTRL4, 6, 1, 0},              /* data format */
+    {L3GD20H_REG_CTRL4, 4, 2, 0},              /* full scale */
+    {L3GD20H_REG_CTRL4, 3, 1, 0},              /* level sensitive latched */
+    {L3GD20H_REG_CTRL4, 1, 2, 0},              /* self test */
+    {L3GD20H_REG_CTRL4, 0, 1, 0},              /* spi wire */
+    {L3GD20H_REG_CTRL5, 7, 1, 0},              /* boot */
+    {L3GD20H_REG_CTRL5, 6, 1, 0},              /* fifo enable */
+    {L3GD20H_REG_CTRL5, 5, 1, 0},              /* stop on fifo threshold */
+    {L3GD20H_REG_CTRL5, 4, 1, 0},              /* high pass filter */
+    {L3GD20H_REG_CTRL5, 2, 2, 0},              /* interrupt selection */
+    {L3GD20H_REG_CTRL5, 0, 2, 0},              /* out selection */
+    {L3GD20H_REG_FIFO_CTRL, 5, 3, 0},          /* fifo mode */
+    {L3GD20H_REG_FIFO_CTRL, 0, 5, 0},          /* fifo threshold */
+    {L3GD20H_REG_FIFO_SRC, 0, 5, 0},           /* fifo level */
+    {L3GD20H_REG_IG_CFG, 0, 1, 0},             /* x low event */
+    {L3GD20H_REG_IG_CFG, 1, 1, 0},             /* x high event */
+    {L3GD20H_REG_IG_CFG, 2, 1, 0},             /* y low event */
+    {L3GD20H_REG_IG_CFG, 3, 1, 0},             /* y high event */
+    {L3GD20H_REG_IG_CFG, 4, 1, 0},             /* z low event */
+    {L3GD20H_REG_IG_CFG, 5, 1, 0},             /* z high event */
+    {L3GD20H_REG_IG_CFG, 6, 1, 0},             /* latch */
+    {L3GD20H_REG_IG_CFG, 7, 1, 0},             /* and or combination */
+    {L3GD20H_REG_IG_THS_XH, 7, 1, 0},          /* counter mode */
+    {L3GD20H_REG_IG_DURATION, 7, 1, 0},        /* wait */
+    {L3GD20H_REG_IG_DURATION, 0, 7, 0},        /* duration */
+    {L3GD20H_REG_LOW_ODR, 5, 1, 0},            /* data ready active level */
+    {L3GD20H_REG_LOW_ODR, 3, 1, 0}             /* iic disable */
+};
+
+#if (L3GD20H_STATIC_BUS != L3GD20H_STATIC_BUS_NONE)
+#ifdef L3GD20H_STATIC_BUS_HEADER
+#include L3GD20H_STATIC_BUS_HEADER
+#else
+#if (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_IIC)
+uint8_t l3gd20h_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+uint8_t l3gd20h_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      static bus read bytes
+ * @param[in]  addr iic device write address
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static inline uint8_t l3gd20h_static_bus_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return l3gd20h_interface_iic_read(addr, reg, buf, len);        /* read data */
+}
+
+/**
+ * @brief     static bus write bytes
+ * @param[in] addr iic device write address
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static inline uint8_t l3gd20h_static_bus_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return l3gd20h_interface_iic_write(addr, reg, buf, len);       /* write data */
+}
+#else
+uint8_t l3gd20h_interface_spi_read(uint8_t reg, uint8_t *buf, uint16_t len);
+uint8_t l3gd20h_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      static bus read bytes
+ * @param[in]  addr unused
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static inline uint8_t l3gd20h_static_bus_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;                                                    /* not used */
+    
+    return l3gd20h_interface_spi_read(reg, buf, len);              /* read data */
+}
+
+/**
+ * @brief     static bus write bytes
+ * @param[in] addr unused
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static inline uint8_t l3gd20h_static_bus_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;                                                    /* not used */
+    
+    return l3gd20h_interface_spi_write(reg, buf, len);             /* write data */
+}
+#endif
+#endif
+#endif
+
+/**
+ * @brief      run one bus read
  * @param[in]  *handle pointer to an l3gd20h handle structure
  * @param[in]  reg iic register address
  * @param[out] *buf pointer to a data buffer
@@ -91,9 +343,26 @@
  *             - 1 read failed
  * @note       none
  */
-static uint8_t a_l3gd20h_iic_spi_read(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+static inline uint8_t a_l3gd20h_bus_read(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle->iic_spi == L3GD20H_INTERFACE_IIC)                        /* iic interface */
+#if (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_IIC)
+    if (len > 1)                                                                       /* len > 1 */
+    {
+        reg |= 1 << 7;                                                                 /* flag bit 7 */
+    }
+    
+    return (l3gd20h_static_bus_read(handle->iic_addr, reg, buf, len) != 0) ? 1 : 0;    /* read data */
+#elif (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_SPI)
+    (void)handle;                                                                      /* not used */
+    if (len > 1)                                                                       /* len > 1 */
+    {
+        reg |= 1 << 6;                                                                 /* flag address increment */
+    }
+    reg |= 1 << 7;                                                                     /* set read bit */
+    
+    return (l3gd20h_static_bus_read(0x00, reg, buf, len) != 0) ? 1 : 0;                /* read data */
+#else
+    if (L3GD20H_BUS_IS_IIC(handle))                                      /* iic interface */
     {
         if (len > 1)                                                     /* len > 1 */
         {
@@ -126,10 +395,11 @@ static uint8_t a_l3gd20h_iic_spi_read(l3gd20h_handle_t *handle, uint8_t reg, uin
             return 0;                                                    /* success return 0 */
         }
     }
+#endif
 }
 
 /**
- * @brief     iic or spi interface write bytes
+ * @brief     run one bus write
  * @param[in] *handle pointer to an l3gd20h handle structure
  * @param[in] reg iic register address
  * @param[in] *buf pointer to a data buffer
@@ -139,9 +409,21 @@ static uint8_t a_l3gd20h_iic_spi_read(l3gd20h_handle_t *handle, uint8_t reg, uin
  *            - 1 write failed
  * @note      none
  */
-static uint8_t a_l3gd20h_iic_spi_write(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+static inline uint8_t a_l3gd20h_bus_write(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle->iic_spi == L3GD20H_INTERFACE_IIC)                         /* iic interface */
+#if (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_IIC)
+    return (l3gd20h_static_bus_write(handle->iic_addr, reg, buf, len) != 0) ? 1 : 0;   /* write data */
+#elif (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_SPI)
+    (void)handle;                                                                      /* not used */
+    if (len > 1)                                                                       /* len > 1 */
+    {
+        reg |= 1 << 6;                                                                 /* flag address increment */
+    }
+    reg &= ~(1 << 7);                                                                  /* set write bit */
+    
+    return (l3gd20h_static_bus_write(0x00, reg, buf, len) != 0) ? 1 : 0;               /* write data */
+#else
+    if (L3GD20H_BUS_IS_IIC(handle))                                       /* iic interface */
     {
         if (handle->iic_write(handle->iic_addr, reg, buf, len) != 0)      /* write data */
         {
@@ -169,790 +451,1446 @@ static uint8_t a_l3gd20h_iic_spi_write(l3gd20h_handle_t *handle, uint8_t reg, ui
             return 0;                                                     /* success return 0 */
         }
     }
+#endif
 }
 
+#if (L3GD20H_TRACE_ENABLE == 1)
 /**
- * @brief     set the chip interface
+ * @brief     add one trace entry
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] interface chip interface
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- * @note      none
+ * @param[in] type trace type
+ * @param[in] reg register address
+ * @param[in] len data length
+ * @param[in] res result
+ * @note      the oldest entry is overwritten when the ring is full
  */
-uint8_t l3gd20h_set_interface(l3gd20h_handle_t *handle, l3gd20h_interface_t interface)
+static void a_l3gd20h_trace_put(l3gd20h_handle_t *handle, l3gd20h_trace_type_t type, uint8_t reg,
+                                uint16_t len, uint8_t res)
 {
-    if (handle == NULL)                          /* check handle */
+    l3gd20h_trace_t *trace;
+    
+    trace = &handle->trace[handle->trace_head & (L3GD20H_TRACE_DEPTH - 1)];                 /* get the entry */
+    trace->us = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;                /* set the time */
+    trace->len = len;                                                                       /* set the length */
+    trace->type = (uint8_t)type;                                                            /* set the type */
+    trace->reg = reg;                                                                       /* set the register */
+    trace->res = res;                                                                       /* set the result */
+    handle->trace_head++;                                                                   /* head++ */
+    if (handle->trace_count < L3GD20H_TRACE_DEPTH)                                          /* ring is not full */
     {
-        return 2;                                /* return error */
+        handle->trace_count++;                                                              /* count++ */
     }
+    else
+    {
+        handle->trace_lost++;                                                               /* overwrite the oldest */
+    }
+}
+#endif
+
+#if (L3GD20H_COUNTER_ENABLE == 1)
+/**
+ * @brief     account one bus transaction
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] dir transaction direction
+ * @param[in] reg register address
+ * @param[in] len data length
+ * @param[in] res transaction result
+ * @param[in] start start time in us
+ * @note      none
+ */
+static void a_l3gd20h_counter_bus(l3gd20h_handle_t *handle, l3gd20h_counter_dir_t dir, uint8_t reg,
+                                  uint16_t len, uint8_t res, uint64_t start)
+{
+    uint64_t us;
+    uint8_t bin;
     
-    handle->iic_spi = (uint8_t)interface;        /* set the interface */
-    
-    return 0;                                    /* success return 0 */
+    reg &= L3GD20H_COUNTER_REG_NUM - 1;                                      /* drop the address flags */
+    handle->counter.transactions[dir][reg]++;                                /* count the transaction */
+    handle->counter.bytes[dir][reg] += len;                                  /* count the bytes */
+    if (res != 0)                                                            /* check result */
+    {
+        handle->counter.errors++;                                            /* count the error */
+    }
+    if (handle->timestamp_us != NULL)                                        /* timestamp is valid */
+    {
+        us = handle->timestamp_us() - start;                                 /* get the hook time */
+        handle->counter.bus_us[dir] += us;                                   /* add the hook time */
+        bin = 0;                                                             /* below 1 us */
+        while ((us != 0) && (bin < (L3GD20H_COUNTER_HIST_BINS - 1)))        /* find the bin */
+        {
+            us >>= 1;                                                        /* next power of two */
+            bin++;                                                           /* bin++ */
+        }
+        handle->counter.hist[dir][bin]++;                                    /* count the hook time */
+    }
 }
+#endif
 
 /**
- * @brief      get the chip interface
+ * @brief      iic or spi interface read bytes
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *interface pointer to a chip interface buffer
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
  * @return     status code
  *             - 0 success
- *             - 2 handle is NULL
- * @note       none
+ *             - 1 read failed
+ * @note       a failed read is issued again up to L3GD20H_BUS_RETRY times
  */
-uint8_t l3gd20h_get_interface(l3gd20h_handle_t *handle, l3gd20h_interface_t *interface)
+#if ((L3GD20H_COUNTER_ENABLE == 0) && (L3GD20H_TRACE_ENABLE == 0) && (L3GD20H_BUS_RETRY == 0))
+static inline uint8_t a_l3gd20h_iic_spi_read(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle == NULL)                                         /* check handle */
-    {
-        return 2;                                               /* return error */
+    return a_l3gd20h_bus_read(handle, reg, buf, len);                                     /* read data */
+}
+#else
+static uint8_t a_l3gd20h_iic_spi_read(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint8_t retry;
+#if (L3GD20H_COUNTER_ENABLE == 1)
+    uint64_t start;
+#endif
+    
+    for (retry = L3GD20H_BUS_RETRY; ; retry--)                                            /* run the retries */
+    {
+#if (L3GD20H_COUNTER_ENABLE == 1)
+        start = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;              /* get the start time */
+#endif
+        L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_BUS_READ_BEGIN, reg, len, 0);            /* trace the start */
+        res = a_l3gd20h_bus_read(handle, reg, buf, len);                                  /* read data */
+        L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_BUS_READ_END, reg, len, res);            /* trace the end */
+#if (L3GD20H_COUNTER_ENABLE == 1)
+        a_l3gd20h_counter_bus(handle, L3GD20H_COUNTER_DIR_READ, reg, len, res, start);    /* account the read */
+#endif
+        if ((res == 0) || (retry == 0))                                                   /* done */
+        {
+            return res;                                                                   /* return the result */
+        }
+        L3GD20H_COUNT(handle, retries, 1);                                                /* count the retry */
     }
-    
-    *interface = (l3gd20h_interface_t)(handle->iic_spi);        /* get the interface */
-    
-    return 0;                                                   /* success return 0 */
 }
+#endif
 
 /**
- * @brief     set the iic address pin
+ * @brief     iic or spi interface write bytes
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] addr_pin address pin
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
  * @return    status code
  *            - 0 success
- *            - 2 handle is NULL
- * @note      none
+ *            - 1 write failed
+ * @note      a failed write is issued again up to L3GD20H_BUS_RETRY times
  */
-uint8_t l3gd20h_set_addr_pin(l3gd20h_handle_t *handle, l3gd20h_address_t addr_pin)
+#if ((L3GD20H_COUNTER_ENABLE == 0) && (L3GD20H_TRACE_ENABLE == 0) && (L3GD20H_BUS_RETRY == 0))
+static inline uint8_t a_l3gd20h_iic_spi_write(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle == NULL)                          /* check handle */
-    {
-        return 2;                                /* return error */
+    return a_l3gd20h_bus_write(handle, reg, buf, len);                                    /* write data */
+}
+#else
+static uint8_t a_l3gd20h_iic_spi_write(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint8_t retry;
+#if (L3GD20H_COUNTER_ENABLE == 1)
+    uint64_t start;
+#endif
+    
+    for (retry = L3GD20H_BUS_RETRY; ; retry--)                                            /* run the retries */
+    {
+#if (L3GD20H_COUNTER_ENABLE == 1)
+        start = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;              /* get the start time */
+#endif
+        L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_BUS_WRITE_BEGIN, reg, len, 0);           /* trace the start */
+        res = a_l3gd20h_bus_write(handle, reg, buf, len);                                 /* write data */
+        L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_BUS_WRITE_END, reg, len, res);           /* trace the end */
+#if (L3GD20H_COUNTER_ENABLE == 1)
+        a_l3gd20h_counter_bus(handle, L3GD20H_COUNTER_DIR_WRITE, reg, len, res, start);   /* account the write */
+#endif
+        if ((res == 0) || (retry == 0))                                                   /* done */
+        {
+            return res;                                                                   /* return the result */
+        }
+        L3GD20H_COUNT(handle, retries, 1);                                                /* count the retry */
     }
-    
-    handle->iic_addr = (uint8_t)addr_pin;        /* set the iic address */
-    
-    return 0;                                    /* success return 0 */
 }
+#endif
 
 /**
- * @brief      get the iic address pin
+ * @brief      read a register field
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *addr_pin pointer to an address pin buffer
+ * @param[in]  field register field index
+ * @param[out] *value pointer to a field value buffer
  * @return     status code
  *             - 0 success
+ *             - 1 read failed
  *             - 2 handle is NULL
+ *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_addr_pin(l3gd20h_handle_t *handle, l3gd20h_address_t *addr_pin)
+static uint8_t a_l3gd20h_field_read(l3gd20h_handle_t *handle, l3gd20h_field_index_t field, uint8_t *value)
 {
-    if (handle == NULL)                                       /* check handle */
+    uint8_t prev;
+    const l3gd20h_field_t *f;
+    
+    if (handle == NULL)                                                                          /* check handle */
     {
-        return 2;                                             /* return error */
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if (field >= L3GD20H_FIELD_MAX)                                                              /* check field */
+    {
+        return 1;                                                                                /* return error */
     }
     
-    *addr_pin = (l3gd20h_address_t)(handle->iic_addr);        /* get the iic address */
+    f = &gs_l3gd20h_field[field];                                                                /* get the field */
+    if (a_l3gd20h_iic_spi_read(handle, f->reg, (uint8_t *)&prev, 1) != 0)                        /* read config */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read register 0x%02X failed.\n", f->reg);                /* read register failed */
+        
+        return 1;                                                                                /* return error */
+    }
+    *value = (uint8_t)((prev >> f->shift) & ((1 << f->width) - 1));                              /* get the field */
     
-    return 0;                                                 /* success return 0 */
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     set the chip mode
+ * @brief     write a register field
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] mode chip mode
+ * @param[in] field register field index
+ * @param[in] value field value
  * @return    status code
  *            - 0 success
- *            - 1 set mode failed
+ *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the other bits of the register are kept
  */
-uint8_t l3gd20h_set_mode(l3gd20h_handle_t *handle, l3gd20h_mode_t mode)
+static uint8_t a_l3gd20h_field_write(l3gd20h_handle_t *handle, l3gd20h_field_index_t field, uint8_t value)
 {
-    uint8_t res, prev;
+    uint8_t prev, mask;
+    const l3gd20h_field_t *f;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                          /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                     /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                                /* return error */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);             /* read config */
-    if (res != 0)                                                                             /* check result */
+    if (field >= L3GD20H_FIELD_MAX)                                                              /* check field */
     {
-        handle->debug_print("l3gd20h: read ctrl1 failed.\n");                                 /* read ctrl1 failed */
-        
-        return 1;                                                                             /* return error */
+        return 1;                                                                                /* return error */
     }
-    if (mode == L3GD20H_MODE_SLEEP)                                                           /* if sleep mode */
+    
+    f = &gs_l3gd20h_field[field];                                                                /* get the field */
+    if (a_l3gd20h_iic_spi_read(handle, f->reg, (uint8_t *)&prev, 1) != 0)                        /* read config */
     {
-        prev |= (1 << 3);                                                                     /* set pd */
-        prev &= ~(0x07);                                                                      /* clear config */
+        L3GD20H_PRINT(handle, "l3gd20h: read register 0x%02X failed.\n", f->reg);                /* read register failed */
         
-        return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);       /* write config */
+        return 1;                                                                                /* return error */
     }
-    else
+    mask = (uint8_t)(((1 << f->width) - 1) << f->shift);                                         /* get the mask */
+    prev = (uint8_t)((prev & ~mask) | ((value << f->shift) & mask));                             /* set the field */
+    if (a_l3gd20h_iic_spi_write(handle, f->reg, (uint8_t *)&prev, 1) != 0)                       /* write config */
     {
-        prev &= ~(1 << 3);                                                                    /* clear pd */
-        prev |= (mode << 3);                                                                  /* set mode */
-        prev |= 0x07;                                                                         /* set x,y,z enable */
+        L3GD20H_PRINT(handle, "l3gd20h: write register 0x%02X failed.\n", f->reg);               /* write register failed */
         
-        return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);       /* write config */
+        return 1;                                                                                /* return error */
     }
+    
+    return 0;                                                                                    /* success return 0 */
 }
 
+#if (L3GD20H_BIAS_ENABLE == 1)
 /**
- * @brief      get the chip mode
+ * @brief l3gd20h bias limit definition, L3GD20H_BIAS_LIMIT_DPS in fractional lsb of the 245 dps range
+ */
+#define L3GD20H_BIAS_LIMIT (((int64_t)L3GD20H_BIAS_LIMIT_DPS * 4000 * (1 << L3GD20H_BIAS_FRACTION_BITS)) / 35)
+
+/**
+ * @brief l3gd20h bias scale table, lsb of a range in lsb of the 245 dps range as a shift
+ */
+static const uint8_t gs_l3gd20h_bias_shift[4] =
+{
+    0, 1, 3, 3,
+};
+
+/**
+ * @brief     subtract a bias offset from one axis
+ * @param[in] v raw value
+ * @param[in] offset bias offset
+ * @return    compensated value
+ * @note      the result saturates at the data range
+ */
+static int16_t a_l3gd20h_bias_sub(int16_t v, int16_t offset)
+{
+    int32_t r;
+    
+    r = (int32_t)v - offset;                                                          /* remove the bias */
+    r = (r > 32767) ? 32767 : r;                                                      /* positive limit */
+    r = (r < -32768) ? -32768 : r;                                                    /* negative limit */
+    
+    return (int16_t)r;                                                                /* return the value */
+}
+
+/**
+ * @brief      get the bias offset of a batch
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *mode pointer to a chip mode buffer
- * @return     status code
- *             - 0 success
- *             - 1 get mode failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @param[in]  range full scale range bits
+ * @param[out] *offset pointer to a bias offset buffer
+ * @return     offset to pass to the decode, NULL when the compensation is off
+ * @note       the offset is rounded once per batch to the lsb of the range
  */
-uint8_t l3gd20h_get_mode(l3gd20h_handle_t *handle, l3gd20h_mode_t *mode)
+static const int16_t *a_l3gd20h_bias_offset(l3gd20h_handle_t *handle, uint8_t range, int16_t offset[3])
 {
-    uint8_t res, prev;
+    uint8_t i;
+    int32_t d;
+    int32_t v;
     
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->bias_mode == L3GD20H_BIAS_OFF)                                        /* compensation is off */
     {
-        return 3;                                                                       /* return error */
+        return NULL;                                                                  /* no offset */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl1 failed.\n");                           /* read ctrl1 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    if ((prev & 0x07) != 0)                                                             /* if x,y,z valid */
+    d = (int32_t)1 << (L3GD20H_BIAS_FRACTION_BITS + gs_l3gd20h_bias_shift[range & 0x03]);  /* lsb of the range */
+    for (i = 0; i < 3; i++)                                                           /* each axis */
     {
-        prev &= 1 << 3;                                                                 /* set pd */
-        *mode  = (l3gd20h_mode_t)((prev >> 3) & 0x01);                                  /* normal or power down mode */
-    }
-    else
-    {
-        if ((prev & (1 << 3)) != 0)                                                     /* if pd == 1 */
-        {
-            *mode = L3GD20H_MODE_SLEEP;                                                 /* sleep mode*/
-        }
-        else
-        {
-            prev &= 1 << 3;                                                             /* set pd */
-            *mode  = (l3gd20h_mode_t)((prev >> 3) & 0x01);                              /* set power down mode */
-        }
+        v = handle->bias[i] + handle->bias_temp[i];                                   /* get the bias and the temperature term */
+        offset[i] = (int16_t)((v >= 0) ? ((v + d / 2) / d) : -((-v + d / 2) / d));   /* round to the lsb */
     }
     
-    return 0;                                                                           /* success return 0 */
+    return offset;                                                                    /* return the offset */
 }
 
 /**
- * @brief     set the axis
- * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] axis set axis
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set axis failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ * @brief     convert a standard deviation threshold to a variance threshold
+ * @param[in] dps standard deviation in dps
+ * @return    variance in lsb^2 of the 245 dps range
  * @note      none
  */
-uint8_t l3gd20h_set_axis(l3gd20h_handle_t *handle, l3gd20h_axis_t axis, l3gd20h_bool_t enable)
+static uint32_t a_l3gd20h_bias_limit(float dps)
 {
-    uint8_t res, prev;
+    float lsb;
     
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
+    lsb = dps * 1000.0f / 8.75f;                                                      /* 8.75 mdps/digit */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+    return (uint32_t)(lsb * lsb + 0.5f);                                              /* return the variance */
+}
+
+/**
+ * @brief     restart a still window
+ * @param[in] *still pointer to a still window structure
+ * @note      none
+ */
+static void a_l3gd20h_still_restart(l3gd20h_still_t *still)
+{
+    uint8_t i;
+    
+    for (i = 0; i < 3; i++)                                                           /* each axis */
     {
-        handle->debug_print("l3gd20h: read ctrl1 failed.\n");                             /* read ctrl1 failed */
-        
-        return 1;                                                                         /* return error */
+        still->sum[i] = 0;                                                            /* clear the sum */
+        still->square[i] = 0;                                                         /* clear the squares */
     }
-    prev &= ~(1 << axis);                                                                 /* clear enable bit */
-    prev |= enable << axis;                                                               /* set enable */
-    
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);       /* write config */
+    still->n = 0;                                                                     /* no sample */
 }
 
 /**
- * @brief      get the axis
- * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[in]  axis set axis
- * @param[out] *enable pointer to a bool value buffer
- * @return     status code
- *             - 0 success
- *             - 1 get axis failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     add a compensated batch to a still window
+ * @param[in] *still pointer to a still window structure
+ * @param[in] *remap pointer to the axis remap of the batch
+ * @param[in] range full scale range bits
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] len sample length
+ * @param[in] window window length
+ * @return    1 when the window is full, else 0
+ * @note      the rest of a batch that fills the window is skipped, so the next window starts
+ *            with the offset of the next batch, every output axis is added to its sensor axis
  */
-uint8_t l3gd20h_get_axis(l3gd20h_handle_t *handle, l3gd20h_axis_t axis, l3gd20h_bool_t *enable) 
+static uint8_t a_l3gd20h_still_add(l3gd20h_still_t *still, const uint8_t *remap, uint8_t range,
+                                   int16_t (*raw)[3], uint16_t len, uint16_t window)
 {
-    uint8_t res, prev;
+    uint16_t i;
+    uint8_t j;
+    int32_t v;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (range != still->range)                                                        /* range changed */
     {
-        return 2;                                                                       /* return error */
+        a_l3gd20h_still_restart(still);                                               /* restart the window */
+        still->range = range;                                                         /* save the range */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    for (i = 0; i < len; i++)                                                         /* each sample */
     {
-        return 3;                                                                       /* return error */
+        for (j = 0; j < 3; j++)                                                       /* each axis */
+        {
+#if (L3GD20H_REMAP_ENABLE == 1)
+            v = ((remap[j] & 0x04) != 0) ? -(int32_t)raw[i][j] : raw[i][j];          /* undo the sign */
+            still->sum[remap[j] & 0x03] += v;                                         /* add to the sum */
+            still->square[remap[j] & 0x03] += (uint64_t)(v * v);                      /* add to the squares */
+#else
+            (void)remap;                                                              /* sensor frame */
+            v = raw[i][j];                                                            /* get the axis */
+            still->sum[j] += v;                                                       /* add to the sum */
+            still->square[j] += (uint64_t)(v * v);                                    /* add to the squares */
+#endif
+        }
+        still->n++;                                                                   /* one more sample */
+        if (still->n >= window)                                                       /* window is full */
+        {
+            return 1;                                                                 /* full */
+        }
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    return 0;                                                                         /* not full */
+}
+
+/**
+ * @brief      close a still window
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[in]  *still pointer to a still window structure
+ * @param[in]  *offset pointer to the bias offset the window was compensated with
+ * @param[out] *mean pointer to a mean buffer in fractional lsb of the 245 dps range
+ * @return     1 when the window was still, else 0
+ * @note       the mean is the device output without the host compensation, a window that moves
+ *             or sits beyond L3GD20H_BIAS_LIMIT_DPS is not still
+ */
+static uint8_t a_l3gd20h_still_close(l3gd20h_handle_t *handle, l3gd20h_still_t *still, const int16_t *offset,
+                                     int64_t mean[3])
+{
+    uint8_t i;
+    uint8_t shift;
+    uint64_t n;
+    uint64_t a;
+    uint64_t var;
+    int64_t limit;
+    uint8_t res;
+    
+    shift = gs_l3gd20h_bias_shift[still->range & 0x03];                               /* get the scale */
+    n = still->n;                                                                     /* get the samples */
+    limit = L3GD20H_BIAS_LIMIT;                                                       /* get the limit */
+    res = 1;                                                                          /* init 1 */
+    for (i = 0; i < 3; i++)                                                           /* each axis */
     {
-        handle->debug_print("l3gd20h: read ctrl1 failed.\n");                           /* read ctrl1 failed */
-        
-        return 1;                                                                       /* return error */
+        a = (uint64_t)((still->sum[i] >= 0) ? still->sum[i] : -still->sum[i]);        /* absolute sum */
+        var = n * still->square[i] - a * a;                                           /* n^2 times the variance */
+        if (var > (((uint64_t)handle->bias_limit * n * n) >> (2 * shift)))            /* moving */
+        {
+            res = 0;                                                                  /* not still */
+        }
+        mean[i] = still->sum[i] * ((int64_t)1 << (L3GD20H_BIAS_FRACTION_BITS + shift)) / (int64_t)n +
+                  (int64_t)offset[i] * ((int64_t)1 << (L3GD20H_BIAS_FRACTION_BITS + shift));    /* uncompensated mean */
+        if ((mean[i] > limit) || (mean[i] < -limit))                                  /* beyond the zero rate level */
+        {
+            res = 0;                                                                  /* not a bias */
+        }
     }
-    prev &= (1 << axis);                                                                /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> axis);                                           /* get bool */
+    a_l3gd20h_still_restart(still);                                                   /* restart the window */
     
-    return 0;                                                                           /* success return 0 */
+    return res;                                                                       /* return the result */
 }
 
 /**
- * @brief     set the rate bandwidth
+ * @brief     feed a compensated batch to the bias estimator
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] rate_bandwidth rate bandwidth
- * @return    status code
- *            - 0 success
- *            - 1 set rate bandwidth failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @param[in] range full scale range bits
+ * @param[in] *offset pointer to the bias offset of the batch
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] len sample length
+ * @note      the first still window loads the bias, the bias is the mean without the temperature term,
+ *            the estimator pauses while a reference calibration runs
  */
-uint8_t l3gd20h_set_rate_bandwidth(l3gd20h_handle_t *handle, l3gd20h_lodr_odr_bw_t rate_bandwidth) 
+static void a_l3gd20h_bias_update(l3gd20h_handle_t *handle, uint8_t range, const int16_t *offset,
+                                  int16_t (*raw)[3], uint16_t len)
 {
-    uint8_t res, prev;
+    uint8_t i;
+    int64_t mean[3];
     
-    if (handle == NULL)                                                                   /* check handle */
+    if ((handle->bias_mode != L3GD20H_BIAS_TRACK) || (offset == NULL))                /* not tracking */
     {
-        return 2;                                                                         /* return error */
+        return;                                                                       /* nothing to do */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->reference_state != 0)                                                 /* reference calibration runs */
     {
-        return 3;                                                                         /* return error */
+        return;                                                                       /* the calibration moves the bias */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+    if (a_l3gd20h_still_add(&handle->bias_still, L3GD20H_REMAP(handle), range, raw, len, handle->bias_window) == 0)    /* window is open */
     {
-        handle->debug_print("l3gd20h: read ctrl1 failed.\n");                             /* read ctrl1 failed */
-        
-        return 1;                                                                         /* return error */
+        return;                                                                       /* wait */
     }
-    prev &= ~(0xF << 4);                                                                  /* clear rate and bandwidth bits */
-    prev |= (rate_bandwidth & 0xF) << 4;                                                  /* set rate and bandwidth */
-    if (a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1) != 0)     /* write config */
+    if (a_l3gd20h_still_close(handle, &handle->bias_still, offset, mean) == 0)        /* not still */
     {
-        handle->debug_print("l3gd20h: write ctrl1 failed.\n");                            /* write ctrl1 failed */
-        
-        return 1;                                                                         /* return error */
+        return;                                                                       /* keep the bias */
     }
-
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* read low odr */
-    if (res != 0)                                                                         /* check result */
+    
+    for (i = 0; i < 3; i++)                                                           /* each axis */
     {
-        handle->debug_print("l3gd20h: read low odr failed.\n");                           /* read low odr failed */
-        
-        return 1;                                                                         /* return error */
+        mean[i] -= handle->bias_temp[i];                                              /* remove the temperature term */
+        if (handle->bias_windows == 0)                                                /* first window */
+        {
+            handle->bias[i] = (int32_t)mean[i];                                       /* load the bias */
+        }
+        else
+        {
+            handle->bias[i] += (int32_t)((mean[i] - handle->bias[i]) / (1 << L3GD20H_BIAS_GAIN_SHIFT));    /* track the bias */
+        }
     }
-    prev &= ~(1 << 0);                                                                    /* clear odr bit */
-    prev |= ((rate_bandwidth & 0x10) >> 4) & 0x01;                                        /* set odr */
-    if (a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1) != 0)   /* write config */
+    if (handle->bias_windows != 0xFFFFFFFFU)                                          /* not saturated */
     {
-        handle->debug_print("l3gd20h: write low odr failed.\n");                          /* write low odr failed */
-        
-        return 1;                                                                         /* return error */
+        handle->bias_windows++;                                                       /* one more window */
     }
-    
-    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the rate bandwidth
- * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *rate_bandwidth pointer to a rate bandwidth buffer
- * @return     status code
- *             - 0 success
- *             - 1 get rate bandwidth failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     start a reference calibration run
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] skip samples to skip before the first window
+ * @note      the learned weight of a reference lsb is kept between runs
  */
-uint8_t l3gd20h_get_rate_bandwidth(l3gd20h_handle_t *handle, l3gd20h_lodr_odr_bw_t *rate_bandwidth)
+static void a_l3gd20h_reference_start(l3gd20h_handle_t *handle, uint16_t skip)
 {
-    uint8_t res, prev1, prev2;
-    
-    if (handle == NULL)                                                                     /* check handle */
+    handle->reference_step = 0;                                                       /* no write yet */
+    handle->reference_best = handle->reference_value;                                 /* current value */
+    handle->reference_best_mean = 0x7FFFFFFF;                                         /* no offset yet */
+    handle->reference_skip = skip;                                                    /* set the skip */
+    handle->reference_state = (skip != 0) ? 1 : 2;                                    /* skip or measure */
+    a_l3gd20h_still_restart(&handle->reference_still);                                /* empty window */
+    handle->reference_n = 0;                                                          /* no measured sample */
+}
+
+/**
+ * @brief     end a reference calibration run
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @note      a periodic calibration starts again after the period
+ */
+static void a_l3gd20h_reference_end(l3gd20h_handle_t *handle)
+{
+    handle->reference_state = 0;                                                      /* idle */
+    handle->reference_countdown = handle->reference_period;                           /* wait for the next run */
+    if (handle->reference_runs != 0xFFFFFFFFU)                                        /* not saturated */
     {
-        return 2;                                                                           /* return error */
+        handle->reference_runs++;                                                     /* one more run */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+}
+
+/**
+ * @brief     feed a compensated batch to the reference calibration
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] range full scale range bits
+ * @param[in] *offset pointer to the bias offset of the batch, NULL when the compensation is off
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] len sample length
+ * @return    1 when reference_next should be written, else 0
+ * @note      the register output is y = x - gain * reference on every axis, so only the mean of the
+ *            three axes is removed, the gain is learned with a secant step between two settings
+ */
+static uint8_t a_l3gd20h_reference_update(l3gd20h_handle_t *handle, uint8_t range, const int16_t *offset,
+                                          int16_t (*raw)[3], uint16_t len)
+{
+    const int16_t zero[3] = {0, 0, 0};
+    uint8_t i;
+    uint16_t n;
+    int64_t mean[3];
+    int32_t m;
+    int32_t a;
+    int32_t d;
+    int32_t g;
+    int32_t next;
+    
+    if (handle->reference_state == 0)                                                 /* idle */
+    {
+        if (handle->reference_period == 0)                                            /* runs once */
+        {
+            return 0;                                                                 /* nothing to do */
+        }
+        if (handle->reference_countdown > len)                                        /* period is not over */
+        {
+            handle->reference_countdown -= len;                                       /* count down */
+            
+            return 0;                                                                 /* wait */
+        }
+        a_l3gd20h_reference_start(handle, 0);                                         /* next run */
+        
+        return 0;                                                                     /* measure from the next batch */
+    }
+    if (handle->reference_state == 1)                                                 /* skipping */
     {
-        return 3;                                                                           /* return error */
+        if (handle->reference_skip > len)                                             /* batch is skipped */
+        {
+            handle->reference_skip = (uint16_t)(handle->reference_skip - len);        /* count down */
+            
+            return 0;                                                                 /* wait */
+        }
+        n = handle->reference_skip;                                                   /* samples to skip */
+        handle->reference_skip = 0;                                                   /* skip is over */
+        handle->reference_state = 2;                                                  /* measure */
+        a_l3gd20h_still_restart(&handle->reference_still);                            /* empty window */
+        handle->reference_n = 0;                                                      /* no measured sample */
+        raw += n;                                                                     /* skip the samples */
+        len = (uint16_t)(len - n);                                                    /* remaining samples */
     }
+    if (a_l3gd20h_still_add(&handle->reference_still, L3GD20H_REMAP(handle), range, raw, len, handle->bias_window) == 0)    /* window is open */
+    {
+        return 0;                                                                     /* wait */
+    }
+    n = handle->reference_still.n;                                                    /* samples of the window */
+    if (a_l3gd20h_still_close(handle, &handle->reference_still,
+                              (offset != NULL) ? offset : zero, mean) == 0)           /* not still */
+    {
+        return 0;                                                                     /* measure again */
+    }
+    if (handle->reference_n == 0)                                                     /* first window of a measurement */
+    {
+        memset(handle->reference_sum, 0, sizeof(handle->reference_sum));              /* clear the sums */
+    }
+    for (i = 0; i < 3; i++)                                                           /* each axis */
+    {
+        handle->reference_sum[i] += mean[i] * n;                                      /* add the window */
+    }
+    handle->reference_n += n;                                                         /* count the samples */
+    if (handle->reference_n < L3GD20H_REFERENCE_SAMPLES)                              /* too few samples */
+    {
+        return 0;                                                                     /* average the next window */
+    }
+    for (i = 0; i < 3; i++)                                                           /* each axis */
+    {
+        mean[i] = handle->reference_sum[i] / (int64_t)handle->reference_n;            /* average the windows */
+    }
+    handle->reference_n = 0;                                                          /* next measurement */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev1, 1);          /* read config */
-    if (res != 0)                                                                           /* check result */
+    m = (int32_t)((mean[0] + mean[1] + mean[2]) / 3);                                 /* common offset */
+    a = (m >= 0) ? m : -m;                                                            /* absolute offset */
+    if (a < handle->reference_best_mean)                                              /* best so far */
     {
-        handle->debug_print("l3gd20h: read ctrl1 failed.\n");                               /* read ctrl1 failed */
-        
-        return 1;                                                                           /* return error */
+        handle->reference_best = handle->reference_value;                             /* save the value */
+        handle->reference_best_mean = a;                                              /* save the offset */
+        for (i = 0; i < 3; i++)                                                       /* each axis */
+        {
+            handle->reference_residual[i] = (int32_t)mean[i];                         /* save the residual */
+        }
     }
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev2, 1);        /* read low odr */
-    if (res != 0)                                                                           /* check result */
+    if ((handle->reference_step != 0) && (handle->reference_value != handle->reference_prev))    /* two settings */
+    {
+        d = (m - handle->reference_mean) +
+            handle->reference_gain * (handle->reference_value - handle->reference_prev);    /* error of the predicted move */
+        if (handle->bias_windows != 0)                                                /* bias is valid */
+        {
+            for (i = 0; i < 3; i++)                                                   /* each axis */
+            {
+                handle->bias[i] += d;                                                 /* move the bias by the measured offset */
+            }
+        }
+        g = (handle->reference_mean - m) / (handle->reference_value - handle->reference_prev);   /* secant */
+        if (g > 0)                                                                    /* plausible */
+        {
+            handle->reference_gain = g;                                               /* learn the gain */
+        }
+    }
+    g = handle->reference_gain;                                                       /* get the gain */
+    next = handle->reference_value + ((m >= 0) ? ((m + g / 2) / g) : -((-m + g / 2) / g));    /* step to zero */
+    next = (next > 127) ? 127 : next;                                                 /* positive limit */
+    next = (next < -128) ? -128 : next;                                               /* negative limit */
+    if ((2 * a <= g) || (handle->reference_step >= L3GD20H_REFERENCE_ITERATIONS) ||
+        (next == handle->reference_value))                                            /* done */
     {
-        handle->debug_print("l3gd20h: read low odr failed.\n");                             /* read low odr failed */
+        a_l3gd20h_reference_end(handle);                                              /* end the run */
+        handle->reference_next = handle->reference_best;                              /* go to the best value */
         
-        return 1;                                                                           /* return error */
+        return (handle->reference_best != handle->reference_value) ? 1 : 0;          /* write when it moved */
     }
-    *rate_bandwidth = (l3gd20h_lodr_odr_bw_t)(((prev2 & 0x01) << 4) | (prev1 >> 4));        /* get rate and bandwidth */
+    handle->reference_prev = handle->reference_value;                                 /* save the value */
+    handle->reference_mean = m;                                                       /* save the offset */
+    handle->reference_step++;                                                         /* one more write */
+    handle->reference_next = (int8_t)next;                                            /* set the next value */
     
-    return 0;                                                                               /* success return 0 */
+    return 1;                                                                         /* write */
 }
 
 /**
- * @brief     enable or disable the edge trigger
+ * @brief     account a written reference value
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set edge trigger failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @note      the stored bias follows the device output, so it moves by the subtracted offset
  */
-uint8_t l3gd20h_set_edge_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+static void a_l3gd20h_reference_commit(l3gd20h_handle_t *handle)
 {
-    uint8_t res, prev;
+    uint8_t i;
+    int32_t d;
     
-    if (handle == NULL)                                                                   /* check handle */
+    d = handle->reference_gain * (handle->reference_next - handle->reference_value);  /* removed offset */
+    if (handle->bias_windows != 0)                                                    /* bias is valid */
     {
-        return 2;                                                                         /* return error */
+        for (i = 0; i < 3; i++)                                                       /* each axis */
+        {
+            handle->bias[i] -= d;                                                     /* move the bias */
+        }
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    a_l3gd20h_still_restart(&handle->bias_still);                                     /* the output moved */
+    handle->reference_value = handle->reference_next;                                 /* save the value */
+    if (handle->reference_state != 0)                                                 /* run goes on */
     {
-        return 3;                                                                         /* return error */
+        handle->reference_state = 1;                                                  /* skip */
+        handle->reference_skip = L3GD20H_REFERENCE_SKIP;                              /* skip the old setting */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+}
+
+/**
+ * @brief     check if a burst should carry the temperature
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    2 extra bytes from the temperature register, 0 when no read is due
+ * @note      none
+ */
+static uint8_t a_l3gd20h_bias_temp_due(l3gd20h_handle_t *handle)
+{
+    if ((handle->bias_mode == L3GD20H_BIAS_OFF) || ((handle->bias_temp_state & 0x01) == 0))    /* no model in use */
     {
-        handle->debug_print("l3gd20h: read ctrl2 failed.\n");                             /* read ctrl2 failed */
-        
-        return 1;                                                                         /* return error */
+        return 0;                                                                     /* no read */
     }
-    prev &= ~(1 << 7);                                                                    /* clear enable bit */
-    prev |= enable << 7;                                                                  /* set enable */
     
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);       /* write config */
+    return (handle->bias_temp_countdown == 0) ? 2 : 0;                                /* read when the interval is over */
 }
 
 /**
- * @brief      get the edge trigger status
- * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *enable pointer to a bool value buffer
- * @return     status code
- *             - 0 success
- *             - 1 get edge trigger failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     account a burst for the temperature model
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] *buf pointer to the burst data
+ * @param[in] skip extra bytes in front of the output data
+ * @param[in] len samples in the burst
+ * @note      the term is cached and only computed again when the temperature changes,
+ *            the new term applies from the next batch on
  */
-uint8_t l3gd20h_get_edge_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+static void a_l3gd20h_bias_temp_count(l3gd20h_handle_t *handle, const uint8_t *buf, uint8_t skip, uint16_t len)
 {
-    uint8_t res, prev;
+    uint8_t i;
+    int8_t v;
+    float x;
+    float term;
+    int8_t k;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (skip == 0)                                                                    /* no temperature */
     {
-        return 2;                                                                       /* return error */
+        handle->bias_temp_countdown = (handle->bias_temp_countdown > len) ?
+                                      (uint16_t)(handle->bias_temp_countdown - len) : 0;    /* count down */
+        
+        return;                                                                       /* done */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    
+    handle->bias_temp_countdown = L3GD20H_BIAS_TEMP_INTERVAL;                          /* restart the interval */
+    v = (int8_t)buf[0];                                                               /* get the temperature */
+    if (((handle->bias_temp_state & 0x02) != 0) && (v == handle->bias_temp_raw))      /* unchanged */
     {
-        return 3;                                                                       /* return error */
+        return;                                                                       /* keep the term */
     }
+    x = 25.0f - (float)v - handle->bias_tref;                                         /* distance to the reference */
+    for (i = 0; i < 3; i++)                                                           /* each axis */
+    {
+        term = 0.0f;                                                                  /* init 0 */
+        for (k = L3GD20H_BIAS_TEMP_ORDER; k >= 0; k--)                                /* horner */
+        {
+            term = term * x + handle->bias_coeff[i][k];                               /* next coefficient */
+        }
+        term = term * 1000.0f / 8.75f * (float)(1 << L3GD20H_BIAS_FRACTION_BITS);     /* convert to fractional lsb */
+        term = (term > (float)L3GD20H_BIAS_LIMIT) ? (float)L3GD20H_BIAS_LIMIT : term;      /* positive limit */
+        term = (term < -(float)L3GD20H_BIAS_LIMIT) ? -(float)L3GD20H_BIAS_LIMIT : term;    /* negative limit */
+        handle->bias_temp[i] = (int32_t)((term >= 0.0f) ? (term + 0.5f) : (term - 0.5f));  /* round the term */
+    }
+    handle->bias_temp_raw = v;                                                        /* save the temperature */
+    handle->bias_temp_state |= 0x02;                                                  /* temperature is read */
+    a_l3gd20h_still_restart(&handle->bias_still);                                     /* the offset moved */
+}
+#endif
+
+#if (L3GD20H_REMAP_ENABLE == 1)
+/**
+ * @brief      store one remapped axis
+ * @param[in]  *s pointer to the sensor axes of a sample
+ * @param[in]  remap sensor axis and sign
+ * @return     output axis
+ * @note       a negated -32768 saturates to 32767
+ */
+static inline int16_t a_l3gd20h_remap(const int16_t *s, uint8_t remap)
+{
+    int32_t v;
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    v = s[remap & 0x03];                                                              /* select the sensor axis */
+    if ((remap & 0x04) != 0)                                                          /* flip the sign */
     {
-        handle->debug_print("l3gd20h: read ctrl2 failed.\n");                           /* read ctrl2 failed */
-        
-        return 1;                                                                       /* return error */
+        v = (v == -32768) ? 32767 : -v;                                               /* negate and saturate */
     }
     
-    prev &= (1 << 7);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 7);                                              /* get bool */
-    
-    return 0;                                                                           /* success return 0 */
+    return (int16_t)v;                                                                /* return the axis */
 }
+#endif
 
 /**
- * @brief     enable or disable the level trigger
- * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set level trigger failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      decode the output register bytes
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  ble big little endian bit
+ * @param[in]  range full scale range bits
+ * @param[in]  *offset pointer to a bias offset buffer, NULL skips the compensation
+ * @param[in]  *remap pointer to the axis remap, NULL keeps the sensor frame
+ * @param[out] **raw pointer to a raw data buffer
+ * @param[out] **dps pointer to a converted data buffer, NULL skips the conversion
+ * @param[in]  len sample length
+ * @note       buf may alias raw, every sample is loaded before it is stored, the bias is removed in
+ *             the sensor frame before the axes are remapped
  */
-uint8_t l3gd20h_set_level_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+static void a_l3gd20h_decode(const uint8_t *buf, uint8_t ble, uint8_t range, const int16_t *offset,
+                             const uint8_t *remap, int16_t (*raw)[3], float (*dps)[3], uint16_t len)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
+    uint16_t i;
+    uint8_t b[6];
+    int16_t s[3];
+    float sensitivity;
+
+    if (range == 0)                                                                  /* ±245 dps */
     {
-        return 2;                                                                         /* return error */
+        sensitivity = 8.75f;                                                         /* 8.75 mdps/digit */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    else if (range == 1)                                                             /* ±500 dps */
     {
-        return 3;                                                                         /* return error */
+        sensitivity = 17.5f;                                                         /* 17.5 mdps/digit */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+    else                                                                             /* ±2000 dps */
     {
-        handle->debug_print("l3gd20h: read ctrl2 failed.\n");                             /* read ctrl2 failed */
-        
-        return 1;                                                                         /* return error */
+        sensitivity = 70.0f;                                                         /* 70 mdps/digit */
+    }
+    for (i = 0; i < len; i++)                                                        /* decode all samples */
+    {
+        memcpy(b, &buf[i * 6], 6);                                                   /* load the sample */
+        if (ble == 0)                                                                /* little endian */
+        {
+            s[0] = (int16_t)(((uint16_t)b[1] << 8) | b[0]);                          /* set x */
+            s[1] = (int16_t)(((uint16_t)b[3] << 8) | b[2]);                          /* set y */
+            s[2] = (int16_t)(((uint16_t)b[5] << 8) | b[4]);                          /* set z */
+        }
+        else                                                                         /* big endian */
+        {
+            s[0] = (int16_t)(((uint16_t)b[0] << 8) | b[1]);                          /* set x */
+            s[1] = (int16_t)(((uint16_t)b[2] << 8) | b[3]);                          /* set y */
+            s[2] = (int16_t)(((uint16_t)b[4] << 8) | b[5]);                          /* set z */
+        }
+#if (L3GD20H_BIAS_ENABLE == 1)
+        if (offset != NULL)                                                          /* remove the bias */
+        {
+            s[0] = a_l3gd20h_bias_sub(s[0], offset[0]);                              /* set x */
+            s[1] = a_l3gd20h_bias_sub(s[1], offset[1]);                              /* set y */
+            s[2] = a_l3gd20h_bias_sub(s[2], offset[2]);                              /* set z */
+        }
+#else
+        (void)offset;                                                                /* no bias */
+#endif
+#if (L3GD20H_REMAP_ENABLE == 1)
+        raw[i][0] = a_l3gd20h_remap(s, remap[0]);                                    /* set x */
+        raw[i][1] = a_l3gd20h_remap(s, remap[1]);                                    /* set y */
+        raw[i][2] = a_l3gd20h_remap(s, remap[2]);                                    /* set z */
+#else
+        (void)remap;                                                                 /* sensor frame */
+        raw[i][0] = s[0];                                                            /* set x */
+        raw[i][1] = s[1];                                                            /* set y */
+        raw[i][2] = s[2];                                                            /* set z */
+#endif
+        if (dps != NULL)                                                             /* convert the data */
+        {
+            dps[i][0] = (float)(raw[i][0]) * sensitivity / 1000.0f;                  /* set x */
+            dps[i][1] = (float)(raw[i][1]) * sensitivity / 1000.0f;                  /* set y */
+            dps[i][2] = (float)(raw[i][2]) * sensitivity / 1000.0f;                  /* set z */
+        }
     }
-    prev &= ~(1 << 6);                                                                    /* get bool */
-    prev |= enable << 6;                                                                  /* set enable */
-    
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);       /* write config */
 }
 
+#if ((L3GD20H_SETTLE_ENABLE == 1) || (L3GD20H_TIMESTAMP_ENABLE == 1) || (L3GD20H_BIAS_ENABLE == 1))
 /**
- * @brief      get the level trigger status
- * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *enable pointer to a bool value buffer
- * @return     status code
- *             - 0 success
- *             - 1 get level trigger failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief l3gd20h sample period table
+ * @note  indexed by bits 4:2 of l3gd20h_lodr_odr_bw_t, the low odr bit selects the last four entries
  */
-uint8_t l3gd20h_get_level_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+static const uint32_t gs_l3gd20h_period_ns[8] =
 {
-    uint8_t res, prev;
+    10000000, 5000000, 2500000, 1250000,
+    80000000, 40000000, 20000000, 0,
+};
+#endif
+
+#if (L3GD20H_BIAS_ENABLE == 1)
+/**
+ * @brief     get the still window of a rate
+ * @param[in] rate rate bandwidth
+ * @return    samples of a still window
+ * @note      the window spans L3GD20H_BIAS_WINDOW_MS and at least L3GD20H_BIAS_WINDOW_MIN samples,
+ *            so a still phase of the same length holds a window at every rate
+ */
+static uint16_t a_l3gd20h_bias_window(uint8_t rate)
+{
+    uint32_t period;
+    uint64_t n;
     
-    if (handle == NULL)                                                                   /* check handle */
+    period = gs_l3gd20h_period_ns[(rate >> 2) & 0x07];                                    /* get the period */
+    period = (period == 0) ? gs_l3gd20h_period_ns[6] : period;                            /* reserved rates run at 50 Hz */
+    n = ((uint64_t)L3GD20H_BIAS_WINDOW_MS * 1000000 + period - 1) / period;               /* convert to samples */
+    n = (n < L3GD20H_BIAS_WINDOW_MIN) ? L3GD20H_BIAS_WINDOW_MIN : n;                      /* fewest samples */
+    
+    return (uint16_t)((n > 0xFFFF) ? 0xFFFF : n);                                         /* return the window */
+}
+#endif
+
+#if (L3GD20H_SETTLE_ENABLE == 1)
+/**
+ * @brief l3gd20h low pass bandwidth table
+ * @note  indexed by l3gd20h_lodr_odr_bw_t in 0.1 Hz, 0 when the bandwidth is not given
+ */
+static const uint16_t gs_l3gd20h_bandwidth[32] =
+{
+    125, 250, 250, 250, 125, 0, 0, 700, 200, 250, 500, 1100, 300, 350, 0, 1000,
+    0, 0, 0, 0, 0, 0, 0, 0, 166, 166, 166, 166, 0, 0, 0, 0,
+};
+
+/**
+ * @brief l3gd20h high pass settling table
+ * @note  indexed by the high pass cut off frequency, three time constants in samples
+ *        for the odr to cut off ratios 12.5, 25, 50, 100, 200, 500, 1000, 2000, 5000 and 10000
+ */
+static const uint16_t gs_l3gd20h_hpf_settle[16] =
+{
+    6, 12, 24, 48, 96, 239, 478, 955, 2388, 4775, 4775, 4775, 4775, 4775, 4775, 4775,
+};
+
+/**
+ * @brief l3gd20h settle event enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_SETTLE_EVENT_TURN_ON = 0x00,        /**< power down to normal */
+    L3GD20H_SETTLE_EVENT_WAKE    = 0x01,        /**< sleep to normal */
+    L3GD20H_SETTLE_EVENT_RATE    = 0x02,        /**< output data rate or bandwidth change */
+    L3GD20H_SETTLE_EVENT_FILTER  = 0x03,        /**< high pass filter or output path change */
+} l3gd20h_settle_event_t;
+
+/**
+ * @brief     open a settling window after a reconfiguration
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] event reconfiguration event
+ * @return    status code
+ *            - 0 success
+ *            - 1 read config failed
+ * @note      nothing is read while the settling is off, a longer open window is kept, in the fifo modes the
+ *            window starts behind the samples queued at the call, in bypass mode it also ends on timestamp_us
+ */
+static uint8_t a_l3gd20h_settle(l3gd20h_handle_t *handle, l3gd20h_settle_event_t event)
+{
+    uint8_t ctrl[5];
+    uint8_t low;
+    uint8_t rate;
+    uint32_t period;
+    uint64_t ns;
+    uint32_t samples;
+    uint64_t until;
+#if (L3GD20H_FIFO_ENABLE == 1)
+    uint8_t fifo;
+    uint8_t src;
+    uint32_t start;
+    uint32_t end;
+#endif
+    
+    if (handle->settle_mode == L3GD20H_SETTLE_OFF)                                                    /* settling is off */
+    {
+        return 0;                                                                                     /* success return 0 */
+    }
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)ctrl, 5) != 0)                   /* read ctrl1 - ctrl5 */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read ctrl failed.\n");                                        /* read ctrl failed */
+        
+        return 1;                                                                                     /* return error */
+    }
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&low, 1) != 0)                 /* read low odr */
     {
-        return 2;                                                                         /* return error */
+        L3GD20H_PRINT(handle, "l3gd20h: read low odr failed.\n");                                     /* read low odr failed */
+        
+        return 1;                                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    rate = (uint8_t)(((low & 0x01) << 4) | (ctrl[0] >> 4));                                           /* get the rate bandwidth */
+    period = gs_l3gd20h_period_ns[(rate >> 2) & 0x07];                                                /* get the period */
+    period = (period == 0) ? gs_l3gd20h_period_ns[6] : period;                                        /* reserved rates run at 50 Hz */
+    ns = 0;                                                                                           /* init 0 */
+    if (gs_l3gd20h_bandwidth[rate] != 0)                                                              /* bandwidth is given */
     {
-        return 3;                                                                         /* return error */
+        ns = 4774648293ULL / gs_l3gd20h_bandwidth[rate];                                              /* three low pass time constants */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+    if (event == L3GD20H_SETTLE_EVENT_TURN_ON)                                                        /* wake from power down */
+    {
+        ns += (uint64_t)L3GD20H_SETTLE_TURN_ON_MS * 1000000;                                          /* add the turn on time */
+    }
+    samples = (uint32_t)((ns + period - 1) / period);                                                 /* convert to samples */
+    samples = (samples < L3GD20H_SETTLE_MIN_SAMPLES) ? L3GD20H_SETTLE_MIN_SAMPLES : samples;          /* restart of the filter chain */
+    if (((ctrl[4] & (1 << 4)) != 0) && ((ctrl[4] & 0x03) != 0) &&
+        (gs_l3gd20h_hpf_settle[ctrl[1] & 0x0F] > samples))                                            /* high pass filter is slower */
     {
-        handle->debug_print("l3gd20h: read ctrl2 failed.\n");                             /* read ctrl2 failed */
+        samples = gs_l3gd20h_hpf_settle[ctrl[1] & 0x0F];                                              /* wait for the high pass filter */
+    }
+    handle->settle_period_ns = period;                                                                /* save the period */
+#if (L3GD20H_FIFO_ENABLE == 1)
+    fifo = 0;                                                                                         /* bypass mode */
+    if ((ctrl[4] & (1 << 6)) != 0)                                                                    /* fifo is enabled */
+    {
+        if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_CTRL, (uint8_t *)&fifo, 1) != 0)          /* read fifo ctrl */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: read fifo ctrl failed.\n");                               /* read fifo ctrl failed */
+            
+            return 1;                                                                                 /* return error */
+        }
+        fifo = fifo >> 5;                                                                             /* get the mode */
+    }
+    if (fifo != 0)                                                                                    /* fifo modes */
+    {
+        if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_SRC, (uint8_t *)&src, 1) != 0)            /* read fifo source */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: read fifo source failed.\n");                             /* read fifo source failed */
+            
+            return 1;                                                                                 /* return error */
+        }
+        start = src & 0x1F;                                                                           /* samples queued before the change */
+        if (start != 0)                                                                               /* the last one may follow the write */
+        {
+            start--;                                                                                  /* count it to the window */
+            samples++;                                                                                /* one more settling sample */
+        }
+        end = start + samples;                                                                        /* end of the window */
+        if (handle->settle != 0)                                                                      /* a window is open */
+        {
+            end = (handle->settle_queued + handle->settle > end) ?
+                  (handle->settle_queued + handle->settle) : end;                                     /* keep the later end */
+            start = (handle->settle_queued < start) ? handle->settle_queued : start;                  /* keep the earlier start */
+        }
+        handle->settle_queued = (uint8_t)start;                                                       /* deliver the queued samples first */
+        handle->settle = end - start;                                                                 /* open the window */
+        handle->settle_until_us = 0;                                                                  /* counted in samples */
         
-        return 1;                                                                         /* return error */
+        return 0;                                                                                     /* success return 0 */
+    }
+#endif
+    if (handle->timestamp_us != NULL)                                                                 /* bypass reads the newest sample */
+    {
+        until = handle->timestamp_us() + ((uint64_t)(samples + 1) * period + 999) / 1000;             /* the next sample may come a period late */
+        handle->settle_until_us = ((handle->settle != 0) && (handle->settle_until_us > until)) ?
+                                  handle->settle_until_us : until;                                    /* keep the later end */
     }
-    prev &= (1 << 6);                                                                     /* get enable */
-    *enable = (l3gd20h_bool_t)(prev >> 6);                                                /* get bool */
+    handle->settle = (samples > handle->settle) ? samples : handle->settle;                           /* open the window */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                         /* success return 0 */
 }
 
 /**
- * @brief     set the high pass filter mode
- * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] mode high pass filter mode
- * @return    status code
- *            - 0 success
- *            - 1 set high pass filter mode failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief          apply the settling window to a decoded batch
+ * @param[in]      *handle pointer to an l3gd20h handle structure
+ * @param[in]      fifo fifo mode flag
+ * @param[in, out] **raw pointer to a raw data buffer
+ * @param[in, out] **dps pointer to a converted data buffer, may be NULL
+ * @param[in, out] *len pointer to a length buffer
+ * @param[in, out] *level pointer to a fifo level buffer, NULL when no timestamp is taken
+ * @note           the fifo reads are capped at the queued samples, so a batch holds either samples from before
+ *                 the change or the window at its front, dropped samples are removed from the front so the
+ *                 remaining samples keep their order, a bypass read counts the periods left on timestamp_us
  */
-uint8_t l3gd20h_set_high_pass_filter_mode(l3gd20h_handle_t *handle, l3gd20h_high_pass_filter_mode_t mode)
+static void a_l3gd20h_settle_apply(l3gd20h_handle_t *handle, uint8_t fifo, int16_t (*raw)[3], float (*dps)[3],
+                                   uint16_t *len, uint8_t *level)
 {
-    uint8_t res, prev;
+    uint16_t n;
+    uint64_t now;
     
-    if (handle == NULL)                                                                   /* check handle */
+    handle->settle_dropped = 0;                                                                      /* nothing dropped */
+    if (handle->settle_queued != 0)                                                                  /* samples from before the change */
     {
-        return 2;                                                                         /* return error */
+        n = (handle->settle_queued < (*len)) ? handle->settle_queued : (*len);                       /* queued samples in the batch */
+        handle->settle_queued = (uint8_t)(handle->settle_queued - n);                                /* deliver them */
+        handle->settle_tagged = 0;                                                                   /* nothing tagged */
+        
+        return;                                                                                      /* done */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if ((fifo == 0) && (handle->settle != 0) && (handle->settle_until_us != 0) &&
+        (handle->timestamp_us != NULL))                                                              /* bypass reads the newest sample */
     {
-        return 3;                                                                         /* return error */
+        now = handle->timestamp_us();                                                                /* get the time */
+        handle->settle = (now >= handle->settle_until_us) ? 0 :
+                         (uint32_t)(((handle->settle_until_us - now) * 1000 + handle->settle_period_ns - 1) /
+                                    handle->settle_period_ns);                                       /* periods left */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+    n = (handle->settle < (*len)) ? (uint16_t)handle->settle : (*len);                               /* settling samples in the batch */
+    if (handle->settle_mode == L3GD20H_SETTLE_DROP)                                                  /* drop them */
     {
-        handle->debug_print("l3gd20h: read ctrl2 failed.\n");                             /* read ctrl2 failed */
-        
-        return 1;                                                                         /* return error */
+        if ((n != 0) && (n != (*len)))                                                               /* keep the tail */
+        {
+            memmove(raw, raw + n, sizeof(raw[0]) * ((*len) - n));                                    /* move the raw data */
+            if (dps != NULL)                                                                         /* converted data wanted */
+            {
+                memmove(dps, dps + n, sizeof(dps[0]) * ((*len) - n));                                /* move the converted data */
+            }
+        }
+        *len -= n;                                                                                   /* shorten the batch */
+        if (level != NULL)                                                                           /* timestamp wanted */
+        {
+            *level = (uint8_t)((*level) - n);                                                        /* keep the anchor on the same sample */
+        }
+        handle->settle_dropped = n;                                                                  /* save the count */
+        handle->settle_tagged = 0;                                                                   /* nothing tagged */
     }
-    prev &= ~(3 << 4);                                                                    /* clear the mode */
-    prev |= mode << 4;                                                                    /* set the mode */
-    
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);       /* write config */
+    else if (handle->settle_mode == L3GD20H_SETTLE_TAG)                                              /* tag them */
+    {
+        handle->settle_tagged = n;                                                                   /* save the count */
+    }
+    else                                                                                             /* deliver them */
+    {
+        n = 0;                                                                                       /* no window */
+        handle->settle_tagged = 0;                                                                   /* nothing tagged */
+    }
+    handle->settle -= n;                                                                             /* close the window */
 }
+#endif
 
+#if (L3GD20H_RANGE_ENABLE == 1)
 /**
- * @brief      get the high pass filter mode
+ * @brief l3gd20h auto ranging table
+ * @note  indexed by the full scale bits, half of the lower full scale in lsb of the range, 0 at the lowest range
+ */
+static const uint16_t gs_l3gd20h_range_low[4] =
+{
+    0, 8192, 4096, 4096,
+};
+#endif
+
+/**
+ * @brief      decode a batch that may start with samples of the previous full scale
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *mode pointer to a high pass filter mode buffer
- * @return     status code
- *             - 0 success
- *             - 1 get high pass filter mode failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  ble big little endian bit
+ * @param[in]  range full scale range bits of the chip
+ * @param[out] *offset pointer to a bias offset buffer of the range
+ * @param[out] **raw pointer to a raw data buffer
+ * @param[out] **dps pointer to a converted data buffer, NULL skips the conversion
+ * @param[in]  len sample length
+ * @return     bias offset of the range, NULL when the compensation is off
+ * @note       buf may alias raw, the samples queued at the last switch come first and are decoded with
+ *             the previous full scale, the split is kept for l3gd20h_get_range_tag
  */
-uint8_t l3gd20h_get_high_pass_filter_mode(l3gd20h_handle_t *handle, l3gd20h_high_pass_filter_mode_t *mode)
+static const int16_t *a_l3gd20h_range_decode(l3gd20h_handle_t *handle, const uint8_t *buf, uint8_t ble, uint8_t range,
+                                             int16_t offset[3], int16_t (*raw)[3], float (*dps)[3], uint16_t len)
 {
-    uint8_t res, prev;
+    int16_t prev[3];
+    const int16_t *off;
+    uint16_t n;
+    
+#if (L3GD20H_RANGE_ENABLE == 1)
+    n = (handle->range_pending < len) ? handle->range_pending : len;                                 /* samples of the previous range */
+    if (n != 0)                                                                                      /* batch starts with old samples */
+    {
+#if (L3GD20H_BIAS_ENABLE == 1)
+        off = a_l3gd20h_bias_offset(handle, handle->range_prev, prev);                               /* get the old bias offset */
+#else
+        off = NULL;                                                                                  /* no bias */
+#endif
+        a_l3gd20h_decode(buf, ble, handle->range_prev, off, L3GD20H_REMAP(handle), raw, dps, n);             /* decode the old samples */
+    }
+#else
+    (void)handle;                                                                                    /* one full scale */
+    (void)prev;                                                                                      /* one full scale */
+    n = 0;                                                                                           /* no old sample */
+#endif
+#if (L3GD20H_BIAS_ENABLE == 1)
+    off = a_l3gd20h_bias_offset(handle, range, offset);                                              /* get the bias offset */
+#else
+    (void)prev;                                                                                      /* no bias */
+    (void)offset;                                                                                    /* no bias */
+    off = NULL;                                                                                      /* no bias */
+#endif
+    a_l3gd20h_decode(buf + 6 * n, ble, range, off, L3GD20H_REMAP(handle), raw + n,
+                     (dps != NULL) ? (dps + n) : NULL, (uint16_t)(len - n));                         /* decode the new samples */
+#if (L3GD20H_RANGE_ENABLE == 1)
+    handle->range_pending = (uint8_t)(handle->range_pending - n);                                    /* old samples left in the fifo */
+    handle->range_split = n;                                                                         /* save the split */
+    handle->range_head = (n != 0) ? handle->range_prev : range;                                      /* range of the head */
+    handle->range_tail = range;                                                                      /* range of the tail */
+#endif
+    
+    return off;                                                                                      /* return the offset */
+}
+
+#if (L3GD20H_RANGE_ENABLE == 1)
+/**
+ * @brief     switch the full scale after a batch
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] ctrl4 ctrl4 value of the batch
+ * @param[in] fifo fifo mode flag
+ * @param[in] **raw pointer to the samples of the current full scale
+ * @param[in] len sample length
+ * @note      the fifo level is read before and after ctrl4 is written and the larger one keeps the old
+ *            full scale, so a sample captured between the two transfers is not decoded with the new one,
+ *            in bypass mode the output registers keep a sample of the old full scale until the next one,
+ *            the status read after the write picks the bit that tells the next read a new sample is there,
+ *            no switch is made while old samples are queued, a failed switch keeps the range
+ */
+static void a_l3gd20h_range_update(l3gd20h_handle_t *handle, uint8_t ctrl4, uint8_t fifo,
+                                   int16_t (*raw)[3], uint16_t len)
+{
+    uint8_t range;
+    uint8_t next;
+    uint8_t src;
+    uint8_t after;
+    uint16_t i;
+    uint8_t j;
+    int32_t v;
+    int32_t peak;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if ((handle->range_auto == 0) || (handle->range_pending != 0) || (len == 0))                     /* no switch now */
     {
-        return 2;                                                                         /* return error */
+        return;                                                                                      /* nothing to do */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+#if (L3GD20H_BIAS_ENABLE == 1)
+    if (handle->reference_state != 0)                                                                /* reference calibration runs */
     {
-        return 3;                                                                         /* return error */
+        return;                                                                                      /* keep the range */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+#endif
+    range = (ctrl4 >> 4) & 0x03;                                                                     /* get the range */
+    peak = 0;                                                                                        /* init 0 */
+    for (i = 0; i < len; i++)                                                                        /* each sample */
+    {
+        for (j = 0; j < 3; j++)                                                                      /* each axis */
+        {
+            v = (raw[i][j] >= 0) ? raw[i][j] : -(int32_t)raw[i][j];                                  /* absolute value */
+            peak = (v > peak) ? v : peak;                                                            /* keep the peak */
+        }
+    }
+    if ((peak >= L3GD20H_RANGE_HIGH) && (range < 2))                                                 /* near saturation */
+    {
+        next = (uint8_t)(range + 1);                                                                 /* one step up */
+    }
+    else if (peak < gs_l3gd20h_range_low[range])                                                     /* fits the lower range */
+    {
+        handle->range_quiet += len;                                                                  /* count the quiet samples */
+        if (handle->range_quiet < L3GD20H_RANGE_HOLD)                                                /* not long enough */
+        {
+            return;                                                                                  /* wait */
+        }
+        next = (range >= 2) ? 1 : 0;                                                                 /* one step down */
+    }
+    else
     {
-        handle->debug_print("l3gd20h: read ctrl2 failed.\n");                             /* read ctrl2 failed */
+        handle->range_quiet = 0;                                                                     /* restart the count */
         
-        return 1;                                                                         /* return error */
+        return;                                                                                      /* keep the range */
     }
-    prev &= (3 << 4);                                                                     /* get the mode bits */
-    *mode = (l3gd20h_high_pass_filter_mode_t)(prev >> 4);                                 /* get the mode */
     
-    return 0;                                                                             /* success return 0 */
+    src = 0;                                                                                         /* nothing queued */
+    if (fifo != 0)                                                                                   /* fifo modes */
+    {
+        if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_SRC, (uint8_t *)&src, 1) != 0)           /* read fifo source */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: read fifo source failed.\n");                            /* read fifo source failed */
+            
+            return;                                                                                  /* keep the range */
+        }
+    }
+    ctrl4 = (uint8_t)((ctrl4 & ~(3 << 4)) | (next << 4));                                            /* set the range */
+    if (a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL4, (uint8_t *)&ctrl4, 1) != 0)               /* write ctrl4 */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write ctrl4 failed.\n");                                     /* write ctrl4 failed */
+        
+        return;                                                                                      /* keep the range */
+    }
+    if (fifo != 0)                                                                                   /* fifo modes */
+    {
+        if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_SRC, (uint8_t *)&after, 1) != 0)         /* read fifo source again */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: read fifo source failed.\n");                            /* read fifo source failed */
+            
+            after = src;                                                                             /* keep the first level */
+        }
+        src = ((after & 0x1F) > (src & 0x1F)) ? after : src;                                         /* take the larger level */
+        handle->range_status = 0;                                                                    /* the level counts */
+    }
+    else
+    {
+        if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_STATUS, (uint8_t *)&after, 1) != 0)          /* read status */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: read status failed.\n");                                 /* read status failed */
+            handle->range_status = 0;                                                                /* keep the old range once */
+        }
+        else
+        {
+            handle->range_status = ((after & (1 << 3)) != 0) ? (1 << 7) : (1 << 3);                  /* overrun after a queued sample */
+        }
+        src = 1;                                                                                     /* the output registers */
+    }
+    handle->range_prev = range;                                                                      /* save the old range */
+    handle->range_pending = src & 0x1F;                                                              /* old samples in the chip */
+    handle->range_quiet = 0;                                                                         /* restart the count */
 }
+#endif
 
 /**
- * @brief     set the high pass filter cut off frequency
+ * @brief     set the chip interface
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] frequency high pass filter cut off frequency
+ * @param[in] interface chip interface
  * @return    status code
  *            - 0 success
- *            - 1 set high pass filter cut off frequency failed
  *            - 2 handle is NULL
- *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_high_pass_filter_cut_off_frequency(l3gd20h_handle_t *handle, l3gd20h_high_pass_filter_cut_off_frequency_t frequency)
+uint8_t l3gd20h_set_interface(l3gd20h_handle_t *handle, l3gd20h_interface_t interface)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle == NULL)                          /* check handle */
     {
-        return 3;                                                                         /* return error */
+        return 2;                                /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl2 failed.\n");                             /* read ctrl2 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(0x0F);                                                                      /* clear the cut-off frequency */
-    prev |= frequency;                                                                    /* set the frequency */
+    handle->iic_spi = (uint8_t)interface;        /* set the interface */
     
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);       /* write config */
+    return 0;                                    /* success return 0 */
 }
 
 /**
- * @brief      get the high pass filter cut off frequency
+ * @brief      get the chip interface
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *frequency pointer to a high pass filter cut off frequency buffer
+ * @param[out] *interface pointer to a chip interface buffer
  * @return     status code
  *             - 0 success
- *             - 1 get high pass filter cut off frequency failed
  *             - 2 handle is NULL
- *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_high_pass_filter_cut_off_frequency(l3gd20h_handle_t *handle, l3gd20h_high_pass_filter_cut_off_frequency_t *frequency)
+uint8_t l3gd20h_get_interface(l3gd20h_handle_t *handle, l3gd20h_interface_t *interface)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle == NULL)                                         /* check handle */
     {
-        return 3;                                                                         /* return error */
+        return 2;                                               /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL2, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl2 failed.\n");                             /* read ctrl2 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= 0x0F;                                                                         /* get the cut-off frequency */
-    *frequency = (l3gd20h_high_pass_filter_cut_off_frequency_t)(prev >> 0);               /* get the frequency */
+    *interface = (l3gd20h_interface_t)(handle->iic_spi);        /* get the interface */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                   /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the interrupt1
+ * @brief     set the iic address pin
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] enable bool value
+ * @param[in] addr_pin address pin
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt1 failed
  *            - 2 handle is NULL
- *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_addr_pin(l3gd20h_handle_t *handle, l3gd20h_address_t addr_pin)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle == NULL)                          /* check handle */
     {
-        return 3;                                                                         /* return error */
+        return 2;                                /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                             /* read ctrl3 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 7);                                                                    /* clear enable */
-    prev |= enable << 7;                                                                  /* set enable */
+    handle->iic_addr = (uint8_t)addr_pin;        /* set the iic address */
     
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* write config */
+    return 0;                                    /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt1 status
+ * @brief      get the iic address pin
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *addr_pin pointer to an address pin buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt1 failed
  *             - 2 handle is NULL
- *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_addr_pin(l3gd20h_handle_t *handle, l3gd20h_address_t *addr_pin)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle == NULL)                                       /* check handle */
     {
-        return 3;                                                                       /* return error */
+        return 2;                                             /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                           /* read ctrl3 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (1 << 7);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 7);                                              /* get bool */
+    *addr_pin = (l3gd20h_address_t)(handle->iic_addr);        /* get the iic address */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                 /* success return 0 */
 }
 
 /**
- * @brief     enable or disable boot on the interrupt1
+ * @brief     set the chip mode
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] enable bool value
+ * @param[in] mode chip mode
  * @return    status code
  *            - 0 success
- *            - 1 set boot on interrupt1 failed
+ *            - 1 set mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_boot_on_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_mode(l3gd20h_handle_t *handle, l3gd20h_mode_t mode)
 {
-    uint8_t res, prev;
+    uint8_t res, prev, awake;
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    l3gd20h_settle_event_t event;
+#endif
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);             /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                             /* read ctrl3 failed */
+        L3GD20H_PRINT(handle, "l3gd20h: read ctrl1 failed.\n");                               /* read ctrl1 failed */
         
-        return 1;                                                                         /* return error */
+        return 1;                                                                             /* return error */
+    }
+    if (mode == L3GD20H_MODE_SLEEP)                                                           /* if sleep mode */
+    {
+        prev |= (1 << 3);                                                                     /* set pd */
+        prev &= ~(0x07);                                                                      /* clear config */
+        
+        return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);       /* write config */
+    }
+    else
+    {
+#if (L3GD20H_SETTLE_ENABLE == 1)
+        event = ((prev & (1 << 3)) == 0) ? L3GD20H_SETTLE_EVENT_TURN_ON : L3GD20H_SETTLE_EVENT_WAKE;    /* get the wake event */
+#endif
+        awake = (uint8_t)(((prev & (1 << 3)) != 0) && ((prev & 0x07) != 0));                      /* already in normal mode */
+        prev &= ~(1 << 3);                                                                    /* clear pd */
+        prev |= (mode << 3);                                                                  /* set mode */
+        prev |= 0x07;                                                                         /* set x,y,z enable */
+        if (a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1) != 0)     /* write config */
+        {
+            return 1;                                                                         /* return error */
+        }
+        if ((mode != L3GD20H_MODE_NORMAL) || (awake != 0))                                    /* no wake */
+        {
+            return 0;                                                                         /* success return 0 */
+        }
+        
+#if (L3GD20H_SETTLE_ENABLE == 1)
+        return a_l3gd20h_settle(handle, event);                                               /* open the settling window */
+#else
+        return 0;                                                                             /* success return 0 */
+#endif
     }
-    prev &= ~(1 << 6);                                                                    /* clear enable bit */
-    prev |= enable << 6;                                                                  /* set enable */
-    
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* write config */
 }
 
 /**
- * @brief      get the boot on the interrupt1 status
+ * @brief      get the chip mode
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *mode pointer to a chip mode buffer
  * @return     status code
  *             - 0 success
- *             - 1 get boot on interrupt1 failed
+ *             - 1 get mode failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_boot_on_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_mode(l3gd20h_handle_t *handle, l3gd20h_mode_t *mode)
 {
     uint8_t res, prev;
     
@@ -965,71 +1903,85 @@ uint8_t l3gd20h_get_boot_on_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t
         return 3;                                                                       /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* read config */
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);       /* read config */
     if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                           /* read ctrl3 failed */
+        L3GD20H_PRINT(handle, "l3gd20h: read ctrl1 failed.\n");                         /* read ctrl1 failed */
         
         return 1;                                                                       /* return error */
     }
-    prev &= (1 << 6);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 6);                                              /* get bool */
+    if ((prev & 0x07) != 0)                                                             /* if x,y,z valid */
+    {
+        prev &= 1 << 3;                                                                 /* set pd */
+        *mode  = (l3gd20h_mode_t)((prev >> 3) & 0x01);                                  /* normal or power down mode */
+    }
+    else
+    {
+        if ((prev & (1 << 3)) != 0)                                                     /* if pd == 1 */
+        {
+            *mode = L3GD20H_MODE_SLEEP;                                                 /* sleep mode*/
+        }
+        else
+        {
+            prev &= 1 << 3;                                                             /* set pd */
+            *mode  = (l3gd20h_mode_t)((prev >> 3) & 0x01);                              /* set power down mode */
+        }
+    }
     
     return 0;                                                                           /* success return 0 */
 }
 
+#if (L3GD20H_SETTLE_ENABLE == 1)
 /**
- * @brief     set the interrupt active level
+ * @brief     set the settling sample handling
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] level interrupt active level
+ * @param[in] settle settling sample handling
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt active level failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 settle is invalid
+ * @note      the window is opened by the next wake, rate or filter change
  */
-uint8_t l3gd20h_set_interrupt_active_level(l3gd20h_handle_t *handle, l3gd20h_interrupt_active_level_t level)
+uint8_t l3gd20h_set_settle(l3gd20h_handle_t *handle, l3gd20h_settle_t settle)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                       /* return error */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+    if (settle > L3GD20H_SETTLE_TAG)                                                    /* check settle */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                             /* read ctrl3 failed */
+        L3GD20H_PRINT(handle, "l3gd20h: settle is invalid.\n");                         /* settle is invalid */
         
-        return 1;                                                                         /* return error */
+        return 4;                                                                       /* return error */
     }
-    prev &= ~(1 << 5);                                                                    /* clear level bit */
-    prev |= level << 5;                                                                   /* set level bit */
     
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* write config */
+    handle->settle_mode = (uint8_t)settle;                                              /* set the mode */
+    handle->settle = 0;                                                                 /* close the window */
+    handle->settle_tagged = 0;                                                          /* nothing tagged */
+    handle->settle_dropped = 0;                                                         /* nothing dropped */
+    handle->settle_queued = 0;                                                          /* nothing queued */
+    handle->settle_until_us = 0;                                                        /* no deadline */
+    
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt active level
+ * @brief      get the settling sample handling
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *level pointer to an interrupt active level buffer
+ * @param[out] *settle pointer to a settling sample handling buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt active level failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_interrupt_active_level(l3gd20h_handle_t *handle, l3gd20h_interrupt_active_level_t *level)
+uint8_t l3gd20h_get_settle(l3gd20h_handle_t *handle, l3gd20h_settle_t *settle)
 {
-    uint8_t res, prev;
-    
     if (handle == NULL)                                                                 /* check handle */
     {
         return 2;                                                                       /* return error */
@@ -1039,71 +1991,98 @@ uint8_t l3gd20h_get_interrupt_active_level(l3gd20h_handle_t *handle, l3gd20h_int
         return 3;                                                                       /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    *settle = (l3gd20h_settle_t)(handle->settle_mode);                                  /* get the mode */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the settling window state
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *remaining pointer to a remaining samples buffer
+ * @param[out] *tagged pointer to a tagged samples buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       tagged is the number of settling samples at the start of the last read,
+ *             it is only set in tag mode
+ */
+uint8_t l3gd20h_get_settling(l3gd20h_handle_t *handle, uint32_t *remaining, uint16_t *tagged)
+{
+    if (handle == NULL)                                                                 /* check handle */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                           /* read ctrl3 failed */
-        
-        return 1;                                                                       /* return error */
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
     }
-    prev &= (1 << 5);                                                                   /* get the level bit */
-    *level = (l3gd20h_interrupt_active_level_t)(prev >> 5);                             /* get the level */
+    
+    *remaining = handle->settle;                                                        /* get the remaining samples */
+    *tagged = handle->settle_tagged;                                                    /* get the tagged samples */
     
     return 0;                                                                           /* success return 0 */
 }
+#endif
 
+#if (L3GD20H_REMAP_ENABLE == 1)
 /**
- * @brief     set the interrupt pin type
+ * @brief     set the axis remap
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] pin_type interrupt pin type
+ * @param[in] x sensor axis of the output x
+ * @param[in] y sensor axis of the output y
+ * @param[in] z sensor axis of the output z
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt pin type failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 remap is invalid
+ * @note      the remap is applied while the output registers are decoded, so it costs nothing per
+ *            sample, every sensor axis must be used once, the bias, the temperature model and the
+ *            reference calibration stay in the sensor frame
  */
-uint8_t l3gd20h_set_interrupt_pin_type(l3gd20h_handle_t *handle, l3gd20h_pin_type_t pin_type)
+uint8_t l3gd20h_set_axis_remap(l3gd20h_handle_t *handle, l3gd20h_remap_t x, l3gd20h_remap_t y, l3gd20h_remap_t z)
 {
-    uint8_t res, prev;
+    uint8_t used;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                       /* return error */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+    used = (uint8_t)((1 << (x & 0x03)) | (1 << (y & 0x03)) | (1 << (z & 0x03)));        /* get the used axes */
+    if ((((x | y | z) & ~0x07) != 0) || (used != 0x07))                                 /* check the remap */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                             /* read ctrl3 failed */
+        L3GD20H_PRINT(handle, "l3gd20h: remap is invalid.\n");                          /* remap is invalid */
         
-        return 1;                                                                         /* return error */
+        return 4;                                                                       /* return error */
     }
-    prev &= ~(1 << 4);                                                                    /* clear pin type bit */
-    prev |= pin_type << 4;                                                                /* set pin type */
     
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* write config */
+    handle->remap[0] = (uint8_t)x;                                                      /* set x */
+    handle->remap[1] = (uint8_t)y;                                                      /* set y */
+    handle->remap[2] = (uint8_t)z;                                                      /* set z */
+    
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt pin type
+ * @brief      get the axis remap
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *pin_type pointer to an interrupt pin type buffer
+ * @param[out] *x pointer to a sensor axis buffer of the output x
+ * @param[out] *y pointer to a sensor axis buffer of the output y
+ * @param[out] *z pointer to a sensor axis buffer of the output z
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt pin type failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_interrupt_pin_type(l3gd20h_handle_t *handle, l3gd20h_pin_type_t *pin_type)
+uint8_t l3gd20h_get_axis_remap(l3gd20h_handle_t *handle, l3gd20h_remap_t *x, l3gd20h_remap_t *y, l3gd20h_remap_t *z)
 {
-    uint8_t res, prev;
-    
     if (handle == NULL)                                                                 /* check handle */
     {
         return 2;                                                                       /* return error */
@@ -1113,71 +2092,58 @@ uint8_t l3gd20h_get_interrupt_pin_type(l3gd20h_handle_t *handle, l3gd20h_pin_typ
         return 3;                                                                       /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                           /* read ctrl3 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (1 << 4);                                                                   /* get pin type bit */
-    *pin_type = (l3gd20h_pin_type_t)(prev >> 4);                                        /* get pin type */
+    *x = (l3gd20h_remap_t)(handle->remap[0]);                                           /* get x */
+    *y = (l3gd20h_remap_t)(handle->remap[1]);                                           /* get y */
+    *z = (l3gd20h_remap_t)(handle->remap[2]);                                           /* get z */
     
     return 0;                                                                           /* success return 0 */
 }
+#endif
 
+#if (L3GD20H_RANGE_ENABLE == 1)
 /**
- * @brief     enable or disable the data ready on interrupt2
+ * @brief     enable or disable the auto ranging
  * @param[in] *handle pointer to an l3gd20h handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set data ready on interrupt2 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the full scale is switched by l3gd20h_read and l3gd20h_read_timestamp after a batch is
+ *            decoded, the samples still queued in the fifo at the switch are decoded with the old full
+ *            scale, the fifo level is read before and after the switch and the larger one counts, so a
+ *            sample captured right after the switch may be decoded with the old full scale, the switch
+ *            pauses while a reference calibration runs, the interrupt thresholds are not rescaled
  */
-uint8_t l3gd20h_set_data_ready_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_auto_range(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                             /* read ctrl3 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 3);                                                                    /* set data ready bit */
-    prev |= enable << 3;                                                                  /* set data ready */
+    handle->range_auto = (uint8_t)enable;                                               /* set the flag */
+    handle->range_quiet = 0;                                                            /* restart the count */
     
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* write config */
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get the data ready on interrupt2 status
+ * @brief      get the auto ranging status
  * @param[in]  *handle pointer to an l3gd20h handle structure
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get data ready on interrupt2 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_data_ready_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_auto_range(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
-    
     if (handle == NULL)                                                                 /* check handle */
     {
         return 2;                                                                       /* return error */
@@ -1187,105 +2153,138 @@ uint8_t l3gd20h_get_data_ready_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_b
         return 3;                                                                       /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    *enable = (l3gd20h_bool_t)(handle->range_auto);                                     /* get the flag */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the full scale tags of the last read
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *split pointer to a sample number buffer
+ * @param[out] *head pointer to a full scale buffer of the first split samples
+ * @param[out] *tail pointer to a full scale buffer of the other samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the raw data of a read keeps the lsb it was captured at, so the first split samples use
+ *             the sensitivity of head and the others the sensitivity of tail, the converted data is
+ *             already scaled per sample
+ */
+uint8_t l3gd20h_get_range_tag(l3gd20h_handle_t *handle, uint16_t *split, l3gd20h_full_scale_t *head,
+                              l3gd20h_full_scale_t *tail)
+{
+    if (handle == NULL)                                                                 /* check handle */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                           /* read ctrl3 failed */
-        
-        return 1;                                                                       /* return error */
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
     }
-    prev &= (1 << 3);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 3);                                              /* get bool */
+    
+    *split = handle->range_split;                                                       /* get the split */
+    *head = (l3gd20h_full_scale_t)((handle->range_head >= 2) ? 2 : handle->range_head); /* get the head range */
+    *tail = (l3gd20h_full_scale_t)((handle->range_tail >= 2) ? 2 : handle->range_tail); /* get the tail range */
     
     return 0;                                                                           /* success return 0 */
 }
+#endif
 
 /**
- * @brief     enable or disable the fifo threshold on interrupt2
+ * @brief     set the axis
  * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] axis set axis
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set fifo threshold on interrupt2 failed
+ *            - 1 set axis failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 axis is invalid
  * @note      none
  */
-uint8_t l3gd20h_set_fifo_threshold_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_axis(l3gd20h_handle_t *handle, l3gd20h_axis_t axis, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
+    l3gd20h_field_index_t field;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                  /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                        /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                             /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                        /* return error */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
+    if (axis > L3GD20H_AXIS_Z)                                           /* check the axis */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                             /* read ctrl3 failed */
+        L3GD20H_PRINT(handle, "l3gd20h: axis is invalid.\n");            /* axis is invalid */
         
-        return 1;                                                                         /* return error */
+        return 4;                                                        /* return error */
     }
-    prev &= ~(1 << 2);                                                                    /* clear enable bit */
-    prev |= enable << 2;                                                                  /* set enable */
-   
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* write config */
+    
+    field = (l3gd20h_field_index_t)(L3GD20H_FIELD_AXIS_Y + axis);        /* get the field */
+    
+    return a_l3gd20h_field_write(handle, field, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get the fifo threshold on interrupt2 status
+ * @brief      get the axis
  * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[in]  axis set axis
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo threshold on interrupt2 failed
+ *             - 1 get axis failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 axis is invalid
  * @note       none
  */
-uint8_t l3gd20h_get_fifo_threshold_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_axis(l3gd20h_handle_t *handle, l3gd20h_axis_t axis, l3gd20h_bool_t *enable) 
 {
-    uint8_t res, prev;
+    uint8_t res, value;
+    l3gd20h_field_index_t field;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                  /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                        /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                             /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                        /* return error */
     }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    if (axis > L3GD20H_AXIS_Z)                                           /* check the axis */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                           /* read ctrl3 failed */
+        L3GD20H_PRINT(handle, "l3gd20h: axis is invalid.\n");            /* axis is invalid */
         
-        return 1;                                                                       /* return error */
+        return 4;                                                        /* return error */
     }
-    prev &= (1 << 2);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 2);                                              /* get bool */
-  
-    return 0;                                                                           /* success return 0 */
+    
+    field = (l3gd20h_field_index_t)(L3GD20H_FIELD_AXIS_Y + axis);        /* get the field */
+    res = a_l3gd20h_field_read(handle, field, &value);                   /* read the field */
+    if (res != 0)                                                        /* check result */
+    {
+        return res;                                                      /* return error */
+    }
+    *enable = (l3gd20h_bool_t)(value);                                   /* get the value */
+    
+    return 0;                                                            /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the fifo overrun on interrupt2
+ * @brief     set the rate bandwidth
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] enable bool value
+ * @param[in] rate_bandwidth rate bandwidth
  * @return    status code
  *            - 0 success
- *            - 1 set fifo overrun on interrupt2 failed
+ *            - 1 set rate bandwidth failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_fifo_overrun_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_rate_bandwidth(l3gd20h_handle_t *handle, l3gd20h_lodr_odr_bw_t rate_bandwidth) 
 {
     uint8_t res, prev;
     
@@ -1298,2042 +2297,1391 @@ uint8_t l3gd20h_set_fifo_overrun_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h
         return 3;                                                                         /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);         /* read config */
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                         /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read ctrl1 failed.\n");                           /* read ctrl1 failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    prev &= ~(0xF << 4);                                                                  /* clear rate and bandwidth bits */
+    prev |= (rate_bandwidth & 0xF) << 4;                                                  /* set rate and bandwidth */
+    if (a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1) != 0)     /* write config */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write ctrl1 failed.\n");                          /* write ctrl1 failed */
+        
+        return 1;                                                                         /* return error */
+    }
+
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* read low odr */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                             /* read ctrl3 failed */
+        L3GD20H_PRINT(handle, "l3gd20h: read low odr failed.\n");                         /* read low odr failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    prev &= ~(1 << 0);                                                                    /* clear odr bit */
+    prev |= ((rate_bandwidth & 0x10) >> 4) & 0x01;                                        /* set odr */
+    if (a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1) != 0)   /* write config */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write low odr failed.\n");                        /* write low odr failed */
         
         return 1;                                                                         /* return error */
     }
-    prev &= ~(1 << 1);                                                                    /* clear enable bit */
-    prev |= enable << 1;                                                                  /* set enable */
+#if (L3GD20H_BIAS_ENABLE == 1)
+    handle->bias_window = a_l3gd20h_bias_window((uint8_t)rate_bandwidth);                 /* follow the rate */
+    a_l3gd20h_still_restart(&handle->bias_still);                                         /* restart the window */
+#endif
     
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* write config */
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    return a_l3gd20h_settle(handle, L3GD20H_SETTLE_EVENT_RATE);                            /* open the settling window */
+#else
+    return 0;                                                                              /* success return 0 */
+#endif
 }
 
 /**
- * @brief      get the fifo overrun on interrupt2 status
+ * @brief      get the rate bandwidth
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *rate_bandwidth pointer to a rate bandwidth buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo overrun on interrupt2 failed
+ *             - 1 get rate bandwidth failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_fifo_overrun_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_rate_bandwidth(l3gd20h_handle_t *handle, l3gd20h_lodr_odr_bw_t *rate_bandwidth)
 {
-    uint8_t res, prev;
+    uint8_t res, prev1, prev2;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                           /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev1, 1);          /* read config */
+    if (res != 0)                                                                           /* check result */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                           /* read ctrl3 failed */
+        L3GD20H_PRINT(handle, "l3gd20h: read ctrl1 failed.\n");                             /* read ctrl1 failed */
         
-        return 1;                                                                       /* return error */
+        return 1;                                                                           /* return error */
+    }
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev2, 1);        /* read low odr */
+    if (res != 0)                                                                           /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read low odr failed.\n");                           /* read low odr failed */
+        
+        return 1;                                                                           /* return error */
     }
-    prev &= (1 << 1);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 1);                                              /* get bool */
+    *rate_bandwidth = (l3gd20h_lodr_odr_bw_t)(((prev2 & 0x01) << 4) | (prev1 >> 4));        /* get rate and bandwidth */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the fifo empty on interrupt2
+ * @brief     enable or disable the edge trigger
  * @param[in] *handle pointer to an l3gd20h handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set fifo empty on interrupt2 failed
+ *            - 1 set edge trigger failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_fifo_empty_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_edge_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                             /* read ctrl3 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 0);                                                                    /* clear enable bit */
-    prev |= enable << 0;                                                                  /* set enable */
-    
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_EDGE_TRIGGER, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get the fifo empty on interrupt2 status
+ * @brief      get the edge trigger status
  * @param[in]  *handle pointer to an l3gd20h handle structure
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo empty on interrupt2 failed
+ *             - 1 get edge trigger failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_fifo_empty_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_edge_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
-    {
-        return 3;                                                                       /* return error */
-    }
+    uint8_t res, value;
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL3, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_EDGE_TRIGGER, &value);        /* read the field */
+    if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("l3gd20h: read ctrl3 failed.\n");                           /* read ctrl3 failed */
-        
-        return 1;                                                                       /* return error */
+        return res;                                                                /* return error */
     }
-    prev &= (1 << 0);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 0);                                              /* get bool */
+    *enable = (l3gd20h_bool_t)(value);                                             /* get the value */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                      /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the block data update
+ * @brief     enable or disable the level trigger
  * @param[in] *handle pointer to an l3gd20h handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set block data update failed
+ *            - 1 set level trigger failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_block_data_update(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_level_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                             /* read ctrl4 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 7);                                                                    /* clear enable bit */
-    prev |= enable << 7;                                                                  /* set enable */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_LEVEL_TRIGGER, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get the block data update status
+ * @brief      get the level trigger status
  * @param[in]  *handle pointer to an l3gd20h handle structure
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get block data update failed
+ *             - 1 get level trigger failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_block_data_update(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_level_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
-    {
-        return 3;                                                                       /* return error */
-    }
+    uint8_t res, value;
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_LEVEL_TRIGGER, &value);        /* read the field */
+    if (res != 0)                                                                   /* check result */
     {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                           /* read ctrl4 failed */
-        
-        return 1;                                                                       /* return error */
+        return res;                                                                 /* return error */
     }
-    prev &= (1 << 7);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 7);                                              /* get bool */
+    *enable = (l3gd20h_bool_t)(value);                                              /* get the value */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                       /* success return 0 */
 }
 
 /**
- * @brief     set the data format
+ * @brief     set the high pass filter mode
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] data_format data format
+ * @param[in] mode high pass filter mode
  * @return    status code
  *            - 0 success
- *            - 1 set data format failed
+ *            - 1 set high pass filter mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_data_format(l3gd20h_handle_t *handle, l3gd20h_data_format_t data_format)
+uint8_t l3gd20h_set_high_pass_filter_mode(l3gd20h_handle_t *handle, l3gd20h_high_pass_filter_mode_t mode)
 {
-    uint8_t res, prev;
+    uint8_t res;
     
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    res = a_l3gd20h_field_write(handle, L3GD20H_FIELD_HIGH_PASS_FILTER_MODE, (uint8_t)mode);         /* write the field */
+    if (res != 0)                                                                                    /* check result */
     {
-        return 3;                                                                         /* return error */
+        return res;                                                                                  /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                             /* read ctrl4 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 6);                                                                    /* clear enable bit */
-    prev |= data_format << 6;                                                             /* set enable */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* write config */
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    return a_l3gd20h_settle(handle, L3GD20H_SETTLE_EVENT_FILTER);                                    /* open the settling window */
+#else
+    return 0;                                                                                        /* success return 0 */
+#endif
 }
 
 /**
- * @brief      get the data format
+ * @brief      get the high pass filter mode
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *data_format pointer to a data format buffer
+ * @param[out] *mode pointer to a high pass filter mode buffer
  * @return     status code
  *             - 0 success
- *             - 1 get data format failed
+ *             - 1 get high pass filter mode failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_data_format(l3gd20h_handle_t *handle, l3gd20h_data_format_t *data_format)
+uint8_t l3gd20h_get_high_pass_filter_mode(l3gd20h_handle_t *handle, l3gd20h_high_pass_filter_mode_t *mode)
 {
-    uint8_t res, prev;
+    uint8_t res, value;
     
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_HIGH_PASS_FILTER_MODE, &value);        /* read the field */
+    if (res != 0)                                                                           /* check result */
     {
-        return 3;                                                                       /* return error */
+        return res;                                                                         /* return error */
     }
+    *mode = (l3gd20h_high_pass_filter_mode_t)(value);                                       /* get the value */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                           /* read ctrl4 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (1 << 6);                                                                   /* get enable bit */
-    *data_format = (l3gd20h_data_format_t)(prev >> 6);                                  /* set enable */
-   
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief     set the full scale
+ * @brief     set the high pass filter cut off frequency
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] full_scale full scale
+ * @param[in] frequency high pass filter cut off frequency
  * @return    status code
  *            - 0 success
- *            - 1 set full scale failed
+ *            - 1 set high pass filter cut off frequency failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_full_scale(l3gd20h_handle_t *handle, l3gd20h_full_scale_t full_scale)
+uint8_t l3gd20h_set_high_pass_filter_cut_off_frequency(l3gd20h_handle_t *handle, l3gd20h_high_pass_filter_cut_off_frequency_t frequency)
 {
-    uint8_t res, prev;
+    uint8_t res;
     
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    res = a_l3gd20h_field_write(handle, L3GD20H_FIELD_HIGH_PASS_FILTER_CUT_OFF_FREQUENCY, (uint8_t)frequency);         /* write the field */
+    if (res != 0)                                                                                                      /* check result */
     {
-        return 3;                                                                         /* return error */
+        return res;                                                                                                    /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                             /* read ctrl4 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(3 << 4);                                                                    /* clear the scale bits */
-    prev |= full_scale << 4;                                                              /* set scale */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* write config */
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    return a_l3gd20h_settle(handle, L3GD20H_SETTLE_EVENT_FILTER);                                                      /* open the settling window */
+#else
+    return 0;                                                                                                          /* success return 0 */
+#endif
 }
 
 /**
- * @brief      get the full scale
+ * @brief      get the high pass filter cut off frequency
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *full_scale pointer to a full scale buffer
+ * @param[out] *frequency pointer to a high pass filter cut off frequency buffer
  * @return     status code
  *             - 0 success
- *             - 1 get full scale failed
+ *             - 1 get high pass filter cut off frequency failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_full_scale(l3gd20h_handle_t *handle, l3gd20h_full_scale_t *full_scale)
+uint8_t l3gd20h_get_high_pass_filter_cut_off_frequency(l3gd20h_handle_t *handle, l3gd20h_high_pass_filter_cut_off_frequency_t *frequency)
 {
-    uint8_t res, prev;
+    uint8_t res, value;
     
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_HIGH_PASS_FILTER_CUT_OFF_FREQUENCY, &value);        /* read the field */
+    if (res != 0)                                                                                        /* check result */
     {
-        return 3;                                                                       /* return error */
+        return res;                                                                                      /* return error */
     }
+    *frequency = (l3gd20h_high_pass_filter_cut_off_frequency_t)(value);                                  /* get the value */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                           /* read ctrl4 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (3 << 4);                                                                   /* get scale bits */
-    *full_scale = (l3gd20h_full_scale_t)(prev >> 4);                                    /* get scale */
-  
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                            /* success return 0 */
 }
 
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
 /**
- * @brief     enable or disable the level sensitive latched
+ * @brief     enable or disable the interrupt1
  * @param[in] *handle pointer to an l3gd20h handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set level sensitive latched failed
+ *            - 1 set interrupt1 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_level_sensitive_latched(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                             /* read ctrl4 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 3);                                                                    /* clear enable bit */
-    prev |= enable << 3;                                                                  /* set enable */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_INTERRUPT1, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get the level sensitive latched status
+ * @brief      get the interrupt1 status
  * @param[in]  *handle pointer to an l3gd20h handle structure
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get level sensitive latched failed
+ *             - 1 get interrupt1 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_level_sensitive_latched(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
+    uint8_t res, value;
     
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_INTERRUPT1, &value);        /* read the field */
+    if (res != 0)                                                                /* check result */
     {
-        return 3;                                                                       /* return error */
+        return res;                                                              /* return error */
     }
+    *enable = (l3gd20h_bool_t)(value);                                           /* get the value */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                           /* read ctrl4 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (1 << 3);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 3);                                              /* get bool */
-  
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                    /* success return 0 */
 }
+#endif
 
 /**
- * @brief     set the self test
+ * @brief     enable or disable boot on the interrupt1
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] self_test self test
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set self test failed
+ *            - 1 set boot on interrupt1 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_self_test(l3gd20h_handle_t *handle, l3gd20h_self_test_t self_test)
+uint8_t l3gd20h_set_boot_on_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                             /* read ctrl4 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(3 << 1);                                                                    /* clear self test bits */
-    prev |= self_test << 1;                                                               /* set self test */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_BOOT_ON_INTERRUPT1, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get the self test
+ * @brief      get the boot on the interrupt1 status
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *self_test pointer to a self test buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get self test failed
+ *             - 1 get boot on interrupt1 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_self_test(l3gd20h_handle_t *handle, l3gd20h_self_test_t *self_test)
+uint8_t l3gd20h_get_boot_on_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
+    uint8_t res, value;
     
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_BOOT_ON_INTERRUPT1, &value);        /* read the field */
+    if (res != 0)                                                                        /* check result */
     {
-        return 3;                                                                       /* return error */
+        return res;                                                                      /* return error */
     }
+    *enable = (l3gd20h_bool_t)(value);                                                   /* get the value */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                           /* read ctrl4 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (3 << 1);                                                                   /* get self test bits */
-    *self_test = (l3gd20h_self_test_t)(prev >> 1);                                      /* get self test */
-  
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the spi wire
+ * @brief     set the interrupt active level
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] spi_wire spi wire
+ * @param[in] level interrupt active level
  * @return    status code
  *            - 0 success
- *            - 1 set spi wire failed
+ *            - 1 set interrupt active level failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_spi_wire(l3gd20h_handle_t *handle, l3gd20h_spi_wire_t spi_wire)
+uint8_t l3gd20h_set_interrupt_active_level(l3gd20h_handle_t *handle, l3gd20h_interrupt_active_level_t level)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                             /* read ctrl4 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 0);                                                                    /* clear spi wire bit */
-    prev |= spi_wire << 0;                                                                /* set spi wire */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_INTERRUPT_ACTIVE_LEVEL, (uint8_t)level);        /* write the field */
 }
 
 /**
- * @brief      get the spi wire
+ * @brief      get the interrupt active level
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *spi_wire pointer to a spi wire buffer
+ * @param[out] *level pointer to an interrupt active level buffer
  * @return     status code
  *             - 0 success
- *             - 1 get spi wire failed
+ *             - 1 get interrupt active level failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_spi_wire(l3gd20h_handle_t *handle, l3gd20h_spi_wire_t *spi_wire)
+uint8_t l3gd20h_get_interrupt_active_level(l3gd20h_handle_t *handle, l3gd20h_interrupt_active_level_t *level)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
-    {
-        return 3;                                                                       /* return error */
-    }
+    uint8_t res, value;
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_INTERRUPT_ACTIVE_LEVEL, &value);        /* read the field */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                           /* read ctrl4 failed */
-        
-        return 1;                                                                       /* return error */
+        return res;                                                                          /* return error */
     }
-    prev &= (1 << 0);                                                                   /* get spi wire bit */
-    *spi_wire = (l3gd20h_spi_wire_t)(prev >> 0);                                        /* get spi wire */
+    *level = (l3gd20h_interrupt_active_level_t)(value);                                      /* get the value */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief     set the boot
+ * @brief     set the interrupt pin type
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] boot boot mode
+ * @param[in] pin_type interrupt pin type
  * @return    status code
  *            - 0 success
- *            - 1 set boot failed
+ *            - 1 set interrupt pin type failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_boot(l3gd20h_handle_t *handle, l3gd20h_boot_t boot)
+uint8_t l3gd20h_set_interrupt_pin_type(l3gd20h_handle_t *handle, l3gd20h_pin_type_t pin_type)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                             /* read ctrl5 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 7);                                                                    /* clear boot */
-    prev |= boot << 7;                                                                    /* set boot */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_INTERRUPT_PIN_TYPE, (uint8_t)pin_type);        /* write the field */
 }
 
 /**
- * @brief      get the boot
+ * @brief      get the interrupt pin type
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *boot pointer to a boot mode buffer
+ * @param[out] *pin_type pointer to an interrupt pin type buffer
  * @return     status code
  *             - 0 success
- *             - 1 get boot failed
+ *             - 1 get interrupt pin type failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_boot(l3gd20h_handle_t *handle, l3gd20h_boot_t *boot)
+uint8_t l3gd20h_get_interrupt_pin_type(l3gd20h_handle_t *handle, l3gd20h_pin_type_t *pin_type)
 {
-    uint8_t res, prev;
+    uint8_t res, value;
     
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_INTERRUPT_PIN_TYPE, &value);        /* read the field */
+    if (res != 0)                                                                        /* check result */
     {
-        return 3;                                                                       /* return error */
+        return res;                                                                      /* return error */
     }
+    *pin_type = (l3gd20h_pin_type_t)(value);                                             /* get the value */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                           /* read ctrl5 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (1 << 7);                                                                   /* get enable bit */
-    *boot = (l3gd20h_boot_t)(prev >> 7);                                                /* get bool */
-  
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the fifo
+ * @brief     enable or disable the data ready on interrupt2
  * @param[in] *handle pointer to an l3gd20h handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set fifo failed
+ *            - 1 set data ready on interrupt2 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_fifo(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_data_ready_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                             /* read ctrl5 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 6);                                                                    /* clear enable bit */
-    prev |= enable << 6;                                                                  /* set enable */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_DATA_READY_ON_INTERRUPT2, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get the fifo status
+ * @brief      get the data ready on interrupt2 status
  * @param[in]  *handle pointer to an l3gd20h handle structure
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo failed
+ *             - 1 get data ready on interrupt2 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_fifo(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_data_ready_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
+    uint8_t res, value;
     
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_DATA_READY_ON_INTERRUPT2, &value);        /* read the field */
+    if (res != 0)                                                                              /* check result */
     {
-        return 3;                                                                       /* return error */
+        return res;                                                                            /* return error */
     }
+    *enable = (l3gd20h_bool_t)(value);                                                         /* get the value */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                           /* read ctrl5 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (1 << 6);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 6);                                              /* get bool */
-  
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
+#if (L3GD20H_FIFO_ENABLE == 1)
 /**
- * @brief     enable or disable stop on fifo threshold
+ * @brief     enable or disable the fifo threshold on interrupt2
  * @param[in] *handle pointer to an l3gd20h handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set stop on fifo threshold failed
+ *            - 1 set fifo threshold on interrupt2 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_stop_on_fifo_threshold(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_fifo_threshold_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                             /* read ctrl5 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 5);                                                                    /* clear fifo enable bit */
-    prev |= enable << 5;                                                                  /* set enable */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_FIFO_THRESHOLD_ON_INTERRUPT2, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get stop on fifo threshold status
+ * @brief      get the fifo threshold on interrupt2 status
  * @param[in]  *handle pointer to an l3gd20h handle structure
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get stop on fifo threshold failed
+ *             - 1 get fifo threshold on interrupt2 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_stop_on_fifo_threshold(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_fifo_threshold_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
+    uint8_t res, value;
     
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_FIFO_THRESHOLD_ON_INTERRUPT2, &value);        /* read the field */
+    if (res != 0)                                                                                  /* check result */
     {
-        return 3;                                                                       /* return error */
+        return res;                                                                                /* return error */
     }
+    *enable = (l3gd20h_bool_t)(value);                                                             /* get the value */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                           /* read ctrl5 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (1 << 5);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 5);                                              /* get bool */
-  
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                      /* success return 0 */
 }
 
 /**
- * @brief     enable or disable high pass filter
+ * @brief     enable or disable the fifo overrun on interrupt2
  * @param[in] *handle pointer to an l3gd20h handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set high pass filter failed
+ *            - 1 set fifo overrun on interrupt2 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_high_pass_filter(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_fifo_overrun_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                             /* read ctrl5 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 4);                                                                    /* clear enable bit */
-    prev |= enable << 4;                                                                  /* set enable */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_FIFO_OVERRUN_ON_INTERRUPT2, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get high pass filter status
+ * @brief      get the fifo overrun on interrupt2 status
  * @param[in]  *handle pointer to an l3gd20h handle structure
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get high pass filter failed
+ *             - 1 get fifo overrun on interrupt2 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_high_pass_filter(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_fifo_overrun_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
+    uint8_t res, value;
     
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_FIFO_OVERRUN_ON_INTERRUPT2, &value);        /* read the field */
+    if (res != 0)                                                                                /* check result */
     {
-        return 3;                                                                       /* return error */
+        return res;                                                                              /* return error */
     }
+    *enable = (l3gd20h_bool_t)(value);                                                           /* get the value */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                           /* read ctrl5 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (1 << 4);                                                                   /* get enable bit */
-    *enable = (l3gd20h_bool_t)(prev >> 4);                                              /* get bool */
-  
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     set the interrupt selection
+ * @brief     enable or disable the fifo empty on interrupt2
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] selection interrupt selection
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt selection failed
+ *            - 1 set fifo empty on interrupt2 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_interrupt_selection(l3gd20h_handle_t *handle, l3gd20h_selection_t selection)
+uint8_t l3gd20h_set_fifo_empty_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                             /* read ctrl5 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(3 << 2);                                                                    /* clear selection */
-    prev |= selection << 2;                                                               /* set selection */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_FIFO_EMPTY_ON_INTERRUPT2, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get the interrupt selection
+ * @brief      get the fifo empty on interrupt2 status
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *selection pointer to an interrupt selection buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt selection failed
+ *             - 1 get fifo empty on interrupt2 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_interrupt_selection(l3gd20h_handle_t *handle, l3gd20h_selection_t *selection)
+uint8_t l3gd20h_get_fifo_empty_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
+    uint8_t res, value;
     
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_FIFO_EMPTY_ON_INTERRUPT2, &value);        /* read the field */
+    if (res != 0)                                                                              /* check result */
     {
-        return 3;                                                                       /* return error */
+        return res;                                                                            /* return error */
     }
+    *enable = (l3gd20h_bool_t)(value);                                                         /* get the value */
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                           /* read ctrl5 failed */
-        
-        return 1;                                                                       /* return error */
-    }
-    prev &= (3 << 2);                                                                   /* get the selection bits */
-    *selection = (l3gd20h_selection_t)(prev >> 2);                                      /* get the selection */
-  
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
+#endif
 
 /**
- * @brief     set the out selection
+ * @brief     enable or disable the block data update
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] selection out selection
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set out selection failed
+ *            - 1 set block data update failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_out_selection(l3gd20h_handle_t *handle, l3gd20h_selection_t selection)
+uint8_t l3gd20h_set_block_data_update(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                             /* read ctrl5 failed */
-        
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(3 << 0);                                                                    /* clear the selection bits */
-    prev |= selection << 0;                                                               /* get the selection */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_BLOCK_DATA_UPDATE, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get the out selection
+ * @brief      get the block data update status
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *selection pointer to an out selection buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get out selection failed
+ *             - 1 get block data update failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_out_selection(l3gd20h_handle_t *handle, l3gd20h_selection_t *selection)
+uint8_t l3gd20h_get_block_data_update(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
-    {
-        return 3;                                                                       /* return error */
-    }
+    uint8_t res, value;
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1);       /* read config */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_BLOCK_DATA_UPDATE, &value);        /* read the field */
     if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                           /* read ctrl5 failed */
-        
-        return 1;                                                                       /* return error */
+        return res;                                                                     /* return error */
     }
-    prev &= (3 << 0);                                                                   /* get the selection bits */
-    *selection = (l3gd20h_selection_t)(prev >> 0);                                      /* get the selection */
-  
+    *enable = (l3gd20h_bool_t)(value);                                                  /* get the value */
+    
     return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief     set the high pass filter reference
+ * @brief     set the data format
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] value high pass filter reference value
+ * @param[in] data_format data format
  * @return    status code
  *            - 0 success
- *            - 1 set high pass filter reference failed
+ *            - 1 set data format failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_high_pass_filter_reference(l3gd20h_handle_t *handle, uint8_t value)
+uint8_t l3gd20h_set_data_format(l3gd20h_handle_t *handle, l3gd20h_data_format_t data_format)
 {
-    if (handle == NULL)                                                                        /* check handle */
-    {
-        return 2;                                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
-    {
-        return 3;                                                                              /* return error */
-    }
-    
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_REFERENCE, (uint8_t *)&value, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_DATA_FORMAT, (uint8_t)data_format);        /* write the field */
 }
 
 /**
- * @brief      get the high pass filter reference
+ * @brief      get the data format
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *value pointer to a high pass filter reference value buffer
+ * @param[out] *data_format pointer to a data format buffer
  * @return     status code
  *             - 0 success
- *             - 1 get high pass filter reference failed
+ *             - 1 get data format failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_high_pass_filter_reference(l3gd20h_handle_t *handle, uint8_t *value)
+uint8_t l3gd20h_get_data_format(l3gd20h_handle_t *handle, l3gd20h_data_format_t *data_format)
 {
-    if (handle == NULL)                                                                        /* check handle */
-    {
-        return 2;                                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_DATA_FORMAT, &value);        /* read the field */
+    if (res != 0)                                                                 /* check result */
     {
-        return 3;                                                                              /* return error */
+        return res;                                                               /* return error */
     }
+    *data_format = (l3gd20h_data_format_t)(value);                                /* get the value */
     
-    return a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_REFERENCE, (uint8_t *)value, 1);         /* read config */
+    return 0;                                                                     /* success return 0 */
 }
 
 /**
- * @brief      read the temperature
+ * @brief     set the full scale
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] full_scale full scale
+ * @return    status code
+ *            - 0 success
+ *            - 1 set full scale failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_full_scale(l3gd20h_handle_t *handle, l3gd20h_full_scale_t full_scale)
+{
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_FULL_SCALE, (uint8_t)full_scale);        /* write the field */
+}
+
+/**
+ * @brief      get the full scale
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *raw pointer to a raw temperature buffer
- * @param[out] *temp pointer to a converted temperature buffer
+ * @param[out] *full_scale pointer to a full scale buffer
  * @return     status code
  *             - 0 success
- *             - 1 read temperature failed
+ *             - 1 get full scale failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_read_temperature(l3gd20h_handle_t *handle, int8_t *raw, float *temp)
+uint8_t l3gd20h_get_full_scale(l3gd20h_handle_t *handle, l3gd20h_full_scale_t *full_scale)
 {
-    uint8_t res;
-  
-    if (handle == NULL)                                                                  /* check handle */
-    {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
-    {
-        return 3;                                                                        /* return error */
-    }
+    uint8_t res, value;
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_OUT_TEMP, (uint8_t *)raw, 1);       /* read data */
-    if (res != 0)                                                                        /* check result */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_FULL_SCALE, &value);        /* read the field */
+    if (res != 0)                                                                /* check result */
     {
-        handle->debug_print("l3gd20h: read temperature failed.\n");                      /* read temperature failed */
-    
-        return 1;                                                                        /* return error */
+        return res;                                                              /* return error */
     }
-    *temp = (float)(*raw) * (-1.0f) + 25.0f;                                             /* convert the raw data */
-  
-    return 0;                                                                            /* success return 0 */
+    *full_scale = (l3gd20h_full_scale_t)(value);                                 /* get the value */
+    
+    return 0;                                                                    /* success return 0 */
 }
 
 /**
- * @brief      get the chip status
+ * @brief     enable or disable the level sensitive latched
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set level sensitive latched failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_level_sensitive_latched(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+{
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_LEVEL_SENSITIVE_LATCHED, (uint8_t)enable);        /* write the field */
+}
+
+/**
+ * @brief      get the level sensitive latched status
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *status pointer to a status buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get status failed
+ *             - 1 get level sensitive latched failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_status(l3gd20h_handle_t *handle, uint8_t *status)
+uint8_t l3gd20h_get_level_sensitive_latched(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    if (handle == NULL)                                                                  /* check handle */
-    {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_LEVEL_SENSITIVE_LATCHED, &value);        /* read the field */
+    if (res != 0)                                                                             /* check result */
     {
-        return 3;                                                                        /* return error */
+        return res;                                                                           /* return error */
     }
+    *enable = (l3gd20h_bool_t)(value);                                                        /* get the value */
     
-    return a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_STATUS, (uint8_t *)status, 1);     /* read config */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the fifo mode
+ * @brief     set the self test
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] fifo_mode chip fifo working mode
+ * @param[in] self_test self test
  * @return    status code
  *            - 0 success
- *            - 1 set fifo mode failed
+ *            - 1 set self test failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_fifo_mode(l3gd20h_handle_t *handle, l3gd20h_fifo_mode_t fifo_mode)
+uint8_t l3gd20h_set_self_test(l3gd20h_handle_t *handle, l3gd20h_self_test_t self_test)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                       /* check handle */
-    {
-        return 2;                                                                             /* return error */
-    }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
-    {
-        return 3;                                                                             /* return error */
-    }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_CTRL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                             /* check result */
-    {
-        handle->debug_print("l3gd20h: read fifo ctrl failed.\n");                             /* read fifo ctrl failed */
-   
-        return 1;                                                                             /* return error */
-    }
-    prev &= ~(7 << 5);
-    prev |= fifo_mode << 5;                                                                   /* clear fifo mode bits */
-                                                                                              /* set fifo mode */
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_FIFO_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_SELF_TEST, (uint8_t)self_test);        /* write the field */
 }
 
 /**
- * @brief      get the fifo mode
+ * @brief      get the self test
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *fifo_mode pointer to a chip fifo working mode buffer
+ * @param[out] *self_test pointer to a self test buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo mode failed
+ *             - 1 get self test failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_fifo_mode(l3gd20h_handle_t *handle, l3gd20h_fifo_mode_t *fifo_mode)
+uint8_t l3gd20h_get_self_test(l3gd20h_handle_t *handle, l3gd20h_self_test_t *self_test)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                     /* check handle */
-    {
-        return 2;                                                                           /* return error */
-    }
-    if (handle->inited != 1)                                                                /* check handle initialization */
-    {
-        return 3;                                                                           /* return error */
-    }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_CTRL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                           /* check result */
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_SELF_TEST, &value);        /* read the field */
+    if (res != 0)                                                               /* check result */
     {
-        handle->debug_print("l3gd20h: read fifo ctrl failed.\n");                           /* read fifo ctrl failed */
-   
-        return 1;                                                                           /* return error */
+        return res;                                                             /* return error */
     }
-    prev &= (7 << 5);                                                                       /* get fifo mode bits */
-    *fifo_mode = (l3gd20h_fifo_mode_t)(prev >> 5);                                          /* get fifo mode */
-  
-    return 0;                                                                               /* success return 0 */
+    *self_test = (l3gd20h_self_test_t)(value);                                  /* get the value */
+    
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief     set the fifo threshold
+ * @brief     set the spi wire
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] threshold fifo threshold
+ * @param[in] spi_wire spi wire
  * @return    status code
  *            - 0 success
- *            - 1 set fifo threshold failed
+ *            - 1 set spi wire failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 threshold is invalid
- * @note      threshold <= 31
+ * @note      none
  */
-uint8_t l3gd20h_set_fifo_threshold(l3gd20h_handle_t *handle, uint8_t threshold)
+uint8_t l3gd20h_set_spi_wire(l3gd20h_handle_t *handle, l3gd20h_spi_wire_t spi_wire)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                       /* check handle */
-    {
-        return 2;                                                                             /* return error */
-    }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
-    {
-        return 3;                                                                             /* return error */
-    }
-    
-    if (threshold > 31)                                                                       /* check the threshold */
-    {
-        handle->debug_print("l3gd20h: threshold is invalid.\n");                              /* threshold is invalid */
-    
-        return 4;                                                                             /* return error */
-    }
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_CTRL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                             /* check result */
-    {
-        handle->debug_print("l3gd20h: read fifo ctrl failed.\n");                             /* read fifo ctrl failed */
-    
-        return 1;                                                                             /* return error */
-    }
-    prev &= ~(0x1F);                                                                          /* clear the threshold bits */
-    prev |= threshold;                                                                        /* set the threshold */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_FIFO_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_SPI_WIRE, (uint8_t)spi_wire);        /* write the field */
 }
 
 /**
- * @brief      get the fifo threshold
+ * @brief      get the spi wire
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *threshold pointer to a fifo threshold buffer
+ * @param[out] *spi_wire pointer to a spi wire buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo threshold failed
+ *             - 1 get spi wire failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_fifo_threshold(l3gd20h_handle_t *handle, uint8_t *threshold)
+uint8_t l3gd20h_get_spi_wire(l3gd20h_handle_t *handle, l3gd20h_spi_wire_t *spi_wire)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                     /* check handle */
-    {
-        return 2;                                                                           /* return error */
-    }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_SPI_WIRE, &value);        /* read the field */
+    if (res != 0)                                                              /* check result */
     {
-        return 3;                                                                           /* return error */
+        return res;                                                            /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_CTRL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                           /* check result */
-    {
-        handle->debug_print("l3gd20h: read fifo ctrl failed.\n");                           /* read fifo ctrl failed */
+    *spi_wire = (l3gd20h_spi_wire_t)(value);                                   /* get the value */
     
-        return 1;                                                                           /* return error */
-    }
-    prev &= (0x1F);                                                                         /* get threshold bits */
-    *threshold = prev;                                                                      /* set threshold */
-  
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get the fifo level
+ * @brief     set the boot
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] boot boot mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set boot failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_boot(l3gd20h_handle_t *handle, l3gd20h_boot_t boot)
+{
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_BOOT, (uint8_t)boot);        /* write the field */
+}
+
+/**
+ * @brief      get the boot
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *level pointer to a fifo level buffer
+ * @param[out] *boot pointer to a boot mode buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo level failed
+ *             - 1 get boot failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_fifo_level(l3gd20h_handle_t *handle, uint8_t *level)
+uint8_t l3gd20h_get_boot(l3gd20h_handle_t *handle, l3gd20h_boot_t *boot)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                    /* check handle */
-    {
-        return 2;                                                                          /* return error */
-    }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_BOOT, &value);        /* read the field */
+    if (res != 0)                                                          /* check result */
     {
-        return 3;                                                                          /* return error */
+        return res;                                                        /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_SRC, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                          /* check result */
-    {
-        handle->debug_print("l3gd20h: read fifo src failed.\n");                           /* read fifo src failed */
+    *boot = (l3gd20h_boot_t)(value);                                       /* get the value */
     
-        return 1;                                                                          /* return error */
-    }
-    prev &= (0x1F);                                                                        /* get level bits */
-    *level = prev;                                                                         /* get level */
-  
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                              /* success return 0 */
 }
 
+#if (L3GD20H_FIFO_ENABLE == 1)
 /**
- * @brief     set the interrupt event
+ * @brief     enable or disable the fifo
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] interrupt_event chip interrupt event
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt event failed
+ *            - 1 set fifo failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_interrupt_event(l3gd20h_handle_t *handle, l3gd20h_interrupt_event_t interrupt_event, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_fifo(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                    /* check handle */
-    {
-        return 2;                                                                          /* return error */
-    }
-    if (handle->inited != 1)                                                               /* check handle initialization */
-    {
-        return 3;                                                                          /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_CFG, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                          /* check result */
-    {
-        handle->debug_print("l3gd20h: read interrupt cfg failed.\n");                      /* read interrupt cfg failed */
-    
-        return 1;                                                                          /* return error */
-    }
-    prev &= ~(1 << interrupt_event);                                                       /* clear event bit */
-    prev |= enable << interrupt_event;                                                     /* set event bit */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_CFG, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_FIFO, (uint8_t)enable);        /* write the field */
 }
 
 /**
- * @brief      get the interrupt event
+ * @brief      get the fifo status
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[in]  interrupt_event chip interrupt event
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt event failed
+ *             - 1 get fifo failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_interrupt_event(l3gd20h_handle_t *handle, l3gd20h_interrupt_event_t interrupt_event, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_fifo(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                  /* check handle */
-    {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
-    {
-        return 3;                                                                        /* return error */
-    }
+    uint8_t res, value;
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_CFG, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                        /* check result */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_FIFO, &value);        /* read the field */
+    if (res != 0)                                                          /* check result */
     {
-        handle->debug_print("l3gd20h: read interrupt cfg failed.\n");                    /* read interrupt cfg failed */
-    
-        return 1;                                                                        /* return error */
+        return res;                                                        /* return error */
     }
-    prev &= (1 << interrupt_event);                                                      /* get interrupt bit */
-    *enable = (l3gd20h_bool_t)(prev >> interrupt_event);                                 /* get interrupt */
-  
-    return 0;                                                                            /* success return 0 */
+    *enable = (l3gd20h_bool_t)(value);                                     /* get the value */
+    
+    return 0;                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt source
+ * @brief     enable or disable stop on fifo threshold
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set stop on fifo threshold failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_stop_on_fifo_threshold(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+{
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_STOP_ON_FIFO_THRESHOLD, (uint8_t)enable);        /* write the field */
+}
+
+/**
+ * @brief      get stop on fifo threshold status
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *src pointer to an interrupt source buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt source failed
+ *             - 1 get stop on fifo threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_interrupt_source(l3gd20h_handle_t *handle, uint8_t *src)
+uint8_t l3gd20h_get_stop_on_fifo_threshold(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t res;
-  
-    if (handle == NULL)                                                                /* check handle */
-    {
-        return 2;                                                                      /* return error */
-    }
-    if (handle->inited != 1)                                                           /* check handle initialization */
-    {
-        return 3;                                                                      /* return error */
-    }
+    uint8_t res, value;
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_SRC, (uint8_t *)src, 1);       /* read config */
-    if (res != 0)                                                                      /* check result */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_STOP_ON_FIFO_THRESHOLD, &value);        /* read the field */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("l3gd20h: read interrupt source failed.\n");               /* read interrupt source failed */
-    
-        return 1;                                                                      /* return error */
+        return res;                                                                          /* return error */
     }
+    *enable = (l3gd20h_bool_t)(value);                                                       /* get the value */
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                                                                /* success return 0 */
 }
+#endif
 
 /**
- * @brief     set the x interrupt threshold
+ * @brief     enable or disable high pass filter
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] threshold interrupt threshold
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set x interrupt threshold failed
+ *            - 1 set high pass filter failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 threshold is invalid
  * @note      none
  */
-uint8_t l3gd20h_set_x_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t threshold)
+uint8_t l3gd20h_set_high_pass_filter(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
 {
     uint8_t res;
-    uint8_t buf[2];
-  
-    if (handle == NULL)                                                                        /* check handle */
-    {
-        return 2;                                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
-    {
-        return 3;                                                                              /* return error */
-    }
-    if (threshold > 0x8000U)                                                                   /* check the threshold */
-    {
-        handle->debug_print("l3gd20h: threshold is invalid.\n");                               /* threshold is invalid */
-    
-        return 4;                                                                              /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_XH, (uint8_t *)buf, 1);            /* read x interrupt threshold */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("l3gd20h: read x interrupt threshold failed.\n");                  /* read x interrupt threshold failed */
-    
-        return 1;                                                                              /* return error */
-    }
-    buf[0] = buf[0] | ((threshold >> 8) & 0x7F);                                               /* set threshold high */
-    buf[1] = (threshold) & 0xFF;                                                               /* set threshold low*/
-  
-    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_XH, (uint8_t *)&buf[0], 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("l3gd20h: write x interrupt high threshold failed.\n");            /* write x interrupt high threshold failed */
-    
-        return 1;                                                                              /* return error */
-    }
     
-    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_XL, (uint8_t *)&buf[1], 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
+    res = a_l3gd20h_field_write(handle, L3GD20H_FIELD_HIGH_PASS_FILTER, (uint8_t)enable);         /* write the field */
+    if (res != 0)                                                                                 /* check result */
     {
-        handle->debug_print("l3gd20h: write x interrupt low threshold failed.\n");             /* write x interrupt low threshold failed */
-    
-        return 1;                                                                              /* return error */
+        return res;                                                                               /* return error */
     }
     
-    return 0;                                                                                  /* success return 0 */
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    return a_l3gd20h_settle(handle, L3GD20H_SETTLE_EVENT_FILTER);                                 /* open the settling window */
+#else
+    return 0;                                                                                     /* success return 0 */
+#endif
 }
 
 /**
- * @brief      get the x interrupt threshold
+ * @brief      get high pass filter status
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *threshold pointer to an interrupt threshold buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get x interrupt threshold failed
+ *             - 1 get high pass filter failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_x_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t *threshold)
+uint8_t l3gd20h_get_high_pass_filter(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
 {
-    uint8_t buf[2];
-  
-    if (handle == NULL)                                                                     /* check handle */
-    {
-        return 2;                                                                           /* return error */
-    }
-    if (handle->inited != 1)                                                                /* check handle initialization */
-    {
-        return 3;                                                                           /* return error */
-    }
+    uint8_t res, value;
     
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_XH, (uint8_t *)&buf[0], 1) != 0)  /* read x interrupt high threshold */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_HIGH_PASS_FILTER, &value);        /* read the field */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->debug_print("l3gd20h: read x interrupt high threshold failed.\n");          /* read x interrupt high threshold failed */
-    
-        return 1;                                                                           /* return error */
+        return res;                                                                    /* return error */
     }
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_XL, (uint8_t *)&buf[1], 1) != 0)  /* read x interrupt low threshold */
-    {
-        handle->debug_print("l3gd20h: read x interrupt low threshold failed.\n");           /* read x interrupt low threshold failed */
+    *enable = (l3gd20h_bool_t)(value);                                                 /* get the value */
     
-        return 1;                                                                           /* return error */
-    }
-    *threshold = (uint16_t)((uint16_t)buf[0] << 8) | buf[1];                                /* get the threshold */
-    *threshold &= ~(1 << 15);                                                               /* clear the 15th bit */
-  
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
 /**
- * @brief     set the y interrupt threshold
+ * @brief     set the interrupt selection
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] threshold interrupt threshold
+ * @param[in] selection interrupt selection
  * @return    status code
  *            - 0 success
- *            - 1 set y interrupt threshold failed
+ *            - 1 set interrupt selection failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 threshold is invalid
  * @note      none
  */
-uint8_t l3gd20h_set_y_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t threshold)
+uint8_t l3gd20h_set_interrupt_selection(l3gd20h_handle_t *handle, l3gd20h_selection_t selection)
 {
-    uint8_t res;
-    uint8_t buf[2];
-  
-    if (handle == NULL)                                                                        /* check handle */
-    {
-        return 2;                                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
-    {
-        return 3;                                                                              /* return error */
-    }
-    if (threshold > 0x8000U)                                                                   /* check the threshold */
-    {
-        handle->debug_print("l3gd20h: threshold is invalid.\n");                               /* threshold is invalid */
-    
-        return 4;                                                                              /* return error */
-    }
-    
-    buf[0] = (threshold >> 8) & 0xFF;                                                          /* set the high threshold */
-    buf[1] = (threshold) & 0xFF;                                                               /* set the low threshold */
-  
-    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_YH, (uint8_t *)&buf[0], 1);       /* write the config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("l3gd20h: write y interrupt high threshold failed.\n");            /* write y interrupt high threshold failed */
-    
-        return 1;                                                                              /* return error */
-    }
-    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_YL, (uint8_t *)&buf[1], 1);       /* write the config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("l3gd20h: write y interrupt low threshold failed.\n");             /* write y interrupt low threshold failed */
-    
-        return 1;                                                                              /* return error */
-    }
-    
-    return 0;                                                                                  /* success return 0 */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_INTERRUPT_SELECTION, (uint8_t)selection);        /* write the field */
 }
 
 /**
- * @brief      get the y interrupt threshold
+ * @brief      get the interrupt selection
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *threshold pointer to an interrupt threshold buffer
+ * @param[out] *selection pointer to an interrupt selection buffer
  * @return     status code
  *             - 0 success
- *             - 1 get y interrupt threshold failed
+ *             - 1 get interrupt selection failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_y_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t *threshold)
+uint8_t l3gd20h_get_interrupt_selection(l3gd20h_handle_t *handle, l3gd20h_selection_t *selection)
 {
-    uint8_t buf[2];
-  
-    if (handle == NULL)                                                                     /* check handle */
-    {
-        return 2;                                                                           /* return error */
-    }
-    if (handle->inited != 1)                                                                /* check handle initialization */
-    {
-        return 3;                                                                           /* return error */
-    }
+    uint8_t res, value;
     
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_YH, (uint8_t *)&buf[0], 1) != 0)  /* read y interrupt high threshold */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_INTERRUPT_SELECTION, &value);        /* read the field */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("l3gd20h: read y interrupt high threshold failed.\n");          /* read y interrupt high threshold failed */
-    
-        return 1;                                                                           /* return error */
+        return res;                                                                       /* return error */
     }
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_YL, (uint8_t *)&buf[1], 1) != 0)  /* read y interrupt low threshold */
-    {
-        handle->debug_print("l3gd20h: read y interrupt low threshold failed.\n");           /* read y interrupt low threshold failed */
+    *selection = (l3gd20h_selection_t)(value);                                            /* get the value */
     
-        return 1;                                                                           /* return error */
-    }
-    *threshold = (uint16_t)(buf[0] << 8) | buf[1];                                          /* get the threshold */
-    *threshold &= ~(1 << 15);                                                               /* clear the 15th bit */
-  
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
+#endif
 
 /**
- * @brief     set the z interrupt threshold
+ * @brief     set the out selection
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] threshold interrupt threshold
+ * @param[in] selection out selection
  * @return    status code
  *            - 0 success
- *            - 1 set z interrupt threshold failed
+ *            - 1 set out selection failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 threshold is invalid
  * @note      none
  */
-uint8_t l3gd20h_set_z_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t threshold)
+uint8_t l3gd20h_set_out_selection(l3gd20h_handle_t *handle, l3gd20h_selection_t selection)
 {
     uint8_t res;
-    uint8_t buf[2];
-  
-    if (handle == NULL)                                                                        /* check handle */
-    {
-        return 2;                                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
-    {
-        return 3;                                                                              /* return error */
-    }
-    if (threshold > 0x8000U)                                                                   /* check the threshold */
-    {
-        handle->debug_print("l3gd20h: threshold is invalid.\n");                               /* threshold is invalid */
-    
-        return 4;                                                                              /* return error */
-    }
-    
-    buf[0] = (threshold >> 8) & 0xFF;                                                          /* set the high threshold */
-    buf[1] = (threshold) & 0xFF;                                                               /* set the low threshold */
-  
-    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_ZH, (uint8_t *)&buf[0], 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("l3gd20h: write z interrupt high threshold failed.\n");            /* write z interrupt high threshold failed */
     
-        return 1;                                                                              /* return error */
-    }
-    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_ZL, (uint8_t *)&buf[1], 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
+    res = a_l3gd20h_field_write(handle, L3GD20H_FIELD_OUT_SELECTION, (uint8_t)selection);         /* write the field */
+    if (res != 0)                                                                                 /* check result */
     {
-        handle->debug_print("l3gd20h: write z interrupt low threshold failed.\n");             /* write z interrupt low threshold failed */
-    
-        return 1;                                                                              /* return error */
+        return res;                                                                               /* return error */
     }
     
-    return 0;                                                                                  /* success return 0 */
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    return a_l3gd20h_settle(handle, L3GD20H_SETTLE_EVENT_FILTER);                                 /* open the settling window */
+#else
+    return 0;                                                                                     /* success return 0 */
+#endif
 }
 
 /**
- * @brief      get the z interrupt threshold
+ * @brief      get the out selection
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *threshold pointer to an interrupt threshold buffer
+ * @param[out] *selection pointer to an out selection buffer
  * @return     status code
  *             - 0 success
- *             - 1 get z interrupt threshold failed
+ *             - 1 get out selection failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_z_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t *threshold)
+uint8_t l3gd20h_get_out_selection(l3gd20h_handle_t *handle, l3gd20h_selection_t *selection)
 {
-    uint8_t buf[2];
-  
-    if (handle == NULL)                                                                     /* check handle */
-    {
-        return 2;                                                                           /* return error */
-    }
-    if (handle->inited != 1)                                                                /* check handle initialization */
-    {
-        return 3;                                                                           /* return error */
-    }
+    uint8_t res, value;
     
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_ZH, (uint8_t *)&buf[0], 1) != 0)  /* read the config */
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_OUT_SELECTION, &value);        /* read the field */
+    if (res != 0)                                                                   /* check result */
     {
-        handle->debug_print("l3gd20h: read z interrupt high threshold failed.\n");          /* read z interrupt high threshold failed */
-    
-        return 1;                                                                           /* return error */
+        return res;                                                                 /* return error */
     }
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_ZL, (uint8_t *)&buf[1], 1) != 0)  /* read the config */
-    {
-        handle->debug_print("l3gd20h: read z interrupt low threshold failed.\n");           /* read z interrupt low threshold failed */
+    *selection = (l3gd20h_selection_t)(value);                                      /* get the value */
     
-        return 1;                                                                           /* return error */
-    }
-    *threshold = (uint16_t)((uint16_t)buf[0] << 8) | buf[1];                                /* get the threshold */
-    *threshold &= ~(1 << 15);                                                               /* clear the 15th bit */
-  
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                       /* success return 0 */
 }
 
 /**
- * @brief     set the counter mode
+ * @brief     set the high pass filter reference
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] counter_mode counter mode
+ * @param[in] value high pass filter reference value
  * @return    status code
  *            - 0 success
- *            - 1 set counter mode failed
+ *            - 1 set high pass filter reference failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_counter_mode(l3gd20h_handle_t *handle, l3gd20h_counter_mode_t counter_mode)
+uint8_t l3gd20h_set_high_pass_filter_reference(l3gd20h_handle_t *handle, uint8_t value)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                              /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_XH, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                             /* check result */
-    {
-        handle->debug_print("l3gd20h: read x interrupt threshold failed.\n");                 /* read x interrupt threshold failed */
     
-        return 1;                                                                             /* return error */
-    }
-    prev &= ~(1 << 7);                                                                        /* clear the counter mode bit */
-    prev |= counter_mode << 7;                                                                /* set the counter mode */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_XH, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_REFERENCE, (uint8_t *)&value, 1);       /* write config */
 }
 
 /**
- * @brief      get the counter mode
+ * @brief      get the high pass filter reference
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *counter_mode pointer to a counter mode buffer
+ * @param[out] *value pointer to a high pass filter reference value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get counter mode failed
+ *             - 1 get high pass filter reference failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_counter_mode(l3gd20h_handle_t *handle, l3gd20h_counter_mode_t *counter_mode)
+uint8_t l3gd20h_get_high_pass_filter_reference(l3gd20h_handle_t *handle, uint8_t *value)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                              /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_XH, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                           /* check result */
-    {
-        handle->debug_print("l3gd20h: read x interrupt threshold failed.\n");               /* read x interrupt threshold failed */
     
-        return 1;                                                                           /* return error */
-    }
-    prev &= (1 << 7);                                                                       /* get the counter mode bit */
-    *counter_mode = (l3gd20h_counter_mode_t)(prev >> 7);                                    /* get the counter mode */
-  
-    return 0;                                                                               /* success return 0 */
+    return a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_REFERENCE, (uint8_t *)value, 1);         /* read config */
 }
 
 /**
- * @brief     enable or disable the wait
- * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set wait failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      read the temperature
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *temp pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t l3gd20h_set_wait(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_read_temperature(l3gd20h_handle_t *handle, int8_t *raw, float *temp)
 {
-    uint8_t res, prev;
+    uint8_t res;
   
-    if (handle == NULL)                                                                         /* check handle */
+#if (L3GD20H_CHECK_ENABLE == 1)
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                               /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                               /* return error */
+        return 3;                                                                        /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_DURATION, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                               /* check result */
+#endif
+    
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_OUT_TEMP, (uint8_t *)raw, 1);       /* read data */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("l3gd20h: read duration failed.\n");                                /* read duration failed */
+        L3GD20H_PRINT(handle, "l3gd20h: read temperature failed.\n");                    /* read temperature failed */
     
-        return 1;                                                                               /* return error */
+        return 1;                                                                        /* return error */
     }
-    prev &= ~(1 << 7);                                                                          /* clear enable bit */
-    prev |= enable << 7;                                                                        /* set enable */
+    *temp = (float)(*raw) * (-1.0f) + 25.0f;                                             /* convert the raw data */
   
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_DURATION, (uint8_t *)&prev, 1);       /* write config */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the wait status
+ * @brief      get the chip status
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 get wait failed
+ *             - 1 get status failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_wait(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_status(l3gd20h_handle_t *handle, uint8_t *status)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                       /* check handle */
+#if (L3GD20H_CHECK_ENABLE == 1)
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                        /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_DURATION, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
-    {
-        handle->debug_print("l3gd20h: read duration failed.\n");                              /* read duration failed */
+#endif
     
-        return 1;                                                                             /* return error */
-    }
-    prev &= (1 << 7);                                                                         /* get the wait bit */
-    *enable = (l3gd20h_bool_t)(prev >> 7);                                                    /* get bool */
-  
-    return 0;                                                                                 /* success return 0 */
+    return a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_STATUS, (uint8_t *)status, 1);     /* read config */
 }
 
+#if (L3GD20H_FIFO_ENABLE == 1)
 /**
- * @brief     set the wait duration
+ * @brief     set the fifo mode
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] duration wait duration
+ * @param[in] fifo_mode chip fifo working mode
  * @return    status code
  *            - 0 success
- *            - 1 set duration failed
+ *            - 1 set fifo mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t l3gd20h_set_duration(l3gd20h_handle_t *handle, uint8_t duration)
+uint8_t l3gd20h_set_fifo_mode(l3gd20h_handle_t *handle, l3gd20h_fifo_mode_t fifo_mode)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                         /* check handle */
-    {
-        return 2;                                                                               /* return error */
-    }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
-    {
-        return 3;                                                                               /* return error */
-    }
-    if (duration > 0x7F)                                                                        /* check the duration */
-    {
-        handle->debug_print("l3gd20h: duration is over 0x7F.\n");                               /* duration is over 0x7F */
-    
-        return 1;                                                                               /* return error */
-    }
-    
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_DURATION, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                               /* check result */
-    {
-        handle->debug_print("l3gd20h: read duration failed.\n");                                /* read duration failed */
-    
-        return 1;                                                                               /* return error */
-    }
-    prev |= duration & 0x7F;                                                                    /* set the duration */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_DURATION, (uint8_t *)&prev, 1);       /* write config */
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_FIFO_MODE, (uint8_t)fifo_mode);        /* write the field */
 }
 
 /**
- * @brief      get the wait duration
+ * @brief      get the fifo mode
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *duration pointer to a wait duration buffer
+ * @param[out] *fifo_mode pointer to a chip fifo working mode buffer
  * @return     status code
  *             - 0 success
- *             - 1 get duration failed
+ *             - 1 get fifo mode failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_duration(l3gd20h_handle_t *handle, uint8_t *duration)
+uint8_t l3gd20h_get_fifo_mode(l3gd20h_handle_t *handle, l3gd20h_fifo_mode_t *fifo_mode)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                       /* check handle */
-    {
-        return 2;                                                                             /* return error */
-    }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_FIFO_MODE, &value);        /* read the field */
+    if (res != 0)                                                               /* check result */
     {
-        return 3;                                                                             /* return error */
+        return res;                                                             /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_DURATION, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
-    {
-        handle->debug_print("l3gd20h: read duration failed.\n");                              /* read duration failed */
+    *fifo_mode = (l3gd20h_fifo_mode_t)(value);                                  /* get the value */
     
-        return 1;                                                                             /* return error */
-    }
-    prev &= 0x7F;                                                                             /* get duration bits */
-    *duration = prev;                                                                         /* get duration */
-  
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief     set the data ready active level
+ * @brief     set the fifo threshold
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] level interrupt active level
+ * @param[in] threshold fifo threshold
  * @return    status code
  *            - 0 success
- *            - 1 set data ready active level failed
+ *            - 1 set fifo threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 threshold is invalid
+ * @note      threshold <= 31
  */
-uint8_t l3gd20h_set_data_ready_active_level(l3gd20h_handle_t *handle, l3gd20h_interrupt_active_level_t level)
+uint8_t l3gd20h_set_fifo_threshold(l3gd20h_handle_t *handle, uint8_t threshold)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                            /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                                  /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                                       /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                                  /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                           /* check result */
+    if (threshold > 31)                                                                            /* check the threshold */
     {
-        handle->debug_print("l3gd20h: read low odr failed.\n");                             /* read low odr failed */
+        L3GD20H_PRINT(handle, "l3gd20h: threshold is invalid.\n");                                 /* threshold is invalid */
     
-        return 1;                                                                           /* return error */
+        return 4;                                                                                  /* return error */
     }
-    prev &= ~(1 << 5);                                                                      /* clear level bit */
-    prev |= level << 5;                                                                     /* set level */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* write config */
+    
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_FIFO_THRESHOLD, (uint8_t)threshold);        /* write the field */
 }
 
 /**
- * @brief      get the data ready active level
+ * @brief      get the fifo threshold
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *level pointer to an interrupt active level buffer
+ * @param[out] *threshold pointer to a fifo threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get data ready active level failed
+ *             - 1 get fifo threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_data_ready_active_level(l3gd20h_handle_t *handle, l3gd20h_interrupt_active_level_t *level)
+uint8_t l3gd20h_get_fifo_threshold(l3gd20h_handle_t *handle, uint8_t *threshold)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                   /* check handle */
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_FIFO_THRESHOLD, &value);        /* read the field */
+    if (res != 0)                                                                    /* check result */
     {
-        return 2;                                                                         /* return error */
+        return res;                                                                  /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    *threshold = value;                                                              /* get the value */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      get the fifo level
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *level pointer to a fifo level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get fifo level failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_get_fifo_level(l3gd20h_handle_t *handle, uint8_t *level)
+{
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_FIFO_LEVEL, &value);        /* read the field */
+    if (res != 0)                                                                /* check result */
     {
-        return 3;                                                                         /* return error */
+        return res;                                                              /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read low odr failed.\n");                           /* return error */
+    *level = value;                                                              /* get the value */
     
-        return 1;                                                                         /* return error */
-    }
-    prev &= (1 << 5);                                                                     /* get pin level bit */
-    *level = (l3gd20h_interrupt_active_level_t)(prev >> 5);                               /* get pin level */
-  
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                    /* success return 0 */
 }
+#endif
 
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
 /**
- * @brief     enable or disable the iic interface
+ * @brief     set the interrupt event
  * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] interrupt_event chip interrupt event
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set iic failed
+ *            - 1 set interrupt event failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 interrupt event is invalid
  * @note      none
  */
-uint8_t l3gd20h_set_iic(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+uint8_t l3gd20h_set_interrupt_event(l3gd20h_handle_t *handle, l3gd20h_interrupt_event_t interrupt_event, l3gd20h_bool_t enable)
 {
-    uint8_t res, prev;
-  
+    l3gd20h_field_index_t field;
+    
     if (handle == NULL)                                                                     /* check handle */
     {
         return 2;                                                                           /* return error */
@@ -3342,71 +3690,36 @@ uint8_t l3gd20h_set_iic(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
     {
         return 3;                                                                           /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                           /* check result */
+    if (interrupt_event > L3GD20H_INTERRUPT_EVENT_AND_OR_COMBINATION)                       /* check the event */
     {
-        handle->debug_print("l3gd20h: read low odr failed.\n");                             /* read low odr failed */
-    
-        return 1;                                                                           /* return error */
+        L3GD20H_PRINT(handle, "l3gd20h: interrupt event is invalid.\n");                    /* interrupt event is invalid */
+        
+        return 4;                                                                           /* return error */
     }
-    prev &= ~(1 << 3);                                                                      /* clear enable bit */
-    prev |= enable << 3;                                                                    /* set enable */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* write config */
+    
+    field = (l3gd20h_field_index_t)(L3GD20H_FIELD_IG_X_LOW_EVENT + interrupt_event);        /* get the field */
+    
+    return a_l3gd20h_field_write(handle, field, (uint8_t)enable);                           /* write the field */
 }
 
 /**
- * @brief      get the iic interface status
+ * @brief      get the interrupt event
  * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[in]  interrupt_event chip interrupt event
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get iic failed
+ *             - 1 get interrupt event failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 interrupt event is invalid
  * @note       none
  */
-uint8_t l3gd20h_get_iic(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+uint8_t l3gd20h_get_interrupt_event(l3gd20h_handle_t *handle, l3gd20h_interrupt_event_t interrupt_event, l3gd20h_bool_t *enable)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read low odr failed.\n");                           /* read low odr failed */
+    uint8_t res, value;
+    l3gd20h_field_index_t field;
     
-        return 1;                                                                         /* return error */
-    }
-    prev &= (1 << 3);                                                                     /* get enable bit */
-   *enable = (l3gd20h_bool_t)(prev >> 3);                                                 /* get bool */
-  
-    return 0;                                                                             /* success return 0 */
-}
-
-/**
- * @brief     soft reset the device
- * @param[in] *handle pointer to an l3gd20h handle structure
- * @return    status code
- *            - 0 success
- *            - 1 soft reset failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t l3gd20h_soft_reset(l3gd20h_handle_t *handle)
-{
-    uint8_t res, prev;
-  
     if (handle == NULL)                                                                     /* check handle */
     {
         return 2;                                                                           /* return error */
@@ -3415,698 +3728,3150 @@ uint8_t l3gd20h_soft_reset(l3gd20h_handle_t *handle)
     {
         return 3;                                                                           /* return error */
     }
-  
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                           /* check result */
+    if (interrupt_event > L3GD20H_INTERRUPT_EVENT_AND_OR_COMBINATION)                       /* check the event */
     {
-        handle->debug_print("l3gd20h: read low odr failed.\n");                             /* read low odr failed */
+        L3GD20H_PRINT(handle, "l3gd20h: interrupt event is invalid.\n");                    /* interrupt event is invalid */
+        
+        return 4;                                                                           /* return error */
+    }
     
-        return 1;                                                                           /* return error */
+    field = (l3gd20h_field_index_t)(L3GD20H_FIELD_IG_X_LOW_EVENT + interrupt_event);        /* get the field */
+    res = a_l3gd20h_field_read(handle, field, &value);                                      /* read the field */
+    if (res != 0)                                                                           /* check result */
+    {
+        return res;                                                                         /* return error */
     }
-    prev &= ~(1 << 2);                                                                      /* clear reset bit */
-    prev |= 1 << 2;                                                                         /* set reset bit */
-  
-    return a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* write config */
+    *enable = (l3gd20h_bool_t)(value);                                                      /* get the value */
+    
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief      convert the interrupt threshold real data to the register raw data
+ * @brief      get the interrupt source
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[in]  dps interrupt threshold real data
- * @param[out] *reg pointer to an interrupt threshold raw data buffer
+ * @param[out] *src pointer to an interrupt source buffer
  * @return     status code
  *             - 0 success
- *             - 1 convert to register failed
+ *             - 1 get interrupt source failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_interrupt_threshold_convert_to_register(l3gd20h_handle_t *handle, float dps, uint16_t *reg)
+uint8_t l3gd20h_get_interrupt_source(l3gd20h_handle_t *handle, uint8_t *src)
 {
-    uint8_t range, prev;
+    uint8_t res;
   
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                                      /* return error */
     }
-  
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1) != 0)  /* read config */
-    {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                         /* read ctrl4 failed */
     
-        return 1;                                                                     /* return error */
-    }
-    range = (prev & (3 << 4)) >> 4;                                                   /* get range */
-    if (range == 0)
-    {
-        *reg = (uint16_t)(dps * 1000.0f / 7.5f);                                      /* convert */
-    }
-    else if (range == 1)
-    {
-        *reg = (uint16_t)(dps * 1000.0f / 15.3f);                                     /* convert */
-    }
-    else
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_SRC, (uint8_t *)src, 1);       /* read config */
+    if (res != 0)                                                                      /* check result */
     {
-        *reg = (uint16_t)(dps * 1000.0f / 61.0f);                                     /* convert */
+        L3GD20H_PRINT(handle, "l3gd20h: read interrupt source failed.\n");             /* read interrupt source failed */
+    
+        return 1;                                                                      /* return error */
     }
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief      convert the interrupt threshold register raw data to the real data
+ * @brief     set the x interrupt threshold
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] threshold interrupt threshold
+ * @return    status code
+ *            - 0 success
+ *            - 1 set x interrupt threshold failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 threshold is invalid
+ * @note      none
+ */
+uint8_t l3gd20h_set_x_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t threshold)
+{
+    uint8_t res;
+    uint8_t buf[2];
+  
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if (threshold > 0x8000U)                                                                   /* check the threshold */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: threshold is invalid.\n");                             /* threshold is invalid */
+    
+        return 4;                                                                              /* return error */
+    }
+    
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_XH, (uint8_t *)buf, 1);            /* read x interrupt threshold */
+    if (res != 0)                                                                              /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read x interrupt threshold failed.\n");                /* read x interrupt threshold failed */
+    
+        return 1;                                                                              /* return error */
+    }
+    buf[0] = buf[0] | ((threshold >> 8) & 0x7F);                                               /* set threshold high */
+    buf[1] = (threshold) & 0xFF;                                                               /* set threshold low*/
+  
+    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_XH, (uint8_t *)&buf[0], 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write x interrupt high threshold failed.\n");            /* write x interrupt high threshold failed */
+    
+        return 1;                                                                              /* return error */
+    }
+    
+    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_XL, (uint8_t *)&buf[1], 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write x interrupt low threshold failed.\n");            /* write x interrupt low threshold failed */
+    
+        return 1;                                                                              /* return error */
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the x interrupt threshold
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[in]  reg interrupt threshold raw data
- * @param[out] *dps pointer to an interrupt threshold real data buffer
+ * @param[out] *threshold pointer to an interrupt threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 convert to data failed
+ *             - 1 get x interrupt threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_interrupt_threshold_convert_to_data(l3gd20h_handle_t *handle, uint16_t reg, float *dps)
+uint8_t l3gd20h_get_x_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t *threshold)
 {
-    uint8_t range, prev;
+    uint8_t buf[2];
   
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                                           /* return error */
+    }
+    
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_XH, (uint8_t *)&buf[0], 1) != 0)  /* read x interrupt high threshold */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read x interrupt high threshold failed.\n");            /* read x interrupt high threshold failed */
+    
+        return 1;                                                                           /* return error */
+    }
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_XL, (uint8_t *)&buf[1], 1) != 0)  /* read x interrupt low threshold */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read x interrupt low threshold failed.\n");            /* read x interrupt low threshold failed */
+    
+        return 1;                                                                           /* return error */
     }
+    *threshold = (uint16_t)((uint16_t)buf[0] << 8) | buf[1];                                /* get the threshold */
+    *threshold &= ~(1 << 15);                                                               /* clear the 15th bit */
   
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1) != 0)  /* read config */
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the y interrupt threshold
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] threshold interrupt threshold
+ * @return    status code
+ *            - 0 success
+ *            - 1 set y interrupt threshold failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 threshold is invalid
+ * @note      none
+ */
+uint8_t l3gd20h_set_y_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t threshold)
+{
+    uint8_t res;
+    uint8_t buf[2];
+  
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if (threshold > 0x8000U)                                                                   /* check the threshold */
     {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                         /* read ctrl4 failed */
+        L3GD20H_PRINT(handle, "l3gd20h: threshold is invalid.\n");                             /* threshold is invalid */
     
-        return 1;                                                                     /* return error */
+        return 4;                                                                              /* return error */
     }
-    range = (prev & (3 << 4)) >> 4;                                                   /* get range */
-    if (range == 0)
+    
+    buf[0] = (threshold >> 8) & 0xFF;                                                          /* set the high threshold */
+    buf[1] = (threshold) & 0xFF;                                                               /* set the low threshold */
+  
+    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_YH, (uint8_t *)&buf[0], 1);       /* write the config */
+    if (res != 0)                                                                              /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write y interrupt high threshold failed.\n");            /* write y interrupt high threshold failed */
+    
+        return 1;                                                                              /* return error */
+    }
+    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_YL, (uint8_t *)&buf[1], 1);       /* write the config */
+    if (res != 0)                                                                              /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write y interrupt low threshold failed.\n");            /* write y interrupt low threshold failed */
+    
+        return 1;                                                                              /* return error */
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the y interrupt threshold
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *threshold pointer to an interrupt threshold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get y interrupt threshold failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_get_y_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t *threshold)
+{
+    uint8_t buf[2];
+  
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_YH, (uint8_t *)&buf[0], 1) != 0)  /* read y interrupt high threshold */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read y interrupt high threshold failed.\n");            /* read y interrupt high threshold failed */
+    
+        return 1;                                                                           /* return error */
+    }
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_YL, (uint8_t *)&buf[1], 1) != 0)  /* read y interrupt low threshold */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read y interrupt low threshold failed.\n");            /* read y interrupt low threshold failed */
+    
+        return 1;                                                                           /* return error */
+    }
+    *threshold = (uint16_t)(buf[0] << 8) | buf[1];                                          /* get the threshold */
+    *threshold &= ~(1 << 15);                                                               /* clear the 15th bit */
+  
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the z interrupt threshold
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] threshold interrupt threshold
+ * @return    status code
+ *            - 0 success
+ *            - 1 set z interrupt threshold failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 threshold is invalid
+ * @note      none
+ */
+uint8_t l3gd20h_set_z_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t threshold)
+{
+    uint8_t res;
+    uint8_t buf[2];
+  
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if (threshold > 0x8000U)                                                                   /* check the threshold */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: threshold is invalid.\n");                             /* threshold is invalid */
+    
+        return 4;                                                                              /* return error */
+    }
+    
+    buf[0] = (threshold >> 8) & 0xFF;                                                          /* set the high threshold */
+    buf[1] = (threshold) & 0xFF;                                                               /* set the low threshold */
+  
+    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_ZH, (uint8_t *)&buf[0], 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write z interrupt high threshold failed.\n");            /* write z interrupt high threshold failed */
+    
+        return 1;                                                                              /* return error */
+    }
+    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_IG_THS_ZL, (uint8_t *)&buf[1], 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write z interrupt low threshold failed.\n");            /* write z interrupt low threshold failed */
+    
+        return 1;                                                                              /* return error */
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the z interrupt threshold
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *threshold pointer to an interrupt threshold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get z interrupt threshold failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_get_z_interrupt_threshold(l3gd20h_handle_t *handle, uint16_t *threshold)
+{
+    uint8_t buf[2];
+  
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_ZH, (uint8_t *)&buf[0], 1) != 0)  /* read the config */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read z interrupt high threshold failed.\n");            /* read z interrupt high threshold failed */
+    
+        return 1;                                                                           /* return error */
+    }
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_THS_ZL, (uint8_t *)&buf[1], 1) != 0)  /* read the config */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read z interrupt low threshold failed.\n");            /* read z interrupt low threshold failed */
+    
+        return 1;                                                                           /* return error */
+    }
+    *threshold = (uint16_t)((uint16_t)buf[0] << 8) | buf[1];                                /* get the threshold */
+    *threshold &= ~(1 << 15);                                                               /* clear the 15th bit */
+  
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the counter mode
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] counter_mode counter mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set counter mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_counter_mode(l3gd20h_handle_t *handle, l3gd20h_counter_mode_t counter_mode)
+{
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_COUNTER_MODE, (uint8_t)counter_mode);        /* write the field */
+}
+
+/**
+ * @brief      get the counter mode
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *counter_mode pointer to a counter mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get counter mode failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_get_counter_mode(l3gd20h_handle_t *handle, l3gd20h_counter_mode_t *counter_mode)
+{
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_COUNTER_MODE, &value);        /* read the field */
+    if (res != 0)                                                                  /* check result */
+    {
+        return res;                                                                /* return error */
+    }
+    *counter_mode = (l3gd20h_counter_mode_t)(value);                               /* get the value */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the wait
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set wait failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_wait(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+{
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_WAIT, (uint8_t)enable);        /* write the field */
+}
+
+/**
+ * @brief      get the wait status
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get wait failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_get_wait(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+{
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_WAIT, &value);        /* read the field */
+    if (res != 0)                                                          /* check result */
+    {
+        return res;                                                        /* return error */
+    }
+    *enable = (l3gd20h_bool_t)(value);                                     /* get the value */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the wait duration
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] duration wait duration
+ * @return    status code
+ *            - 0 success
+ *            - 1 set duration failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_duration(l3gd20h_handle_t *handle, uint8_t duration)
+{
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (duration > 0x7F)                                                                    /* check the duration */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: duration is over 0x7F.\n");                         /* duration is over 0x7F */
+    
+        return 1;                                                                           /* return error */
+    }
+    
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_DURATION, (uint8_t)duration);        /* write the field */
+}
+
+/**
+ * @brief      get the wait duration
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *duration pointer to a wait duration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get duration failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_get_duration(l3gd20h_handle_t *handle, uint8_t *duration)
+{
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_DURATION, &value);        /* read the field */
+    if (res != 0)                                                              /* check result */
+    {
+        return res;                                                            /* return error */
+    }
+    *duration = value;                                                         /* get the value */
+    
+    return 0;                                                                  /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     set the data ready active level
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] level interrupt active level
+ * @return    status code
+ *            - 0 success
+ *            - 1 set data ready active level failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_data_ready_active_level(l3gd20h_handle_t *handle, l3gd20h_interrupt_active_level_t level)
+{
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_DATA_READY_ACTIVE_LEVEL, (uint8_t)level);        /* write the field */
+}
+
+/**
+ * @brief      get the data ready active level
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *level pointer to an interrupt active level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get data ready active level failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_get_data_ready_active_level(l3gd20h_handle_t *handle, l3gd20h_interrupt_active_level_t *level)
+{
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_DATA_READY_ACTIVE_LEVEL, &value);        /* read the field */
+    if (res != 0)                                                                             /* check result */
+    {
+        return res;                                                                           /* return error */
+    }
+    *level = (l3gd20h_interrupt_active_level_t)(value);                                       /* get the value */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the iic interface
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set iic failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_iic(l3gd20h_handle_t *handle, l3gd20h_bool_t enable)
+{
+    return a_l3gd20h_field_write(handle, L3GD20H_FIELD_IIC, (uint8_t)enable);        /* write the field */
+}
+
+/**
+ * @brief      get the iic interface status
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get iic failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_get_iic(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable)
+{
+    uint8_t res, value;
+    
+    res = a_l3gd20h_field_read(handle, L3GD20H_FIELD_IIC, &value);        /* read the field */
+    if (res != 0)                                                         /* check result */
+    {
+        return res;                                                       /* return error */
+    }
+    *enable = (l3gd20h_bool_t)(value);                                    /* get the value */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     soft reset the device
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 soft reset failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the auto ranging state restarts from the full scale after reset
+ */
+uint8_t l3gd20h_soft_reset(l3gd20h_handle_t *handle)
+{
+    uint8_t res, prev;
+  
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+  
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                           /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read low odr failed.\n");                           /* read low odr failed */
+    
+        return 1;                                                                           /* return error */
+    }
+    prev &= ~(1 << 2);                                                                      /* clear reset bit */
+    prev |= 1 << 2;                                                                         /* set reset bit */
+    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);        /* write config */
+    if (res != 0)                                                                           /* check result */
+    {
+        return 1;                                                                           /* return error */
+    }
+#if (L3GD20H_RANGE_ENABLE == 1)
+    handle->range_prev = gs_l3gd20h_field[L3GD20H_FIELD_FULL_SCALE].reset;                  /* full scale after reset */
+    handle->range_pending = 0;                                                              /* the fifo is empty */
+    handle->range_status = 0;                                                               /* no status check */
+    handle->range_quiet = 0;                                                                /* restart the count */
+    handle->range_head = handle->range_prev;                                                /* range of the head */
+    handle->range_tail = handle->range_prev;                                                /* range of the tail */
+#endif
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
+/**
+ * @brief      convert the interrupt threshold real data to the register raw data
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[in]  dps interrupt threshold real data
+ * @param[out] *reg pointer to an interrupt threshold raw data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 convert to register failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_interrupt_threshold_convert_to_register(l3gd20h_handle_t *handle, float dps, uint16_t *reg)
+{
+    uint8_t range, prev;
+  
+    if (handle == NULL)                                                               /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (handle->inited != 1)                                                          /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+  
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1) != 0)  /* read config */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read ctrl4 failed.\n");                       /* read ctrl4 failed */
+    
+        return 1;                                                                     /* return error */
+    }
+    range = (prev & (3 << 4)) >> 4;                                                   /* get range */
+    if (range == 0)
+    {
+        *reg = (uint16_t)(dps * 1000.0f / 7.5f);                                      /* convert */
+    }
+    else if (range == 1)
+    {
+        *reg = (uint16_t)(dps * 1000.0f / 15.3f);                                     /* convert */
+    }
+    else
+    {
+        *reg = (uint16_t)(dps * 1000.0f / 61.0f);                                     /* convert */
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      convert the interrupt threshold register raw data to the real data
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[in]  reg interrupt threshold raw data
+ * @param[out] *dps pointer to an interrupt threshold real data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 convert to data failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_interrupt_threshold_convert_to_data(l3gd20h_handle_t *handle, uint16_t reg, float *dps)
+{
+    uint8_t range, prev;
+  
+    if (handle == NULL)                                                               /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (handle->inited != 1)                                                          /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+  
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1) != 0)  /* read config */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read ctrl4 failed.\n");                       /* read ctrl4 failed */
+    
+        return 1;                                                                     /* return error */
+    }
+    range = (prev & (3 << 4)) >> 4;                                                   /* get range */
+    if (range == 0)
+    {
+        *dps = (float)(reg * 8.75f / 1000.0f);                                        /* convert */
+    }
+    else if (range == 1)
+    {
+        *dps = (float)(reg * 17.50f / 1000.0f);                                       /* convert */
+    }
+    else
+    {
+        *dps = (float)(reg * 70.0f / 1000.0f);                                        /* convert */
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     interrupt handler
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] num interrupt number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_irq_handler(l3gd20h_handle_t *handle, uint8_t num)
+{
+    uint8_t res, prev;
+  
+#if (L3GD20H_CHECK_ENABLE == 1)
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+#endif
+    
+    L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_IRQ, num, 0, 0);                                /* trace the entry */
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
+    if (num == 1)                                                                            /* interrupt 1 */
+    {
+        res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_SRC, (uint8_t *)&prev, 1);       /* read config */
+        if (res != 0)                                                                        /* check result */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: read interrupt source failed.\n");               /* read interrupt source failed */
+      
+            return 1;                                                                        /* return error */
+        }
+        L3GD20H_COUNT(handle, irq[L3GD20H_COUNTER_IRQ_INT1], 1);                             /* count the interrupt */
+        if ((prev & (1 << 6)) != 0)                                                          /* check active */
+        {
+            L3GD20H_COUNT(handle, irq[L3GD20H_COUNTER_IRQ_INT1_ACTIVE], 1);                  /* count the source */
+            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
+            {
+                handle->receive_callback(L3GD20H_INTERRUPT1_INTERRUPT_ACTIVE);               /* run receive callback */
+            }
+        }
+        if ((prev & (1 << 5)) != 0)                                                          /* check z high */
+        {
+            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
+            {
+                handle->receive_callback(L3GD20H_INTERRUPT1_Z_HIGH);                         /* run receive callback */
+            }
+        }
+        if ((prev & (1 << 4)) != 0)                                                          /* check z low */
+        {
+            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
+            {
+                handle->receive_callback(L3GD20H_INTERRUPT1_Z_LOW);                          /* run receive callback */
+            }
+        }
+        if ((prev & (1 << 3)) != 0)                                                          /* check y high */
+        {
+            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
+            {
+                handle->receive_callback(L3GD20H_INTERRUPT1_Y_HIGH);                         /* run receive callback */
+            }
+        }
+        if ((prev & (1 << 2)) != 0)                                                          /* check y low */
+        {                                                                                    /* check y low */
+            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
+            {
+                handle->receive_callback(L3GD20H_INTERRUPT1_Y_LOW);                          /* run receive callback */
+            }
+        }
+        if ((prev & (1 << 1)) != 0)                                                          /* check x high */
+        {
+            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
+            {
+                handle->receive_callback(L3GD20H_INTERRUPT1_X_HIGH);                         /* run receive callback */
+            }
+        }
+        if ((prev & (1 << 0)) != 0)                                                          /* check x low */
+        {
+            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
+           {
+               handle->receive_callback(L3GD20H_INTERRUPT1_X_LOW);                           /* run receive callback */
+           }
+        }
+        
+        return 0;                                                                            /* success return 0 */
+  }
+  else if (num == 2)                                                                         /* interrupt 2 */
+#else
+  if (num == 2)                                                                              /* interrupt 2 */
+#endif
+  {
+      res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_STATUS, (uint8_t *)&prev, 1);         /* read config */
+      if (res != 0)                                                                          /* check result */
+      {
+          L3GD20H_PRINT(handle, "l3gd20h: read status failed.\n");                           /* read status failed */
+      
+          return 1;                                                                          /* return error */
+      }
+      L3GD20H_COUNT(handle, irq[L3GD20H_COUNTER_IRQ_INT2], 1);                               /* count the interrupt */
+      if ((prev & (1 << L3GD20H_STATUS_XYZ_OVERRUN)) != 0)                                   /* check status xyz overrun */
+      {
+          L3GD20H_COUNT(handle, irq[L3GD20H_COUNTER_IRQ_STATUS_OVERRUN], 1);                 /* count the source */
+          L3GD20H_COUNT(handle, status_overrun, 1);                                          /* count the overrun */
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_XYZ_OVERRUN);                      /* run receive callback */
+          }
+      }
+      if ((prev & (1 << L3GD20H_STATUS_Z_OVERRUN)) != 0)                                     /* check status z overrun */
+      {
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_Z_OVERRUN);                        /* run receive callback */
+          }
+      }
+      if ((prev & (1 << L3GD20H_STATUS_Y_OVERRUN)) != 0)                                     /* check status y overrun */
+      {
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_Y_OVERRUN);                        /* run receive callback */
+          }
+      }
+      if ((prev & (1 << L3GD20H_STATUS_X_OVERRUN)) != 0)                                     /* check status x overrun */
+      {
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_X_OVERRUN);                        /* run receive callback */
+          }
+      }
+      if ((prev & (1 << L3GD20H_STATUS_XYZ_DATA_READY)) != 0)                                /* check status xyz data ready */
+      {
+          L3GD20H_COUNT(handle, irq[L3GD20H_COUNTER_IRQ_DATA_READY], 1);                     /* count the source */
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_XYZ_DATA_READY);                   /* run receive callback */
+          }
+      }
+      if ((prev & (1 << L3GD20H_STATUS_Z_DATA_READY)) != 0)                                  /* check status z data ready */
+      {
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_Z_DATA_READY);                     /* run receive callback */
+          }
+      }
+      if ((prev & (1 << L3GD20H_STATUS_Y_DATA_READY)) != 0)                                  /* check status y data ready */
+      {
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_Y_DATA_READY);                     /* run receive callback */
+          }
+      }
+      if ((prev & (1 << L3GD20H_STATUS_X_DATA_READY)) != 0)                                  /* check status x data ready */
+      {
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_X_DATA_READY);                     /* run receive callback */
+          }
+      }
+
+#if (L3GD20H_FIFO_ENABLE == 1)
+      res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_SRC, (uint8_t *)&prev, 1);       /* read config */
+      if (res != 0)                                                                          /* check result */
+      {
+          L3GD20H_PRINT(handle, "l3gd20h: read fifo source failed.\n");                      /* read fifo source failed*/
+      
+          return 1;                                                                          /* return error */
+      }
+      if ((prev & (1 << 7)) != 0)                                                            /* check fifo threshold */
+      {
+          L3GD20H_COUNT(handle, irq[L3GD20H_COUNTER_IRQ_FIFO_THRESHOLD], 1);                 /* count the source */
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_FIFO_THRESHOLD);                   /* run receive callback */
+          }
+      }
+      if ((prev & (1 << 6)) != 0)                                                            /* check fifo overrun */
+      {
+          L3GD20H_COUNT(handle, irq[L3GD20H_COUNTER_IRQ_FIFO_OVERRUN], 1);                   /* count the source */
+          L3GD20H_COUNT(handle, fifo_overrun, 1);                                            /* count the overrun */
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_FIFO_OVERRRUN);                    /* run receive callback */
+          }
+      }
+      if ((prev & (1 << 5)) != 0)                                                            /* check fifo empty */
+      {
+          L3GD20H_COUNT(handle, irq[L3GD20H_COUNTER_IRQ_FIFO_EMPTY], 1);                     /* count the source */
+          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
+          {
+              handle->receive_callback(L3GD20H_INTERRUPT2_FIFO_EMPTY);                       /* run receive callback */
+          }
+      }
+#endif
+      
+      return 0;                                                                              /* success return 0 */
+  }
+  else
+  {
+      L3GD20H_PRINT(handle, "l3gd20h: interrupt number is invalid.\n");                      /* interrupt number is invalid */
+    
+      return 1;                                                                              /* return error */
+  }
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi or iic initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t l3gd20h_init(l3gd20h_handle_t *handle)
+{
+    uint8_t res, prev;
+    uint8_t id;
+  
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->debug_print == NULL)                                                      /* check debug_print */
+    {
+        return 3;                                                                         /* return error */
+    }
+#if (L3GD20H_IIC_ENABLE == 1)
+    if (handle->iic_init == NULL)                                                         /* check iic_init */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: iic_init is null.\n");                            /* iic_init is null */
+    
+        return 3;                                                                         /* return error */
+    }
+    if (handle->iic_deinit == NULL)                                                       /* check iic_deinit */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: iic_deinit is null.\n");                          /* iic_deinit is null */
+        
+        return 3;                                                                         /* return error */
+    }
+#if (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_NONE)
+    if (handle->iic_read == NULL)                                                         /* check iic_read */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: iic_read is null.\n");                            /* iic_read is null */
+    
+        return 3;                                                                         /* return error */
+    }
+    if (handle->iic_write == NULL)                                                        /* check iic_write */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: iic_write is null.\n");                           /* iic_write is null */
+    
+        return 3;                                                                         /* return error */
+    }
+#endif
+#endif
+#if (L3GD20H_SPI_ENABLE == 1)
+    if (handle->spi_init == NULL)                                                         /* check spi_init */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: spi_init is null.\n");                            /* spi_init is null */
+    
+        return 3;                                                                         /* return error */
+    }
+    if (handle->spi_deinit == NULL)                                                       /* check spi_deinit */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: spi_deinit is null.\n");                          /* spi_deinit is null */
+    
+        return 3;                                                                         /* return error */
+    }
+#if (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_NONE)
+    if (handle->spi_read == NULL)                                                         /* check spi_read */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: spi_read is null.\n");                            /* spi_read is null */
+    
+        return 3;                                                                         /* return error */
+    }
+    if (handle->spi_write == NULL)                                                        /* check spi_write */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: spi_write is null.\n");                           /* spi_write is null */
+    
+        return 3;                                                                         /* return error */
+    }
+#endif
+#endif
+    if (handle->delay_ms == NULL)                                                         /* check delay_ms */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: delay_ms is null.\n");                            /* delay_ms is null */
+    
+        return 3;                                                                         /* return error */
+    }
+    
+#if ((L3GD20H_SPI_ENABLE == 0) || (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_IIC))
+    if (handle->iic_spi != L3GD20H_INTERFACE_IIC)                                         /* check interface */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: interface is not supported.\n");                  /* interface is not supported */
+    
+        return 1;                                                                         /* return error */
+    }
+#elif ((L3GD20H_IIC_ENABLE == 0) || (L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_SPI))
+    if (handle->iic_spi != L3GD20H_INTERFACE_SPI)                                         /* check interface */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: interface is not supported.\n");                  /* interface is not supported */
+    
+        return 1;                                                                         /* return error */
+    }
+#endif
+    if (L3GD20H_BUS_IS_IIC(handle))                                                       /* iic interface */
+    {
+        if (handle->iic_init() != 0)                                                      /* initialize iic bus */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: iic init failed.\n");                         /* iic init failed */
+      
+            return 1;                                                                     /* return error */
+        }
+    }
+    else
+    {
+        if (handle->spi_init() != 0)                                                      /* initialize spi bus */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: spi init failed.\n");                         /* spi init failed */
+      
+            return 1;                                                                     /* return error */
+        }
+    }
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_WHO_AM_I, (uint8_t *)&id, 1) != 0)     /* read id */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read id failed.\n");                              /* read id failed */
+        if (L3GD20H_BUS_IS_IIC(handle))                                                   /* if iic interface */
+        {
+            (void)handle->iic_deinit();                                                   /* iic deinit */
+        }
+        else                                                                              /* spi interface */
+        {
+            (void)handle->spi_deinit();                                                   /* spi deinit */
+        }
+        
+        return 1;                                                                         /* return error */
+    }
+    if (id != 0xD7)                                                                       /* check id */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: id is invalid.\n");                               /* id is invalid */
+        if (L3GD20H_BUS_IS_IIC(handle))                                                   /* if iic interface */
+        {
+            (void)handle->iic_deinit();                                                   /* iic deinit */
+        }
+        else
+        {
+            (void)handle->spi_deinit();                                                   /* spi deinit */
+        }
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                         /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read low odr failed.\n");                         /* read low odr failed */
+        if (L3GD20H_BUS_IS_IIC(handle))                                                   /* if iic interface */
+        {                                                                               
+            (void)handle->iic_deinit();                                                   /* iic deinit */
+        }
+        else
+        {
+            (void)handle->spi_deinit();                                                   /* spi deinit */
+        }
+    
+        return 1;                                                                         /* return error */
+    }
+    prev &= ~(1 << 2);                                                                    /* clear reset bit */
+    prev |= 1 << 2;                                                                       /* set reset bit */
+    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);      /* write config */
+    if (res != 0)                                                                         /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write low odr failed.\n");                        /* write low odr failed */
+        if (L3GD20H_BUS_IS_IIC(handle))                                                   /* if iic interface */
+        {
+            (void)handle->iic_deinit();                                                   /* iic deinit */
+        }
+        else
+        {
+            (void)handle->spi_deinit();                                                   /* spi deinit */
+        }
+        
+        return 1;                                                                         /* return error */
+    }
+    handle->delay_ms(12);                                                                 /* delay 12 ms */
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                         /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read low odr failed.\n");                         /* read low odr failed */
+        if (L3GD20H_BUS_IS_IIC(handle))                                                   /* if iic interface */
+        {
+            (void)handle->iic_deinit();                                                   /* iic deinit */
+        }
+        else
+        {
+            (void)handle->spi_deinit();                                                   /* spi deinit */
+        }
+    
+        return 1;                                                                         /* return error */
+    }
+    if (((prev >> 2) & 0x01) != 0x0)                                                      /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: reset chip failed.\n");                           /* reset chip failed */
+        if (L3GD20H_BUS_IS_IIC(handle))                                                   /* if iic interface */
+        {
+            (void)handle->iic_deinit();                                                   /* iic deinit */
+        }
+        else
+        {
+            (void)handle->spi_deinit();                                                   /* spi deinit */
+        }
+    
+        return 1;                                                                         /* return error */
+    }
+    
+#if (L3GD20H_ASYNC_ENABLE == 1)
+    handle->async_head = 0;                                                               /* reset the async queue head */
+    handle->async_count = 0;                                                              /* reset the async queue count */
+    handle->async_busy = 0;                                                               /* clear the async busy flag */
+#endif
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    handle->settle_mode = L3GD20H_SETTLE_OFF;                                             /* deliver every sample */
+    handle->settle = 0;                                                                   /* no settling window */
+    handle->settle_tagged = 0;                                                            /* nothing tagged */
+    handle->settle_dropped = 0;                                                           /* nothing dropped */
+    handle->settle_queued = 0;                                                            /* nothing queued */
+    handle->settle_period_ns = 0;                                                         /* no period */
+    handle->settle_until_us = 0;                                                          /* no deadline */
+#endif
+#if (L3GD20H_REMAP_ENABLE == 1)
+    handle->remap[0] = L3GD20H_REMAP_POSITIVE_X;                                          /* output x is sensor x */
+    handle->remap[1] = L3GD20H_REMAP_POSITIVE_Y;                                          /* output y is sensor y */
+    handle->remap[2] = L3GD20H_REMAP_POSITIVE_Z;                                          /* output z is sensor z */
+#endif
+#if (L3GD20H_RANGE_ENABLE == 1)
+    handle->range_auto = 0;                                                               /* fixed full scale */
+    handle->range_prev = 0;                                                               /* no switch yet */
+    handle->range_pending = 0;                                                            /* no old sample */
+    handle->range_status = 0;                                                             /* no status check */
+    handle->range_quiet = 0;                                                              /* no quiet sample */
+    handle->range_split = 0;                                                              /* no split */
+    handle->range_head = 0;                                                               /* 245 dps */
+    handle->range_tail = 0;                                                               /* 245 dps */
+#endif
+#if (L3GD20H_BIAS_ENABLE == 1)
+    handle->bias_mode = L3GD20H_BIAS_OFF;                                                 /* no compensation */
+    handle->bias_still.range = 0;                                                         /* 245 dps window */
+    handle->bias[0] = 0;                                                                  /* clear x */
+    handle->bias[1] = 0;                                                                  /* clear y */
+    handle->bias[2] = 0;                                                                  /* clear z */
+    handle->bias_limit = a_l3gd20h_bias_limit(L3GD20H_BIAS_THRESHOLD_DPS);                /* default threshold */
+    handle->bias_windows = 0;                                                             /* no bias yet */
+    handle->bias_window = a_l3gd20h_bias_window(L3GD20H_LOW_ODR_0_ODR_100HZ_BW_0_12P5HZ);   /* rate after the reset */
+    a_l3gd20h_still_restart(&handle->bias_still);                                         /* empty window */
+    memset(handle->bias_coeff, 0, sizeof(handle->bias_coeff));                            /* no model */
+    handle->bias_tref = 25.0f;                                                            /* 25 degrees */
+    handle->bias_temp[0] = 0;                                                             /* clear x */
+    handle->bias_temp[1] = 0;                                                             /* clear y */
+    handle->bias_temp[2] = 0;                                                             /* clear z */
+    handle->bias_temp_countdown = 0;                                                      /* read on the first burst */
+    handle->bias_temp_raw = 0;                                                            /* no temperature */
+    handle->bias_temp_state = 0;                                                          /* no model */
+    handle->reference_state = 0;                                                          /* idle */
+    handle->reference_n = 0;                                                              /* no measured sample */
+    handle->reference_value = 0;                                                          /* power on value */
+    handle->reference_gain = L3GD20H_REFERENCE_GAIN;                                      /* first guess */
+    handle->reference_residual[0] = 0;                                                    /* clear x */
+    handle->reference_residual[1] = 0;                                                    /* clear y */
+    handle->reference_residual[2] = 0;                                                    /* clear z */
+    handle->reference_period = 0;                                                         /* runs once */
+    handle->reference_countdown = 0;                                                      /* no run */
+    handle->reference_runs = 0;                                                           /* no run yet */
+#endif
+    handle->inited = 1;                                                                   /* flag finish initialization */
+  
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 power down failed
+ * @note      none
+ */
+uint8_t l3gd20h_deinit(l3gd20h_handle_t *handle)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                        /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read ctrl1 failed.\n");                          /* read ctrl1 failed */
+        
+        return 4;                                                                        /* return error */
+    }
+    prev &= ~(1 << 3);                                                                   /* set power down bit */
+    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                        /* check result */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write ctrl1 failed.\n");                         /* write ctrl1 failed */
+        
+        return 4;                                                                        /* return error */
+    }
+    handle->inited = 0;                                                                  /* flag close */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+#if (L3GD20H_ASYNC_ENABLE == 1)
+/**
+ * @brief     start an async transfer
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] read 1 for read and 0 for write
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the address bits follow a_l3gd20h_iic_spi_read and a_l3gd20h_iic_spi_write
+ */
+static uint8_t a_l3gd20h_async_start(l3gd20h_handle_t *handle, uint8_t read, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+#if (L3GD20H_COUNTER_ENABLE == 1)
+    l3gd20h_counter_dir_t dir;
+    
+    dir = (read != 0) ? L3GD20H_COUNTER_DIR_READ : L3GD20H_COUNTER_DIR_WRITE;     /* get the direction */
+    handle->counter.transactions[dir][reg & (L3GD20H_COUNTER_REG_NUM - 1)]++;     /* count the transaction */
+    handle->counter.bytes[dir][reg & (L3GD20H_COUNTER_REG_NUM - 1)] += len;       /* count the bytes */
+    
+#endif
+    if (L3GD20H_BUS_IS_IIC(handle))                                                /* iic interface */
+    {
+        if (read != 0)                                                             /* read */
+        {
+            if (len > 1)                                                           /* len > 1 */
+            {
+                reg |= 1 << 7;                                                     /* flag bit 7 */
+            }
+            
+            return handle->iic_read_async(handle->iic_addr, reg, buf, len);        /* start reading */
+        }
+        else
+        {
+            return handle->iic_write_async(handle->iic_addr, reg, buf, len);       /* start writing */
+        }
+    }
+    else                                                                           /* spi interface */
+    {
+        if (len > 1)                                                               /* len > 1 */
+        {
+            reg |= 1 << 6;                                                         /* flag address increment */
+        }
+        if (read != 0)                                                             /* read */
+        {
+            reg |= 1 << 7;                                                         /* set read bit */
+            
+            return handle->spi_read_async(reg, buf, len);                          /* start reading */
+        }
+        else
+        {
+            reg &= ~(1 << 7);                                                      /* set write bit */
+            
+            return handle->spi_write_async(reg, buf, len);                         /* start writing */
+        }
+    }
+}
+
+/**
+ * @brief     run the first step of the queue head
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      none
+ */
+static uint8_t a_l3gd20h_async_kick(l3gd20h_handle_t *handle)
+{
+    l3gd20h_async_request_t *req;
+    
+    req = &handle->async_queue[handle->async_head];                                               /* get the head */
+    req->state = 0;                                                                               /* reset the state */
+    handle->async_busy = 1;                                                                       /* flag busy */
+    if (req->type == L3GD20H_ASYNC_TYPE_CONFIG)                                                   /* config */
+    {
+        if (a_l3gd20h_async_start(handle, 1, req->reg, &req->prev, 1) != 0)                       /* read the register */
+        {
+            handle->async_busy = 0;                                                               /* clear busy */
+            
+            return 1;                                                                             /* return error */
+        }
+    }
+    else                                                                                          /* read or drain */
+    {
+        L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_BEGIN, L3GD20H_REG_OUT_X_L, req->len, 0);   /* trace the start */
+        if (a_l3gd20h_async_start(handle, 1, L3GD20H_REG_CTRL4, &req->ctrl4, 1) != 0)             /* read ctrl4 */
+        {
+            handle->async_busy = 0;                                                               /* clear busy */
+            
+            return 1;                                                                             /* return error */
+        }
+    }
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     finish the queue head and start the next request
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] res request result
+ * @note      a failed start of the next request finishes it with an error
+ */
+static void a_l3gd20h_async_finish(l3gd20h_handle_t *handle, uint8_t res)
+{
+    l3gd20h_async_request_t req;
+    
+    while (1)
+    {
+        req = handle->async_queue[handle->async_head];                                            /* copy the head */
+        handle->async_head = (uint8_t)((handle->async_head + 1) % L3GD20H_ASYNC_QUEUE_DEPTH);     /* pop the head */
+        handle->async_count--;                                                                    /* count-- */
+        handle->async_busy = 0;                                                                   /* clear busy */
+        if (req.type != L3GD20H_ASYNC_TYPE_CONFIG)                                                /* read or drain */
+        {
+            L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_END, L3GD20H_REG_OUT_X_L,
+                          (res == 0) ? req.len : 0, res);                                         /* trace the end */
+        }
+        if (req.callback != NULL)                                                                 /* callback is valid */
+        {
+            req.callback(req.type, res, (res == 0) ? req.len : 0);                                /* run the callback */
+        }
+        if ((handle->async_busy != 0) || (handle->async_count == 0))                              /* started in the callback or empty */
+        {
+            return;                                                                               /* nothing to start */
+        }
+        if (a_l3gd20h_async_kick(handle) == 0)                                                    /* start the next request */
+        {
+            return;                                                                               /* running */
+        }
+        L3GD20H_PRINT(handle, "l3gd20h: async start failed.\n");                                  /* async start failed */
+        res = 1;                                                                                  /* finish it with an error */
+    }
+}
+
+/**
+ * @brief     push an async request
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] *req pointer to a request
+ * @return    status code
+ *            - 0 success
+ *            - 1 start transfer failed
+ *            - 4 queue is full
+ *            - 5 async function is NULL
+ * @note      a push from a completion callback finds older requests queued behind an idle bus,
+ *            a failed start of such a head finishes it with an error and keeps the new request queued
+ */
+static uint8_t a_l3gd20h_async_push(l3gd20h_handle_t *handle, const l3gd20h_async_request_t *req)
+{
+    uint8_t tail;
+    
+    if (L3GD20H_BUS_IS_IIC(handle))                                                               /* iic interface */
+    {
+        if ((handle->iic_read_async == NULL) || (handle->iic_write_async == NULL))                /* check the iic functions */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: iic async function is null.\n");                      /* iic async function is null */
+            
+            return 5;                                                                             /* return error */
+        }
+    }
+    else                                                                                          /* spi interface */
+    {
+        if ((handle->spi_read_async == NULL) || (handle->spi_write_async == NULL))                /* check the spi functions */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: spi async function is null.\n");                      /* spi async function is null */
+            
+            return 5;                                                                             /* return error */
+        }
+    }
+    if (handle->async_count >= L3GD20H_ASYNC_QUEUE_DEPTH)                                         /* check the queue */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: async queue is full.\n");                                 /* async queue is full */
+        
+        return 4;                                                                                 /* return error */
+    }
+    
+    tail = (uint8_t)((handle->async_head + handle->async_count) % L3GD20H_ASYNC_QUEUE_DEPTH);     /* get the tail */
+    handle->async_queue[tail] = *req;                                                             /* copy the request */
+    handle->async_count++;                                                                        /* count++ */
+    if (handle->async_busy == 0)                                                                  /* bus is idle */
+    {
+        if (a_l3gd20h_async_kick(handle) != 0)                                                    /* start the head */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: async start failed.\n");                              /* async start failed */
+            if (handle->async_count == 1)                                                         /* the head is the request */
+            {
+                if (req->type != L3GD20H_ASYNC_TYPE_CONFIG)                                       /* read or drain */
+                {
+                    L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_END, L3GD20H_REG_OUT_X_L, 0, 1);    /* trace the end */
+                }
+                handle->async_count = 0;                                                          /* drop the request */
+                
+                return 1;                                                                         /* return error */
+            }
+            a_l3gd20h_async_finish(handle, 1);                                                    /* finish the older head with an error */
+        }
+    }
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+#if (L3GD20H_BIAS_ENABLE == 1)
+/**
+ * @brief     feed an async batch to the reference calibration
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] range full scale range bits
+ * @param[in] *offset pointer to the bias offset of the batch, NULL when the compensation is off
+ * @param[in] **raw pointer to a raw data buffer
+ * @param[in] len sample length
+ * @note      the write is queued behind the running request, so the next read sees the new value
+ */
+static void a_l3gd20h_reference_async(l3gd20h_handle_t *handle, uint8_t range, const int16_t *offset,
+                                      int16_t (*raw)[3], uint16_t len)
+{
+    l3gd20h_async_request_t req;
+    
+    if (a_l3gd20h_reference_update(handle, range, offset, raw, len) == 0)                         /* no write is due */
+    {
+        return;                                                                                   /* nothing to do */
+    }
+    
+    memset(&req, 0, sizeof(l3gd20h_async_request_t));                                             /* clear the request */
+    req.type = L3GD20H_ASYNC_TYPE_CONFIG;                                                         /* set config */
+    req.reg = L3GD20H_REG_REFERENCE;                                                              /* set the register */
+    req.mask = 0xFF;                                                                              /* whole register */
+    req.value = (uint8_t)handle->reference_next;                                                  /* set the value */
+    if (a_l3gd20h_async_push(handle, &req) != 0)                                                  /* queue the write */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: write reference failed.\n");                              /* write reference failed */
+        handle->reference_state = 0;                                                              /* stop the run */
+        handle->reference_countdown = handle->reference_period;                                   /* try again later */
+        
+        return;                                                                                   /* return */
+    }
+    a_l3gd20h_reference_commit(handle);                                                           /* account the write */
+}
+#endif
+#endif
+
+/**
+ * @brief          finish a decoded batch
+ * @param[in]      *handle pointer to an l3gd20h handle structure
+ * @param[in]      *buf pointer to the burst data, NULL when no temperature is read
+ * @param[in]      skip extra bytes in front of the output data
+ * @param[in]      ctrl4 ctrl4 value of the batch
+ * @param[in]      fifo fifo mode flag
+ * @param[in]      async 1 when called from l3gd20h_async_irq_handler
+ * @param[in]      *off pointer to the bias offset of the batch, NULL when the compensation is off
+ * @param[in, out] **raw pointer to a raw data buffer
+ * @param[in, out] **dps pointer to a converted data buffer, may be NULL
+ * @param[in, out] *len pointer to a length buffer
+ * @param[in, out] *level pointer to a fifo level buffer, NULL when no timestamp is taken
+ * @note           runs the temperature count, the settling window, the bias estimator, the reference
+ *                 calibration and the auto ranging, the async handler queues the reference write and
+ *                 leaves the auto ranging to the next blocking read, because both need the bus
+ */
+static void a_l3gd20h_read_finish(l3gd20h_handle_t *handle, const uint8_t *buf, uint8_t skip, uint8_t ctrl4,
+                                  uint8_t fifo, uint8_t async, const int16_t *off,
+                                  int16_t (*raw)[3], float (*dps)[3], uint16_t *len, uint8_t *level)
+{
+    uint8_t range;
+    uint16_t first;
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    uint16_t total;
+#endif
+
+    range = (ctrl4 >> 4) & 0x03;                                                                    /* get the range */
+#if (L3GD20H_BIAS_ENABLE == 1)
+    a_l3gd20h_bias_temp_count(handle, buf, skip, *len);                                             /* account the temperature */
+#else
+    (void)buf;                                                                                      /* no temperature */
+    (void)skip;                                                                                     /* no temperature */
+#endif
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    total = *len;                                                                                   /* save the length */
+    a_l3gd20h_settle_apply(handle, fifo, raw, dps, len, level);                                     /* handle the settling samples */
+    first = (uint16_t)(total - (*len));                                                             /* dropped samples */
+#if (L3GD20H_RANGE_ENABLE == 1)
+    handle->range_split = (handle->range_split > first) ? (uint16_t)(handle->range_split - first) : 0;    /* move the split */
+    first = (handle->range_split > handle->settle_tagged) ? handle->range_split : handle->settle_tagged;  /* first sample of the range */
+#else
+    first = handle->settle_tagged;                                                                  /* first sample of the range */
+#endif
+#else
+    (void)dps;                                                                                      /* no settling window */
+    (void)level;                                                                                    /* no settling window */
+    first = L3GD20H_RANGE_SPLIT(handle);                                                            /* first sample of the range */
+#endif
+#if (L3GD20H_BIAS_ENABLE == 1)
+    a_l3gd20h_bias_update(handle, range, off, raw + first, (uint16_t)((*len) - first));             /* feed the bias estimator */
+#if (L3GD20H_ASYNC_ENABLE == 1)
+    if (async != 0)                                                                                 /* bus is busy */
+    {
+        a_l3gd20h_reference_async(handle, range, off, raw + first, (uint16_t)((*len) - first));     /* queue the reference write */
+    }
+    else
+#endif
+    if (a_l3gd20h_reference_update(handle, range, off, raw + first, (uint16_t)((*len) - first)) != 0)    /* reference write is due */
+    {
+        if (a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_REFERENCE,
+                                    (uint8_t *)&handle->reference_next, 1) != 0)                    /* write the reference */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: write reference failed.\n");                            /* write reference failed */
+            handle->reference_state = 0;                                                            /* stop the run */
+            handle->reference_countdown = handle->reference_period;                                 /* try again later */
+        }
+        else
+        {
+            a_l3gd20h_reference_commit(handle);                                                     /* account the write */
+        }
+    }
+#else
+    (void)range;                                                                                    /* no bias */
+    (void)off;                                                                                      /* no bias */
+#endif
+#if (L3GD20H_RANGE_ENABLE == 1)
+    if (async == 0)                                                                                 /* bus is free */
+    {
+        a_l3gd20h_range_update(handle, ctrl4, fifo, raw + first, (uint16_t)((*len) - first));      /* switch the range */
+    }
+#else
+    (void)handle;                                                                                   /* one full scale */
+    (void)fifo;                                                                                     /* one full scale */
+    (void)raw;                                                                                      /* one full scale */
+    (void)len;                                                                                      /* one full scale */
+    (void)first;                                                                                    /* one full scale */
+    (void)async;                                                                                    /* one full scale */
+#endif
+}
+
+/**
+ * @brief         read the data and stamp the read
+ * @param[in]     *handle pointer to an l3gd20h handle structure
+ * @param[out]    **raw pointer to a raw data buffer
+ * @param[out]    **dps pointer to a converted data buffer
+ * @param[in,out] *len pointer to a date length buffer
+ * @param[out]    *level pointer to a fifo level buffer
+ * @param[out]    *us pointer to a timestamp buffer, NULL skips the stamp
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          the stamp is taken right after the fifo level is known, level is the number of samples
+ *                that were in the fifo at that time
+ */
+static uint8_t a_l3gd20h_read(l3gd20h_handle_t *handle, int16_t (*raw)[3], float (*dps)[3], uint16_t *len,
+                              uint8_t *level, uint64_t *us)
+{
+    uint8_t res, prev;
+    uint8_t ble, range;
+    uint8_t reg, skip, lead;
+    uint8_t ctrl4, fifo;
+    int16_t offset[3];
+    const int16_t *off;
+#if (L3GD20H_FIFO_ENABLE == 1)
+    uint8_t mode, cnt, enable;
+    uint8_t buf[32 * 6 + 2];
+#else
+    uint8_t buf[6 + 2];
+#endif
+  
+    L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_BEGIN, L3GD20H_REG_OUT_X_L, *len, 0);              /* trace the start */
+#if (L3GD20H_FIFO_ENABLE == 1)
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_CTRL, (uint8_t *)&prev, 1) != 0)             /* read fifo ctrl */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read fifo ctrl failed.\n");                                  /* read fifo ctrl failed */
+        L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_END, L3GD20H_REG_OUT_X_L, 0, 1);               /* trace the end */
+    
+        return 1;                                                                                    /* return error */
+    }
+    mode = prev >> 5;                                                                                /* get the mode */
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1) != 0)                 /* read ctrl5 */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read ctrl5 failed.\n");                                      /* read ctrl5 failed */
+        L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_END, L3GD20H_REG_OUT_X_L, 0, 1);               /* trace the end */
+    
+        return 1;                                                                                    /* return error */
+    }
+    enable = (prev & (1 << 6)) >> 6;                                                                 /* get enable */
+#endif
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1) != 0)                 /* get ctrl4 */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read ctrl4 failed.\n");                                      /* read ctrl4 failed */
+        L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_END, L3GD20H_REG_OUT_X_L, 0, 1);               /* trace the end */
+    
+        return 1;                                                                                    /* return error */
+    }
+    ctrl4 = prev;                                                                                    /* save ctrl4 */
+    range = (prev & (3 << 4)) >> 4;                                                                  /* get range */
+    ble = (prev & (1 << 6)) >> 6;                                                                    /* get big little endian */
+    fifo = 0;                                                                                        /* bypass mode */
+#if (L3GD20H_BIAS_ENABLE == 1)
+    skip = a_l3gd20h_bias_temp_due(handle);                                                          /* temperature rides on the burst */
+#else
+    skip = 0;                                                                                        /* no temperature */
+#endif
+    reg = (skip != 0) ? L3GD20H_REG_OUT_TEMP : L3GD20H_REG_OUT_X_L;                                  /* first register */
+#if (L3GD20H_FIFO_ENABLE == 1)
+    if ((mode && enable) != 0)                                                                       /* fifo modes */
+    {
+        fifo = 1;                                                                                    /* fifo mode */
+        res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_SRC, (uint8_t *)&prev, 1);             /* read fifo source */
+        if (res != 0)                                                                                /* check result */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: read fifo source failed.\n");                            /* read fifo source failed */
+            L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_END, L3GD20H_REG_OUT_X_L, 0, 1);           /* trace the end */
+      
+            return 1;                                                                                /* return error */
+        }
+        if ((prev & (1 << 6)) != 0)                                                                  /* check fifo overrun */
+        {
+            L3GD20H_COUNT(handle, fifo_overrun, 1);                                                  /* count the overrun */
+        }
+        cnt = prev & 0x1F;                                                                           /* get counter */
+#if (L3GD20H_TIMESTAMP_ENABLE == 1)
+        if (us != NULL)                                                                              /* timestamp wanted */
+        {
+            *us = handle->timestamp_us();                                                            /* stamp the fifo level */
+            *level = cnt;                                                                            /* save the level */
+        }
+#endif
+        *len = ((*len) < cnt) ? (*len) : cnt;                                                        /* get the length */
+#if (L3GD20H_SETTLE_ENABLE == 1)
+        if ((handle->settle_queued != 0) && (handle->settle_queued < (*len)))                        /* samples from before the change */
+        {
+            *len = handle->settle_queued;                                                            /* keep them apart from the window */
+        }
+#endif
+        res = a_l3gd20h_iic_spi_read(handle, reg, (uint8_t *)buf, 6 * (*len) + skip);                /* read all data */
+        if (res != 0)                                                                                /* check result */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: read data failed.\n");                                   /* read data failed */
+            L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_END, L3GD20H_REG_OUT_X_L, 0, 1);           /* trace the end */
+      
+            return 1;                                                                                /* return error */
+        }
+        off = a_l3gd20h_range_decode(handle, buf + skip, ble, range, offset, raw, dps, *len);        /* decode the data */
+        L3GD20H_COUNT(handle, samples_delivered, *len);                                              /* count the samples */
+    }                                                                                                /* bypass mode */
+    else
+#endif
+    {
+        *len = 1;                                                                                    /* set length */
+#if (L3GD20H_TIMESTAMP_ENABLE == 1)
+        if (us != NULL)                                                                              /* timestamp wanted */
+        {
+            *us = handle->timestamp_us();                                                            /* stamp the output registers */
+            *level = 1;                                                                              /* one sample */
+        }
+#else
+        (void)us;                                                                                    /* no timestamp */
+#endif
+#if (L3GD20H_RANGE_ENABLE == 1)
+        lead = ((handle->range_pending != 0) && (handle->range_status != 0) && (skip == 0)) ? 1 : 0; /* status rides on the burst */
+        reg = (lead != 0) ? L3GD20H_REG_STATUS : reg;                                                /* first register */
+#else
+        lead = 0;                                                                                    /* no status */
+#endif
+        res = a_l3gd20h_iic_spi_read(handle, reg, (uint8_t *)buf, 6 + skip + lead);                  /* read data */
+        if (res != 0)                                                                                /* check result */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: read data failed.\n");                                   /* read data failed */
+            L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_END, L3GD20H_REG_OUT_X_L, 0, 1);           /* trace the end */
+      
+            return 1;                                                                                /* return error */
+        }
+#if (L3GD20H_RANGE_ENABLE == 1)
+        if ((handle->range_pending != 0) && (handle->range_status != 0))                             /* switched in bypass mode */
+        {
+            if ((buf[skip + lead - 1] & handle->range_status) != 0)                                  /* a sample of the new range */
+            {
+                handle->range_pending = 0;                                                           /* decode with the new range */
+            }
+            handle->range_status = 0;                                                                /* checked */
+        }
+#endif
+        off = a_l3gd20h_range_decode(handle, buf + skip + lead, ble, range, offset, raw, dps, 1);    /* decode the data */
+        L3GD20H_COUNT(handle, samples_delivered, 1);                                                 /* count the sample */
+     }
+     a_l3gd20h_read_finish(handle, buf, skip, ctrl4, fifo, 0, off, raw, dps, len, level);           /* finish the batch */
+     L3GD20H_TRACE(handle, L3GD20H_TRACE_TYPE_READ_END, L3GD20H_REG_OUT_X_L, *len, 0);               /* trace the end */
+  
+     return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief         read the data
+ * @param[in]     *handle pointer to an l3gd20h handle structure
+ * @param[out]    **raw pointer to a raw data buffer
+ * @param[out]    **dps pointer to a converted data buffer
+ * @param[in,out] *len pointer to a date length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 len is invalid
+ * @note          none
+ */
+uint8_t l3gd20h_read(l3gd20h_handle_t *handle, int16_t (*raw)[3], float (*dps)[3], uint16_t *len) 
+{
+#if (L3GD20H_CHECK_ENABLE == 1)
+    if (handle == NULL)                                                                              /* check handle */
+    {
+        return 2;                                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                                         /* check handle initialization */
+    {
+        return 3;                                                                                    /* return error */
+    }
+#endif
+
+    if ((*len) == 0)                                                                                 /* check length */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: length is zero.\n");                                         /* length is zero. */
+    
+        return 4;                                                                                    /* return error */
+    }
+    
+    return a_l3gd20h_read(handle, raw, dps, len, NULL, NULL);                                        /* read the data */
+}
+
+#if (L3GD20H_TIMESTAMP_ENABLE == 1)
+/**
+ * @brief     add a point to the drift window and estimate the period
+ * @param[in] *ts pointer to a timestamp structure
+ * @param[in] anchor_ns time of the anchor sample in ns
+ * @param[in] n sample index of the anchor sample
+ * @note      the period is the slope between the oldest and the newest point of the window,
+ *            the bound adds the spread of the other points around that line to one period of stamp
+ *            phase and the 1us stamp resolution of both ends over the window length
+ */
+static void a_l3gd20h_timestamp_drift(l3gd20h_timestamp_t *ts, uint64_t anchor_ns, uint32_t n)
+{
+    uint8_t i;
+    uint8_t k;
+    uint8_t last;
+    uint8_t first;
+    uint32_t dn;
+    int64_t dt;
+    int64_t err;
+    int64_t limit;
+    int64_t res;
+    int64_t res_min;
+    int64_t res_max;
+    uint32_t period;
+    
+    if (ts->point_count != 0)                                                                         /* window is not empty */
+    {
+        last = (uint8_t)((ts->point_head + L3GD20H_TIMESTAMP_WINDOW - 1) % L3GD20H_TIMESTAMP_WINDOW);     /* get the newest point */
+        dn = n - ts->point_n[last];                                                                   /* get the samples since */
+        if (dn < L3GD20H_TIMESTAMP_STEP)                                                              /* too close */
+        {
+            return;                                                                                   /* skip the point */
+        }
+        err = (int64_t)(anchor_ns - ts->point_ns[last]) - (int64_t)dn * ts->period_ns;               /* get the line error */
+        limit = (int64_t)dn * ts->nominal_ns / L3GD20H_TIMESTAMP_DRIFT_LIMIT +
+                (int64_t)ts->period_ns * L3GD20H_TIMESTAMP_RELOCK;                                    /* get the limit */
+        if ((err > limit) || (err < -limit))                                                          /* lost samples or a clock jump */
+        {
+            ts->point_count = 0;                                                                      /* restart the window */
+        }
+    }
+    ts->point_ns[ts->point_head] = anchor_ns;                                                         /* save the time */
+    ts->point_n[ts->point_head] = n;                                                                  /* save the index */
+    ts->point_head = (uint8_t)((ts->point_head + 1) % L3GD20H_TIMESTAMP_WINDOW);                      /* move the head */
+    if (ts->point_count < L3GD20H_TIMESTAMP_WINDOW)                                                   /* not full */
+    {
+        ts->point_count++;                                                                            /* count++ */
+    }
+    if (ts->point_count < L3GD20H_TIMESTAMP_POINT_MIN)                                                /* too few points */
+    {
+        return;                                                                                       /* wait for more points */
+    }
+    
+    first = (uint8_t)((ts->point_head + L3GD20H_TIMESTAMP_WINDOW - ts->point_count) %
+                      L3GD20H_TIMESTAMP_WINDOW);                                                      /* get the oldest point */
+    last = (uint8_t)((ts->point_head + L3GD20H_TIMESTAMP_WINDOW - 1) % L3GD20H_TIMESTAMP_WINDOW);         /* get the newest point */
+    dn = ts->point_n[last] - ts->point_n[first];                                                      /* get the window samples */
+    dt = (int64_t)(ts->point_ns[last] - ts->point_ns[first]);                                         /* get the window time */
+    period = (uint32_t)((dt + dn / 2) / dn);                                                          /* get the period */
+    res_min = 0;                                                                                      /* init 0 */
+    res_max = 0;                                                                                      /* init 0 */
+    for (i = 0; i < ts->point_count; i++)                                                             /* check every point */
+    {
+        k = (uint8_t)((first + i) % L3GD20H_TIMESTAMP_WINDOW);                                        /* get the point */
+        res = (int64_t)(ts->point_ns[k] - ts->point_ns[first]) -
+              (int64_t)(ts->point_n[k] - ts->point_n[first]) * dt / dn;                               /* get the residual */
+        res_min = (res < res_min) ? res : res_min;                                                    /* get the min */
+        res_max = (res > res_max) ? res : res_max;                                                    /* get the max */
+    }
+    if ((period > ts->nominal_ns + ts->nominal_ns / L3GD20H_TIMESTAMP_DRIFT_LIMIT) ||
+        (period < ts->nominal_ns - ts->nominal_ns / L3GD20H_TIMESTAMP_DRIFT_LIMIT))                   /* check the range */
+    {
+        return;                                                                                       /* drop the estimate */
+    }
+    ts->period_ns = period;                                                                           /* use the estimate */
+    ts->bound_ns = (uint32_t)((res_max - res_min + period + 2000 + dn - 1) / dn);                     /* set the bound */
+}
+
+/**
+ * @brief      assign the sample times of a batch
+ * @param[in]  *ts pointer to a timestamp structure
+ * @param[in]  anchor_ns time of the anchor sample in ns
+ * @param[in]  anchor index of the anchor sample in the batch
+ * @param[in]  len batch length
+ * @param[out] *us pointer to a timestamp buffer
+ * @note       the first batch and a batch far from the prediction lock the track to the measurement,
+ *             later batches continue the track and move it by a fraction of the measured error,
+ *             a relock never goes back behind the last sample time of the previous batch,
+ *             the anchor also feeds the drift window so the period follows the real output data rate
+ */
+static void a_l3gd20h_timestamp_assign(l3gd20h_timestamp_t *ts, uint64_t anchor_ns, uint16_t anchor,
+                                       uint16_t len, uint64_t *us)
+{
+    uint64_t first;
+    int64_t err;
+    int64_t limit;
+    uint16_t i;
+    
+    a_l3gd20h_timestamp_drift(ts, anchor_ns, ts->samples + anchor);                          /* update the period */
+    first = (uint64_t)anchor * ts->period_ns;                                                 /* get the anchor offset */
+    first = (anchor_ns > first) ? (anchor_ns - first) : 0;                                    /* get the first sample time */
+    limit = (int64_t)ts->period_ns * L3GD20H_TIMESTAMP_RELOCK;                                /* get the relock limit */
+    if (ts->locked != 0)                                                                      /* track is running */
+    {
+        err = (int64_t)(first - ts->next_ns);                                                 /* get the error */
+        if ((err > limit) || (err < -limit))                                                  /* lost the track */
+        {
+            ts->locked = 0;                                                                   /* relock */
+        }
+        else
+        {
+            ts->residual_ns = (int32_t)err;                                                   /* save the residual */
+            first = ts->next_ns + (uint64_t)(err / (1 << L3GD20H_TIMESTAMP_GAIN_SHIFT));      /* follow the measurement */
+        }
+    }
+    if (ts->locked == 0)                                                                      /* start the track */
+    {
+        if ((ts->samples != 0) && ((first / 1000) <= ts->last_us))                            /* behind the previous batch */
+        {
+            first = (ts->last_us + 1) * 1000;                                                 /* keep the times increasing */
+        }
+        ts->residual_ns = 0;                                                                  /* no residual */
+        ts->locked = 1;                                                                       /* flag locked */
+    }
+    for (i = 0; i < len; i++)                                                                 /* assign the times */
+    {
+        us[i] = (first + (uint64_t)i * ts->period_ns) / 1000;                                 /* set the time */
+    }
+    ts->last_us = us[len - 1];                                                                /* save the last time */
+    ts->next_ns = first + (uint64_t)len * ts->period_ns;                                      /* predict the next batch */
+    ts->samples += len;                                                                       /* count the samples */
+}
+
+#if (L3GD20H_SETTLE_ENABLE == 1)
+/**
+ * @brief     skip the samples dropped in front of a batch
+ * @param[in] *ts pointer to a timestamp structure
+ * @param[in] n dropped samples
+ * @note      the track and the drift window keep counting the samples the device produced
+ */
+static void a_l3gd20h_timestamp_skip(l3gd20h_timestamp_t *ts, uint16_t n)
+{
+    ts->next_ns += (uint64_t)n * ts->period_ns;                                               /* move the prediction */
+    ts->samples += n;                                                                         /* count the samples */
+}
+#endif
+
+/**
+ * @brief         read the data with the sample times
+ * @param[in]     *handle pointer to an l3gd20h handle structure
+ * @param[in]     *ts pointer to a timestamp structure
+ * @param[out]    **raw pointer to a raw data buffer
+ * @param[out]    **dps pointer to a converted data buffer
+ * @param[out]    *us pointer to a timestamp buffer
+ * @param[in,out] *len pointer to a date length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle or ts is NULL
+ *                - 3 handle is not initialized
+ *                - 4 len is NULL or invalid
+ *                - 5 timestamp_us is NULL
+ *                - 6 ts is not initialized
+ * @note          the read is stamped when the fifo level is known, the newest sample is taken
+ *                half a period before the stamp on average and the others one period apart,
+ *                dropped settling samples keep their place in the time line
+ */
+uint8_t l3gd20h_read_timestamp(l3gd20h_handle_t *handle, l3gd20h_timestamp_t *ts,
+                               int16_t (*raw)[3], float (*dps)[3], uint64_t *us, uint16_t *len)
+{
+    uint8_t level;
+    uint64_t stamp;
+    
+    if (handle == NULL)                                                                                 /* check handle */
+    {
+        return 2;                                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                                            /* check handle initialization */
+    {
+        return 3;                                                                                       /* return error */
+    }
+    if (ts == NULL)                                                                                     /* check ts */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: ts is null.\n");                                                /* ts is null */
+        
+        return 2;                                                                                       /* return error */
+    }
+    if (len == NULL)                                                                                    /* check len */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: len is null.\n");                                               /* len is null */
+        
+        return 4;                                                                                       /* return error */
+    }
+    if ((*len) == 0)                                                                                    /* check length */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: length is zero.\n");                                            /* length is zero. */
+        
+        return 4;                                                                                       /* return error */
+    }
+    if (handle->timestamp_us == NULL)                                                                   /* check timestamp_us */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: timestamp_us is null.\n");                                      /* timestamp_us is null */
+        
+        return 5;                                                                                       /* return error */
+    }
+    if (ts->period_ns == 0)                                                                             /* check ts */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: ts is not initialized.\n");                                     /* ts is not initialized */
+        
+        return 6;                                                                                       /* return error */
+    }
+    
+    level = 0;                                                                                          /* init 0 */
+    stamp = 0;                                                                                          /* init 0 */
+    if (a_l3gd20h_read(handle, raw, dps, len, &level, &stamp) != 0)                                     /* read the data */
+    {
+        return 1;                                                                                       /* return error */
+    }
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    if (handle->settle_mode == L3GD20H_SETTLE_DROP)                                                     /* settling samples are dropped */
+    {
+        a_l3gd20h_timestamp_skip(ts, handle->settle_dropped);                                           /* skip them */
+    }
+#endif
+    if ((*len) != 0)                                                                                    /* not empty */
+    {
+        a_l3gd20h_timestamp_assign(ts, stamp * 1000 - ts->period_ns / 2, (uint16_t)(level - 1),
+                                   *len, us);                                                           /* assign the times */
+    }
+    
+    return 0;                                                                                           /* success return 0 */
+}
+#endif
+
+#if (L3GD20H_ASYNC_ENABLE == 1)
+/**
+ * @brief      submit an async read request
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] **raw pointer to a raw data buffer with at least 1 sample
+ * @param[out] **dps pointer to a converted data buffer, NULL skips the conversion
+ * @param[in]  *callback pointer to a completion callback
+ * @return     status code
+ *             - 0 success
+ *             - 1 start transfer failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 queue is full
+ *             - 5 async function is NULL
+ * @note       raw and dps must stay valid until the callback runs,
+ *             the call must not preempt l3gd20h_async_irq_handler or be preempted by it,
+ *             the sample runs the same settling, bias and reference steps as l3gd20h_read, the reference
+ *             write is queued behind the request, the auto ranging only runs in the blocking reads and
+ *             no timestamp is taken, stamp the callback and use l3gd20h_timestamp_assign
+ */
+uint8_t l3gd20h_async_read(l3gd20h_handle_t *handle, int16_t (*raw)[3], float (*dps)[3],
+                           void (*callback)(uint8_t type, uint8_t res, uint16_t len))
+{
+    l3gd20h_async_request_t req;
+    
+#if (L3GD20H_CHECK_ENABLE == 1)
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    if (handle->inited != 1)                             /* check handle initialization */
+    {
+        return 3;                                        /* return error */
+    }
+#endif
+    
+    memset(&req, 0, sizeof(l3gd20h_async_request_t));    /* clear the request */
+    req.type = L3GD20H_ASYNC_TYPE_READ;                  /* set read */
+    req.len = 1;                                         /* one sample */
+    req.raw = raw;                                       /* set raw buffer */
+    req.dps = dps;                                       /* set dps buffer */
+    req.callback = callback;                             /* set callback */
+    
+    return a_l3gd20h_async_push(handle, &req);           /* push the request */
+}
+
+#if (L3GD20H_FIFO_ENABLE == 1)
+/**
+ * @brief      submit an async fifo drain request
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] **raw pointer to a raw data buffer
+ * @param[out] **dps pointer to a converted data buffer, NULL skips the conversion
+ * @param[in]  len max sample length of the buffers
+ * @param[in]  *callback pointer to a completion callback
+ * @return     status code
+ *             - 0 success
+ *             - 1 start transfer failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 queue is full
+ *             - 5 async function is NULL
+ *             - 6 len is invalid
+ * @note       1 <= len <= 32, the callback reports the drained length after the settling drop,
+ *             the call must not preempt l3gd20h_async_irq_handler or be preempted by it,
+ *             the batch runs the same steps as l3gd20h_async_read
+ */
+uint8_t l3gd20h_async_drain(l3gd20h_handle_t *handle, int16_t (*raw)[3], float (*dps)[3], uint16_t len,
+                            void (*callback)(uint8_t type, uint8_t res, uint16_t len))
+{
+    l3gd20h_async_request_t req;
+    
+#if (L3GD20H_CHECK_ENABLE == 1)
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (handle->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+#endif
+    if ((len == 0) || (len > 32))                                      /* check the length */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: len is invalid.\n");            /* len is invalid */
+        
+        return 6;                                                      /* return error */
+    }
+    
+    memset(&req, 0, sizeof(l3gd20h_async_request_t));                 /* clear the request */
+    req.type = L3GD20H_ASYNC_TYPE_DRAIN;                               /* set drain */
+    req.len = len;                                                     /* set the max length */
+    req.raw = raw;                                                     /* set raw buffer */
+    req.dps = dps;                                                     /* set dps buffer */
+    req.callback = callback;                                           /* set callback */
+    
+    return a_l3gd20h_async_push(handle, &req);                         /* push the request */
+}
+#endif
+
+/**
+ * @brief     submit an async config request
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] reg register address
+ * @param[in] mask changed bits of the register
+ * @param[in] value new value of the changed bits
+ * @param[in] *callback pointer to a completion callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 start transfer failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 queue is full
+ *            - 5 async function is NULL
+ * @note      the register is read, modified and written back,
+ *            the call must not preempt l3gd20h_async_irq_handler or be preempted by it
+ */
+uint8_t l3gd20h_async_apply_config(l3gd20h_handle_t *handle, uint8_t reg, uint8_t mask, uint8_t value,
+                                   void (*callback)(uint8_t type, uint8_t res, uint16_t len))
+{
+    l3gd20h_async_request_t req;
+    
+#if (L3GD20H_CHECK_ENABLE == 1)
+    if (handle == NULL)                                      /* check handle */
     {
-        *dps = (float)(reg * 8.75f / 1000.0f);                                        /* convert */
+        return 2;                                            /* return error */
     }
-    else if (range == 1)
+    if (handle->inited != 1)                                 /* check handle initialization */
     {
-        *dps = (float)(reg * 17.50f / 1000.0f);                                       /* convert */
+        return 3;                                            /* return error */
     }
-    else
+#endif
+    
+    memset(&req, 0, sizeof(l3gd20h_async_request_t));       /* clear the request */
+    req.type = L3GD20H_ASYNC_TYPE_CONFIG;                    /* set config */
+    req.reg = reg;                                           /* set the register */
+    req.mask = mask;                                         /* set the mask */
+    req.value = value;                                       /* set the value */
+    req.callback = callback;                                 /* set callback */
+    
+    return a_l3gd20h_async_push(handle, &req);               /* push the request */
+}
+
+/**
+ * @brief      get the pending async request count
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *count pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t l3gd20h_async_get_pending(l3gd20h_handle_t *handle, uint8_t *count)
+{
+    if (handle == NULL)                     /* check handle */
     {
-        *dps = (float)(reg * 70.0f / 1000.0f);                                        /* convert */
+        return 2;                           /* return error */
     }
     
-    return 0;                                                                         /* success return 0 */
+    *count = handle->async_count;           /* get the count */
+    
+    return 0;                               /* success return 0 */
 }
 
 /**
- * @brief     interrupt handler
+ * @brief     async transfer complete handler
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] num interrupt number
+ * @param[in] res transfer result, 0 means success
  * @return    status code
  *            - 0 success
- *            - 1 run failed
+ *            - 1 no request is running
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      call it from the dma or bus interrupt when a started transfer finishes,
+ *            the queue is not locked, so mask that interrupt around a submit from thread context,
+ *            a submit from a completion callback is safe
  */
-uint8_t l3gd20h_irq_handler(l3gd20h_handle_t *handle, uint8_t num)
+uint8_t l3gd20h_async_irq_handler(l3gd20h_handle_t *handle, uint8_t res)
 {
-    uint8_t res, prev;
-  
-    if (handle == NULL)                                                                      /* check handle */
+    uint8_t cnt;
+    uint8_t range;
+    int16_t offset[3];
+    const int16_t *off;
+    l3gd20h_async_request_t *req;
+    
+#if (L3GD20H_CHECK_ENABLE == 1)
+    if (handle == NULL)                                                                                     /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                                /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                                           /* return error */
+    }
+#endif
+    if ((handle->async_busy == 0) || (handle->async_count == 0))                                            /* check the running request */
+    {
+        return 1;                                                                                           /* return error */
     }
     
-    if (num == 1)                                                                            /* interrupt 1 */
+    req = &handle->async_queue[handle->async_head];                                                         /* get the head */
+    if (res != 0)                                                                                           /* check result */
     {
-        res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_IG_SRC, (uint8_t *)&prev, 1);       /* read config */
-        if (res != 0)                                                                        /* check result */
+        L3GD20H_PRINT(handle, "l3gd20h: async transfer failed.\n");                                         /* async transfer failed */
+        L3GD20H_COUNT(handle, errors, 1);                                                                   /* count the error */
+        a_l3gd20h_async_finish(handle, 1);                                                                  /* finish with error */
+        
+        return 0;                                                                                           /* success return 0 */
+    }
+    req->state++;                                                                                           /* next step */
+    if (req->type == L3GD20H_ASYNC_TYPE_CONFIG)                                                             /* config */
+    {
+        if (req->state == 1)                                                                                /* register is read */
         {
-            handle->debug_print("l3gd20h: read interrupt source failed.\n");                 /* read interrupt source failed */
-      
-            return 1;                                                                        /* return error */
+            req->prev = (uint8_t)((req->prev & ~req->mask) | (req->value & req->mask));                     /* modify the bits */
+            res = a_l3gd20h_async_start(handle, 0, req->reg, &req->prev, 1);                                /* write the register */
         }
-        if ((prev & (1 << 6)) != 0)                                                          /* check active */
+        else                                                                                                /* register is written */
         {
-            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
-            {
-                handle->receive_callback(L3GD20H_INTERRUPT1_INTERRUPT_ACTIVE);               /* run receive callback */
-            }
+            a_l3gd20h_async_finish(handle, 0);                                                              /* finish */
+            
+            return 0;                                                                                       /* success return 0 */
         }
-        if ((prev & (1 << 5)) != 0)                                                          /* check z high */
+    }
+    else if (req->type == L3GD20H_ASYNC_TYPE_READ)                                                          /* read */
+    {
+        if (req->state == 1)                                                                                /* ctrl4 is read */
         {
-            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
-            {
-                handle->receive_callback(L3GD20H_INTERRUPT1_Z_HIGH);                         /* run receive callback */
-            }
+            res = a_l3gd20h_async_start(handle, 1, L3GD20H_REG_OUT_X_L, (uint8_t *)req->raw, 6);            /* read the data */
         }
-        if ((prev & (1 << 4)) != 0)                                                          /* check z low */
+        else                                                                                                /* data is read */
         {
-            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
-            {
-                handle->receive_callback(L3GD20H_INTERRUPT1_Z_LOW);                          /* run receive callback */
-            }
+            range = (req->ctrl4 >> 4) & 0x03;                                                               /* get the range */
+            off = a_l3gd20h_range_decode(handle, (uint8_t *)req->raw, (req->ctrl4 >> 6) & 0x01, range, offset,
+                                         req->raw, req->dps, 1);                                            /* decode in place */
+            L3GD20H_COUNT(handle, samples_delivered, 1);                                                    /* count the sample */
+            a_l3gd20h_read_finish(handle, NULL, 0, req->ctrl4, 0, 1, off, req->raw, req->dps,
+                                  &req->len, NULL);                                                         /* finish the batch */
+            a_l3gd20h_async_finish(handle, 0);                                                              /* finish */
+            
+            return 0;                                                                                       /* success return 0 */
         }
-        if ((prev & (1 << 3)) != 0)                                                          /* check y high */
+    }
+    else                                                                                                    /* drain */
+    {
+        if (req->state == 1)                                                                                /* ctrl4 is read */
         {
-            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
+            res = a_l3gd20h_async_start(handle, 1, L3GD20H_REG_FIFO_SRC, &req->prev, 1);                    /* read fifo source */
+        }
+        else if (req->state == 2)                                                                           /* fifo source is read */
+        {
+            if ((req->prev & (1 << 6)) != 0)                                                                /* check fifo overrun */
             {
-                handle->receive_callback(L3GD20H_INTERRUPT1_Y_HIGH);                         /* run receive callback */
+                L3GD20H_COUNT(handle, fifo_overrun, 1);                                                     /* count the overrun */
             }
-        }
-        if ((prev & (1 << 2)) != 0)                                                          /* check y low */
-        {                                                                                    /* check y low */
-            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
+            cnt = req->prev & 0x1F;                                                                         /* get counter */
+            req->len = (req->len < cnt) ? req->len : cnt;                                                   /* get the length */
+#if (L3GD20H_SETTLE_ENABLE == 1)
+            if ((handle->settle_queued != 0) && (handle->settle_queued < req->len))                         /* samples from before the change */
             {
-                handle->receive_callback(L3GD20H_INTERRUPT1_Y_LOW);                          /* run receive callback */
+                req->len = handle->settle_queued;                                                           /* keep them apart from the window */
             }
-        }
-        if ((prev & (1 << 1)) != 0)                                                          /* check x high */
-        {
-            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
+#endif
+            if (req->len == 0)                                                                              /* fifo is empty */
             {
-                handle->receive_callback(L3GD20H_INTERRUPT1_X_HIGH);                         /* run receive callback */
+                a_l3gd20h_async_finish(handle, 0);                                                          /* finish */
+                
+                return 0;                                                                                   /* success return 0 */
             }
+            res = a_l3gd20h_async_start(handle, 1, L3GD20H_REG_OUT_X_L, (uint8_t *)req->raw, 6 * req->len); /* read all data */
         }
-        if ((prev & (1 << 0)) != 0)                                                          /* check x low */
+        else                                                                                                /* data is read */
         {
-            if (handle->receive_callback != NULL)                                            /* receive callback is valid */
-           {
-               handle->receive_callback(L3GD20H_INTERRUPT1_X_LOW);                           /* run receive callback */
-           }
+            range = (req->ctrl4 >> 4) & 0x03;                                                               /* get the range */
+            off = a_l3gd20h_range_decode(handle, (uint8_t *)req->raw, (req->ctrl4 >> 6) & 0x01, range, offset,
+                                         req->raw, req->dps, req->len);                                     /* decode in place */
+            L3GD20H_COUNT(handle, samples_delivered, req->len);                                             /* count the samples */
+            a_l3gd20h_read_finish(handle, NULL, 0, req->ctrl4, 1, 1, off, req->raw, req->dps,
+                                  &req->len, NULL);                                                         /* finish the batch */
+            a_l3gd20h_async_finish(handle, 0);                                                              /* finish */
+            
+            return 0;                                                                                       /* success return 0 */
         }
-        
-        return 0;                                                                            /* success return 0 */
-  }
-  else if (num == 2)                                                                         /* interrupt 2 */
-  {
-      res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_STATUS, (uint8_t *)&prev, 1);         /* read config */
-      if (res != 0)                                                                          /* check result */
-      {
-          handle->debug_print("l3gd20h: read status failed.\n");                             /* read status failed */
-      
-          return 1;                                                                          /* return error */
-      }
-      if ((prev & (1 << L3GD20H_STATUS_XYZ_OVERRUN)) != 0)                                   /* check status xyz overrun */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_XYZ_OVERRUN);                      /* run receive callback */
-          }
-      }
-      if ((prev & (1 << L3GD20H_STATUS_Z_OVERRUN)) != 0)                                     /* check status z overrun */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_Z_OVERRUN);                        /* run receive callback */
-          }
-      }
-      if ((prev & (1 << L3GD20H_STATUS_Y_OVERRUN)) != 0)                                     /* check status y overrun */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_Y_OVERRUN);                        /* run receive callback */
-          }
-      }
-      if ((prev & (1 << L3GD20H_STATUS_X_OVERRUN)) != 0)                                     /* check status x overrun */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_X_OVERRUN);                        /* run receive callback */
-          }
-      }
-      if ((prev & (1 << L3GD20H_STATUS_XYZ_DATA_READY)) != 0)                                /* check status xyz data ready */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_XYZ_DATA_READY);                   /* run receive callback */
-          }
-      }
-      if ((prev & (1 << L3GD20H_STATUS_Z_DATA_READY)) != 0)                                  /* check status z data ready */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_Z_DATA_READY);                     /* run receive callback */
-          }
-      }
-      if ((prev & (1 << L3GD20H_STATUS_Y_DATA_READY)) != 0)                                  /* check status y data ready */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_Y_DATA_READY);                     /* run receive callback */
-          }
-      }
-      if ((prev & (1 << L3GD20H_STATUS_X_DATA_READY)) != 0)                                  /* check status x data ready */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_X_DATA_READY);                     /* run receive callback */
-          }
-      }
+    }
+    if (res != 0)                                                                                           /* check the start */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: async start failed.\n");                                            /* async start failed */
+        a_l3gd20h_async_finish(handle, 1);                                                                  /* finish with error */
+    }
+    
+    return 0;                                                                                               /* success return 0 */
+}
+#endif
 
-      res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_SRC, (uint8_t *)&prev, 1);       /* read config */
-      if (res != 0)                                                                          /* check result */
-      {
-          handle->debug_print("l3gd20h: read fifo source failed.\n");                        /* read fifo source failed*/
-      
-          return 1;                                                                          /* return error */
-      }
-      if ((prev & (1 << 7)) != 0)                                                            /* check fifo threshold */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_FIFO_THRESHOLD);                   /* run receive callback */
-          }
-      }
-      if ((prev & (1 << 6)) != 0)                                                            /* check fifo overrun */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_FIFO_OVERRRUN);                    /* run receive callback */
-          }
-      }
-      if ((prev & (1 << 5)) != 0)                                                            /* check fifo empty */
-      {
-          if (handle->receive_callback != NULL)                                              /* receive callback is valid */
-          {
-              handle->receive_callback(L3GD20H_INTERRUPT2_FIFO_EMPTY);                       /* run receive callback */
-          }
-      }
-      
-      return 0;                                                                              /* success return 0 */
-  }
-  else
-  {
-      handle->debug_print("l3gd20h: interrupt number is invalid.\n");                        /* interrupt number is invalid */
+#if (L3GD20H_COUNTER_ENABLE == 1)
+/**
+ * @brief      take a snapshot of the performance counters
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *counter pointer to a counter structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the histograms are only filled when timestamp_us is linked
+ */
+uint8_t l3gd20h_counter_snapshot(l3gd20h_handle_t *handle, l3gd20h_counter_t *counter)
+{
+    if (handle == NULL)                                                   /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (handle->inited != 1)                                              /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    
+    memcpy(counter, &handle->counter, sizeof(l3gd20h_counter_t));         /* copy the counters */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     reset the performance counters
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_counter_reset(l3gd20h_handle_t *handle)
+{
+    if (handle == NULL)                                                   /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (handle->inited != 1)                                              /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    
+    memset(&handle->counter, 0, sizeof(l3gd20h_counter_t));              /* clear the counters */
+    
+    return 0;                                                             /* success return 0 */
+}
+#endif
+
+#if (L3GD20H_TRACE_ENABLE == 1)
+/**
+ * @brief         read the trace ring
+ * @param[in]     *handle pointer to an l3gd20h handle structure
+ * @param[out]    *trace pointer to a trace buffer
+ * @param[in,out] *len pointer to a trace length buffer
+ * @param[out]    *lost pointer to an overwritten entry number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          the entries are returned oldest first and removed from the ring,
+ *                the timestamps are only valid when timestamp_us is linked
+ */
+uint8_t l3gd20h_trace_read(l3gd20h_handle_t *handle, l3gd20h_trace_t *trace, uint16_t *len, uint32_t *lost)
+{
+    uint32_t tail;
+    uint16_t i;
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    
+    tail = handle->trace_head - handle->trace_count;                                            /* get the oldest entry */
+    *len = (uint16_t)(((*len) < handle->trace_count) ? (*len) : handle->trace_count);           /* get the length */
+    for (i = 0; i < (*len); i++)                                                                /* copy the entries */
+    {
+        trace[i] = handle->trace[(tail + i) & (L3GD20H_TRACE_DEPTH - 1)];                       /* copy one entry */
+    }
+    handle->trace_count -= *len;                                                                /* remove the entries */
+    *lost = handle->trace_lost;                                                                 /* get the lost entries */
+    handle->trace_lost = 0;                                                                     /* clear the lost entries */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     clear the trace ring
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_trace_clear(l3gd20h_handle_t *handle)
+{
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
     
-      return 1;                                                                              /* return error */
-  }
+    handle->trace_count = 0;                                                                    /* clear the entries */
+    handle->trace_lost = 0;                                                                     /* clear the lost entries */
+    
+    return 0;                                                                                   /* success return 0 */
 }
+#endif
 
+#if (L3GD20H_TIMESTAMP_ENABLE == 1)
 /**
- * @brief     initialize the chip
- * @param[in] *handle pointer to an l3gd20h handle structure
+ * @brief     init a timestamp structure
+ * @param[in] *ts pointer to a timestamp structure
+ * @param[in] rate rate bandwidth
  * @return    status code
  *            - 0 success
- *            - 1 spi or iic initialization failed
- *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 id is invalid
- * @note      none
+ *            - 2 ts is NULL
+ *            - 4 rate is invalid
+ * @note      the period starts at the nominal output data rate of the rate and follows the drift estimate
  */
-uint8_t l3gd20h_init(l3gd20h_handle_t *handle)
+uint8_t l3gd20h_timestamp_init(l3gd20h_timestamp_t *ts, l3gd20h_lodr_odr_bw_t rate)
 {
-    uint8_t res, prev;
-    uint8_t id;
-  
-    if (handle == NULL)                                                                   /* check handle */
+    if (ts == NULL)                                                                             /* check ts */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->debug_print == NULL)                                                      /* check debug_print */
+    if ((uint8_t)rate > L3GD20H_LOW_ODR_1_ODR_50HZ_BW_3_16P6HZ)                                 /* check rate */
     {
-        return 3;                                                                         /* return error */
+        return 4;                                                                               /* return error */
     }
-    if (handle->iic_init == NULL)                                                         /* check iic_init */
+    
+    ts->next_ns = 0;                                                                            /* no prediction */
+    ts->nominal_ns = gs_l3gd20h_period_ns[((uint8_t)rate >> 2) & 0x07];                         /* set the nominal period */
+    ts->period_ns = ts->nominal_ns;                                                             /* start at the nominal period */
+    ts->bound_ns = 0;                                                                           /* no estimate */
+    ts->residual_ns = 0;                                                                        /* no residual */
+    ts->samples = 0;                                                                            /* no sample */
+    ts->last_us = 0;                                                                            /* no sample time */
+    ts->point_head = 0;                                                                         /* reset the window */
+    ts->point_count = 0;                                                                        /* empty window */
+    ts->locked = 0;                                                                             /* start unlocked */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      assign the sample times of a batch
+ * @param[in]  *ts pointer to a timestamp structure
+ * @param[in]  anchor_us time of the anchor sample in us
+ * @param[in]  anchor index of the anchor sample in the batch
+ * @param[in]  len batch length
+ * @param[out] *us pointer to a timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ts is NULL
+ *             - 3 ts is not initialized
+ * @note       an interrupt driven reader passes the interrupt time and the index of the sample
+ *             that raised it, the times stay continuous with the previous batch
+ */
+uint8_t l3gd20h_timestamp_assign(l3gd20h_timestamp_t *ts, uint64_t anchor_us, uint16_t anchor,
+                                 uint16_t len, uint64_t *us)
+{
+    if (ts == NULL)                                                                             /* check ts */
     {
-        handle->debug_print("l3gd20h: iic_init is null.\n");                              /* iic_init is null */
+        return 2;                                                                               /* return error */
+    }
+    if (ts->period_ns == 0)                                                                     /* check initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
     
-        return 3;                                                                         /* return error */
+    if (len != 0)                                                                               /* not empty */
+    {
+        a_l3gd20h_timestamp_assign(ts, anchor_us * 1000, anchor, len, us);                      /* assign the times */
     }
-    if (handle->iic_deinit == NULL)                                                       /* check iic_deinit */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the estimated output data rate
+ * @param[in]  *ts pointer to a timestamp structure
+ * @param[out] *odr pointer to an output data rate buffer in Hz
+ * @param[out] *bound pointer to a confidence bound buffer in Hz
+ * @return     status code
+ *             - 0 success
+ *             - 2 ts is NULL
+ *             - 3 ts is not initialized
+ *             - 4 estimate has not converged
+ * @note       the sample times follow the estimate from L3GD20H_TIMESTAMP_POINT_MIN drift points on,
+ *             it is only reported once the window holds L3GD20H_TIMESTAMP_WINDOW points, the real rate
+ *             lies within odr - bound and odr + bound while the host clock is good
+ */
+uint8_t l3gd20h_timestamp_get_odr(l3gd20h_timestamp_t *ts, float *odr, float *bound)
+{
+    if (ts == NULL)                                                                             /* check ts */
     {
-        handle->debug_print("l3gd20h: iic_deinit is null.\n");                            /* iic_deinit is null */
-        
-        return 3;                                                                         /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->iic_read == NULL)                                                         /* check iic_read */
+    if (ts->period_ns == 0)                                                                     /* check initialization */
     {
-        handle->debug_print("l3gd20h: iic_read is null.\n");                              /* iic_read is null */
+        return 3;                                                                               /* return error */
+    }
+    if ((ts->point_count < L3GD20H_TIMESTAMP_WINDOW) || (ts->bound_ns == 0))                   /* check the estimate */
+    {
+        return 4;                                                                               /* return error */
+    }
     
-        return 3;                                                                         /* return error */
+    *odr = 1000000000.0f / (float)ts->period_ns;                                                /* get the rate */
+    *bound = (*odr) * (float)ts->bound_ns / (float)ts->period_ns;                               /* get the bound */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+#endif
+
+#if (L3GD20H_BIAS_ENABLE == 1)
+/**
+ * @brief     compute the checksum of a calibration blob
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc-8 with the polynomial 0x07
+ * @note      none
+ */
+static uint8_t a_l3gd20h_bias_crc(const uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t crc;
+    
+    crc = 0x00;                                                                                 /* init 0 */
+    for (i = 0; i < len; i++)                                                                   /* each byte */
+    {
+        crc ^= buf[i];                                                                          /* xor the byte */
+        for (j = 0; j < 8; j++)                                                                 /* each bit */
+        {
+            crc = ((crc & 0x80) != 0) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);     /* shift */
+        }
     }
-    if (handle->iic_write == NULL)                                                        /* check iic_write */
+    
+    return crc;                                                                                 /* return the crc */
+}
+
+/**
+ * @brief     set the bias compensation mode
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] mode bias compensation mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 mode is invalid
+ * @note      the bias is subtracted from the raw data during the decode, so the converted data
+ *            is compensated too, the running window restarts and the stored bias is kept
+ */
+uint8_t l3gd20h_bias_set_mode(l3gd20h_handle_t *handle, l3gd20h_bias_t mode)
+{
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (mode > L3GD20H_BIAS_TRACK)                                                              /* check mode */
     {
-        handle->debug_print("l3gd20h: iic_write is null.\n");                             /* iic_write is null */
+        L3GD20H_PRINT(handle, "l3gd20h: mode is invalid.\n");                                   /* mode is invalid */
+        
+        return 4;                                                                               /* return error */
+    }
     
-        return 3;                                                                         /* return error */
+    handle->bias_mode = (uint8_t)mode;                                                          /* set the mode */
+    a_l3gd20h_still_restart(&handle->bias_still);                                               /* restart the window */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the bias compensation mode
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *mode pointer to a bias compensation mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_bias_get_mode(l3gd20h_handle_t *handle, l3gd20h_bias_t *mode)
+{
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
     }
-    if (handle->spi_init == NULL)                                                         /* check spi_init */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        handle->debug_print("l3gd20h: spi_init is null.\n");                              /* spi_init is null */
+        return 3;                                                                               /* return error */
+    }
     
-        return 3;                                                                         /* return error */
+    *mode = (l3gd20h_bias_t)(handle->bias_mode);                                                /* get the mode */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     set the still threshold
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] dps standard deviation threshold in dps
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 dps is invalid
+ * @note      0 < dps <= 100, it should sit above the noise of the selected bandwidth
+ */
+uint8_t l3gd20h_bias_set_threshold(l3gd20h_handle_t *handle, float dps)
+{
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
     }
-    if (handle->spi_deinit == NULL)                                                       /* check spi_deinit */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (!((dps > 0.0f) && (dps <= 100.0f)))                                                     /* check dps */
     {
-        handle->debug_print("l3gd20h: spi_deinit is null.\n");                            /* spi_deinit is null */
+        L3GD20H_PRINT(handle, "l3gd20h: dps is invalid.\n");                                    /* dps is invalid */
+        
+        return 4;                                                                               /* return error */
+    }
     
-        return 3;                                                                         /* return error */
+    handle->bias_limit = a_l3gd20h_bias_limit(dps);                                             /* set the threshold */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the bias
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *dps pointer to a bias buffer in dps
+ * @param[out] *windows pointer to a still windows buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       windows is 0 until the first still window or load
+ */
+uint8_t l3gd20h_bias_get(l3gd20h_handle_t *handle, float dps[3], uint32_t *windows)
+{
+    uint8_t i;
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
     }
-    if (handle->spi_read == NULL)                                                         /* check spi_read */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        handle->debug_print("l3gd20h: spi_read is null.\n");                              /* spi_read is null */
+        return 3;                                                                               /* return error */
+    }
     
-        return 3;                                                                         /* return error */
+    for (i = 0; i < 3; i++)                                                                     /* each axis */
+    {
+        dps[i] = (float)handle->bias[i] * 8.75f / 1000.0f /
+                 (float)(1 << L3GD20H_BIAS_FRACTION_BITS);                                      /* convert the bias */
     }
-    if (handle->spi_write == NULL)                                                        /* check spi_write */
+    *windows = handle->bias_windows;                                                            /* get the windows */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     clear the bias
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_bias_reset(l3gd20h_handle_t *handle)
+{
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        handle->debug_print("l3gd20h: spi_write is null.\n");                             /* spi_write is null */
+        return 3;                                                                               /* return error */
+    }
     
-        return 3;                                                                         /* return error */
+    handle->bias[0] = 0;                                                                        /* clear x */
+    handle->bias[1] = 0;                                                                        /* clear y */
+    handle->bias[2] = 0;                                                                        /* clear z */
+    handle->bias_windows = 0;                                                                   /* no bias */
+    a_l3gd20h_still_restart(&handle->bias_still);                                               /* restart the window */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      save the bias to a calibration blob
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *blob pointer to a L3GD20H_BIAS_BLOB_SIZE bytes buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no bias yet
+ * @note       the blob is byte ordered and can be stored as it is
+ */
+uint8_t l3gd20h_bias_save(l3gd20h_handle_t *handle, uint8_t *blob)
+{
+    uint8_t i;
+    uint32_t v;
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
     }
-    if (handle->delay_ms == NULL)                                                         /* check delay_ms */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (handle->bias_windows == 0)                                                              /* check the bias */
     {
-        handle->debug_print("l3gd20h: delay_ms is null.\n");                              /* delay_ms is null */
+        L3GD20H_PRINT(handle, "l3gd20h: no bias yet.\n");                                       /* no bias yet */
+        
+        return 4;                                                                               /* return error */
+    }
     
-        return 3;                                                                         /* return error */
+    blob[0] = 'B';                                                                              /* set the magic */
+    blob[1] = 0x01;                                                                             /* set the version */
+    for (i = 0; i < 3; i++)                                                                     /* each axis */
+    {
+        v = (uint32_t)handle->bias[i];                                                          /* get the bias */
+        blob[2 + i * 4 + 0] = (uint8_t)(v >> 0);                                                /* set byte 0 */
+        blob[2 + i * 4 + 1] = (uint8_t)(v >> 8);                                                /* set byte 1 */
+        blob[2 + i * 4 + 2] = (uint8_t)(v >> 16);                                               /* set byte 2 */
+        blob[2 + i * 4 + 3] = (uint8_t)(v >> 24);                                               /* set byte 3 */
     }
+    v = handle->bias_windows;                                                                   /* get the windows */
+    blob[14] = (uint8_t)(v >> 0);                                                               /* set byte 0 */
+    blob[15] = (uint8_t)(v >> 8);                                                               /* set byte 1 */
+    blob[16] = (uint8_t)(v >> 16);                                                              /* set byte 2 */
+    blob[17] = (uint8_t)(v >> 24);                                                              /* set byte 3 */
+    blob[18] = L3GD20H_BIAS_FRACTION_BITS;                                                      /* set the fraction bits */
+    blob[19] = a_l3gd20h_bias_crc(blob, 19);                                                    /* set the checksum */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     load the bias from a calibration blob
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] *blob pointer to a L3GD20H_BIAS_BLOB_SIZE bytes buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 blob is invalid
+ * @note      the loaded bias keeps its window count, so tracking goes on with the small gain
+ */
+uint8_t l3gd20h_bias_load(l3gd20h_handle_t *handle, const uint8_t *blob)
+{
+    uint8_t i;
+    int32_t bias[3];
+    int32_t limit;
+    uint32_t windows;
     
-    if (handle->iic_spi == L3GD20H_INTERFACE_IIC)                                         /* iic interface */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        if (handle->iic_init() != 0)                                                      /* initialize iic bus */
-        {
-            handle->debug_print("l3gd20h: iic init failed.\n");                           /* iic init failed */
-      
-            return 1;                                                                     /* return error */
-        }
+        return 2;                                                                               /* return error */
     }
-    else
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        if (handle->spi_init() != 0)                                                      /* initialize spi bus */
+        return 3;                                                                               /* return error */
+    }
+    if ((blob[0] != 'B') || (blob[1] != 0x01) || (blob[18] != L3GD20H_BIAS_FRACTION_BITS) ||
+        (a_l3gd20h_bias_crc(blob, 19) != blob[19]))                                             /* check the blob */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: blob is invalid.\n");                                   /* blob is invalid */
+        
+        return 4;                                                                               /* return error */
+    }
+    
+    limit = (int32_t)L3GD20H_BIAS_LIMIT;                                                        /* get the limit */
+    for (i = 0; i < 3; i++)                                                                     /* each axis */
+    {
+        bias[i] = (int32_t)(((uint32_t)blob[2 + i * 4 + 0] << 0) | ((uint32_t)blob[2 + i * 4 + 1] << 8) |
+                            ((uint32_t)blob[2 + i * 4 + 2] << 16) | ((uint32_t)blob[2 + i * 4 + 3] << 24));    /* get the bias */
+        if ((bias[i] > limit) || (bias[i] < -limit))                                            /* check the range */
         {
-            handle->debug_print("l3gd20h: spi init failed.\n");                           /* spi init failed */
-      
-            return 1;                                                                     /* return error */
+            L3GD20H_PRINT(handle, "l3gd20h: blob is invalid.\n");                               /* blob is invalid */
+            
+            return 4;                                                                           /* return error */
         }
     }
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_WHO_AM_I, (uint8_t *)&id, 1) != 0)     /* read id */
+    windows = ((uint32_t)blob[14] << 0) | ((uint32_t)blob[15] << 8) |
+              ((uint32_t)blob[16] << 16) | ((uint32_t)blob[17] << 24);                          /* get the windows */
+    handle->bias[0] = bias[0];                                                                  /* set x */
+    handle->bias[1] = bias[1];                                                                  /* set y */
+    handle->bias[2] = bias[2];                                                                  /* set z */
+    handle->bias_windows = (windows == 0) ? 1 : windows;                                        /* a loaded bias is valid */
+    a_l3gd20h_still_restart(&handle->bias_still);                                               /* restart the window */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     get the absolute value
+ * @param[in] v value
+ * @return    absolute value
+ * @note      the driver does not link the math library
+ */
+static double a_l3gd20h_fabs(double v)
+{
+    return (v < 0.0) ? -v : v;                                                                  /* return the value */
+}
+
+/**
+ * @brief     fit the bias temperature model
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] *temp pointer to a temperature buffer in degrees
+ * @param[in] **dps pointer to a still bias buffer in dps
+ * @param[in] len number of pairs
+ * @param[in] order polynomial order
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 order is invalid
+ *            - 5 len is too small
+ *            - 6 temperatures are too close
+ * @note      the pairs are logged still biases with the compensation off, the model term is added to
+ *            the stored bias, so a tracked or saved bias is the residual of the model
+ */
+uint8_t l3gd20h_bias_temp_fit(l3gd20h_handle_t *handle, const float *temp, const float (*dps)[3],
+                              uint16_t len, uint8_t order)
+{
+    double a[L3GD20H_BIAS_TEMP_ORDER + 1][L3GD20H_BIAS_TEMP_ORDER + 4];
+    double p[2 * L3GD20H_BIAS_TEMP_ORDER + 1];
+    double tref;
+    double f;
+    uint16_t i;
+    uint8_t n, r, c, k;
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (order > L3GD20H_BIAS_TEMP_ORDER)                                                        /* check order */
     {
-        handle->debug_print("l3gd20h: read id failed.\n");                                /* read id failed */
-        if (handle->iic_spi == L3GD20H_INTERFACE_IIC)                                     /* if iic interface */
-        {
-            (void)handle->iic_deinit();                                                   /* iic deinit */
-        }
-        else                                                                              /* spi interface */
-        {
-            (void)handle->spi_deinit();                                                   /* spi deinit */
-        }
+        L3GD20H_PRINT(handle, "l3gd20h: order is invalid.\n");                                  /* order is invalid */
         
-        return 1;                                                                         /* return error */
+        return 4;                                                                               /* return error */
     }
-    if (id != 0xD7)                                                                       /* check id */
+    if (len <= order)                                                                           /* check len */
     {
-        handle->debug_print("l3gd20h: id is invalid.\n");                                 /* id is invalid */
-        if (handle->iic_spi == L3GD20H_INTERFACE_IIC)                                     /* if iic interface */
-        {
-            (void)handle->iic_deinit();                                                   /* iic deinit */
-        }
-        else
-        {
-            (void)handle->spi_deinit();                                                   /* spi deinit */
-        }
+        L3GD20H_PRINT(handle, "l3gd20h: len is too small.\n");                                  /* len is too small */
         
-        return 4;                                                                         /* return error */
+        return 5;                                                                               /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                         /* check result */
+    n = (uint8_t)(order + 1);                                                                   /* unknowns */
+    tref = 0.0;                                                                                 /* init 0 */
+    for (i = 0; i < len; i++)                                                                   /* each pair */
     {
-        handle->debug_print("l3gd20h: read low odr failed.\n");                           /* read low odr failed */
-        if (handle->iic_spi == L3GD20H_INTERFACE_IIC)                                     /* if iic interface */
-        {                                                                               
-            (void)handle->iic_deinit();                                                   /* iic deinit */
+        tref += temp[i];                                                                        /* sum the temperatures */
+    }
+    tref /= (double)len;                                                                        /* center the fit */
+    memset(a, 0, sizeof(a));                                                                    /* clear the equations */
+    for (i = 0; i < len; i++)                                                                   /* each pair */
+    {
+        p[0] = 1.0;                                                                             /* power 0 */
+        for (k = 1; k < 2 * n - 1; k++)                                                         /* other powers */
+        {
+            p[k] = p[k - 1] * ((double)temp[i] - tref);                                         /* next power */
         }
-        else
+        for (r = 0; r < n; r++)                                                                 /* each row */
         {
-            (void)handle->spi_deinit();                                                   /* spi deinit */
+            for (c = 0; c < n; c++)                                                             /* each column */
+            {
+                a[r][c] += p[r + c];                                                            /* normal matrix */
+            }
+            for (k = 0; k < 3; k++)                                                             /* each axis */
+            {
+                a[r][n + k] += p[r] * dps[i][k];                                                /* right side */
+            }
         }
-    
-        return 1;                                                                         /* return error */
     }
-    prev &= ~(1 << 2);                                                                    /* clear reset bit */
-    prev |= 1 << 2;                                                                       /* set reset bit */
-    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);      /* write config */
-    if (res != 0)                                                                         /* check result */
+    for (c = 0; c < n; c++)                                                                     /* gauss elimination */
     {
-        handle->debug_print("l3gd20h: write low odr failed.\n");                          /* write low odr failed */
-        if (handle->iic_spi == L3GD20H_INTERFACE_IIC)                                     /* if iic interface */
+        k = c;                                                                                  /* pivot row */
+        for (r = (uint8_t)(c + 1); r < n; r++)                                                  /* find the pivot */
         {
-            (void)handle->iic_deinit();                                                   /* iic deinit */
+            k = (a_l3gd20h_fabs(a[r][c]) > a_l3gd20h_fabs(a[k][c])) ? r : k;                                        /* larger pivot */
         }
-        else
+        if (a_l3gd20h_fabs(a[k][c]) < 1e-6)                                                               /* singular */
         {
-            (void)handle->spi_deinit();                                                   /* spi deinit */
+            L3GD20H_PRINT(handle, "l3gd20h: temperatures are too close.\n");                    /* temperatures are too close */
+            
+            return 6;                                                                           /* return error */
         }
-        
-        return 1;                                                                         /* return error */
-    }
-    handle->delay_ms(12);                                                                 /* delay 12 ms */
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_LOW_ODR, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("l3gd20h: read low odr failed.\n");                           /* read low odr failed */
-        if (handle->iic_spi == L3GD20H_INTERFACE_IIC)                                     /* if iic interface */
+        for (r = 0; r < n + 3; r++)                                                             /* swap the rows */
         {
-            (void)handle->iic_deinit();                                                   /* iic deinit */
+            f = a[c][r];                                                                        /* save */
+            a[c][r] = a[k][r];                                                                  /* move */
+            a[k][r] = f;                                                                        /* restore */
         }
-        else
+        for (r = 0; r < n; r++)                                                                 /* eliminate */
         {
-            (void)handle->spi_deinit();                                                   /* spi deinit */
+            if (r != c)                                                                         /* other rows */
+            {
+                f = a[r][c] / a[c][c];                                                          /* factor */
+                for (k = c; k < n + 3; k++)                                                     /* each column */
+                {
+                    a[r][k] -= f * a[c][k];                                                     /* subtract */
+                }
+            }
         }
-    
-        return 1;                                                                         /* return error */
     }
-    if (((prev >> 2) & 0x01) != 0x0)                                                      /* check result */
+    for (k = 0; k < 3; k++)                                                                     /* each axis */
     {
-        handle->debug_print("l3gd20h: reset chip failed.\n");                             /* reset chip failed */
-        if (handle->iic_spi == L3GD20H_INTERFACE_IIC)                                     /* if iic interface */
-        {
-            (void)handle->iic_deinit();                                                   /* iic deinit */
-        }
-        else
+        for (r = 0; r <= L3GD20H_BIAS_TEMP_ORDER; r++)                                          /* each coefficient */
         {
-            (void)handle->spi_deinit();                                                   /* spi deinit */
+            handle->bias_coeff[k][r] = (r < n) ? (float)(a[r][n + k] / a[r][r]) : 0.0f;         /* solve */
         }
-    
-        return 1;                                                                         /* return error */
+        handle->bias_temp[k] = 0;                                                               /* no term until the next read */
     }
+    handle->bias_tref = (float)tref;                                                            /* save the reference */
+    handle->bias_temp_countdown = 0;                                                            /* read on the next burst */
+    handle->bias_temp_state = 0x01;                                                             /* model is loaded */
+    a_l3gd20h_still_restart(&handle->bias_still);                                               /* restart the window */
     
-    handle->inited = 1;                                                                   /* flag finish initialization */
-  
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief     clear the bias temperature model
  * @param[in] *handle pointer to an l3gd20h handle structure
  * @return    status code
  *            - 0 success
- *            - 1 iic or spi deinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 power down failed
- * @note      none
+ * @note      the temperature reads stop
  */
-uint8_t l3gd20h_deinit(l3gd20h_handle_t *handle)
+uint8_t l3gd20h_bias_temp_clear(l3gd20h_handle_t *handle)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                               /* return error */
     }
     
-    res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                        /* check result */
+    memset(handle->bias_coeff, 0, sizeof(handle->bias_coeff));                                  /* clear the model */
+    handle->bias_temp[0] = 0;                                                                   /* clear x */
+    handle->bias_temp[1] = 0;                                                                   /* clear y */
+    handle->bias_temp[2] = 0;                                                                   /* clear z */
+    handle->bias_temp_state = 0;                                                                /* no model */
+    a_l3gd20h_still_restart(&handle->bias_still);                                               /* restart the window */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the temperature term of the bias
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *degree pointer to a temperature buffer in degrees
+ * @param[out] *dps pointer to a temperature term buffer in dps
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no model or no temperature yet
+ * @note       the term follows the temperature read by the last burst
+ */
+uint8_t l3gd20h_bias_temp_get(l3gd20h_handle_t *handle, float *degree, float dps[3])
+{
+    uint8_t i;
+    
+    if (handle == NULL)                                                                         /* check handle */
     {
-        handle->debug_print("l3gd20h: read ctrl1 failed.\n");                            /* read ctrl1 failed */
-        
-        return 4;                                                                        /* return error */
+        return 2;                                                                               /* return error */
     }
-    prev &= ~(1 << 3);                                                                   /* set power down bit */
-    res = a_l3gd20h_iic_spi_write(handle, L3GD20H_REG_CTRL1, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                        /* check result */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        handle->debug_print("l3gd20h: write ctrl1 failed.\n");                           /* write ctrl1 failed */
-        
-        return 4;                                                                        /* return error */
+        return 3;                                                                               /* return error */
+    }
+    if (handle->bias_temp_state != 0x03)                                                        /* check the model */
+    {
+        return 4;                                                                               /* return error */
     }
-    handle->inited = 0;                                                                  /* flag close */
     
-    return 0;                                                                            /* success return 0 */
+    *degree = 25.0f - (float)handle->bias_temp_raw;                                             /* convert the temperature */
+    for (i = 0; i < 3; i++)                                                                     /* each axis */
+    {
+        dps[i] = (float)handle->bias_temp[i] * 8.75f / 1000.0f /
+                 (float)(1 << L3GD20H_BIAS_FRACTION_BITS);                                      /* convert the term */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief         read the data
- * @param[in]     *handle pointer to an l3gd20h handle structure
- * @param[out]    **raw pointer to a raw data buffer
- * @param[out]    **dps pointer to a converted data buffer
- * @param[in,out] *len pointer to a date length buffer
- * @return        status code
- *                - 0 success
- *                - 1 read failed
- *                - 2 handle is NULL
- *                - 3 handle is not initialized
- *                - 4 len is invalid
- * @note          none
+ * @brief     start the reference calibration
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] period samples between two runs, 0 runs once
+ * @return    status code
+ *            - 0 success
+ *            - 1 calibrate failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the high pass filter is enabled in reference mode and the output path goes through it,
+ *            the calibration runs inside the reads and writes the reference register between two
+ *            batches, the stream is not stopped and the device should be still for a few windows
  */
-uint8_t l3gd20h_read(l3gd20h_handle_t *handle, int16_t (*raw)[3], float (*dps)[3], uint16_t *len) 
+uint8_t l3gd20h_reference_calibrate(l3gd20h_handle_t *handle, uint32_t period)
 {
-    uint8_t res, prev;
-    uint8_t mode, cnt, i;
-    uint8_t ble, range, enable;
-    uint8_t buf[32 * 6];
-  
-    if (handle == NULL)                                                                              /* check handle */
+    uint8_t value;
+    l3gd20h_selection_t selection;
+    
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                                    /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                                    /* return error */
+        return 3;                                                                               /* return error */
     }
-
-    if ((*len) == 0)                                                                                 /* check length */
-    {
-        handle->debug_print("l3gd20h: length is zero.\n");                                           /* length is zero. */
     
-        return 4;                                                                                    /* return error */
+    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_REFERENCE, (uint8_t *)&value, 1) != 0)       /* read the reference */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: read reference failed.\n");                             /* read reference failed */
+        
+        return 1;                                                                               /* return error */
     }
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_CTRL, (uint8_t *)&prev, 1) != 0)             /* read fifo ctrl */
+    if (l3gd20h_set_high_pass_filter_mode(handle, L3GD20H_HIGH_PASS_FILTER_MODE_REFERENCE_SIGNAL) != 0)    /* reference mode */
     {
-        handle->debug_print("l3gd20h: read fifo ctrl failed.\n");                                    /* read fifo ctrl failed */
-    
-        return 1;                                                                                    /* return error */
+        L3GD20H_PRINT(handle, "l3gd20h: set high pass filter mode failed.\n");                  /* set high pass filter mode failed */
+        
+        return 1;                                                                               /* return error */
     }
-    mode = prev >> 5;                                                                                /* get the mode */
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL5, (uint8_t *)&prev, 1) != 0)                 /* read ctrl5 */
+    if (l3gd20h_get_out_selection(handle, &selection) != 0)                                     /* get the output path */
+    {
+        L3GD20H_PRINT(handle, "l3gd20h: get out selection failed.\n");                         /* get out selection failed */
+        
+        return 1;                                                                               /* return error */
+    }
+    if (selection == L3GD20H_SELECTION_LPF1)                                                    /* high pass filter is bypassed */
+    {
+        if (l3gd20h_set_out_selection(handle, L3GD20H_SELECTION_LPF1_HPF) != 0)                 /* route through the filter */
+        {
+            L3GD20H_PRINT(handle, "l3gd20h: set out selection failed.\n");                     /* set out selection failed */
+            
+            return 1;                                                                           /* return error */
+        }
+    }
+    if (l3gd20h_set_high_pass_filter(handle, L3GD20H_BOOL_TRUE) != 0)                           /* enable the filter */
     {
-        handle->debug_print("l3gd20h: read ctrl5 failed.\n");                                        /* read ctrl5 failed */
+        L3GD20H_PRINT(handle, "l3gd20h: set high pass filter failed.\n");                      /* set high pass filter failed */
+        
+        return 1;                                                                               /* return error */
+    }
     
-        return 1;                                                                                    /* return error */
+    handle->reference_value = (int8_t)value;                                                    /* save the value */
+    handle->reference_period = period;                                                          /* set the period */
+    a_l3gd20h_reference_start(handle, L3GD20H_REFERENCE_SKIP);                                  /* skip the old setting */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     stop the reference calibration
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the reference register and the filter setting are kept
+ */
+uint8_t l3gd20h_reference_stop(l3gd20h_handle_t *handle)
+{
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
     }
-    enable = (prev & (1 << 6)) >> 6;                                                                 /* get enable */
-    if (a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_CTRL4, (uint8_t *)&prev, 1) != 0)                 /* get ctrl4 */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        handle->debug_print("l3gd20h: read ctrl4 failed.\n");                                        /* read ctrl4 failed */
+        return 3;                                                                               /* return error */
+    }
     
-        return 1;                                                                                    /* return error */
+    handle->reference_state = 0;                                                                /* idle */
+    handle->reference_period = 0;                                                               /* no next run */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the reference calibration result
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *value pointer to a reference value buffer
+ * @param[out] *residual pointer to a residual offset buffer in dps
+ * @param[out] *runs pointer to a finished runs buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the residual is the still output left at the chosen value, the part that differs between
+ *             the axes stays for the host bias
+ */
+uint8_t l3gd20h_reference_get(l3gd20h_handle_t *handle, int8_t *value, float residual[3], uint32_t *runs)
+{
+    uint8_t i;
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
     }
-    range = (prev & (3 << 4)) >> 4;                                                                  /* get range */
-    ble = (prev & (1 << 6)) >> 6;                                                                    /* get big little endian */
-    if ((mode && enable) != 0)                                                                       /* fifo modes */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_FIFO_SRC, (uint8_t *)&prev, 1);             /* read fifo source */
-        if (res != 0)                                                                                /* check result */
-        {
-            handle->debug_print("l3gd20h: read fifo source failed.\n");                              /* read fifo source failed */
-      
-            return 1;                                                                                /* return error */
-        }
-        cnt = prev & 0x1F;                                                                           /* get counter */
-        *len = ((*len) < cnt) ? (*len) : cnt;                                                        /* get the length */
-        res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_OUT_X_L, (uint8_t *)buf, 6 * (*len));       /* read all data */
-        if (res != 0)                                                                                /* check result */
-        {
-            handle->debug_print("l3gd20h: read data failed.\n");                                     /* read data failed */
-      
-            return 1;                                                                                /* return error */
-        }
-        for (i = 0; i < (*len); i++)                                                                 /* get data */
-        {
-            if (ble == 0)                                                                            /* little endian */
-            {
-                raw[i][0] = (int16_t)(((uint16_t)buf[1 + i * 6] << 8) | buf[0 + i * 6]);             /* set x */
-                raw[i][1] = (int16_t)(((uint16_t)buf[3 + i * 6] << 8) | buf[2 + i * 6]);             /* set y */
-                raw[i][2] = (int16_t)(((uint16_t)buf[5 + i * 6] << 8) | buf[4 + i * 6]);             /* set z */
-            }
-            else                                                                                     /* big endian */
-            {
-                raw[i][0] = (int16_t)(((uint16_t)buf[0 + i * 6] << 8) | buf[1 + i * 6]);             /* set x */
-                raw[i][1] = (int16_t)(((uint16_t)buf[2 + i * 6] << 8) | buf[3 + i * 6]);             /* set y */
-                raw[i][2] = (int16_t)(((uint16_t)buf[4 + i * 6] << 8) | buf[5 + i * 6]);             /* set z */
-            }
-           if (range == 0)                                                                           /* ±245 dps */
-           {
-               dps[i][0] = (float)(raw[i][0]) * 8.75f / 1000.0f;                                     /* set x */
-               dps[i][1] = (float)(raw[i][1]) * 8.75f / 1000.0f;                                     /* set y */
-               dps[i][2] = (float)(raw[i][2]) * 8.75f / 1000.0f;                                     /* set z */
-           }
-           else if (range == 1)                                                                      /* ±500 dps */
-           {
-               dps[i][0] = (float)(raw[i][0]) * 17.5f / 1000.0f;                                     /* set x */
-               dps[i][1] = (float)(raw[i][1]) * 17.5f / 1000.0f;                                     /* set y */
-               dps[i][2] = (float)(raw[i][2]) * 17.5f / 1000.0f;                                     /* set z */
-           }
-           else                                                                                      /* ±2000 dps */
-           {
-               dps[i][0] = (float)(raw[i][0]) * 70.0f / 1000.0f;                                     /* set x */
-               dps[i][1] = (float)(raw[i][1]) * 70.0f / 1000.0f;                                     /* set y */
-               dps[i][2] = (float)(raw[i][2]) * 70.0f / 1000.0f;                                     /* set z */
-           }
-       }
-    }                                                                                                /* bypass mode */
-    else
+        return 3;                                                                               /* return error */
+    }
+    
+    *value = handle->reference_value;                                                           /* get the value */
+    for (i = 0; i < 3; i++)                                                                     /* each axis */
     {
-        *len = 1;                                                                                    /* set length */
-        res = a_l3gd20h_iic_spi_read(handle, L3GD20H_REG_OUT_X_L, (uint8_t *)buf, 6);                /* read data */
-        if (res != 0)                                                                                /* check result */
-        {
-            handle->debug_print("l3gd20h: read data failed.\n");                                     /* read data failed */
-      
-            return 1;                                                                                /* return error */
-        }
-        if (ble == 0)                                                                                /* little endian */
-        {
-            raw[0][0] = (int16_t)(((uint16_t)buf[1] << 8) | buf[0]);                                 /* set x */
-            raw[0][1] = (int16_t)(((uint16_t)buf[3] << 8) | buf[2]);                                 /* set y */
-            raw[0][2] = (int16_t)(((uint16_t)buf[5] << 8) | buf[4]);                                 /* set z */
-        }
-        else                                                                                         /* big endian */
-        {
-            raw[0][0] = (int16_t)(((uint16_t)buf[0] << 8) | buf[1]);                                 /* set x */
-            raw[0][1] = (int16_t)(((uint16_t)buf[2] << 8) | buf[3]);                                 /* set y */
-            raw[0][2] = (int16_t)(((uint16_t)buf[4] << 8) | buf[5]);                                 /* set z */
-        }
-        if (range == 0)                                                                              /* ±245 dps */
-        {
-            dps[0][0] = (float)(raw[0][0]) * 8.75f / 1000.0f;                                        /* set x */
-            dps[0][1] = (float)(raw[0][1]) * 8.75f / 1000.0f;                                        /* set y */
-            dps[0][2] = (float)(raw[0][2]) * 8.75f / 1000.0f;                                        /* set z */
-        }
-        else if (range == 1)                                                                         /* ±500 dps */
-        {
-            dps[0][0] = (float)(raw[0][0]) * 17.5f / 1000.0f;                                        /* set x */
-            dps[0][1] = (float)(raw[0][1]) * 17.5f / 1000.0f;                                        /* set y */
-            dps[0][2] = (float)(raw[0][2]) * 17.5f / 1000.0f;                                        /* set z */
-        }
-        else                                                                                         /* ±2000 dps */
-        {
-            dps[0][0] = (float)(raw[0][0]) * 70.0f / 1000.0f;                                        /* set x */
-            dps[0][1] = (float)(raw[0][1]) * 70.0f / 1000.0f;                                        /* set y */
-            dps[0][2] = (float)(raw[0][2]) * 70.0f / 1000.0f;                                        /* set z */
-        }
-     }
-  
-     return 0;                                                                                       /* success return 0 */
+        residual[i] = (float)handle->reference_residual[i] * 8.75f / 1000.0f /
+                      (float)(1 << L3GD20H_BIAS_FRACTION_BITS);                                 /* convert the residual */
+    }
+    *runs = handle->reference_runs;                                                             /* get the runs */
+    
+    return 0;                                                                                   /* success return 0 */
 }
+#endif
 
 /**
  * @brief     set the chip register
@@ -4123,6 +6888,7 @@ uint8_t l3gd20h_read(l3gd20h_handle_t *handle, int16_t (*raw)[3], float (*dps)[3
  */
 uint8_t l3gd20h_set_reg(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+#if (L3GD20H_CHECK_ENABLE == 1)
     if (handle == NULL)                                          /* check handle */
     {
         return 2;                                                /* return error */
@@ -4131,6 +6897,7 @@ uint8_t l3gd20h_set_reg(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uin
     {
         return 3;                                                /* return error */
     }
+#endif
   
     return a_l3gd20h_iic_spi_write(handle, reg, buf, len);       /* write data */
 }
@@ -4150,6 +6917,7 @@ uint8_t l3gd20h_set_reg(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uin
  */
 uint8_t l3gd20h_get_reg(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+#if (L3GD20H_CHECK_ENABLE == 1)
     if (handle == NULL)                                         /* check handle */
     {
         return 2;                                               /* return error */
@@ -4158,6 +6926,7 @@ uint8_t l3gd20h_get_reg(l3gd20h_handle_t *handle, uint8_t reg, uint8_t *buf, uin
     {
         return 3;                                               /* return error */
     }
+#endif
   
     return a_l3gd20h_iic_spi_read(handle, reg, buf, len);       /* read data */
 }
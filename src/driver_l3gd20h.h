@@ -57,6 +57,100 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief l3gd20h static bus definition
+ * @note  L3GD20H_STATIC_BUS binds the bus at compile time and drops the runtime iic/spi dispatch,
+ *        the bus is reached through l3gd20h_static_bus_read/l3gd20h_static_bus_write defined as
+ *        static inline functions in the header named by L3GD20H_STATIC_BUS_HEADER, or through the
+ *        l3gd20h_interface_iic_* / l3gd20h_interface_spi_* functions when no header is given
+ */
+#define L3GD20H_STATIC_BUS_NONE        0        /**< bus is dispatched through the handle at runtime */
+#define L3GD20H_STATIC_BUS_IIC         1        /**< bus is bound to iic at compile time */
+#define L3GD20H_STATIC_BUS_SPI         2        /**< bus is bound to spi at compile time */
+#ifndef L3GD20H_STATIC_BUS
+    #define L3GD20H_STATIC_BUS L3GD20H_STATIC_BUS_NONE        /**< runtime dispatch by default */
+#endif
+
+/**
+ * @brief l3gd20h feature trim definition
+ * @note  set a macro to 0 to compile the feature out of the driver or to 1 to compile it in,
+ *        the macros from L3GD20H_TIMESTAMP_ENABLE on are off by default, so the handle and the code of a plain
+ *        build stay at the size of the register driver,
+ *        L3GD20H_INTERRUPT_ENABLE covers the interrupt generator api and the interrupt 1 handler,
+ *        L3GD20H_FIFO_ENABLE covers the fifo api and l3gd20h_read then only reads in bypass mode,
+ *        L3GD20H_CHECK_ENABLE covers the handle NULL and initialization checks of the read, irq and register functions,
+ *        L3GD20H_DEBUG_STRING_ENABLE covers the debug messages, the return codes still report every error,
+ *        L3GD20H_TIMESTAMP_ENABLE covers the timestamp api and l3gd20h_read_timestamp, timestamp_us stays
+ *        in the handle for the counters and the trace,
+ *        L3GD20H_SETTLE_ENABLE covers the settling window api and the wake, rate and filter setters
+ *        then only write the registers,
+ *        L3GD20H_BIAS_ENABLE covers the bias estimation, the temperature model and the reference calibration
+ *        with their api, the decode then subtracts nothing,
+ *        L3GD20H_REMAP_ENABLE covers the axis remap api, the decode then keeps the sensor frame,
+ *        L3GD20H_RANGE_ENABLE covers the auto ranging api, every read then decodes with the full scale of ctrl4,
+ *        L3GD20H_ASYNC_ENABLE adds the async bus hooks, the request queue and the async api,
+ *        L3GD20H_COUNTER_ENABLE adds the performance counters to the handle,
+ *        L3GD20H_TRACE_ENABLE adds the transaction trace ring to the handle
+ */
+#ifndef L3GD20H_IIC_ENABLE
+    #define L3GD20H_IIC_ENABLE                 1        /**< enable the iic interface */
+#endif
+#ifndef L3GD20H_SPI_ENABLE
+    #define L3GD20H_SPI_ENABLE                 1        /**< enable the spi interface */
+#endif
+#ifndef L3GD20H_INTERRUPT_ENABLE
+    #define L3GD20H_INTERRUPT_ENABLE           1        /**< enable the interrupt generator */
+#endif
+#ifndef L3GD20H_FIFO_ENABLE
+    #define L3GD20H_FIFO_ENABLE                1        /**< enable the fifo */
+#endif
+#ifndef L3GD20H_CHECK_ENABLE
+    #define L3GD20H_CHECK_ENABLE               1        /**< enable the hot path checks */
+#endif
+#ifndef L3GD20H_DEBUG_STRING_ENABLE
+    #define L3GD20H_DEBUG_STRING_ENABLE        1        /**< enable the debug strings */
+#endif
+#ifndef L3GD20H_TIMESTAMP_ENABLE
+    #define L3GD20H_TIMESTAMP_ENABLE           0        /**< disable the sample timestamps */
+#endif
+#ifndef L3GD20H_SETTLE_ENABLE
+    #define L3GD20H_SETTLE_ENABLE              0        /**< disable the settling window */
+#endif
+#ifndef L3GD20H_BIAS_ENABLE
+    #define L3GD20H_BIAS_ENABLE                0        /**< disable the bias compensation */
+#endif
+#ifndef L3GD20H_REMAP_ENABLE
+    #define L3GD20H_REMAP_ENABLE               0        /**< disable the axis remap */
+#endif
+#ifndef L3GD20H_RANGE_ENABLE
+    #define L3GD20H_RANGE_ENABLE               0        /**< disable the auto ranging */
+#endif
+#ifndef L3GD20H_ASYNC_ENABLE
+    #define L3GD20H_ASYNC_ENABLE               0        /**< disable the async api */
+#endif
+#ifndef L3GD20H_COUNTER_ENABLE
+    #define L3GD20H_COUNTER_ENABLE             0        /**< disable the performance counters */
+#endif
+#ifndef L3GD20H_TRACE_ENABLE
+    #define L3GD20H_TRACE_ENABLE               0        /**< disable the trace ring */
+#endif
+
+/**
+ * @brief l3gd20h bus retry definition
+ * @note  a failed bus transaction is issued again up to L3GD20H_BUS_RETRY times,
+ *        a retried fifo burst may miss the samples the failed burst already popped
+ */
+#ifndef L3GD20H_BUS_RETRY
+    #define L3GD20H_BUS_RETRY 0        /**< no retry by default */
+#endif
+#if ((L3GD20H_IIC_ENABLE == 0) && (L3GD20H_SPI_ENABLE == 0))
+    #error "l3gd20h: at least one interface must be enabled."
+#endif
+#if (((L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_IIC) && (L3GD20H_IIC_ENABLE == 0)) || \
+     ((L3GD20H_STATIC_BUS == L3GD20H_STATIC_BUS_SPI) && (L3GD20H_SPI_ENABLE == 0)))
+    #error "l3gd20h: the static bus is disabled."
+#endif
+
 /**
  * @brief l3gd20h interface enumeration definition
  */
@@ -104,6 +198,30 @@ typedef enum
     L3GD20H_MODE_SLEEP      = 0x02,        /**< sleep mode */
 } l3gd20h_mode_t;
 
+/**
+ * @brief l3gd20h settle enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_SETTLE_OFF  = 0x00,        /**< deliver the settling samples as they are */
+    L3GD20H_SETTLE_DROP = 0x01,        /**< drop the settling samples */
+    L3GD20H_SETTLE_TAG  = 0x02,        /**< deliver the settling samples and count them */
+} l3gd20h_settle_t;
+
+/**
+ * @brief l3gd20h remap enumeration definition
+ * @note  bits 1:0 select the sensor axis, bit 2 flips the sign
+ */
+typedef enum
+{
+    L3GD20H_REMAP_POSITIVE_X = 0x00,        /**< sensor x */
+    L3GD20H_REMAP_POSITIVE_Y = 0x01,        /**< sensor y */
+    L3GD20H_REMAP_POSITIVE_Z = 0x02,        /**< sensor z */
+    L3GD20H_REMAP_NEGATIVE_X = 0x04,        /**< negated sensor x */
+    L3GD20H_REMAP_NEGATIVE_Y = 0x05,        /**< negated sensor y */
+    L3GD20H_REMAP_NEGATIVE_Z = 0x06,        /**< negated sensor z */
+} l3gd20h_remap_t;
+
 /**
  * @brief l3gd20h high pass filter mode enumeration definition
  */
@@ -350,6 +468,298 @@ typedef enum
     L3GD20H_FIFO_MODE_BYPASS_TO_FIFO   = 0x07,        /**< bypass to fifo mode */
 } l3gd20h_fifo_mode_t;
 
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup l3gd20h_async_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h async queue depth definition
+ */
+#ifndef L3GD20H_ASYNC_QUEUE_DEPTH
+    #define L3GD20H_ASYNC_QUEUE_DEPTH 4        /**< max outstanding async requests */
+#endif
+
+/**
+ * @brief l3gd20h async type enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_ASYNC_TYPE_READ   = 0x00,        /**< read one sample from the output registers */
+    L3GD20H_ASYNC_TYPE_DRAIN  = 0x01,        /**< drain the fifo */
+    L3GD20H_ASYNC_TYPE_CONFIG = 0x02,        /**< apply a register config */
+} l3gd20h_async_type_t;
+
+/**
+ * @brief l3gd20h async request structure definition
+ */
+typedef struct l3gd20h_async_request_s
+{
+    uint8_t type;                                                 /**< request type */
+    uint8_t state;                                                /**< state machine step */
+    uint8_t reg;                                                  /**< config register address */
+    uint8_t mask;                                                 /**< config bit mask */
+    uint8_t value;                                                /**< config value */
+    uint8_t prev;                                                 /**< register transfer buffer */
+    uint8_t ctrl4;                                                /**< ctrl4 transfer buffer */
+    uint16_t len;                                                 /**< sample length */
+    int16_t (*raw)[3];                                            /**< raw data buffer */
+    float (*dps)[3];                                              /**< converted data buffer */
+    void (*callback)(uint8_t type, uint8_t res, uint16_t len);    /**< completion callback */
+} l3gd20h_async_request_t;
+
+/**
+ * @}
+ */
+
+#if (L3GD20H_COUNTER_ENABLE == 1)
+/**
+ * @addtogroup l3gd20h_counter_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h counter size definition
+ * @note  the register counters are indexed by the register address,
+ *        bin 0 of a histogram counts the transactions below 1 us and bin n the transactions
+ *        from 2^(n - 1) us to 2^n us, the last bin also counts every longer transaction
+ */
+#define L3GD20H_COUNTER_REG_NUM         0x40        /**< register address space */
+#define L3GD20H_COUNTER_HIST_BINS       16          /**< histogram bins */
+
+/**
+ * @brief l3gd20h counter direction enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_COUNTER_DIR_READ  = 0x00,        /**< read transactions */
+    L3GD20H_COUNTER_DIR_WRITE = 0x01,        /**< write transactions */
+    L3GD20H_COUNTER_DIR_MAX   = 0x02,        /**< direction number */
+} l3gd20h_counter_dir_t;
+
+/**
+ * @brief l3gd20h counter interrupt enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_COUNTER_IRQ_INT1           = 0x00,        /**< interrupt 1 handler runs */
+    L3GD20H_COUNTER_IRQ_INT1_ACTIVE    = 0x01,        /**< interrupt generator active */
+    L3GD20H_COUNTER_IRQ_INT2           = 0x02,        /**< interrupt 2 handler runs */
+    L3GD20H_COUNTER_IRQ_DATA_READY     = 0x03,        /**< xyz data ready */
+    L3GD20H_COUNTER_IRQ_STATUS_OVERRUN = 0x04,        /**< xyz overrun in the status register */
+    L3GD20H_COUNTER_IRQ_FIFO_THRESHOLD = 0x05,        /**< fifo threshold */
+    L3GD20H_COUNTER_IRQ_FIFO_OVERRUN   = 0x06,        /**< fifo overrun */
+    L3GD20H_COUNTER_IRQ_FIFO_EMPTY     = 0x07,        /**< fifo empty */
+    L3GD20H_COUNTER_IRQ_MAX            = 0x08,        /**< source number */
+} l3gd20h_counter_irq_t;
+
+/**
+ * @brief l3gd20h counter structure definition
+ */
+typedef struct l3gd20h_counter_s
+{
+    uint32_t transactions[L3GD20H_COUNTER_DIR_MAX][L3GD20H_COUNTER_REG_NUM];        /**< bus transactions by register */
+    uint32_t bytes[L3GD20H_COUNTER_DIR_MAX][L3GD20H_COUNTER_REG_NUM];               /**< bus bytes by register */
+    uint32_t errors;                                                                /**< failed bus transactions */
+    uint32_t retries;                                                               /**< retried bus transactions */
+    uint32_t irq[L3GD20H_COUNTER_IRQ_MAX];                                          /**< interrupts by source */
+    uint32_t samples_delivered;                                                     /**< samples returned to the caller */
+    uint32_t fifo_overrun;                                                          /**< fifo source reads that found the fifo overrun */
+    uint32_t status_overrun;                                                        /**< interrupt 2 runs that found the xyz overrun */
+    uint32_t hist[L3GD20H_COUNTER_DIR_MAX][L3GD20H_COUNTER_HIST_BINS];              /**< bus hook time histograms */
+    uint64_t bus_us[L3GD20H_COUNTER_DIR_MAX];                                       /**< bus hook time in us */
+} l3gd20h_counter_t;
+
+/**
+ * @}
+ */
+#endif
+
+#if (L3GD20H_TRACE_ENABLE == 1)
+/**
+ * @addtogroup l3gd20h_trace_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h trace depth definition
+ * @note  the depth must be a power of two, the oldest entries are overwritten when the ring is full
+ */
+#ifndef L3GD20H_TRACE_DEPTH
+    #define L3GD20H_TRACE_DEPTH 64        /**< trace ring entries */
+#endif
+
+/**
+ * @brief l3gd20h trace type enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_TRACE_TYPE_BUS_READ_BEGIN  = 0x00,        /**< bus read starts */
+    L3GD20H_TRACE_TYPE_BUS_READ_END    = 0x01,        /**< bus read ends */
+    L3GD20H_TRACE_TYPE_BUS_WRITE_BEGIN = 0x02,        /**< bus write starts */
+    L3GD20H_TRACE_TYPE_BUS_WRITE_END   = 0x03,        /**< bus write ends */
+    L3GD20H_TRACE_TYPE_IRQ             = 0x04,        /**< interrupt handler entry, reg is the interrupt number */
+    L3GD20H_TRACE_TYPE_READ_BEGIN      = 0x05,        /**< l3gd20h_read starts */
+    L3GD20H_TRACE_TYPE_READ_END        = 0x06,        /**< l3gd20h_read ends, len is the sample number */
+} l3gd20h_trace_type_t;
+
+/**
+ * @brief l3gd20h trace structure definition
+ */
+typedef struct l3gd20h_trace_s
+{
+    uint64_t us;          /**< timestamp in us */
+    uint16_t len;         /**< data length */
+    uint8_t type;         /**< trace type */
+    uint8_t reg;          /**< register address */
+    uint8_t res;          /**< result of an end entry */
+} l3gd20h_trace_t;
+
+/**
+ * @}
+ */
+#endif
+
+#if (L3GD20H_TIMESTAMP_ENABLE == 1)
+/**
+ * @addtogroup l3gd20h_timestamp_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h timestamp tracking definition
+ * @note  a batch that lands more than L3GD20H_TIMESTAMP_RELOCK periods away from the predicted time
+ *        restarts the track, smaller errors are removed with a gain of 1 / 2^L3GD20H_TIMESTAMP_GAIN_SHIFT
+ */
+#define L3GD20H_TIMESTAMP_RELOCK            2        /**< relock distance in periods */
+#define L3GD20H_TIMESTAMP_GAIN_SHIFT        3        /**< tracking gain shift */
+
+/**
+ * @brief l3gd20h timestamp drift window definition
+ * @note  the drift estimator keeps one point every L3GD20H_TIMESTAMP_STEP samples and fits the period
+ *        over the last L3GD20H_TIMESTAMP_WINDOW points once it holds L3GD20H_TIMESTAMP_POINT_MIN points,
+ *        the estimate counts as converged when the window is full and a longer window gives a tighter bound,
+ *        estimates more than 1 / L3GD20H_TIMESTAMP_DRIFT_LIMIT away from the nominal period are dropped
+ */
+#ifndef L3GD20H_TIMESTAMP_WINDOW
+    #define L3GD20H_TIMESTAMP_WINDOW 16        /**< drift window points */
+#endif
+#ifndef L3GD20H_TIMESTAMP_STEP
+    #define L3GD20H_TIMESTAMP_STEP 64          /**< samples between two drift points */
+#endif
+#define L3GD20H_TIMESTAMP_POINT_MIN   4        /**< drift points of the first estimate */
+#define L3GD20H_TIMESTAMP_DRIFT_LIMIT 8        /**< largest drift as a fraction of the period */
+
+/**
+ * @brief l3gd20h timestamp structure definition
+ */
+typedef struct l3gd20h_timestamp_s
+{
+    uint64_t next_ns;                                    /**< predicted time of the next sample in ns */
+    uint32_t period_ns;                                  /**< sample period in ns */
+    uint32_t nominal_ns;                                 /**< nominal sample period in ns */
+    uint32_t bound_ns;                                   /**< confidence bound of the period in ns, 0 before the first estimate */
+    int32_t residual_ns;                                 /**< measured minus predicted time of the last batch in ns */
+    uint32_t samples;                                    /**< assigned samples */
+    uint64_t last_us;                                    /**< time of the last assigned sample in us */
+    uint64_t point_ns[L3GD20H_TIMESTAMP_WINDOW];         /**< drift point times in ns */
+    uint32_t point_n[L3GD20H_TIMESTAMP_WINDOW];          /**< drift point sample indexes */
+    uint8_t point_head;                                  /**< next drift point */
+    uint8_t point_count;                                 /**< drift points in the window */
+    uint8_t locked;                                      /**< track running flag */
+} l3gd20h_timestamp_t;
+
+/**
+ * @}
+ */
+#endif
+
+/**
+ * @addtogroup l3gd20h_bias_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h bias enumeration definition
+ */
+typedef enum
+{
+    L3GD20H_BIAS_OFF   = 0x00,        /**< deliver the data as it is */
+    L3GD20H_BIAS_HOLD  = 0x01,        /**< subtract the stored bias */
+    L3GD20H_BIAS_TRACK = 0x02,        /**< estimate the bias in still windows and subtract it */
+} l3gd20h_bias_t;
+
+/**
+ * @brief l3gd20h still window structure definition
+ */
+typedef struct l3gd20h_still_s
+{
+    int64_t sum[3];             /**< window sum */
+    uint64_t square[3];         /**< window sum of squares */
+    uint16_t n;                 /**< samples in the window */
+    uint8_t range;              /**< full scale range of the window */
+} l3gd20h_still_t;
+
+/**
+ * @brief l3gd20h bias estimation definition
+ * @note  the bias is kept in 1 / 2^L3GD20H_BIAS_FRACTION_BITS lsb of the 245 dps range, a window of
+ *        L3GD20H_BIAS_WINDOW_MS and at least L3GD20H_BIAS_WINDOW_MIN samples is still when the standard
+ *        deviation of every axis stays below the threshold and the mean stays within L3GD20H_BIAS_LIMIT_DPS,
+ *        the first still window loads the bias and later ones move it with a gain of 1 / 2^L3GD20H_BIAS_GAIN_SHIFT
+ */
+#ifndef L3GD20H_BIAS_WINDOW_MS
+    #define L3GD20H_BIAS_WINDOW_MS 250              /**< time of a still window in ms */
+#endif
+#ifndef L3GD20H_BIAS_WINDOW_MIN
+    #define L3GD20H_BIAS_WINDOW_MIN 16              /**< fewest samples of a still window */
+#endif
+#ifndef L3GD20H_BIAS_THRESHOLD_DPS
+    #define L3GD20H_BIAS_THRESHOLD_DPS 0.5f         /**< default standard deviation threshold */
+#endif
+#define L3GD20H_BIAS_FRACTION_BITS    4             /**< fraction bits of the stored bias */
+#define L3GD20H_BIAS_GAIN_SHIFT       3             /**< tracking gain shift */
+#define L3GD20H_BIAS_LIMIT_DPS        25            /**< largest accepted zero rate level */
+#define L3GD20H_BIAS_BLOB_SIZE        20            /**< calibration blob size in bytes */
+
+/**
+ * @brief l3gd20h bias temperature model definition
+ * @note  the model is a polynomial of the temperature per axis up to L3GD20H_BIAS_TEMP_ORDER, the
+ *        temperature rides on a data burst every L3GD20H_BIAS_TEMP_INTERVAL delivered samples
+ */
+#ifndef L3GD20H_BIAS_TEMP_INTERVAL
+    #define L3GD20H_BIAS_TEMP_INTERVAL 256          /**< samples between two temperature reads */
+#endif
+#define L3GD20H_BIAS_TEMP_ORDER       2             /**< highest polynomial order */
+
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup l3gd20h_reference_driver
+ * @{
+ */
+
+/**
+ * @brief l3gd20h reference calibration definition
+ * @note  the reference register is shared by the three axes and is subtracted by the high pass filter
+ *        in reference mode, a run measures the common offset over the still windows of the bias estimator
+ *        until they hold L3GD20H_REFERENCE_SAMPLES samples, learns the weight of one reference lsb from two
+ *        settings and ends when the offset is within half a reference lsb or after L3GD20H_REFERENCE_ITERATIONS
+ *        writes, L3GD20H_REFERENCE_SKIP samples are skipped after a write so no sample of the old setting is
+ *        measured
+ */
+#ifndef L3GD20H_REFERENCE_SKIP
+    #define L3GD20H_REFERENCE_SKIP 32               /**< samples skipped after a write */
+#endif
+#define L3GD20H_REFERENCE_SAMPLES     64            /**< fewest samples of a measurement */
+#define L3GD20H_REFERENCE_ITERATIONS  4             /**< largest number of writes of a run */
+#define L3GD20H_REFERENCE_GAIN        16            /**< first guess of one reference lsb in fractional lsb of the 245 dps range */
+
 /**
  * @}
  */
@@ -359,6 +769,27 @@ typedef enum
  * @{
  */
 
+/**
+ * @brief l3gd20h settling definition
+ * @note  a wake from power down waits L3GD20H_SETTLE_TURN_ON_MS, every reconfiguration waits three time
+ *        constants of the low pass bandwidth and of the enabled high pass filter, and at least
+ *        L3GD20H_SETTLE_MIN_SAMPLES samples
+ */
+#ifndef L3GD20H_SETTLE_TURN_ON_MS
+    #define L3GD20H_SETTLE_TURN_ON_MS 50        /**< turn on time in ms */
+#endif
+#define L3GD20H_SETTLE_MIN_SAMPLES    2         /**< samples of a digital filter chain restart */
+
+/**
+ * @brief l3gd20h auto ranging definition
+ * @note  the full scale goes one step up when a read reaches L3GD20H_RANGE_HIGH lsb on any axis, and one
+ *        step down after L3GD20H_RANGE_HOLD samples in a row below half of the lower full scale
+ */
+#ifndef L3GD20H_RANGE_HOLD
+    #define L3GD20H_RANGE_HOLD 64               /**< quiet samples before a step down */
+#endif
+#define L3GD20H_RANGE_HIGH            29491     /**< 90 % of the full scale in lsb */
+
 /**
  * @brief l3gd20h handle structure definition
  */
@@ -373,11 +804,86 @@ typedef struct l3gd20h_handle_s
     uint8_t (*spi_deinit)(void);                                                        /**< point to a spi_deinit function address */
     uint8_t (*spi_read)(uint8_t reg, uint8_t *buf, uint16_t len);                       /**< point to a spi_read function address */
     uint8_t (*spi_write)(uint8_t reg, uint8_t *buf, uint16_t len);                      /**< point to a spi_write function address */
+#if (L3GD20H_ASYNC_ENABLE == 1)
+    uint8_t (*iic_read_async)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);   /**< point to an iic_read_async function address */
+    uint8_t (*iic_write_async)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);  /**< point to an iic_write_async function address */
+    uint8_t (*spi_read_async)(uint8_t reg, uint8_t *buf, uint16_t len);                 /**< point to a spi_read_async function address */
+    uint8_t (*spi_write_async)(uint8_t reg, uint8_t *buf, uint16_t len);                /**< point to a spi_write_async function address */
+#endif
     void (*receive_callback)(uint8_t type);                                             /**< point to a receive_callback function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
+    uint64_t (*timestamp_us)(void);                                                     /**< point to a timestamp_us function address */
     uint8_t inited;                                                                     /**< inited flag */
     uint8_t iic_spi;                                                                    /**< iic spi interface type */
+#if (L3GD20H_ASYNC_ENABLE == 1)
+    l3gd20h_async_request_t async_queue[L3GD20H_ASYNC_QUEUE_DEPTH];                     /**< async request queue */
+    uint8_t async_head;                                                                 /**< async queue head */
+    uint8_t async_count;                                                                /**< async queue count */
+    uint8_t async_busy;                                                                 /**< async transfer in flight flag */
+#endif
+#if (L3GD20H_SETTLE_ENABLE == 1)
+    uint8_t settle_mode;                                                                /**< settling sample handling */
+    uint32_t settle;                                                                    /**< samples left in the settling window */
+    uint16_t settle_tagged;                                                             /**< settling samples at the start of the last read */
+    uint16_t settle_dropped;                                                            /**< settling samples dropped from the last read */
+    uint8_t settle_queued;                                                              /**< fifo samples captured before the window opened */
+    uint32_t settle_period_ns;                                                          /**< sample period of the window */
+    uint64_t settle_until_us;                                                           /**< end of the window in bypass mode, 0 without timestamp_us */
+#endif
+#if (L3GD20H_REMAP_ENABLE == 1)
+    uint8_t remap[3];                                                                   /**< sensor axis and sign of every output axis */
+#endif
+#if (L3GD20H_RANGE_ENABLE == 1)
+    uint8_t range_auto;                                                                 /**< auto ranging flag */
+    uint8_t range_prev;                                                                 /**< full scale bits before the last switch */
+    uint8_t range_pending;                                                              /**< samples captured before the last switch */
+    uint8_t range_status;                                                               /**< status bit of a new sample in bypass mode, 0 for none */
+    uint32_t range_quiet;                                                               /**< low amplitude samples in a row */
+    uint16_t range_split;                                                               /**< samples of the last read at range_head */
+    uint8_t range_head;                                                                 /**< full scale bits of the first samples of the last read */
+    uint8_t range_tail;                                                                 /**< full scale bits of the other samples of the last read */
+#endif
+#if (L3GD20H_BIAS_ENABLE == 1)
+    uint8_t bias_mode;                                                                  /**< bias compensation mode */
+    int32_t bias[3];                                                                    /**< bias in fractional lsb of the 245 dps range */
+    l3gd20h_still_t bias_still;                                                         /**< running still window */
+    uint32_t bias_limit;                                                                /**< variance threshold in lsb^2 of the 245 dps range */
+    uint32_t bias_windows;                                                              /**< still windows behind the bias */
+    uint16_t bias_window;                                                               /**< samples of a still window at the rate */
+    float bias_coeff[3][L3GD20H_BIAS_TEMP_ORDER + 1];                                   /**< temperature model coefficients in dps */
+    float bias_tref;                                                                    /**< temperature model reference in degrees */
+    int32_t bias_temp[3];                                                               /**< cached temperature term in fractional lsb */
+    uint16_t bias_temp_countdown;                                                       /**< samples to the next temperature read */
+    int8_t bias_temp_raw;                                                               /**< last temperature register value */
+    uint8_t bias_temp_state;                                                            /**< bit 0 model loaded, bit 1 temperature read */
+    uint8_t reference_state;                                                            /**< 0 idle, 1 skipping, 2 measuring */
+    uint8_t reference_step;                                                             /**< writes of the running calibration */
+    int8_t reference_value;                                                             /**< reference register value */
+    int8_t reference_next;                                                              /**< reference value to write */
+    int8_t reference_prev;                                                              /**< previous reference value */
+    int8_t reference_best;                                                              /**< reference value with the smallest offset */
+    int32_t reference_mean;                                                             /**< common offset at the previous value */
+    int32_t reference_best_mean;                                                        /**< smallest absolute common offset */
+    int32_t reference_gain;                                                             /**< weight of one reference lsb in fractional lsb */
+    int32_t reference_residual[3];                                                      /**< offset left at the best value in fractional lsb */
+    l3gd20h_still_t reference_still;                                                    /**< running still window */
+    int64_t reference_sum[3];                                                           /**< sum of the window means of a measurement */
+    uint32_t reference_n;                                                               /**< samples of a measurement */
+    uint16_t reference_skip;                                                            /**< samples left to skip */
+    uint32_t reference_period;                                                          /**< samples between two runs, 0 runs once */
+    uint32_t reference_countdown;                                                       /**< samples to the next run */
+    uint32_t reference_runs;                                                            /**< finished runs */
+#endif
+#if (L3GD20H_COUNTER_ENABLE == 1)
+    l3gd20h_counter_t counter;                                                          /**< performance counters */
+#endif
+#if (L3GD20H_TRACE_ENABLE == 1)
+    l3gd20h_trace_t trace[L3GD20H_TRACE_DEPTH];                                         /**< trace ring */
+    uint32_t trace_head;                                                                /**< next trace entry */
+    uint32_t trace_count;                                                               /**< unread trace entries */
+    uint32_t trace_lost;                                                                /**< overwritten trace entries */
+#endif
 } l3gd20h_handle_t;
 
 /**
@@ -503,6 +1009,48 @@ typedef struct l3gd20h_info_s
  */
 #define DRIVER_L3GD20H_LINK_RECEIVE_CALLBACK(HANDLE, FUC)        (HANDLE)->receive_callback = FUC
 
+#if (L3GD20H_ASYNC_ENABLE == 1)
+/**
+ * @brief     link iic_read_async function
+ * @param[in] HANDLE pointer to an l3gd20h handle structure
+ * @param[in] FUC pointer to an iic_read_async function address
+ * @note      the function starts the transfer and returns at once
+ */
+#define DRIVER_L3GD20H_LINK_IIC_READ_ASYNC(HANDLE, FUC)          (HANDLE)->iic_read_async = FUC
+
+/**
+ * @brief     link iic_write_async function
+ * @param[in] HANDLE pointer to an l3gd20h handle structure
+ * @param[in] FUC pointer to an iic_write_async function address
+ * @note      the function starts the transfer and returns at once
+ */
+#define DRIVER_L3GD20H_LINK_IIC_WRITE_ASYNC(HANDLE, FUC)         (HANDLE)->iic_write_async = FUC
+
+/**
+ * @brief     link spi_read_async function
+ * @param[in] HANDLE pointer to an l3gd20h handle structure
+ * @param[in] FUC pointer to a spi_read_async function address
+ * @note      the function starts the transfer and returns at once
+ */
+#define DRIVER_L3GD20H_LINK_SPI_READ_ASYNC(HANDLE, FUC)          (HANDLE)->spi_read_async = FUC
+
+/**
+ * @brief     link spi_write_async function
+ * @param[in] HANDLE pointer to an l3gd20h handle structure
+ * @param[in] FUC pointer to a spi_write_async function address
+ * @note      the function starts the transfer and returns at once
+ */
+#define DRIVER_L3GD20H_LINK_SPI_WRITE_ASYNC(HANDLE, FUC)         (HANDLE)->spi_write_async = FUC
+#endif
+
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE pointer to an l3gd20h handle structure
+ * @param[in] FUC pointer to a timestamp_us function address
+ * @note      the function returns a monotonic time in us, it is optional and only used by the counters and the trace
+ */
+#define DRIVER_L3GD20H_LINK_TIMESTAMP_US(HANDLE, FUC)            (HANDLE)->timestamp_us = FUC
+
 /**
  * @}
  */
@@ -610,6 +1158,31 @@ uint8_t l3gd20h_deinit(l3gd20h_handle_t *handle);
  */
 uint8_t l3gd20h_read(l3gd20h_handle_t *handle, int16_t (*raw)[3], float (*dps)[3], uint16_t *len);
 
+#if (L3GD20H_TIMESTAMP_ENABLE == 1)
+/**
+ * @brief         read the data with the sample times
+ * @param[in]     *handle pointer to an l3gd20h handle structure
+ * @param[in]     *ts pointer to a timestamp structure
+ * @param[out]    **raw pointer to a raw data buffer
+ * @param[out]    **dps pointer to a converted data buffer
+ * @param[out]    *us pointer to a timestamp buffer
+ * @param[in,out] *len pointer to a date length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle or ts is NULL
+ *                - 3 handle is not initialized
+ *                - 4 len is NULL or invalid
+ *                - 5 timestamp_us is NULL
+ *                - 6 ts is not initialized
+ * @note          the read is stamped when the fifo level is known, the newest sample is taken
+ *                half a period before the stamp on average and the others one period apart,
+ *                dropped settling samples keep their place in the time line
+ */
+uint8_t l3gd20h_read_timestamp(l3gd20h_handle_t *handle, l3gd20h_timestamp_t *ts,
+                               int16_t (*raw)[3], float (*dps)[3], uint64_t *us, uint16_t *len);
+#endif
+
 /**
  * @brief     interrupt handler
  * @param[in] *handle pointer to an l3gd20h handle structure
@@ -663,94 +1236,221 @@ uint8_t l3gd20h_set_mode(l3gd20h_handle_t *handle, l3gd20h_mode_t mode);
  */
 uint8_t l3gd20h_get_mode(l3gd20h_handle_t *handle, l3gd20h_mode_t *mode);
 
+#if (L3GD20H_SETTLE_ENABLE == 1)
 /**
- * @brief     set the axis
+ * @brief     set the settling sample handling
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] axis set axis
- * @param[in] enable bool value
+ * @param[in] settle settling sample handling
  * @return    status code
  *            - 0 success
- *            - 1 set axis failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 settle is invalid
+ * @note      the window is opened by the next wake, rate or filter change, in the fifo modes it starts behind
+ *            the samples queued at that time, in bypass mode it ends after its sample periods on timestamp_us
+ *            and counts the reads when timestamp_us is not linked
  */
-uint8_t l3gd20h_set_axis(l3gd20h_handle_t *handle, l3gd20h_axis_t axis, l3gd20h_bool_t enable);
+uint8_t l3gd20h_set_settle(l3gd20h_handle_t *handle, l3gd20h_settle_t settle);
 
 /**
- * @brief      get the axis
+ * @brief      get the settling sample handling
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[in]  axis set axis
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *settle pointer to a settling sample handling buffer
  * @return     status code
  *             - 0 success
- *             - 1 get axis failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_axis(l3gd20h_handle_t *handle, l3gd20h_axis_t axis, l3gd20h_bool_t *enable);
+uint8_t l3gd20h_get_settle(l3gd20h_handle_t *handle, l3gd20h_settle_t *settle);
 
 /**
- * @brief     set the rate bandwidth
+ * @brief      get the settling window state
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *remaining pointer to a remaining samples buffer
+ * @param[out] *tagged pointer to a tagged samples buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       tagged is the number of settling samples at the start of the last read,
+ *             it is only set in tag mode, remaining does not count the queued samples in front of the window
+ */
+uint8_t l3gd20h_get_settling(l3gd20h_handle_t *handle, uint32_t *remaining, uint16_t *tagged);
+#endif
+
+#if (L3GD20H_REMAP_ENABLE == 1)
+/**
+ * @brief     set the axis remap
  * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] rate_bandwidth rate bandwidth
+ * @param[in] x sensor axis of the output x
+ * @param[in] y sensor axis of the output y
+ * @param[in] z sensor axis of the output z
  * @return    status code
  *            - 0 success
- *            - 1 set rate bandwidth failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 remap is invalid
+ * @note      the remap is applied while the output registers are decoded, so it costs nothing per
+ *            sample, every sensor axis must be used once, the bias, the temperature model and the
+ *            reference calibration stay in the sensor frame
  */
-uint8_t l3gd20h_set_rate_bandwidth(l3gd20h_handle_t *handle, l3gd20h_lodr_odr_bw_t rate_bandwidth);
+uint8_t l3gd20h_set_axis_remap(l3gd20h_handle_t *handle, l3gd20h_remap_t x, l3gd20h_remap_t y, l3gd20h_remap_t z);
 
 /**
- * @brief      get the rate bandwidth
+ * @brief      get the axis remap
  * @param[in]  *handle pointer to an l3gd20h handle structure
- * @param[out] *rate_bandwidth pointer to a rate bandwidth buffer
+ * @param[out] *x pointer to a sensor axis buffer of the output x
+ * @param[out] *y pointer to a sensor axis buffer of the output y
+ * @param[out] *z pointer to a sensor axis buffer of the output z
  * @return     status code
  *             - 0 success
- *             - 1 get rate bandwidth failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_rate_bandwidth(l3gd20h_handle_t *handle, l3gd20h_lodr_odr_bw_t *rate_bandwidth);
+uint8_t l3gd20h_get_axis_remap(l3gd20h_handle_t *handle, l3gd20h_remap_t *x, l3gd20h_remap_t *y, l3gd20h_remap_t *z);
+#endif
 
+#if (L3GD20H_RANGE_ENABLE == 1)
 /**
- * @brief     enable or disable the edge trigger
+ * @brief     enable or disable the auto ranging
  * @param[in] *handle pointer to an l3gd20h handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set edge trigger failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the full scale is switched by l3gd20h_read and l3gd20h_read_timestamp after a batch is
+ *            decoded, the samples still queued in the fifo at the switch are decoded with the old full
+ *            scale, the fifo level is read before and after the switch and the larger one counts, so a
+ *            sample captured right after the switch may be decoded with the old full scale, in bypass mode
+ *            the output registers keep the old sample until the next one, so the next read adds the status
+ *            register to its burst and decodes the old full scale until a new sample shows up there, the
+ *            switch pauses while a reference calibration runs, the interrupt thresholds are not rescaled
  */
-uint8_t l3gd20h_set_edge_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t enable);
+uint8_t l3gd20h_set_auto_range(l3gd20h_handle_t *handle, l3gd20h_bool_t enable);
 
 /**
- * @brief      get the edge trigger status
+ * @brief      get the auto ranging status
  * @param[in]  *handle pointer to an l3gd20h handle structure
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get edge trigger failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t l3gd20h_get_edge_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable);
+uint8_t l3gd20h_get_auto_range(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable);
 
 /**
- * @brief     enable or disable the level trigger
- * @param[in] *handle pointer to an l3gd20h handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set level trigger failed
- *            - 2 handle is NULL
+ * @brief      get the full scale tags of the last read
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *split pointer to a sample number buffer
+ * @param[out] *head pointer to a full scale buffer of the first split samples
+ * @param[out] *tail pointer to a full scale buffer of the other samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the raw data of a read keeps the lsb it was captured at, so the first split samples use
+ *             the sensitivity of head and the others the sensitivity of tail, the converted data is
+ *             already scaled per sample
+ */
+uint8_t l3gd20h_get_range_tag(l3gd20h_handle_t *handle, uint16_t *split, l3gd20h_full_scale_t *head,
+                              l3gd20h_full_scale_t *tail);
+#endif
+
+/**
+ * @brief     set the axis
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] axis set axis
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set axis failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 axis is invalid
+ * @note      none
+ */
+uint8_t l3gd20h_set_axis(l3gd20h_handle_t *handle, l3gd20h_axis_t axis, l3gd20h_bool_t enable);
+
+/**
+ * @brief      get the axis
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[in]  axis set axis
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get axis failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 axis is invalid
+ * @note       none
+ */
+uint8_t l3gd20h_get_axis(l3gd20h_handle_t *handle, l3gd20h_axis_t axis, l3gd20h_bool_t *enable);
+
+/**
+ * @brief     set the rate bandwidth
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] rate_bandwidth rate bandwidth
+ * @return    status code
+ *            - 0 success
+ *            - 1 set rate bandwidth failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_rate_bandwidth(l3gd20h_handle_t *handle, l3gd20h_lodr_odr_bw_t rate_bandwidth);
+
+/**
+ * @brief      get the rate bandwidth
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *rate_bandwidth pointer to a rate bandwidth buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get rate bandwidth failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_get_rate_bandwidth(l3gd20h_handle_t *handle, l3gd20h_lodr_odr_bw_t *rate_bandwidth);
+
+/**
+ * @brief     enable or disable the edge trigger
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set edge trigger failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_set_edge_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t enable);
+
+/**
+ * @brief      get the edge trigger status
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get edge trigger failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_get_edge_trigger(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable);
+
+/**
+ * @brief     enable or disable the level trigger
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set level trigger failed
+ *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
@@ -1128,7 +1828,7 @@ uint8_t l3gd20h_get_iic(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable);
  *            - 1 soft reset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the auto ranging state restarts from the full scale after reset
  */
 uint8_t l3gd20h_soft_reset(l3gd20h_handle_t *handle);
 
@@ -1143,6 +1843,7 @@ uint8_t l3gd20h_soft_reset(l3gd20h_handle_t *handle);
  * @{
  */
 
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
 /**
  * @brief     enable or disable the interrupt1
  * @param[in] *handle pointer to an l3gd20h handle structure
@@ -1168,6 +1869,7 @@ uint8_t l3gd20h_set_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t enable);
  * @note       none
  */
 uint8_t l3gd20h_get_interrupt1(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable);
+#endif
 
 /**
  * @brief     enable or disable boot on the interrupt1
@@ -1273,6 +1975,7 @@ uint8_t l3gd20h_set_data_ready_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_b
  */
 uint8_t l3gd20h_get_data_ready_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable);
 
+#if (L3GD20H_FIFO_ENABLE == 1)
 /**
  * @brief     enable or disable the fifo threshold on interrupt2
  * @param[in] *handle pointer to an l3gd20h handle structure
@@ -1350,7 +2053,9 @@ uint8_t l3gd20h_set_fifo_empty_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_b
  * @note       none
  */
 uint8_t l3gd20h_get_fifo_empty_on_interrupt2(l3gd20h_handle_t *handle, l3gd20h_bool_t *enable);
+#endif
 
+#if (L3GD20H_INTERRUPT_ENABLE == 1)
 /**
  * @brief     set the interrupt selection
  * @param[in] *handle pointer to an l3gd20h handle structure
@@ -1387,6 +2092,7 @@ uint8_t l3gd20h_get_interrupt_selection(l3gd20h_handle_t *handle, l3gd20h_select
  *            - 1 set interrupt event failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 interrupt event is invalid
  * @note      none
  */
 uint8_t l3gd20h_set_interrupt_event(l3gd20h_handle_t *handle, l3gd20h_interrupt_event_t interrupt_event, l3gd20h_bool_t enable);
@@ -1401,6 +2107,7 @@ uint8_t l3gd20h_set_interrupt_event(l3gd20h_handle_t *handle, l3gd20h_interrupt_
  *             - 1 get interrupt event failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 interrupt event is invalid
  * @note       none
  */
 uint8_t l3gd20h_get_interrupt_event(l3gd20h_handle_t *handle, l3gd20h_interrupt_event_t interrupt_event, l3gd20h_bool_t *enable);
@@ -1604,6 +2311,7 @@ uint8_t l3gd20h_set_duration(l3gd20h_handle_t *handle, uint8_t duration);
  * @note       none
  */
 uint8_t l3gd20h_get_duration(l3gd20h_handle_t *handle, uint8_t *duration);
+#endif
 
 /**
  * @brief     set the data ready active level
@@ -1642,6 +2350,7 @@ uint8_t l3gd20h_get_data_ready_active_level(l3gd20h_handle_t *handle, l3gd20h_in
  * @{
  */
 
+#if (L3GD20H_FIFO_ENABLE == 1)
 /**
  * @brief     enable or disable the fifo
  * @param[in] *handle pointer to an l3gd20h handle structure
@@ -1759,10 +2468,448 @@ uint8_t l3gd20h_get_fifo_threshold(l3gd20h_handle_t *handle, uint8_t *threshold)
  * @note       none
  */
 uint8_t l3gd20h_get_fifo_level(l3gd20h_handle_t *handle, uint8_t *level);
+#endif
+
+/**
+ * @}
+ */
+
+#if (L3GD20H_ASYNC_ENABLE == 1)
+/**
+ * @defgroup l3gd20h_async_driver l3gd20h async driver function
+ * @brief    l3gd20h async driver modules
+ * @ingroup  l3gd20h_driver
+ * @{
+ */
+
+/**
+ * @brief      submit an async read request
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] **raw pointer to a raw data buffer with at least 1 sample
+ * @param[out] **dps pointer to a converted data buffer, NULL skips the conversion
+ * @param[in]  *callback pointer to a completion callback
+ * @return     status code
+ *             - 0 success
+ *             - 1 start transfer failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 queue is full
+ *             - 5 async function is NULL
+ * @note       raw and dps must stay valid until the callback runs,
+ *             the call must not preempt l3gd20h_async_irq_handler or be preempted by it,
+ *             the sample runs the same settling, bias and reference steps as l3gd20h_read, the reference
+ *             write is queued behind the request, the auto ranging only runs in the blocking reads and
+ *             no timestamp is taken, stamp the callback and use l3gd20h_timestamp_assign
+ */
+uint8_t l3gd20h_async_read(l3gd20h_handle_t *handle, int16_t (*raw)[3], float (*dps)[3],
+                           void (*callback)(uint8_t type, uint8_t res, uint16_t len));
+
+#if (L3GD20H_FIFO_ENABLE == 1)
+/**
+ * @brief      submit an async fifo drain request
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] **raw pointer to a raw data buffer
+ * @param[out] **dps pointer to a converted data buffer, NULL skips the conversion
+ * @param[in]  len max sample length of the buffers
+ * @param[in]  *callback pointer to a completion callback
+ * @return     status code
+ *             - 0 success
+ *             - 1 start transfer failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 queue is full
+ *             - 5 async function is NULL
+ *             - 6 len is invalid
+ * @note       1 <= len <= 32, the callback reports the drained length after the settling drop,
+ *             the call must not preempt l3gd20h_async_irq_handler or be preempted by it,
+ *             the batch runs the same steps as l3gd20h_async_read
+ */
+uint8_t l3gd20h_async_drain(l3gd20h_handle_t *handle, int16_t (*raw)[3], float (*dps)[3], uint16_t len,
+                            void (*callback)(uint8_t type, uint8_t res, uint16_t len));
+#endif
+
+/**
+ * @brief     submit an async config request
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] reg register address
+ * @param[in] mask changed bits of the register
+ * @param[in] value new value of the changed bits
+ * @param[in] *callback pointer to a completion callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 start transfer failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 queue is full
+ *            - 5 async function is NULL
+ * @note      the register is read, modified and written back,
+ *            the call must not preempt l3gd20h_async_irq_handler or be preempted by it
+ */
+uint8_t l3gd20h_async_apply_config(l3gd20h_handle_t *handle, uint8_t reg, uint8_t mask, uint8_t value,
+                                   void (*callback)(uint8_t type, uint8_t res, uint16_t len));
+
+/**
+ * @brief      get the pending async request count
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *count pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t l3gd20h_async_get_pending(l3gd20h_handle_t *handle, uint8_t *count);
+
+/**
+ * @brief     async transfer complete handler
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] res transfer result, 0 means success
+ * @return    status code
+ *            - 0 success
+ *            - 1 no request is running
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it from the dma or bus interrupt when a started transfer finishes,
+ *            the queue is not locked, so mask that interrupt around a submit from thread context,
+ *            a submit from a completion callback is safe
+ */
+uint8_t l3gd20h_async_irq_handler(l3gd20h_handle_t *handle, uint8_t res);
+
+/**
+ * @}
+ */
+#endif
+
+#if (L3GD20H_COUNTER_ENABLE == 1)
+/**
+ * @defgroup l3gd20h_counter_driver l3gd20h counter driver function
+ * @brief    l3gd20h counter driver modules
+ * @ingroup  l3gd20h_driver
+ * @{
+ */
+
+/**
+ * @brief      take a snapshot of the performance counters
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *counter pointer to a counter structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the histograms are only filled when timestamp_us is linked
+ */
+uint8_t l3gd20h_counter_snapshot(l3gd20h_handle_t *handle, l3gd20h_counter_t *counter);
+
+/**
+ * @brief     reset the performance counters
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_counter_reset(l3gd20h_handle_t *handle);
 
 /**
  * @}
  */
+#endif
+
+#if (L3GD20H_TRACE_ENABLE == 1)
+/**
+ * @defgroup l3gd20h_trace_driver l3gd20h trace driver function
+ * @brief    l3gd20h trace driver modules
+ * @ingroup  l3gd20h_driver
+ * @{
+ */
+
+/**
+ * @brief         read the trace ring
+ * @param[in]     *handle pointer to an l3gd20h handle structure
+ * @param[out]    *trace pointer to a trace buffer
+ * @param[in,out] *len pointer to a trace length buffer
+ * @param[out]    *lost pointer to an overwritten entry number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          the entries are returned oldest first and removed from the ring,
+ *                the timestamps are only valid when timestamp_us is linked
+ */
+uint8_t l3gd20h_trace_read(l3gd20h_handle_t *handle, l3gd20h_trace_t *trace, uint16_t *len, uint32_t *lost);
+
+/**
+ * @brief     clear the trace ring
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_trace_clear(l3gd20h_handle_t *handle);
+
+/**
+ * @}
+ */
+#endif
+
+#if (L3GD20H_TIMESTAMP_ENABLE == 1)
+/**
+ * @defgroup l3gd20h_timestamp_driver l3gd20h timestamp driver function
+ * @brief    l3gd20h timestamp driver modules
+ * @ingroup  l3gd20h_driver
+ * @{
+ */
+
+/**
+ * @brief     init a timestamp structure
+ * @param[in] *ts pointer to a timestamp structure
+ * @param[in] rate rate bandwidth
+ * @return    status code
+ *            - 0 success
+ *            - 2 ts is NULL
+ *            - 4 rate is invalid
+ * @note      the period starts at the nominal output data rate of the rate and follows the drift estimate
+ */
+uint8_t l3gd20h_timestamp_init(l3gd20h_timestamp_t *ts, l3gd20h_lodr_odr_bw_t rate);
+
+/**
+ * @brief      assign the sample times of a batch
+ * @param[in]  *ts pointer to a timestamp structure
+ * @param[in]  anchor_us time of the anchor sample in us
+ * @param[in]  anchor index of the anchor sample in the batch
+ * @param[in]  len batch length
+ * @param[out] *us pointer to a timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ts is NULL
+ *             - 3 ts is not initialized
+ * @note       an interrupt driven reader passes the interrupt time and the index of the sample
+ *             that raised it, the times stay continuous with the previous batch
+ */
+uint8_t l3gd20h_timestamp_assign(l3gd20h_timestamp_t *ts, uint64_t anchor_us, uint16_t anchor,
+                                 uint16_t len, uint64_t *us);
+
+/**
+ * @brief      get the estimated output data rate
+ * @param[in]  *ts pointer to a timestamp structure
+ * @param[out] *odr pointer to an output data rate buffer in Hz
+ * @param[out] *bound pointer to a confidence bound buffer in Hz
+ * @return     status code
+ *             - 0 success
+ *             - 2 ts is NULL
+ *             - 3 ts is not initialized
+ *             - 4 estimate has not converged
+ * @note       the sample times follow the estimate from L3GD20H_TIMESTAMP_POINT_MIN drift points on,
+ *             it is only reported once the window holds L3GD20H_TIMESTAMP_WINDOW points, the real rate
+ *             lies within odr - bound and odr + bound while the host clock is good
+ */
+uint8_t l3gd20h_timestamp_get_odr(l3gd20h_timestamp_t *ts, float *odr, float *bound);
+
+/**
+ * @}
+ */
+#endif
+
+#if (L3GD20H_BIAS_ENABLE == 1)
+/**
+ * @defgroup l3gd20h_bias_driver l3gd20h bias driver function
+ * @brief    l3gd20h bias driver modules
+ * @ingroup  l3gd20h_driver
+ * @{
+ */
+
+/**
+ * @brief     set the bias compensation mode
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] mode bias compensation mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 mode is invalid
+ * @note      the bias is subtracted from the raw data during the decode, so the converted data
+ *            is compensated too, the running window restarts and the stored bias is kept
+ */
+uint8_t l3gd20h_bias_set_mode(l3gd20h_handle_t *handle, l3gd20h_bias_t mode);
+
+/**
+ * @brief      get the bias compensation mode
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *mode pointer to a bias compensation mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t l3gd20h_bias_get_mode(l3gd20h_handle_t *handle, l3gd20h_bias_t *mode);
+
+/**
+ * @brief     set the still threshold
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] dps standard deviation threshold in dps
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 dps is invalid
+ * @note      0 < dps <= 100, it should sit above the noise of the selected bandwidth
+ */
+uint8_t l3gd20h_bias_set_threshold(l3gd20h_handle_t *handle, float dps);
+
+/**
+ * @brief      get the bias
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *dps pointer to a bias buffer in dps
+ * @param[out] *windows pointer to a still windows buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       windows is 0 until the first still window or load
+ */
+uint8_t l3gd20h_bias_get(l3gd20h_handle_t *handle, float dps[3], uint32_t *windows);
+
+/**
+ * @brief     clear the bias
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t l3gd20h_bias_reset(l3gd20h_handle_t *handle);
+
+/**
+ * @brief      save the bias to a calibration blob
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *blob pointer to a L3GD20H_BIAS_BLOB_SIZE bytes buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no bias yet
+ * @note       the blob is byte ordered and can be stored as it is
+ */
+uint8_t l3gd20h_bias_save(l3gd20h_handle_t *handle, uint8_t *blob);
+
+/**
+ * @brief     load the bias from a calibration blob
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] *blob pointer to a L3GD20H_BIAS_BLOB_SIZE bytes buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 blob is invalid
+ * @note      the loaded bias keeps its window count, so tracking goes on with the small gain
+ */
+uint8_t l3gd20h_bias_load(l3gd20h_handle_t *handle, const uint8_t *blob);
+
+/**
+ * @brief     fit the bias temperature model
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] *temp pointer to a temperature buffer in degrees
+ * @param[in] **dps pointer to a still bias buffer in dps
+ * @param[in] len number of pairs
+ * @param[in] order polynomial order
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 order is invalid
+ *            - 5 len is too small
+ *            - 6 temperatures are too close
+ * @note      the pairs are logged still biases with the compensation off, the model term is added to
+ *            the stored bias, so a tracked or saved bias is the residual of the model
+ */
+uint8_t l3gd20h_bias_temp_fit(l3gd20h_handle_t *handle, const float *temp, const float (*dps)[3],
+                              uint16_t len, uint8_t order);
+
+/**
+ * @brief     clear the bias temperature model
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the temperature reads stop
+ */
+uint8_t l3gd20h_bias_temp_clear(l3gd20h_handle_t *handle);
+
+/**
+ * @brief      get the temperature term of the bias
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *degree pointer to a temperature buffer in degrees
+ * @param[out] *dps pointer to a temperature term buffer in dps
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no model or no temperature yet
+ * @note       the term follows the temperature read by the last burst
+ */
+uint8_t l3gd20h_bias_temp_get(l3gd20h_handle_t *handle, float *degree, float dps[3]);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup l3gd20h_reference_driver l3gd20h reference driver function
+ * @brief    l3gd20h reference driver modules
+ * @ingroup  l3gd20h_driver
+ * @{
+ */
+
+/**
+ * @brief     start the reference calibration
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @param[in] period samples between two runs, 0 runs once
+ * @return    status code
+ *            - 0 success
+ *            - 1 calibrate failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the high pass filter is enabled in reference mode and the output path goes through it,
+ *            the calibration runs inside the reads and writes the reference register between two
+ *            batches, the stream is not stopped and the device should be still for a few windows
+ */
+uint8_t l3gd20h_reference_calibrate(l3gd20h_handle_t *handle, uint32_t period);
+
+/**
+ * @brief     stop the reference calibration
+ * @param[in] *handle pointer to an l3gd20h handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the reference register and the filter setting are kept
+ */
+uint8_t l3gd20h_reference_stop(l3gd20h_handle_t *handle);
+
+/**
+ * @brief      get the reference calibration result
+ * @param[in]  *handle pointer to an l3gd20h handle structure
+ * @param[out] *value pointer to a reference value buffer
+ * @param[out] *residual pointer to a residual offset buffer in dps
+ * @param[out] *runs pointer to a finished runs buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the residual is the still output left at the chosen value, the part that differs between
+ *             the axes stays for the host bias
+ */
+uint8_t l3gd20h_reference_get(l3gd20h_handle_t *handle, int8_t *value, float residual[3], uint32_t *runs);
+
+/**
+ * @}
+ */
+#endif
 
 /**
  * @defgroup l3gd20h_extern_driver l3gd20h extern driver function
@@ -406,6 +406,14 @@ uint8_t l3gd20h_register_test(l3gd20h_interface_t interface, l3gd20h_address_t a
         return 1;
     }
     l3gd20h_interface_debug_print("l3gd20h: check axis %s.\n", enable == L3GD20H_BOOL_TRUE ? "ok" : "error"); 
+    
+    /* invalid axis */
+    res = l3gd20h_set_axis(&gs_handle, (l3gd20h_axis_t)(L3GD20H_AXIS_Z + 1), L3GD20H_BOOL_TRUE);
+    l3gd20h_interface_debug_print("l3gd20h: set invalid axis.\n");
+    l3gd20h_interface_debug_print("l3gd20h: check axis %s.\n", res == 4 ? "ok" : "error");
+    res = l3gd20h_get_axis(&gs_handle, (l3gd20h_axis_t)(L3GD20H_AXIS_Z + 1), &enable);
+    l3gd20h_interface_debug_print("l3gd20h: get invalid axis.\n");
+    l3gd20h_interface_debug_print("l3gd20h: check axis %s.\n", res == 4 ? "ok" : "error");
 
     /* l3gd20h_set_rate_bandwidth/l3gd20h_get_rate_bandwidth test */
     l3gd20h_interface_debug_print("l3gd20h: l3gd20h_set_rate_bandwidth/l3gd20h_get_rate_bandwidth test.\n");
@@ -2532,6 +2540,14 @@ uint8_t l3gd20h_register_test(l3gd20h_interface_t interface, l3gd20h_address_t a
     }
     l3gd20h_interface_debug_print("l3gd20h: check interrupt event %s.\n", enable == L3GD20H_BOOL_FALSE ? "ok" : "error");
     
+    /* invalid interrupt event */
+    res = l3gd20h_set_interrupt_event(&gs_handle, (l3gd20h_interrupt_event_t)(L3GD20H_INTERRUPT_EVENT_AND_OR_COMBINATION + 1), L3GD20H_BOOL_TRUE);
+    l3gd20h_interface_debug_print("l3gd20h: set invalid interrupt event.\n");
+    l3gd20h_interface_debug_print("l3gd20h: check interrupt event %s.\n", res == 4 ? "ok" : "error");
+    res = l3gd20h_get_interrupt_event(&gs_handle, (l3gd20h_interrupt_event_t)(L3GD20H_INTERRUPT_EVENT_AND_OR_COMBINATION + 1), &enable);
+    l3gd20h_interface_debug_print("l3gd20h: get invalid interrupt event.\n");
+    l3gd20h_interface_debug_print("l3gd20h: check interrupt event %s.\n", res == 4 ? "ok" : "error");
+    
     /* l3gd20h_set_x_interrupt_threshold/l3gd20h_get_x_interrupt_threshold test */
     l3gd20h_interface_debug_print("l3gd20h: l3gd20h_set_x_interrupt_threshold/l3gd20h_get_x_interrupt_threshold test.\n");
     threshold = rand() % 32768;